@@ -51,6 +51,8 @@ file(GLOB_RECURSE MODULE_JSON_FILES "${CMAKE_CURRENT_LIST_DIR}/../modules/**/mod
 # --- ნაბიჯი 2: დაამუშავეთ თითოეული მოდული ---
 set(MODULE_CREATE_FUNCTIONS "")
 set(MODULE_INCLUDE_HEADERS "")
+set(MODULE_EVENT_ROUTES "")
+set(MODULE_EVENT_ROUTE_COUNT 0)
 set(COLLECTED_MODULE_DEPENDENCIES "")
 set(ENABLED_MODULE_PATHS "")
 
@@ -131,6 +133,51 @@ foreach(MODULE_JSON_FILE ${MODULE_JSON_FILES})
         endif()
     endif()
     
+    # --- სტატიკური გამოწერები: module.json-ის "subscribes" სექცია ---
+    # თითოეული ჩანაწერი ხდება const (flash-ში მდებარე) მარშრუტიზაციის ცხრილის სტრიქონი,
+    # რომელსაც Event Bus დისპეტჩერიზაციისას დინამიურ გამოწერებთან აერთიანებს.
+    string(JSON SUBSCRIBES_TYPE ERROR_VARIABLE json_error TYPE "${MODULE_JSON_CONTENT}" subscribes)
+    if(NOT json_error AND "${SUBSCRIBES_TYPE}" STREQUAL "ARRAY")
+        string(JSON SUBSCRIBES_COUNT LENGTH "${MODULE_JSON_CONTENT}" subscribes)
+        if(SUBSCRIBES_COUNT GREATER 0)
+            # მარშრუტი იგივე პირობითაა, რაც factory-ს ჩანაწერი
+            if(HAS_CONDITIONAL_CONFIG)
+                set(ROUTE_GUARD ${CONFIG_VARIABLE})
+            elseif("${COMPONENT_NAME}" STREQUAL "logger_module")
+                set(ROUTE_GUARD CONFIG_MODULE_LOGGER_ENABLED)
+            else()
+                string(TOUPPER "${MODULE_NAME}" ROUTE_MODULE_NAME_UPPER)
+                set(ROUTE_GUARD CONFIG_MODULE_${ROUTE_MODULE_NAME_UPPER}_ENABLED)
+            endif()
+
+            string(APPEND MODULE_EVENT_ROUTES "#ifdef ${ROUTE_GUARD}\n")
+            math(EXPR SUBSCRIBES_LAST "${SUBSCRIBES_COUNT} - 1")
+            foreach(SUBSCRIBE_INDEX RANGE ${SUBSCRIBES_LAST})
+                string(JSON ENTRY_TYPE TYPE "${MODULE_JSON_CONTENT}" subscribes ${SUBSCRIBE_INDEX})
+                set(ROUTE_FLAGS "0")
+                if("${ENTRY_TYPE}" STREQUAL "STRING")
+                    string(JSON ROUTE_EVENT GET "${MODULE_JSON_CONTENT}" subscribes ${SUBSCRIBE_INDEX})
+                elseif("${ENTRY_TYPE}" STREQUAL "OBJECT")
+                    string(JSON ROUTE_EVENT GET "${MODULE_JSON_CONTENT}" subscribes ${SUBSCRIBE_INDEX} event)
+                    string(JSON ROUTE_SYNC ERROR_VARIABLE json_error GET "${MODULE_JSON_CONTENT}" subscribes ${SUBSCRIBE_INDEX} sync)
+                    if(NOT json_error AND ROUTE_SYNC)
+                        set(ROUTE_FLAGS "MODULE_EVENT_ROUTE_FLAG_SYNC")
+                    endif()
+                else()
+                    message(FATAL_ERROR "${MODULE_JSON_FILE}: 'subscribes' ჩანაწერი უნდა იყოს სტრიქონი ან ობიექტი.")
+                endif()
+
+                if(NOT ROUTE_EVENT MATCHES "^[A-Za-z0-9_./-]+$")
+                    message(FATAL_ERROR "${MODULE_JSON_FILE}: არასწორი ივენთის სახელი 'subscribes'-ში: '${ROUTE_EVENT}' (wildcard/pattern დაუშვებელია).")
+                endif()
+
+                string(APPEND MODULE_EVENT_ROUTES "    { \"${ROUTE_EVENT}\", \"${MODULE_NAME}\", ${ROUTE_FLAGS} },\n")
+                math(EXPR MODULE_EVENT_ROUTE_COUNT "${MODULE_EVENT_ROUTE_COUNT} + 1")
+            endforeach()
+            string(APPEND MODULE_EVENT_ROUTES "#endif\n")
+        endif()
+    endif()
+
     # ყველა მოდული (conditional და unconditional) დამოკიდებულებების სიაში ემატება
     list(APPEND COLLECTED_MODULE_DEPENDENCIES ${COMPONENT_NAME})
 endforeach()
@@ -145,6 +192,7 @@ message(STATUS "ჩართული მოდულების ბილი
 message(STATUS "--- გენერირებული factory ფაილების კონფიგურაცია ---")
 message(STATUS "სათაურები ჩასასმელად:\n${MODULE_INCLUDE_HEADERS}")
 message(STATUS "სასაქმებელი factory ფუნქციები:\n${MODULE_CREATE_FUNCTIONS}")
+message(STATUS "სტატიკური გამოწერები (${MODULE_EVENT_ROUTE_COUNT}):\n${MODULE_EVENT_ROUTES}")
 
 # გამოიყენეთ configure_file ორივე template ფაილში placeholder-ების ჩასანაცვლებლად.
 configure_file(
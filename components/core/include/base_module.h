@@ -124,6 +124,22 @@ typedef struct
     size_t offset;          /**< @brief The offset of the handle pointer within the private_data struct, calculated using offsetof(). */
 } module_dependency_t;
 
+/**
+ * @brief Forward declaration of a module's event mailbox (owned by the Event Bus).
+ */
+struct module_mailbox_t;
+
+/**
+ * @brief Event handler counters of one module, maintained by the Event Bus.
+ * @details Read them with `synapse_event_bus_get_module_stats()`; modules must not write them.
+ */
+typedef struct
+{
+    uint32_t handled;          /**< @brief `handle_event` calls since the last reset. */
+    uint32_t total_handler_us; /**< @brief Time spent in `handle_event` (wraps after ~71 minutes of handler time). */
+    uint32_t max_handler_us;   /**< @brief Longest single `handle_event` call. */
+} module_event_stats_t;
+
 /**
  * @struct module_t
  * @brief The primary structure defining a framework module.
@@ -175,6 +191,11 @@ struct module_t
 
     void *private_data;                        /**< @brief A pointer to the module's internal, private data structure. */
     const module_dependency_t *dependency_map; /**< @brief (Optional) A NULL-terminated array describing the module's service dependencies for injection. */
+
+    struct module_mailbox_t *mailbox;  /**< @brief (Core) The module's event mailbox, see `synapse_event_bus_enable_mailbox()`; NULL = events are handled on the dispatcher. */
+    module_event_stats_t event_stats;  /**< @brief (Core) Handler counters maintained by the Event Bus. */
+    uint16_t dispatch_slot;            /**< @brief (Core) Per-core dispatch: the module's handler mutex slot, see `synapse_event_bus_set_module_concurrent()`; 0 = not assigned yet. */
+    uint16_t in_dispatch;              /**< @brief (Core) Deliveries a dispatcher has taken from the subscriber lists but not finished yet; `unsubscribe` waits for 0. */
 };
 
 // --- Helper Macros ---
@@ -1,7 +1,7 @@
 /**
  * @file event_bus.h
  * @brief Event Bus კომპონენტის Public API.
- * @version 2.0
+ * @version 2.1
  * @date 2025-06-27
  * @author Giorgi Magradze
  * @details ეს კომპონენტი უზრუნველყოფს ასინქრონული შეტყობინებების (events) მართვის
@@ -14,18 +14,378 @@
 #ifndef SYNAPSE_EVENT_BUS_H
 #define SYNAPSE_EVENT_BUS_H
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "framework_events.h"
+#include "promise_manager.h"
 
 // Forward declarations to avoid circular dependencies
 struct module_t;
 struct event_data_wrapper_t;
 
+/**
+ * @brief Event Bus-ის პრიორიტეტული ზოლები (lanes).
+ * @details თითოეულ ზოლს აქვს საკუთარი რიგი, საკუთარი დისპეტჩერ-ტასკი და
+ *          გადავსების პოლიტიკა (იხ. Kconfig "Event Bus Priority Lanes").
+ *          ზოლები ერთმანეთისგან დამოუკიდებლად მუშავდება, ამიტომ კრიტიკული
+ *          ივენთი არასდროს ელოდება bulk ტრაფიკს.
+ *
+ * @warning რადგან ზოლებს ცალ-ცალკე ტასკები ამუშავებს, ერთი მოდულის `handle_event`
+ *          შეიძლება ერთდროულად გამოიძახონ სხვადასხვა ზოლის დისპეტჩერებმა.
+ *          მოდული, რომელიც სხვადასხვა პრიორიტეტის ივენთებს იწერს, საკუთარ
+ *          მდგომარეობას უნდა იცავდეს (მაგ. mutex-ით ან საკუთარი რიგით).
+ */
+typedef enum
+{
+    SYNAPSE_EVENT_PRIORITY_CRITICAL = 0, /**< @brief სისტემური/საგანგებო ივენთები. */
+    SYNAPSE_EVENT_PRIORITY_NORMAL,       /**< @brief ნაგულისხმევი ზოლი. */
+    SYNAPSE_EVENT_PRIORITY_BULK,         /**< @brief მაღალი სიხშირის, დაბალი ღირებულების ტრაფიკი (ტელემეტრია). */
+    SYNAPSE_EVENT_PRIORITY_MAX           /**< @brief ზოლების რაოდენობა. */
+} synapse_event_priority_t;
+
+/**
+ * @brief ზოლის ქცევა, როცა მისი რიგი სავსეა.
+ */
+typedef enum
+{
+    SYNAPSE_EVENT_OVERFLOW_BLOCK = 0,   /**< @brief ველოდებით `CONFIG_SYNAPSE_TASK_QUEUE_TIMEOUT_MS`-ს, შემდეგ ESP_FAIL. */
+    SYNAPSE_EVENT_OVERFLOW_DROP_NEWEST, /**< @brief ახალი ივენთი იკარგება (ESP_FAIL). */
+    SYNAPSE_EVENT_OVERFLOW_DROP_OLDEST, /**< @brief რიგიდან იშლება უძველესი ივენთი, ახალი ემატება. */
+    SYNAPSE_EVENT_OVERFLOW_SPILL,       /**< @brief ივენთი გადადის ზოლის სათადარიგო ბუფერში (`CONFIG_SYNAPSE_EVENT_SPILL_BUFFER_LENGTH`); ისიც თუ სავსეა - იკარგება. */
+    SYNAPSE_EVENT_OVERFLOW_LANE_DEFAULT = 0xFF, /**< @brief (მხოლოდ ივენთისთვის) ზოლის პოლიტიკის გამოყენება. */
+} synapse_event_overflow_policy_t;
+
+/**
+ * @brief ერთი ზოლის სტატისტიკა.
+ */
+typedef struct
+{
+    uint32_t queue_length;   /**< @brief რიგის ტევადობა (per-core რეჟიმში - ზოლის ყველა რიგის ჯამი). */
+    uint32_t pending;        /**< @brief ამ მომენტში რიგ(ებ)ში მყოფი ივენთები. */
+    uint32_t posted;         /**< @brief რიგში დამატებული ივენთები (სათადარიგო ბუფერიდან დაბრუნებულების ჩათვლით). */
+    uint32_t dispatched;     /**< @brief დამუშავებული ივენთები. */
+    uint32_t dropped;        /**< @brief გადავსების გამო დაკარგული ივენთები (ორივე DROP პოლიტიკით). */
+    uint32_t max_latency_us; /**< @brief უდიდესი დაყოვნება გამოქვეყნებიდან დისპეტჩერამდე (მიკროწამები). */
+    uint32_t dispatch_batches; /**< @brief დისპეტჩერის გაღვიძებები; `dispatched / dispatch_batches` = საშუალო პაკეტის ზომა. */
+    uint32_t conflated;      /**< @brief conflation-ით შერწყმული (რიგში აღარ ჩამდგარი) ივენთები. */
+    uint32_t inline_posted;  /**< @brief ინლაინ payload-ით (wrapper-ის გამოყოფის გარეშე) გამოქვეყნებული ივენთები. */
+    uint32_t high_watermark; /**< @brief რიგში ერთდროულად მყოფი ივენთების მაქსიმუმი (რიგის ზომის შესარჩევად). */
+    uint32_t spilled;        /**< @brief სათადარიგო ბუფერში გადატანილი ივენთები. */
+    uint32_t spill_pending;  /**< @brief ამ მომენტში სათადარიგო ბუფერში მყოფი ივენთები. */
+    uint32_t spill_high_watermark; /**< @brief სათადარიგო ბუფერის შევსების მაქსიმუმი. */
+} synapse_event_lane_stats_t;
+
+/**
+ * @brief ზოლის ერთი დისპეტჩერის სტატისტიკა (`CONFIG_SYNAPSE_EVENT_PER_CORE_DISPATCH`).
+ */
+typedef struct
+{
+    uint8_t core;        /**< @brief ბირთვი, რომელზეც დისპეტჩერ-ტასკია მიბმული, ან `SYNAPSE_EVENT_DISPATCHER_UNPINNED`. */
+    uint32_t pending;    /**< @brief ამ მომენტში დისპეტჩერის რიგში მყოფი ივენთები. */
+    uint32_t dispatched; /**< @brief დისპეტჩერის მიერ დამუშავებული ივენთები (init-იდან). */
+} synapse_event_dispatcher_stats_t;
+
+/** @brief `synapse_event_dispatcher_stats_t::core`: დისპეტჩერი ბირთვზე მიბმული არ არის (ერთი დისპეტჩერი ზოლზე). */
+#define SYNAPSE_EVENT_DISPATCHER_UNPINNED 0xFF
+
+/** @brief `synapse_event_bus_set_dispatch_core()`: ბირთვი არ არის დაფიქსირებული, დისპეტჩერს partition key ირჩევს. */
+#define SYNAPSE_EVENT_DISPATCH_CORE_ANY (-1)
+
+/**
+ * @brief ზოლის დაყოვნების პერცენტილები (გამოქვეყნებიდან handler-ის გამოძახებამდე).
+ * @details მნიშვნელობები აღებულია ლოგ-წრფივი ჰისტოგრამიდან და წარმოადგენს
+ *          bucket-ის ზედა საზღვარს (ცდომილება < 25%), შეზღუდულს `max_us`-ით.
+ */
+typedef struct
+{
+    uint32_t samples; /**< @brief გაზომვების რაოდენობა. */
+    uint32_t p50_us;  /**< @brief მედიანა. */
+    uint32_t p99_us;  /**< @brief 99-ე პერცენტილი. */
+    uint32_t p999_us; /**< @brief 99.9-ე პერცენტილი. */
+    uint32_t max_us;  /**< @brief მაქსიმუმი (ზუსტი). */
+} synapse_event_latency_stats_t;
+
+/**
+ * @brief ერთი ივენთის (event ID) სტატისტიკა.
+ */
+typedef struct
+{
+    uint32_t posted;         /**< @brief რიგში დამატებული ივენთები (სათადარიგო ბუფერიდან დაბრუნებულების ჩათვლით). */
+    uint32_t dropped;        /**< @brief გადავსების გამო დაკარგული ივენთები (უარყოფილი ან რიგიდან გამოდევნილი). */
+    uint32_t spilled;        /**< @brief სათადარიგო ბუფერში გადატანილი ივენთები. */
+    uint32_t conflated;      /**< @brief conflation-ით შერწყმული ივენთები. */
+    uint32_t high_watermark; /**< @brief ზოლის რიგის უდიდესი შევსება ამ ივენთის დამატებისას. */
+} synapse_event_stats_t;
+
+/**
+ * @brief pattern-ების გამოწერების სტატისტიკა.
+ */
+typedef struct
+{
+    uint32_t patterns;   /**< @brief pattern-ების გამოწერების რაოდენობა. */
+    uint32_t trie_nodes; /**< @brief კომპილირებული trie-ს კვანძები. */
+    uint32_t trie_bytes; /**< @brief კომპილირებული trie-ს ზომა ბაიტებში. */
+} synapse_event_pattern_stats_t;
+
+/**
+ * @brief გამოწერების საცავის მეხსიერების ანგარიში.
+ * @details ბაიტები არის მოთხოვნილი ზომები; ალოკატორი თითო `heap_blocks`-ს
+ *          საკუთარ overhead-ს უმატებს.
+ */
+typedef struct
+{
+    uint32_t events;                 /**< @brief ივენთები, რომლებსაც ერთი გამომწერი მაინც ჰყავს. */
+    uint32_t subscriptions;          /**< @brief კონკრეტული და `*` გამოწერები. */
+    uint32_t sync_subscriptions;     /**< @brief მათგან synchronous. */
+    uint32_t filtered_subscriptions; /**< @brief მათგან ფილტრიანი. */
+    uint32_t pattern_subscriptions;  /**< @brief pattern-ების გამოწერები. */
+    uint32_t static_subscriptions;   /**< @brief module.json-ის `subscribes`-ით მიბმული მოდული/ივენთის წყვილები. */
+    uint32_t table_bytes;            /**< @brief ID-ით ინდექსირებული სტატიკური ცხრილი (`CONFIG_SYNAPSE_EVENT_MAX_NAMES` მაჩვენებელი). */
+    uint32_t snapshot_bytes;         /**< @brief გამომწერების snapshot-ები (heap). */
+    uint32_t filter_bytes;           /**< @brief ფილტრის ბლოკები (heap). */
+    uint32_t pattern_bytes;          /**< @brief pattern-ების სია, სტრიქონები და trie (heap). */
+    uint32_t static_bytes;           /**< @brief სტატიკური მარშრუტების დალუქული ცხრილი (heap; const წყარო flash-შია). */
+    uint32_t heap_blocks;            /**< @brief ცოცხალი heap ბლოკები. */
+    uint32_t retired_blocks;         /**< @brief grace period-ის მომლოდინე (ჯერ გაუთავისუფლებელი) ბლოკები. */
+    uint32_t bytes_per_subscription; /**< @brief (`snapshot_bytes` + `filter_bytes`) / `subscriptions`. */
+} synapse_event_memory_stats_t;
+
+/**
+ * @brief მოდულის საფოსტო ყუთის (mailbox) პარამეტრები.
+ * @details ნულოვანი ველი ნიშნავს ნაგულისხმევ მნიშვნელობას.
+ */
+typedef struct
+{
+    uint16_t queue_length;      /**< @brief რიგის სიგრძე; 0 = `CONFIG_SYNAPSE_EVENT_MAILBOX_QUEUE_LENGTH`. */
+    uint32_t stack_size;        /**< @brief შემსრულებელი ტასკის stack; 0 = `CONFIG_SYNAPSE_EVENT_BUS_TASK_STACK_SIZE` (handler-ი აქამდე დისპეტჩერის stack-ზე სრულდებოდა). */
+    UBaseType_t task_priority;  /**< @brief შემსრულებლის პრიორიტეტი; 0 = `CONFIG_SYNAPSE_EVENT_BULK_TASK_PRIORITY`. */
+    uint32_t block_timeout_ms;  /**< @brief რამდენ ხანს დაელოდოს დისპეტჩერი სავსე რიგს; 0 = ახალი ივენთი მაშინვე იკარგება. */
+} synapse_event_mailbox_config_t;
+
+/**
+ * @brief ერთი მოდულის ივენთების დამუშავების სტატისტიკა.
+ */
+typedef struct
+{
+    bool mailbox;            /**< @brief მოდულს აქვს საფოსტო ყუთი. */
+    uint32_t queue_length;   /**< @brief საფოსტო ყუთის ტევადობა (0, თუ ყუთი არ აქვს). */
+    uint32_t pending;        /**< @brief ამ მომენტში ყუთში მყოფი ივენთები. */
+    uint32_t high_watermark; /**< @brief ყუთის შევსების მაქსიმუმი. */
+    uint32_t dropped;        /**< @brief სავსე ყუთის გამო დაკარგული ივენთები. */
+    uint32_t max_wait_us;    /**< @brief უდიდესი დაყოვნება ყუთში (ჩადებიდან handler-მდე). */
+    uint32_t handled;        /**< @brief `handle_event` გამოძახებები. */
+    uint32_t avg_handler_us; /**< @brief handler-ის საშუალო ხანგრძლივობა. */
+    uint32_t max_handler_us; /**< @brief handler-ის უდიდესი ხანგრძლივობა. */
+} synapse_event_module_stats_t;
+
+/**
+ * @brief ივენთის დამუშავების დროებითი (scratch) არენების სტატისტიკა.
+ */
+typedef struct
+{
+    uint32_t arena_size;     /**< @brief ერთი არენის ზომა (`CONFIG_SYNAPSE_EVENT_SCRATCH_SIZE`). */
+    uint32_t arenas;         /**< @brief არენები: თითო დისპეტჩერზე და საფოსტო ყუთზე. */
+    uint32_t high_watermark; /**< @brief ერთი ივენთის დამუშავებისას გამოყენებული ბაიტების მაქსიმუმი. */
+    uint32_t allocations;    /**< @brief წარმატებული scratch გამოყოფები. */
+    uint32_t overflows;      /**< @brief მოთხოვნები, რომლებიც არენაში ვეღარ დაეტია (NULL დაბრუნდა). */
+} synapse_event_scratch_stats_t;
+
+/**
+ * @brief `synapse_event_bus_publish_sync()`-ის სტატისტიკა.
+ */
+typedef struct
+{
+    uint32_t published;       /**< @brief `publish_sync` გამოძახებები. */
+    uint32_t handler_calls;   /**< @brief გამომქვეყნებლის კონტექსტში გამოძახებული handler-ები. */
+    uint32_t forwarded;       /**< @brief ივენთები, რომლებიც asynchronous გამომწერებისთვის ზოლის რიგშიც ჩაიწერა. */
+    uint32_t failed;          /**< @brief გადაგზავნა, რომელიც ზოლმა უარყო. */
+    uint32_t max_dispatch_us; /**< @brief sync handler-ების ყველაზე ხანგრძლივი გამოძახება ერთ გამოქვეყნებაზე. */
+} synapse_event_sync_stats_t;
+
+/**
+ * @brief გამოწერის ფილტრის predicate.
+ * @details გამოიძახება დისპეტჩერის კონტექსტში, wrapper-ის reference-ის
+ *          აღებამდე; false ნიშნავს, რომ მოდული ივენთს არ მიიღებს.
+ * @param[in] event_id ივენთის ID.
+ * @param[in] payload ივენთის payload ან NULL.
+ * @param[in] context `synapse_event_filter_t::context`.
+ * @note უნდა იყოს სწრაფი, ბლოკირების და Event Bus-ის გამოძახებების გარეშე.
+ */
+typedef bool (*synapse_event_filter_fn_t)(synapse_event_id_t event_id, const void *payload, void *context);
+
+/**
+ * @brief payload-ის ველის ტიპი დეკლარაციული ფილტრისთვის.
+ */
+typedef enum
+{
+    SYNAPSE_EVENT_FIELD_NONE = 0, /**< @brief ველის შემოწმება გამორთულია. */
+    SYNAPSE_EVENT_FIELD_U8,       /**< @brief `uint8_t` (ან `bool`/enum-ის 1-ბაიტიანი ველი). */
+    SYNAPSE_EVENT_FIELD_U16,      /**< @brief `uint16_t`. */
+    SYNAPSE_EVENT_FIELD_U32,      /**< @brief `uint32_t` ან enum. */
+    SYNAPSE_EVENT_FIELD_I32,      /**< @brief `int32_t`. */
+    SYNAPSE_EVENT_FIELD_STRING,   /**< @brief payload-ში ჩაშენებული `char[size]` მასივი. */
+} synapse_event_field_type_t;
+
+/**
+ * @brief დეკლარაციული ფილტრის შედარების ოპერაცია.
+ */
+typedef enum
+{
+    SYNAPSE_EVENT_FIELD_EQ = 0, /**< @brief ტოლია. */
+    SYNAPSE_EVENT_FIELD_NE,     /**< @brief არ არის ტოლი. */
+    SYNAPSE_EVENT_FIELD_LT,     /**< @brief ნაკლებია (მხოლოდ რიცხვები). */
+    SYNAPSE_EVENT_FIELD_GT,     /**< @brief მეტია (მხოლოდ რიცხვები). */
+} synapse_event_field_op_t;
+
+/**
+ * @brief payload-ის ერთი ველის შედარება (predicate-ის გარეშე გასაფილტრად).
+ * @details ჩვეულებრივ ივსება `SYNAPSE_EVENT_MATCH_STRING()` / `SYNAPSE_EVENT_MATCH_UINT()` მაკროებით.
+ */
+typedef struct
+{
+    synapse_event_field_type_t type; /**< @brief ველის ტიპი. */
+    synapse_event_field_op_t op;     /**< @brief შედარების ოპერაცია. */
+    uint16_t offset;                 /**< @brief ველის წანაცვლება payload-ში (`offsetof`). */
+    uint16_t size;                   /**< @brief STRING-ისთვის - მასივის ზომა. */
+    union
+    {
+        uint32_t u32;
+        int32_t i32;
+        const char *str; /**< @brief STRING-ის მნიშვნელობა (გამოწერისას კოპირდება). */
+    } value;
+} synapse_event_field_match_t;
+
+/**
+ * @brief გამოწერის ფილტრი: predicate და/ან ველის შედარება (ორივეს მითითებისას - AND).
+ */
+typedef struct
+{
+    synapse_event_filter_fn_t predicate; /**< @brief (Optional) predicate. */
+    void *context;                       /**< @brief predicate-ის კონტექსტი. */
+    synapse_event_field_match_t field;   /**< @brief (Optional) ველის შედარება; payload-ის გარეშე ივენთი არ გადის. */
+} synapse_event_filter_t;
+
+/**
+ * @brief ფილტრიანი გამოწერის სტატისტიკა.
+ */
+typedef struct
+{
+    uint32_t evaluated; /**< @brief ფილტრის შემოწმებები. */
+    uint32_t accepted;  /**< @brief მიწოდებული ივენთები. */
+    uint32_t rejected;  /**< @brief ფილტრით უარყოფილი ივენთები (`handle_event` და acquire/release არ შესრულდა). */
+} synapse_event_filter_stats_t;
+
+/**
+ * @brief ქმნის `char[]` ველის ტოლობის შედარებას.
+ * @code
+ * synapse_event_filter_t filter = {
+ *     .field = SYNAPSE_EVENT_MATCH_STRING(synapse_service_status_payload_t, service_name, "wifi_manager"),
+ * };
+ * @endcode
+ */
+#define SYNAPSE_EVENT_MATCH_STRING(payload_type, member, string)             \
+    ((synapse_event_field_match_t){                                         \
+        .type = SYNAPSE_EVENT_FIELD_STRING,                                 \
+        .op = SYNAPSE_EVENT_FIELD_EQ,                                       \
+        .offset = (uint16_t)offsetof(payload_type, member),                 \
+        .size = (uint16_t)sizeof(((payload_type *)0)->member),              \
+        .value = {.str = (string)},                                         \
+    })
+
+/**
+ * @brief ქმნის უნიშნო რიცხვითი (1/2/4 ბაიტიანი) ველის შედარებას.
+ */
+#define SYNAPSE_EVENT_MATCH_UINT(payload_type, member, compare_op, number)                       \
+    ((synapse_event_field_match_t){                                                             \
+        .type = (sizeof(((payload_type *)0)->member) == 1)   ? SYNAPSE_EVENT_FIELD_U8           \
+                : (sizeof(((payload_type *)0)->member) == 2) ? SYNAPSE_EVENT_FIELD_U16          \
+                                                             : SYNAPSE_EVENT_FIELD_U32,         \
+        .op = (compare_op),                                                                     \
+        .offset = (uint16_t)offsetof(payload_type, member),                                     \
+        .value = {.u32 = (uint32_t)(number)},                                                   \
+    })
+
+/**
+ * @brief conflating ივენთის გასაღების ფუნქცია.
+ * @details იღებს ივენთის payload-ს (ან NULL-ს) და აბრუნებს გასაღებს: ერთი და იმავე
+ *          გასაღების მქონე ივენთებიდან რიგში მხოლოდ უახლესი რჩება
+ *          (მაგ. `synapse_service_status_conflation_key()` - სერვისის სახელის მიხედვით).
+ * @note გამოიძახება გამომქვეყნებლის კონტექსტში; უნდა იყოს სწრაფი და ბლოკირების გარეშე.
+ */
+typedef uint32_t (*synapse_event_conflation_key_fn_t)(const void *payload);
+
+/**
+ * @brief per-core დისპეტჩერის ასარჩევი გასაღების ფუნქცია.
+ * @details იღებს ივენთის payload-ს (ან NULL-ს) და აბრუნებს partition key-ს: ერთი
+ *          და იმავე გასაღების ივენთები ყოველთვის ერთ დისპეტჩერთან მიდის და
+ *          გამოქვეყნების თანმიმდევრობით მუშავდება (მაგ. სენსორის ან რელეს ინდექსი).
+ * @note გამოიძახება გამომქვეყნებლის კონტექსტში; უნდა იყოს სწრაფი და ბლოკირების გარეშე.
+ */
+typedef uint32_t (*synapse_event_partition_key_fn_t)(const void *payload);
+
+/**
+ * @brief `synapse_event_bus_post_batch()`-ის ერთი ელემენტი.
+ */
+typedef struct
+{
+    synapse_event_id_t event_id;              /**< @brief ივენთის interned ID. */
+    struct event_data_wrapper_t *data_wrapper; /**< @brief ივენთის მონაცემები ან NULL. */
+} synapse_event_batch_entry_t;
+
+/**
+ * @brief დაგეგმილი (დაყოვნებული ან პერიოდული) ივენთის handle.
+ * @details შეიცავს სლოტის ინდექსს და თაობას, ამიტომ უკვე შესრულებული ან
+ *          გაუქმებული ტაიმერის handle უსაფრთხოა - `cancel` დააბრუნებს
+ *          ESP_ERR_NOT_FOUND-ს და სხვა ტაიმერს არ შეეხება.
+ */
+typedef uint32_t synapse_event_timer_t;
+
+/** @brief არავალიდური ტაიმერის handle. */
+#define SYNAPSE_EVENT_TIMER_INVALID ((synapse_event_timer_t)0)
+
+/**
+ * @brief დაგეგმილი ივენთების (timing wheel) სტატისტიკა.
+ */
+typedef struct
+{
+    uint32_t capacity;       /**< @brief ტაიმერების მაქსიმალური რაოდენობა (`CONFIG_SYNAPSE_EVENT_TIMER_MAX_TIMERS`). */
+    uint32_t active;         /**< @brief ამჟამად დაგეგმილი ტაიმერები. */
+    uint32_t high_watermark; /**< @brief ერთდროულად დაგეგმილი ტაიმერების მაქსიმუმი. */
+    uint32_t fired;          /**< @brief გამოქვეყნებული ივენთები. */
+    uint32_t post_failures;  /**< @brief გამოქვეყნებები, რომლებიც Event Bus-მა უარყო (მაგ. გადავსება). */
+    uint32_t cancelled;      /**< @brief გაუქმებული ტაიმერები. */
+    uint32_t wakeups;        /**< @brief ტაიმერის ტასკის გაღვიძებები. */
+    uint64_t busy_us;        /**< @brief ტაიმერის ტასკის ჯამური სამუშაო დრო (wheel-ის მართვა და გამოქვეყნება). */
+} synapse_event_timer_stats_t;
+
+/**
+ * @brief მოთხოვნა/პასუხის (request/response) სტატისტიკა.
+ * @details `rtt_*` ველები ითვლება მოთხოვნის გაგზავნიდან `reply`-მდე (ან
+ *          `reply_error`-მდე) - promise-ის callback-ის დაგეგმვის დაყოვნების გარეშე.
+ */
+typedef struct
+{
+    uint32_t capacity;       /**< @brief ერთდროული მოთხოვნების მაქსიმუმი (`CONFIG_SYNAPSE_EVENT_REQUEST_MAX_PENDING`). */
+    uint32_t pending;        /**< @brief პასუხის მოლოდინში მყოფი მოთხოვნები. */
+    uint32_t high_watermark; /**< @brief ერთდროულად მოლოდინში მყოფი მოთხოვნების მაქსიმუმი. */
+    uint32_t sent;           /**< @brief გაგზავნილი მოთხოვნები. */
+    uint32_t replied;        /**< @brief `reply`-ით შესრულებული. */
+    uint32_t failed;         /**< @brief `reply_error`-ით უარყოფილი. */
+    uint32_t timed_out;      /**< @brief ტაიმაუტით უარყოფილი. */
+    uint32_t late_replies;   /**< @brief პასუხები, რომლებმაც მოთხოვნა ვეღარ იპოვეს (ტაიმაუტის შემდეგ ან ორჯერ). */
+    uint32_t rtt_p50_us;     /**< @brief round trip-ის მედიანა. */
+    uint32_t rtt_p99_us;     /**< @brief round trip-ის 99-ე პროცენტილი. */
+    uint32_t rtt_max_us;     /**< @brief round trip-ის მაქსიმუმი. */
+} synapse_event_request_stats_t;
+
 /**
  * @brief Event Bus-ის ინიციალიზაცია და ფონური ტასკის გაშვება.
  *
- * @details ეს ფუნქცია ქმნის ივენთების რიგს (queue) და აამუშავებს ფონურ ტასკს,
- *          რომელიც პასუხისმგებელია რიგში მოხვედრილი ივენთების დამუშავებასა
+ * @details ეს ფუნქცია ქმნის თითოეული პრიორიტეტული ზოლის რიგს (queue) და
+ *          აამუშავებს მის ფონურ დისპეტჩერ-ტასკს, რომელიც პასუხისმგებელია რიგში მოხვედრილი ივენთების დამუშავებასა
  *          და შესაბამისი გამომწერების ინფორმირებაზე.
  *          უნდა გამოიძახოს `system_manager`-მა ინიციალიზაციისას.
  *
@@ -39,16 +399,18 @@ esp_err_t synapse_event_bus_init(void);
  * @brief აქვეყნებს ივენთს Event Bus-ზე ასინქრონულად.
  *
  * @details ეს ფუნქცია ამატებს ივენთს და მის თანდართულ მონაცემებს (თუ არსებობს)
- *          Event Bus-ის რიგში. ფონური ტასკი შემდგომში ამ ივენთს მიაწვდის
+ *          ივენთის ნაგულისხმევი ზოლის (lane) რიგში. ფონური ტასკი შემდგომში ამ ივენთს მიაწვდის
  *          ყველა იმ მოდულს, რომელსაც გამოწერილი აქვს ეს event_name.
+ *          უცნობი სახელი, რომელსაც არც `*`-ის და არც pattern-ის გამომწერი არ იღებს,
+ *          რეესტრში არ ემატება: ივენთი არსად იგზავნება და ბრუნდება ESP_OK.
  *
  * @param[in] event_name ივენთის უნიკალური სახელი (სტრიქონი).
  * @param[in] data_wrapper მაჩვენებელი "შეფუთულ" მონაცემებზე. თუ ივენთს მონაცემები
  *                         არ სჭირდება, ეს პარამეტრი უნდა იყოს NULL.
  *
  * @return esp_err_t ოპერაციის წარმატების კოდი.
- * @retval ESP_OK თუ ივენთი წარმატებით დაემატა რიგში.
- * @retval ESP_ERR_NO_MEM თუ მეხსიერება ვერ გამოიყო ივენთის სახელის კოპირებისთვის.
+ * @retval ESP_OK თუ ივენთი წარმატებით დაემატა რიგში (ან მას მიმღები არ ჰყავს).
+ * @retval ESP_ERR_NO_MEM თუ ივენთის სახელის რეგისტრაცია (interning) ვერ მოხერხდა.
  * @retval ESP_FAIL თუ რიგი სავსეა.
  */
 esp_err_t synapse_event_bus_post(const char *event_name, struct event_data_wrapper_t *data_wrapper);
@@ -59,13 +421,20 @@ esp_err_t synapse_event_bus_post(const char *event_name, struct event_data_wrapp
  * @details როდესაც მითითებული `event_name`-ის მქონე ივენთი გამოქვეყნდება,
  *          Event Bus გამოიძახებს ამ `module`-ის `handle_event` ფუნქციას.
  *
- * @param[in] event_name ივენთის უნიკალური სახელი (სტრიქონი), რომელზეც გამოწერა ხდება.
+ *          `event_name` შეიძლება იყოს იერარქიული pattern (სეგმენტები `.`-ით):
+ *          `+` ემთხვევა ზუსტად ერთ სეგმენტს (`sensor.+.temperature`), ბოლო სეგმენტად
+ *          მდგარი `*` კი - ერთ ან მეტ სეგმენტს (`SYNAPSE_RELAY.*`). `"*"` კვლავ ყველა
+ *          ივენთს ნიშნავს. მოდული, რომელიც ივენთს რამდენიმე გამოწერით ემთხვევა,
+ *          მას ერთხელ იღებს; ერთ ივენთზე მაქსიმუმ `CONFIG_SYNAPSE_EVENT_MAX_PATTERN_MATCHES`
+ *          pattern-ის გამომწერი გამოიძახება.
+ *
+ * @param[in] event_name ივენთის უნიკალური სახელი (სტრიქონი) ან pattern, რომელზეც გამოწერა ხდება.
  * @param[in] module მაჩვენებელი მოდულზე, რომელიც ამ ივენთს გამოიწერს.
  *
  * @return esp_err_t ოპერაციის წარმატების კოდი.
  * @retval ESP_OK თუ გამოწერა წარმატებით შესრულდა (ან მოდული უკვე გამოწერილი იყო).
  * @retval ESP_ERR_NO_MEM თუ მეხსიერება არასაკმარისია ახალი გამომწერის დასამატებლად.
- * @retval ESP_ERR_INVALID_ARG თუ `module` ან `event_name` არასწორია.
+ * @retval ESP_ERR_INVALID_ARG თუ `module` ან `event_name` არასწორია (მაგ. `*` არ არის ბოლო სეგმენტი).
  */
 esp_err_t synapse_event_bus_subscribe(const char *event_name, struct module_t *module);
 
@@ -76,6 +445,16 @@ esp_err_t synapse_event_bus_subscribe(const char *event_name, struct module_t *m
  *          მოიხსნას გამოწერა და თავიდან ავიცილოთ შეცდომები, რომლებიც დაკავშირებულია
  *          განადგურებული მოდულის გამოძახების მცდელობასთან.
  *
+ *          ფუნქცია ბრუნდება მხოლოდ მას შემდეგ, რაც დისპეტჩერები დაასრულებენ ამ
+ *          მოდულის უკვე დაწყებულ მიწოდებებს, ამიტომ დაბრუნების შემდეგ მოდულის
+ *          `handle_event` აღარ გამოიძახება და მისი მეხსიერების გათავისუფლება
+ *          უსაფრთხოა. სხვა მოდულების handler-ებს ფუნქცია არ ელოდება. გამონაკლისი:
+ *          თუ `unsubscribe` იძახება თავად მოდულის `handle_event`-იდან, საკუთარ
+ *          გამოძახებას ვერ დაელოდება და მაშინვე აბრუნებს ESP_OK-ს - სხვა ზოლის
+ *          დისპეტჩერზე უკვე დაწყებული მიწოდება შეიძლება მაინც მოვიდეს.
+ *          ESP_ERR_TIMEOUT-ისას გამოწერა უკვე გაუქმებულია, მაგრამ მოდულის
+ *          გათავისუფლება ჯერ უსაფრთხო არ არის.
+ *
  * @param[in] event_name ივენთის უნიკალური სახელი (სტრიქონი).
  * @param[in] module მაჩვენებელი მოდულზე, რომელიც აუქმებს გამოწერას.
  *
@@ -83,7 +462,685 @@ esp_err_t synapse_event_bus_subscribe(const char *event_name, struct module_t *m
  * @retval ESP_OK თუ გამოწერა წარმატებით გაუქმდა.
  * @retval ESP_ERR_NOT_FOUND თუ მოდული არ იყო გამოწერილი ამ ივენთზე.
  * @retval ESP_ERR_INVALID_ARG თუ პარამეტრები არასწორია.
+ * @retval ESP_ERR_TIMEOUT თუ მოდულის handler-ი `CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS`-ში არ დასრულდა.
  */
 esp_err_t synapse_event_bus_unsubscribe(const char *event_name, struct module_t *module);
 
+// =========================================================================
+//                      Interned Event ID API
+// =========================================================================
+
+/**
+ * @brief Resolves an event name to its interned ID, registering it on first use.
+ *
+ * @details The name is copied once into the Event Bus registry and is never
+ *          freed. Subsequent calls with the same name return the same ID via a
+ *          lock-free hash lookup. Framework events from `framework_events.h`
+ *          are pre-interned, so their `SYNAPSE_EVENT_ID_*` constants can be
+ *          used directly without calling this function.
+ *
+ * @param[in] event_name The unique event name.
+ * @return The interned ID, or SYNAPSE_EVENT_ID_INVALID if the name is invalid
+ *         or the registry is full (`CONFIG_SYNAPSE_EVENT_MAX_NAMES`).
+ */
+synapse_event_id_t synapse_event_bus_intern(const char *event_name);
+
+/**
+ * @brief Looks up the ID of an already interned event name without registering it.
+ * @param[in] event_name The event name.
+ * @return The interned ID, or SYNAPSE_EVENT_ID_INVALID if the name is unknown.
+ */
+synapse_event_id_t synapse_event_bus_find_id(const char *event_name);
+
+/**
+ * @brief Returns the interned name of an event ID.
+ * @details The returned pointer is stable for the lifetime of the firmware and
+ *          is the same pointer passed to `handle_event` for this event.
+ * @param[in] event_id The event ID.
+ * @return The event name, or NULL if the ID is unknown.
+ */
+const char *synapse_event_bus_get_name(synapse_event_id_t event_id);
+
+/**
+ * @brief Posts an event by its interned ID.
+ * @details Same semantics as `synapse_event_bus_post()`, but performs no heap
+ *          allocation and no string handling.
+ * @param[in] event_id The interned event ID.
+ * @param[in] data_wrapper The wrapped event data, or NULL.
+ * @return esp_err_t
+ * @retval ESP_OK If the event was queued.
+ * @retval ESP_ERR_INVALID_ARG If the ID is unknown.
+ * @retval ESP_FAIL If the event's lane is full.
+ */
+esp_err_t synapse_event_bus_post_id(synapse_event_id_t event_id, struct event_data_wrapper_t *data_wrapper);
+
+/**
+ * @brief Posts an event to an explicit priority lane, overriding the event's default lane.
+ * @details Events of the same lane are delivered in FIFO order; there is no
+ *          ordering guarantee between events posted to different lanes.
+ * @param[in] event_name The unique event name.
+ * @param[in] data_wrapper The wrapped event data, or NULL.
+ * @param[in] priority The lane to use.
+ * @return esp_err_t
+ * @retval ESP_OK If the event was queued, or if the name is unknown and no `"*"` or pattern subscriber receives it.
+ * @retval ESP_ERR_INVALID_ARG If the name or priority is invalid.
+ * @retval ESP_ERR_NO_MEM If the name could not be interned.
+ * @retval ESP_FAIL If the lane is full and its overflow policy rejected the event.
+ */
+esp_err_t synapse_event_bus_post_with_priority(const char *event_name,
+                                               struct event_data_wrapper_t *data_wrapper,
+                                               synapse_event_priority_t priority);
+
+/**
+ * @brief ID-based variant of `synapse_event_bus_post_with_priority()`.
+ */
+esp_err_t synapse_event_bus_post_id_with_priority(synapse_event_id_t event_id,
+                                                  struct event_data_wrapper_t *data_wrapper,
+                                                  synapse_event_priority_t priority);
+
+/**
+ * @brief Posts an event whose payload is copied by value into the queue item.
+ *
+ * @details Intended for small payloads such as `synapse_button_payload_t`,
+ *          `synapse_health_pong_payload_t` or `synapse_service_status_payload_t`:
+ *          up to `CONFIG_SYNAPSE_EVENT_INLINE_PAYLOAD_SIZE` bytes are copied into
+ *          the pre-allocated queue slot, so no payload buffer, wrapper or mutex
+ *          is allocated. The caller keeps ownership of `payload` and may reuse
+ *          it as soon as the call returns.
+ *
+ *          Subscribers receive a borrowed wrapper, exactly as for
+ *          `synapse_event_bus_post_from_isr()`: `payload` points to a read-only
+ *          copy that is valid only during `handle_event`.
+ *
+ * @param[in] event_id The interned event ID.
+ * @param[in] payload The payload to copy (may be NULL if `payload_size` is 0).
+ * @param[in] payload_size Payload size in bytes.
+ * @return esp_err_t
+ * @retval ESP_OK If the event was queued (or merged into a pending conflating event).
+ * @retval ESP_ERR_INVALID_ARG If the ID or arguments are invalid.
+ * @retval ESP_ERR_INVALID_SIZE If the payload does not fit the inline area; wrap it instead.
+ * @retval ESP_ERR_INVALID_STATE If the Event Bus is not initialized.
+ * @retval ESP_FAIL If the lane is full and its overflow policy rejected the event.
+ * @note Task context only; from an ISR use `synapse_event_bus_post_from_isr()`.
+ */
+esp_err_t synapse_event_bus_post_inline(synapse_event_id_t event_id, const void *payload, size_t payload_size);
+
+/**
+ * @brief Lane-explicit variant of `synapse_event_bus_post_inline()`.
+ */
+esp_err_t synapse_event_bus_post_inline_with_priority(synapse_event_id_t event_id,
+                                                      const void *payload,
+                                                      size_t payload_size,
+                                                      synapse_event_priority_t priority);
+
+/**
+ * @brief Posts several events in one operation.
+ *
+ * @details Each entry goes to its event's default lane, in array order. The
+ *          entries are enqueued with the scheduler suspended, so a lane
+ *          dispatcher wakes up once per chunk instead of once per event, and it
+ *          then drains up to `CONFIG_SYNAPSE_EVENT_DISPATCH_BATCH_SIZE` events
+ *          under a single subscription lookup. Entries that do not fit into
+ *          their lane fall back to the lane's normal overflow policy (which may
+ *          block). Posting stops at the first rejected entry.
+ *
+ *          As with `synapse_event_bus_post()`, the caller keeps ownership of
+ *          its wrapper references.
+ *
+ * @param[in] entries Array of events to post.
+ * @param[in] count Number of entries.
+ * @param[out] posted_out (Optional) Number of entries that were queued.
+ * @return esp_err_t
+ * @retval ESP_OK If all entries were queued.
+ * @retval ESP_ERR_INVALID_ARG If the array is empty or contains an unknown ID (nothing is posted).
+ * @retval ESP_ERR_INVALID_STATE If the Event Bus is not initialized.
+ * @retval ESP_ERR_INVALID_SIZE If a borrowed payload does not fit the inline area.
+ * @retval ESP_FAIL If a lane rejected an entry; see `posted_out`.
+ */
+esp_err_t synapse_event_bus_post_batch(const synapse_event_batch_entry_t *entries, size_t count, size_t *posted_out);
+
+/**
+ * @brief Posts an event from an interrupt service routine.
+ *
+ * @details The payload is copied by value into the pre-allocated queue slot of
+ *          the event's default lane (at most `CONFIG_SYNAPSE_EVENT_INLINE_PAYLOAD_SIZE`
+ *          bytes), so the call performs no heap allocation, takes no mutex and
+ *          does not log. The lane dispatcher is woken via `xQueueSendFromISR`.
+ *
+ *          Subscribers receive a borrowed wrapper (`SYNAPSE_EVENT_DATA_FLAG_BORROWED`)
+ *          whose `payload` points to the inline copy and is valid only for the
+ *          duration of `handle_event`. Calling `synapse_event_data_release()` on it
+ *          is a harmless no-op, so ordinary handlers need no changes.
+ *
+ *          A full lane always drops the new event, regardless of the lane's
+ *          overflow policy; the drop is counted in the lane statistics.
+ *
+ * @note The function itself is not placed in IRAM; do not call it from ISRs
+ *       registered with `ESP_INTR_FLAG_IRAM` while the flash cache is disabled.
+ *
+ * @param[in] event_id The interned event ID (resolve names before enabling the interrupt).
+ * @param[in] payload The payload to copy, or NULL if `payload_size` is 0.
+ * @param[in] payload_size Payload size in bytes.
+ * @param[out] higher_priority_task_woken Set to pdTRUE if a context switch should be
+ *                                        requested with `portYIELD_FROM_ISR()`.
+ * @return esp_err_t
+ * @retval ESP_OK If the event was queued.
+ * @retval ESP_ERR_INVALID_ARG If the ID is unknown or the payload is too large.
+ * @retval ESP_ERR_INVALID_STATE If the Event Bus is not initialized.
+ * @retval ESP_FAIL If the lane is full.
+ */
+esp_err_t synapse_event_bus_post_from_isr(synapse_event_id_t event_id,
+                                          const void *payload,
+                                          size_t payload_size,
+                                          BaseType_t *higher_priority_task_woken);
+
+/**
+ * @brief Publishes an event and calls its synchronous subscribers in the caller's context.
+ *
+ * @details Subscribers registered with `synapse_event_bus_subscribe_sync()`
+ *          are called directly from this function, before it returns: there
+ *          is no queue, no dispatcher context switch and no name copy, so a
+ *          local reaction (e.g. a relay interlock) runs within microseconds.
+ *          Filters are honoured as usual. If the event also has asynchronous
+ *          subscribers (ordinary, `"*"` or pattern subscriptions), the event is
+ *          then queued on its default lane and the dispatcher delivers it only
+ *          to them; without such subscribers nothing is queued at all.
+ *
+ *          A module's mode follows the subscription through which it receives
+ *          the event: the concrete subscription wins over `"*"`, and `"*"` over
+ *          patterns. Events queued by this function bypass conflation, so a
+ *          synchronous subscriber never receives the same event twice.
+ *
+ *          Handlers run on the caller's stack and priority: they must be
+ *          short, thread-safe and must not block. They receive `data_wrapper` under the usual contract
+ *          (release it when done); the caller keeps its own reference, exactly
+ *          as with `synapse_event_bus_post()`.
+ *
+ * @param[in] event_name The event name.
+ * @param[in] data_wrapper (Optional) Event data.
+ * @return esp_err_t
+ * @retval ESP_OK If the synchronous handlers were called and the event, if needed, was queued.
+ *         An unknown name that no `"*"` or pattern subscriber receives is not interned.
+ * @retval ESP_ERR_INVALID_ARG If the name or ID is invalid.
+ * @retval ESP_ERR_INVALID_STATE If the Event Bus is not initialized or the caller is an ISR.
+ * @retval ESP_ERR_INVALID_SIZE If a borrowed payload must be queued but does not fit the inline area.
+ * @retval ESP_FAIL If the lane rejected the queued copy (synchronous handlers have still run).
+ * @note Task context only.
+ */
+esp_err_t synapse_event_bus_publish_sync(const char *event_name, struct event_data_wrapper_t *data_wrapper);
+
+/**
+ * @brief ID-based variant of `synapse_event_bus_publish_sync()`.
+ */
+esp_err_t synapse_event_bus_publish_sync_id(synapse_event_id_t event_id, struct event_data_wrapper_t *data_wrapper);
+
+/**
+ * @brief `synapse_event_bus_publish_sync()` with an inline payload and no heap use.
+ * @details Synchronous handlers receive a borrowed wrapper that points
+ *          directly to `payload`; if the event is also queued, the payload is
+ *          copied into the queue slot as for `synapse_event_bus_post_inline()`.
+ * @return As `synapse_event_bus_publish_sync()`, or ESP_ERR_INVALID_SIZE if the
+ *         payload exceeds `CONFIG_SYNAPSE_EVENT_INLINE_PAYLOAD_SIZE`.
+ */
+esp_err_t synapse_event_bus_publish_sync_inline(synapse_event_id_t event_id, const void *payload, size_t payload_size);
+
+/**
+ * @brief Reads the `publish_sync` counters (cleared by `synapse_event_bus_reset_lane_stats()`).
+ * @return ESP_OK or ESP_ERR_INVALID_ARG.
+ */
+esp_err_t synapse_event_bus_get_sync_stats(synapse_event_sync_stats_t *stats);
+
+/**
+ * @brief Sets the lane used when the event is posted via `post()` or `post_id()`.
+ * @details All events default to SYNAPSE_EVENT_PRIORITY_NORMAL, except
+ *          SYSTEM_SHUTDOWN_REQUESTED and HEARTBEAT_MISSED, which are critical.
+ * @return ESP_OK, or ESP_ERR_INVALID_ARG if the ID or priority is invalid.
+ */
+esp_err_t synapse_event_bus_set_default_priority(synapse_event_id_t event_id, synapse_event_priority_t priority);
+
+/**
+ * @brief Returns the default lane of an event (NORMAL for unknown IDs).
+ */
+synapse_event_priority_t synapse_event_bus_get_default_priority(synapse_event_id_t event_id);
+
+/**
+ * @brief Enables or disables latest-value (conflating) delivery for an event.
+ * @details While a conflating event is still queued, a new post of the same
+ *          event (and the same key) does not enqueue a second message: it
+ *          replaces the payload of the pending one and releases the old data.
+ *          Subscribers therefore see only the latest state, and a burst of
+ *          state changes costs one queue slot and one dispatch.
+ *
+ *          Suitable for state-change events (e.g. RELAY_STATE_CHANGED,
+ *          SERVICE_STATUS_CHANGED, AGGREGATED_SENSOR_REPORT); never use it for
+ *          events where every occurrence matters (commands, button presses).
+ *          Events are not conflating by default.
+ * @param[in] event_id The event.
+ * @param[in] enable true to enable conflation.
+ * @param[in] key_fn Optional key function. NULL keeps one pending value per
+ *                   event; otherwise one per (event, key) pair.
+ * @note Posts from ISRs are never conflated. When all
+ *       `CONFIG_SYNAPSE_EVENT_CONFLATION_SLOTS` slots are in use, the event is
+ *       queued normally.
+ * @return ESP_OK or ESP_ERR_INVALID_ARG if the ID is invalid.
+ */
+esp_err_t synapse_event_bus_set_conflation(synapse_event_id_t event_id, bool enable,
+                                           synapse_event_conflation_key_fn_t key_fn);
+
+/**
+ * @brief Sets the partition key function of an event for per-core dispatch.
+ * @details With `CONFIG_SYNAPSE_EVENT_PER_CORE_DISPATCH` each lane has one
+ *          dispatcher task per core. By default all posts of one event go to
+ *          the same dispatcher (the key is the event ID), which keeps the
+ *          single-dispatcher ordering per event. A key function spreads one
+ *          busy event over the cores while posts with the same key still stay
+ *          in order (e.g. per sensor or per channel).
+ *
+ *          Keys are dispatched on both cores, but one module's handler still
+ *          runs on one core at a time; a thread-safe subscriber that should
+ *          handle the keys in parallel calls
+ *          `synapse_event_bus_set_module_concurrent()`. Without per-core
+ *          dispatch the call is accepted and has no effect.
+ * @param[in] event_id The event.
+ * @param[in] key_fn The key function, or NULL to partition by event ID again.
+ * @note ISR posts always use the event ID. Changing the key while the event is
+ *       queued may reorder the already queued posts against the new ones.
+ * @return ESP_OK or ESP_ERR_INVALID_ARG if the ID is invalid.
+ */
+esp_err_t synapse_event_bus_set_partition_key(synapse_event_id_t event_id, synapse_event_partition_key_fn_t key_fn);
+
+/**
+ * @brief Pins the dispatch of an event to one core.
+ * @details Overrides the partition key: every post of the event is handled
+ *          by the lane dispatcher running on `core`, e.g. to keep handlers
+ *          that touch a core-bound driver or cache next to it. Without
+ *          per-core dispatch the call is accepted and has no effect.
+ * @param[in] event_id The event.
+ * @param[in] core The core (`0 .. portNUM_PROCESSORS - 1`), or SYNAPSE_EVENT_DISPATCH_CORE_ANY.
+ * @return ESP_OK or ESP_ERR_INVALID_ARG.
+ */
+esp_err_t synapse_event_bus_set_dispatch_core(synapse_event_id_t event_id, int core);
+
+/**
+ * @brief Lets the per-core dispatchers run a module's handler in parallel.
+ * @details With `CONFIG_SYNAPSE_EVENT_PER_CORE_DISPATCH` a dispatcher holds
+ *          a per-module mutex while it calls `handle_event`, so one module is
+ *          never handled on both cores at once, whichever lane, key or core
+ *          its events were routed to. A module whose handler is thread-safe
+ *          can opt out, e.g. to handle the keys of a partitioned event in
+ *          parallel. Mailbox and `publish_sync` handling never take the mutex.
+ *          Without per-core dispatch the call is accepted and has no effect.
+ * @param[in] module The module.
+ * @param[in] concurrent true = no mutex; false = serialized again (the default).
+ * @return ESP_OK or ESP_ERR_INVALID_ARG.
+ */
+esp_err_t synapse_event_bus_set_module_concurrent(struct module_t *module, bool concurrent);
+
+/**
+ * @brief Returns how many posts of an event were merged into a pending one
+ *        (i.e. queue slots and dispatches saved by conflation).
+ */
+uint32_t synapse_event_bus_get_conflated_count(synapse_event_id_t event_id);
+
+/**
+ * @brief Sets the overflow policy of one event, overriding its lane's policy.
+ * @details Lets a producer choose how much a full lane may cost it: critical
+ *          commands can block, telemetry can drop or spill. The policy is
+ *          applied in task context only; ISR posts always drop the new event.
+ *
+ *          SYNAPSE_EVENT_OVERFLOW_SPILL moves the event into the lane's
+ *          secondary buffer, which the dispatcher drains in FIFO order as soon
+ *          as the queue has room. While the buffer is not empty, later SPILL
+ *          posts and `post_batch()` items of that lane queue up behind it, so
+ *          they stay in posting order. Posts with another policy and ISR posts
+ *          do not wait for the buffer and may overtake spilled events.
+ * @param[in] event_id The event.
+ * @param[in] policy The policy, or SYNAPSE_EVENT_OVERFLOW_LANE_DEFAULT to use the lane's policy again.
+ * @param[in] block_timeout_ms Maximum wait for SYNAPSE_EVENT_OVERFLOW_BLOCK; 0 uses
+ *                             `CONFIG_SYNAPSE_TASK_QUEUE_TIMEOUT_MS`. Ignored by other policies.
+ * @return ESP_OK or ESP_ERR_INVALID_ARG.
+ */
+esp_err_t synapse_event_bus_set_overflow_policy(synapse_event_id_t event_id,
+                                                synapse_event_overflow_policy_t policy,
+                                                uint32_t block_timeout_ms);
+
+/**
+ * @brief Reads the per-event counters (posts, drops, spills, queue high-watermark).
+ * @return ESP_OK, or ESP_ERR_INVALID_ARG if the ID is unknown or `stats` is NULL.
+ */
+esp_err_t synapse_event_bus_get_event_stats(synapse_event_id_t event_id, synapse_event_stats_t *stats);
+
+/**
+ * @brief Resets the per-event counters of all events.
+ */
+void synapse_event_bus_reset_event_stats(void);
+
+/**
+ * @brief Reads the post-to-handler latency percentiles of one lane.
+ * @details Samples are collected since init or the last
+ *          synapse_event_bus_reset_lane_stats().
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, or ESP_ERR_NOT_SUPPORTED if
+ *         `CONFIG_SYNAPSE_EVENT_LATENCY_HISTOGRAM` is disabled.
+ */
+esp_err_t synapse_event_bus_get_latency_stats(synapse_event_priority_t priority, synapse_event_latency_stats_t *stats);
+
+/**
+ * @brief Builds a machine-readable JSON report of the Event Bus statistics.
+ * @details The report covers the window since init or the last
+ *          synapse_event_bus_reset_lane_stats(): per-lane counters,
+ *          throughput (`events_per_sec`), latency percentiles and wrapper heap
+ *          traffic (`heap_allocs_per_event`). Intended for benchmark runs that
+ *          are compared between releases; see
+ *          docs/performance/performance_benchmarks.md.
+ * @param[out] json_out Receives a heap-allocated, NUL-terminated string; free it with `free()`.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, ESP_ERR_INVALID_STATE or ESP_ERR_NO_MEM.
+ */
+esp_err_t synapse_event_bus_get_stats_json(char **json_out);
+
+/**
+ * @brief Reads the statistics of one priority lane.
+ * @details `max_latency_us` is the worst observed time between a successful
+ *          post and the start of its dispatch, i.e. the queueing delay a
+ *          critical event sees under a saturating bulk load.
+ * @param[in] priority The lane.
+ * @param[out] stats Destination structure.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, or ESP_ERR_INVALID_STATE if the bus is not initialized.
+ */
+esp_err_t synapse_event_bus_get_lane_stats(synapse_event_priority_t priority, synapse_event_lane_stats_t *stats);
+
+/**
+ * @brief Reads the statistics of one dispatcher of a lane.
+ * @details With `CONFIG_SYNAPSE_EVENT_PER_CORE_DISPATCH` every lane has one
+ *          dispatcher per core (index = core); otherwise only index 0 exists.
+ *          Comparing `dispatched` across the dispatchers of a lane shows how
+ *          evenly the partition keys spread the load.
+ * @param[in] priority The lane.
+ * @param[in] index Dispatcher index, `0 .. synapse_event_bus_get_dispatcher_count() - 1`.
+ * @param[out] stats Destination structure.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, or ESP_ERR_INVALID_STATE if the bus is not initialized.
+ */
+esp_err_t synapse_event_bus_get_dispatcher_stats(synapse_event_priority_t priority, uint8_t index,
+                                                 synapse_event_dispatcher_stats_t *stats);
+
+/**
+ * @brief Returns the number of dispatchers per lane (1, or the core count in per-core mode).
+ */
+uint8_t synapse_event_bus_get_dispatcher_count(void);
+
+/**
+ * @brief Reads the number of pattern subscriptions and the size of their compiled trie.
+ * @return ESP_OK or ESP_ERR_INVALID_ARG.
+ */
+esp_err_t synapse_event_bus_get_pattern_stats(synapse_event_pattern_stats_t *stats);
+
+/**
+ * @brief Reports the RAM used by subscriptions.
+ * @details Subscriber lists are sized to the actual subscriber count, so the
+ *          heap part grows with real subscriptions and not with
+ *          `CONFIG_SYNAPSE_MAX_SUBSCRIBERS_PER_EVENT`. Takes the subscription
+ *          writer mutex; not for the hot path.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, ESP_ERR_INVALID_STATE if the Event Bus is not initialized, or ESP_ERR_TIMEOUT.
+ */
+esp_err_t synapse_event_bus_get_memory_stats(synapse_event_memory_stats_t *stats);
+
+/**
+ * @brief Resets the counters and latency maxima of all lanes.
+ * @details Also clears the handler and mailbox counters of every registered module.
+ */
+void synapse_event_bus_reset_lane_stats(void);
+
+/**
+ * @brief Moves the event handling of a module to its own mailbox and executor task.
+ * @details Normally `handle_event` runs on the lane dispatcher, so a handler
+ *          that does I2C or NVS work delays every other module. With a
+ *          mailbox the dispatcher only copies the event into the module's
+ *          bounded queue (taking a data reference, or copying an inline
+ *          payload) and moves on; the module's executor task calls
+ *          `handle_event` in arrival order.
+ *
+ *          - Synchronous subscriptions (`publish_sync`) still run in the
+ *            publisher's context.
+ *          - When the mailbox is full the dispatcher waits at most
+ *            `block_timeout_ms`, then drops the event (see `dropped`).
+ *          - Events still queued when the module unsubscribes are dropped
+ *            without a handler call; `unsubscribe()` waits for a handler the
+ *            executor has already started. `synapse_event_bus_disable_mailbox()`
+ *            drains the mailbox before it returns.
+ * @param[in] module The module.
+ * @param[in] config Mailbox parameters, or NULL for the defaults.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, ESP_ERR_INVALID_STATE if the module already has a mailbox, or ESP_ERR_NO_MEM.
+ */
+esp_err_t synapse_event_bus_enable_mailbox(struct module_t *module, const synapse_event_mailbox_config_t *config);
+
+/**
+ * @brief Returns a module to dispatcher-context handling and releases its mailbox.
+ * @details Waits until no dispatcher uses the mailbox, lets the executor
+ *          handle the events still queued, then stops it. A slow handler is
+ *          waited for, never killed. The System Manager
+ *          calls this for every module before deinitialization.
+ * @note Must not be called from the module's own handler.
+ * @return ESP_OK (also when the module has no mailbox), ESP_ERR_INVALID_ARG,
+ *         ESP_ERR_INVALID_STATE if called from a handler, or ESP_ERR_TIMEOUT.
+ */
+esp_err_t synapse_event_bus_disable_mailbox(struct module_t *module);
+
+/**
+ * @brief Reads the handler and mailbox statistics of one module.
+ * @details Handler times are measured for every module (`CONFIG_SYNAPSE_EVENT_MODULE_STATS`),
+ *          so slow handlers can be found before a mailbox is enabled. The same
+ *          data is in the `modules` array of `synapse_event_bus_get_stats_json()`.
+ * @return ESP_OK or ESP_ERR_INVALID_ARG.
+ */
+esp_err_t synapse_event_bus_get_module_stats(const struct module_t *module, synapse_event_module_stats_t *stats);
+
+/**
+ * @brief Allocates temporary memory that lives until the current `handle_event` returns.
+ * @details Every lane dispatcher and mailbox executor owns a bump arena of
+ *          `CONFIG_SYNAPSE_EVENT_SCRATCH_SIZE` bytes that it resets after each
+ *          event. An allocation is a pointer increment; the memory is never
+ *          freed individually, so use it for buffers that do not outlive the
+ *          handler (formatted strings, topic names, parse buffers). The result
+ *          is 8-byte aligned.
+ * @note Returns NULL outside an Event Bus handler task (e.g. for a
+ *       `publish_sync()` handler running in the publisher's task), when the
+ *       arena is full, or when arenas are disabled; fall back to `malloc()`.
+ * @param[in] size Bytes needed.
+ * @return Scratch memory or NULL.
+ */
+void *synapse_event_scratch_alloc(size_t size);
+
+/**
+ * @brief Formats a string into the scratch arena.
+ * @details Same lifetime and NULL cases as synapse_event_scratch_alloc(); the
+ *          arena keeps only the bytes actually written.
+ * @return The NUL-terminated string or NULL.
+ */
+char *synapse_event_scratch_printf(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief Reads the scratch arena statistics.
+ * @details Size the arena from `high_watermark` under real load; a growing
+ *          `overflows` means handlers fell back to the heap. Cleared by
+ *          synapse_event_bus_reset_lane_stats().
+ * @return ESP_OK or ESP_ERR_INVALID_ARG.
+ */
+esp_err_t synapse_event_bus_get_scratch_stats(synapse_event_scratch_stats_t *stats);
+
+/**
+ * @brief Subscribes a module to an event by its interned ID.
+ * @see synapse_event_bus_subscribe()
+ */
+esp_err_t synapse_event_bus_subscribe_id(synapse_event_id_t event_id, struct module_t *module);
+
+/**
+ * @brief Unsubscribes a module from an event by its interned ID.
+ * @see synapse_event_bus_unsubscribe()
+ */
+esp_err_t synapse_event_bus_unsubscribe_id(synapse_event_id_t event_id, struct module_t *module);
+
+/**
+ * @brief Subscribes a module with a filter that is evaluated before delivery.
+ * @details The dispatcher evaluates the filter before it takes a wrapper
+ *          reference and calls `handle_event`, so rejected events cost one
+ *          predicate call (or field comparison) instead of an
+ *          acquire/handler/release round-trip. Works for concrete events and
+ *          for `"*"` (predicate only - a field match describes one payload
+ *          layout); pattern subscriptions cannot be filtered. The filter
+ *          (including a STRING value) is copied. Unsubscribe with
+ *          `synapse_event_bus_unsubscribe()`; to change the filter,
+ *          unsubscribe and subscribe again.
+ * @param[in] event_name Event name or `"*"`.
+ * @param[in] module The subscriber.
+ * @param[in] filter The filter (must have a predicate or a field match).
+ * @return ESP_OK (also if the module is already subscribed to the event; the
+ *         existing subscription and its filter are kept), ESP_ERR_INVALID_ARG,
+ *         ESP_ERR_NOT_SUPPORTED for patterns, ESP_ERR_NO_MEM or ESP_ERR_TIMEOUT.
+ */
+esp_err_t synapse_event_bus_subscribe_filtered(const char *event_name, struct module_t *module,
+                                               const synapse_event_filter_t *filter);
+
+/**
+ * @brief ID-based variant of `synapse_event_bus_subscribe_filtered()`.
+ */
+esp_err_t synapse_event_bus_subscribe_id_filtered(synapse_event_id_t event_id, struct module_t *module,
+                                                  const synapse_event_filter_t *filter);
+
+/**
+ * @brief Reads the counters of a filtered subscription.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, or ESP_ERR_NOT_FOUND if the module has no filtered subscription to the event.
+ */
+esp_err_t synapse_event_bus_get_filter_stats(synapse_event_id_t event_id, struct module_t *module,
+                                             synapse_event_filter_stats_t *stats);
+
+/**
+ * @brief Subscribes a module that also accepts in-context delivery.
+ * @details The module receives `synapse_event_bus_publish_sync()` events
+ *          directly in the publisher's context; ordinary `post()` events still
+ *          reach it through the lane dispatcher. Its `handle_event` must
+ *          therefore be cheap, non-blocking and thread-safe. Works for concrete
+ *          events and `"*"`; pattern subscriptions cannot be synchronous.
+ *          Unsubscribe with `synapse_event_bus_unsubscribe()`.
+ * @return ESP_OK (also if the module is already subscribed to the event in
+ *         either mode; the existing subscription is kept), ESP_ERR_INVALID_ARG,
+ *         ESP_ERR_NOT_SUPPORTED for patterns, ESP_ERR_NO_MEM or ESP_ERR_TIMEOUT.
+ */
+esp_err_t synapse_event_bus_subscribe_sync(const char *event_name, struct module_t *module);
+
+/**
+ * @brief ID-based variant of `synapse_event_bus_subscribe_sync()`.
+ */
+esp_err_t synapse_event_bus_subscribe_id_sync(synapse_event_id_t event_id, struct module_t *module);
+
+/**
+ * @brief აქვეყნებს ივენთს `delay_ms` მილიწამის შემდეგ.
+ * @details ტაიმერები ინახება ერთ იერარქიულ timing wheel-ში (4 დონე x 64 სლოტი),
+ *          ამიტომ დამატება და გაუქმება O(1)-ია და ათასობით დაგეგმილი ივენთი
+ *          ერთ ტასკს იყენებს. სიზუსტე არის `CONFIG_SYNAPSE_EVENT_TIMER_RESOLUTION_MS`;
+ *          დაყოვნება მრგვალდება ზემოთ. `data_wrapper`-ზე ტაიმერი იღებს საკუთარ
+ *          reference-ს, ამიტომ გამომძახებელი თავისას ჩვეულებრივ ათავისუფლებს.
+ * @param[in] event_name ივენთის სახელი.
+ * @param[in] data_wrapper (Optional) ივენთის მონაცემები.
+ * @param[in] delay_ms დაყოვნება; 0 = შემდეგ ტიკზე.
+ * @param[out] timer_out (Optional) handle გასაუქმებლად.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, ESP_ERR_NO_MEM (ყველა ტაიმერი დაკავებულია),
+ *         ESP_ERR_INVALID_STATE (Event Bus არ არის ინიციალიზებული) ან
+ *         ESP_ERR_NOT_SUPPORTED (`CONFIG_SYNAPSE_EVENT_TIMER_ENABLE=n`).
+ */
+esp_err_t synapse_event_bus_post_delayed(const char *event_name, struct event_data_wrapper_t *data_wrapper,
+                                         uint32_t delay_ms, synapse_event_timer_t *timer_out);
+
+/**
+ * @brief ID-ზე დაფუძნებული `synapse_event_bus_post_delayed()`.
+ */
+esp_err_t synapse_event_bus_post_delayed_id(synapse_event_id_t event_id, struct event_data_wrapper_t *data_wrapper,
+                                            uint32_t delay_ms, synapse_event_timer_t *timer_out);
+
+/**
+ * @brief აქვეყნებს ივენთს ყოველ `period_ms` მილიწამში, გაუქმებამდე.
+ * @details პერიოდი ითვლება დაგეგმილი დროიდან და არა გამოქვეყნების მომენტიდან,
+ *          ამიტომ ტემპი არ "მიცურავს". თუ ტაიმერის ტასკი ჩამორჩა, გამოტოვებული
+ *          პერიოდები არ ქვეყნდება ზედიზედ. `data_wrapper` (თუ არის) ყოველ
+ *          ჯერზე ერთი და იგივე ქვეყნდება.
+ * @param[in] period_ms პერიოდი (> 0).
+ * @see synapse_event_bus_post_delayed()
+ */
+esp_err_t synapse_event_bus_post_periodic(const char *event_name, struct event_data_wrapper_t *data_wrapper,
+                                          uint32_t period_ms, synapse_event_timer_t *timer_out);
+
+/**
+ * @brief ID-ზე დაფუძნებული `synapse_event_bus_post_periodic()`.
+ */
+esp_err_t synapse_event_bus_post_periodic_id(synapse_event_id_t event_id, struct event_data_wrapper_t *data_wrapper,
+                                             uint32_t period_ms, synapse_event_timer_t *timer_out);
+
+/**
+ * @brief აუქმებს დაგეგმილ ივენთს.
+ * @details გაუქმების შემდეგ ივენთი აღარ გამოქვეყნდება; გამოქვეყნება, რომელიც
+ *          უკვე მიმდინარეობდა, შეიძლება მაინც დასრულდეს. ISR-იდან არ გამოიძახება.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, ESP_ERR_NOT_FOUND (უკვე შესრულდა ან გაუქმდა)
+ *         ან ESP_ERR_NOT_SUPPORTED.
+ */
+esp_err_t synapse_event_bus_cancel_timer(synapse_event_timer_t timer);
+
+/**
+ * @brief აბრუნებს დაგეგმილი ივენთების სტატისტიკას.
+ * @details `busy_us`-ის ცვლილება დროის ინტერვალზე გაყოფილი არის ტაიმერის
+ *          ტასკის CPU დატვირთვა.
+ */
+esp_err_t synapse_event_bus_get_timer_stats(synapse_event_timer_stats_t *stats);
+
+/**
+ * @brief აგზავნის მოთხოვნას ივენთით და აბრუნებს promise-ს პასუხისთვის.
+ * @details ივენთი ქვეყნდება ჩვეულებრივ, მაგრამ მის wrapper-ს აქვს უნიკალური
+ *          `correlation_id`. მომსახურე მოდული `handle_event`-ში (ან მოგვიანებით)
+ *          იძახებს `synapse_event_bus_reply(wrapper->correlation_id, ...)`-ს;
+ *          შედეგი მიდის `then_cb`-ში. თუ `timeout_ms`-ში პასუხი არ მოვიდა,
+ *          promise უარიყოფა და `catch_cb` იღებს მაჩვენებელს `esp_err_t`
+ *          მნიშვნელობაზე `ESP_ERR_TIMEOUT`. callback-ები სრულდება Promise
+ *          Manager-ის ტასკში. მოლოდინში მყოფი მოთხოვნები ინახება ფიქსირებულ
+ *          ცხრილში, ამიტომ პასუხის პოვნა O(1)-ია.
+ * @param[in] event_name მოთხოვნის ივენთი.
+ * @param[in] data_wrapper (Optional) მოთხოვნის მონაცემები; wrapper არ უნდა
+ *            იყოს უკვე გამოყენებული სხვა მოთხოვნაში. NULL-ისას იქმნება ცარიელი
+ *            wrapper, რომელიც მხოლოდ `correlation_id`-ს ატარებს.
+ * @param[in] timeout_ms ტაიმაუტი; 0 = `CONFIG_SYNAPSE_EVENT_REQUEST_DEFAULT_TIMEOUT_MS`.
+ * @param[in] then_cb (Optional) პასუხის callback (`result_data` = `reply`-ის მონაცემები).
+ * @param[in] catch_cb (Optional) შეცდომის/ტაიმაუტის callback.
+ * @param[in] user_context callback-ების კონტექსტი.
+ * @param[out] promise_out (Optional) მოთხოვნის promise.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, ESP_ERR_INVALID_STATE (wrapper უკვე მოთხოვნაა),
+ *         ESP_ERR_NO_MEM (ცხრილი ან ტაიმერები სავსეა), გამოქვეყნების შეცდომა ან
+ *         ESP_ERR_NOT_SUPPORTED (`CONFIG_SYNAPSE_EVENT_TIMER_ENABLE=n`). შეცდომისას
+ *         callback-ები არ გამოიძახება.
+ */
+esp_err_t synapse_event_bus_request(const char *event_name, struct event_data_wrapper_t *data_wrapper,
+                                    uint32_t timeout_ms, promise_then_cb then_cb, promise_catch_cb catch_cb,
+                                    void *user_context, promise_handle_t *promise_out);
+
+/**
+ * @brief პასუხობს მოთხოვნას და ასრულებს (resolve) მის promise-ს.
+ * @param[in] correlation_id მოთხოვნის wrapper-ის `correlation_id`.
+ * @param[in] result_data (Optional) შედეგი (`then_cb`-ის `result_data`).
+ * @param[in] free_fn (Optional) `result_data`-ს ათავისუფლებს callback-ის შემდეგ.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG ან ESP_ERR_NOT_FOUND (მოთხოვნა უკვე
+ *         შესრულდა ან ვადა გაუვიდა; `result_data` თავისუფლდება).
+ */
+esp_err_t synapse_event_bus_reply(uint32_t correlation_id, void *result_data, void (*free_fn)(void *));
+
+/**
+ * @brief პასუხობს მოთხოვნას შეცდომით და უარყოფს (reject) მის promise-ს.
+ * @see synapse_event_bus_reply()
+ */
+esp_err_t synapse_event_bus_reply_error(uint32_t correlation_id, void *error_data, void (*free_fn)(void *));
+
+/**
+ * @brief აბრუნებს მოთხოვნა/პასუხის სტატისტიკას.
+ */
+esp_err_t synapse_event_bus_get_request_stats(synapse_event_request_stats_t *stats);
+
+/**
+ * @brief ანულებს მოთხოვნა/პასუხის მრიცხველებს და round trip-ის ჰისტოგრამას.
+ */
+void synapse_event_bus_reset_request_stats(void);
+
 #endif // SYNAPSE_EVENT_BUS_H
\ No newline at end of file
@@ -0,0 +1,210 @@
+/**
+ * @file event_bus_internal.h
+ * @brief Internal Core API shared by the Event Bus translation units.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-09-24
+ * @details Defines the queue message format and the helpers that operate on
+ *          queued messages outside of `event_bus.c` (e.g. conflation). Not for
+ *          use by modules.
+ */
+
+#ifndef SYNAPSE_EVENT_BUS_INTERNAL_H
+#define SYNAPSE_EVENT_BUS_INTERNAL_H
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+#include "framework_events.h"
+#include "freertos/FreeRTOS.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  struct event_data_wrapper_t;
+  struct module_t;
+
+#define EVENT_INLINE_PAYLOAD_SIZE CONFIG_SYNAPSE_EVENT_INLINE_PAYLOAD_SIZE
+
+  /** @brief The message is a conflation token; its payload lives in a conflation slot. */
+#define EVENT_MESSAGE_FLAG_CONFLATED (1U << 0)
+  /** @brief Synchronous subscribers already received the event in `synapse_event_bus_publish_sync()`. */
+#define EVENT_MESSAGE_FLAG_SYNC_DELIVERED (1U << 1)
+
+  /**
+   * @brief One event as stored in a lane queue.
+   * @details The event is stored by interned ID, so posting copies no names.
+   */
+  typedef struct
+  {
+    synapse_event_id_t event_id;               /**< @brief Interned event ID. */
+    uint8_t inline_size;                       /**< @brief Inline payload size; 0 means the data is in `data_wrapper` (or absent). */
+    uint8_t flags;                             /**< @brief `EVENT_MESSAGE_FLAG_*`. */
+    uint8_t dispatcher;                        /**< @brief Index of the lane dispatcher that owns the message (per-core dispatch). */
+    uint16_t conflation_slot;                  /**< @brief Conflation slot index (valid with EVENT_MESSAGE_FLAG_CONFLATED). */
+    struct event_data_wrapper_t *data_wrapper; /**< @brief Wrapped event data, or NULL. */
+    uint32_t posted_at_us;                     /**< @brief Post time (esp_timer), used for latency statistics. */
+    union
+    {
+      uint8_t bytes[EVENT_INLINE_PAYLOAD_SIZE];
+      uint32_t align_u32;
+      void *align_ptr;
+      double align_double;
+    } inline_data; /**< @brief Inline payload, copied into the pre-allocated queue slot without heap use. */
+  } event_message_t;
+
+  _Static_assert(EVENT_INLINE_PAYLOAD_SIZE <= UINT8_MAX, "CONFIG_SYNAPSE_EVENT_INLINE_PAYLOAD_SIZE must fit into uint8_t");
+
+  /**
+   * @brief Outcome of `synapse_event_conflation_offer()`.
+   */
+  typedef enum
+  {
+    EVENT_CONFLATION_BYPASS = 0, /**< @brief Not conflated (no free slot); enqueue the message as is. */
+    EVENT_CONFLATION_MERGED,     /**< @brief Replaced the payload of a pending message; do not enqueue. */
+    EVENT_CONFLATION_RESERVED,   /**< @brief Payload moved into a new slot; enqueue the message, now a token. */
+  } event_conflation_result_t;
+
+  /**
+   * @brief Initializes the conflation slot table.
+   */
+  esp_err_t synapse_event_conflation_init(void);
+
+  /**
+   * @brief Offers a message of a conflating event to the slot table.
+   * @details If a message with the same event ID and key is still queued, its
+   *          payload is replaced by the payload of `msg` and the previous
+   *          wrapper reference is returned through `replaced_out` for the
+   *          caller to release. Otherwise the payload moves into a free slot
+   *          and `msg` is turned into a token that refers to it.
+   * @note Task context only.
+   */
+  event_conflation_result_t synapse_event_conflation_offer(event_message_t *msg, uint32_t key,
+                                                           struct event_data_wrapper_t **replaced_out);
+
+  /**
+   * @brief Turns a token back into a regular message and frees its slot.
+   * @details Called by the dispatcher when it dequeues a token, and by the
+   *          post path / overflow handling when a token is discarded. Has no
+   *          effect on messages without EVENT_MESSAGE_FLAG_CONFLATED.
+   */
+  void synapse_event_conflation_claim(event_message_t *msg);
+
+  /** @brief Linear buckets below the first octave (0..3 us). */
+#define EVENT_LATENCY_SUB_BUCKETS 4
+  /** @brief Highest tracked bit of a latency value; slower samples (>= 2^26 us, ~67 s) land in the last bucket. */
+#define EVENT_LATENCY_MAX_BIT 25
+  /** @brief Number of histogram buckets: four per octave, relative error below 25 %. */
+#define EVENT_LATENCY_BUCKETS (EVENT_LATENCY_SUB_BUCKETS * EVENT_LATENCY_MAX_BIT)
+
+  /**
+   * @brief Log-linear post-to-handler latency histogram of one lane.
+   * @details Written by the lane's dispatcher(s) with relaxed atomic
+   *          increments (per-core dispatch has one writer per core). Readers
+   *          may observe a sample in flight, which is acceptable for statistics.
+   */
+  typedef struct
+  {
+    uint32_t buckets[EVENT_LATENCY_BUCKETS]; /**< @brief Sample counts per bucket. */
+    uint32_t samples;                        /**< @brief Total number of samples. */
+  } event_latency_histogram_t;
+
+  /**
+   * @brief Adds one latency sample (microseconds).
+   */
+  void synapse_event_latency_record(event_latency_histogram_t *histogram, uint32_t latency_us);
+
+  /**
+   * @brief Returns the upper bound of the bucket that holds the given percentile.
+   * @param[in] per_mille The percentile in 1/1000 (500 = p50, 999 = p99.9).
+   * @return Latency in microseconds, or 0 if there are no samples.
+   */
+  uint32_t synapse_event_latency_percentile(const event_latency_histogram_t *histogram, uint32_t per_mille);
+
+  /**
+   * @brief Clears all samples.
+   */
+  void synapse_event_latency_reset(event_latency_histogram_t *histogram);
+
+  /**
+   * @brief Allocates the timing wheel, starts its task and registers the `timer_api_t` service.
+   * @details Called by `synapse_event_bus_init()`. Does nothing when
+   *          `CONFIG_SYNAPSE_EVENT_TIMER_ENABLE` is off.
+   */
+  esp_err_t synapse_event_timer_init(void);
+
+  /**
+   * @brief Callback of an internal (core) timer; runs in the timer task.
+   */
+  typedef void (*event_timer_callback_t)(uint32_t arg);
+
+  /**
+   * @brief Schedules a one-shot callback on the timing wheel instead of an event post.
+   * @details Used by core services that need timeouts (e.g. request/response).
+   *          Cancel it with `synapse_event_bus_cancel_timer()`. The callback must
+   *          not block; it shares the task with all scheduled events.
+   * @return As `synapse_event_bus_post_delayed_id()`.
+   */
+  esp_err_t synapse_event_timer_schedule_callback(uint32_t delay_ms, event_timer_callback_t callback, uint32_t arg,
+                                                  uint32_t *timer_out);
+
+  /**
+   * @brief Allocates the pending request table of `synapse_event_bus_request()`.
+   * @details Called by `synapse_event_bus_init()` after the timing wheel.
+   */
+  esp_err_t synapse_event_request_init(void);
+
+  /**
+   * @brief Returns true if `module` still receives `event_id` through any subscription.
+   * @details Checks the concrete, static, `"*"` and pattern subscriptions the way
+   *          the dispatcher does, ignoring filters and the sync mode. Used by
+   *          mailbox executors to drop events queued before an unsubscribe.
+   */
+  bool synapse_event_bus_is_routed(const struct module_t *module, synapse_event_id_t event_id);
+
+#if defined(CONFIG_SYNAPSE_EVENT_CAPTURE_ENABLE)
+  /**
+   * @brief Copies a posted message into the capture queue if a capture is running.
+   * @details Never waits; a full capture queue counts the event as lost.
+   * @param[in] priority Lane the message is posted to.
+   */
+  void synapse_event_capture_record(const event_message_t *msg, uint8_t priority);
+
+  /**
+   * @brief ISR variant of `synapse_event_capture_record()`.
+   * @details Fills a preallocated entry under a spinlock instead of building
+   *          one on the interrupt stack, and does not call the payload encoder.
+   * @param[out] higher_priority_task_woken Passed to `xQueueSendFromISR()`; may be NULL.
+   */
+  void synapse_event_capture_record_from_isr(const event_message_t *msg, uint8_t priority,
+                                             BaseType_t *higher_priority_task_woken);
+
+  /**
+   * @brief Returns true while a capture is running.
+   * @details Posts by name then intern unknown names, so the capture sees them.
+   */
+  bool synapse_event_capture_is_active(void);
+
+#define EVENT_CAPTURE(msg, priority) synapse_event_capture_record((msg), (uint8_t)(priority))
+#define EVENT_CAPTURE_FROM_ISR(msg, priority, woken) \
+  synapse_event_capture_record_from_isr((msg), (uint8_t)(priority), (woken))
+#define EVENT_CAPTURE_ACTIVE() synapse_event_capture_is_active()
+#else
+#define EVENT_CAPTURE(msg, priority) \
+  do                                 \
+  {                                  \
+  } while (0)
+#define EVENT_CAPTURE_FROM_ISR(msg, priority, woken) \
+  do                                                 \
+  {                                                  \
+  } while (0)
+#define EVENT_CAPTURE_ACTIVE() (false)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SYNAPSE_EVENT_BUS_INTERNAL_H
@@ -0,0 +1,176 @@
+/**
+ * @file event_capture.h
+ * @brief Event Bus-ის ნაკადის ჩაწერა (capture) და დეტერმინისტული გადათამაშება (replay).
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-09-28
+ * @details Capture რეჟიმში Event Bus ყოველ გამოქვეყნებულ ივენთს (სახელი,
+ *          დროის ნიშნული, ზოლი და payload-ის ბაიტები) წერს sink-ში - ფაილში
+ *          (SPIFFS/FATFS/linux ჰოსტის ფაილური სისტემა) ან მომხმარებლის
+ *          საცავში. გამომქვეყნებელი მხოლოდ აკოპირებს ჩანაწერს რიგში; ჩაწერას
+ *          ასრულებს დაბალი პრიორიტეტის writer ტასკი, ამიტომ ფაილური I/O
+ *          გამოქვეყნების გზაზე არ ხვდება.
+ *
+ *          Replay კითხულობს ჩაწერილ ფაილს და ხელახლა აქვეყნებს ივენთებს
+ *          ორიგინალი ტემპით (1x), N-ჯერ სწრაფად ან მაქსიმალური სიჩქარით -
+ *          რეალური (მაგ. წარმოებიდან მოპოვებული) დატვირთვის რეპროდუქციისთვის
+ *          linux ჰოსტ target-ზე ან მოწყობილობაზე.
+ *
+ *          ფაილის ფორმატი (little-endian):
+ *          - სათაური: `"SCAP"`, ვერსია (u16), რეზერვი (u16);
+ *          - `'N'` ჩანაწერი: ID (u16), სახელის სიგრძე (u8), სახელი - ყოველი ივენთისთვის პირველ გამოჩენამდე;
+ *          - `'E'` ჩანაწერი: ID (u16), ზოლი (u8), დროშები (u8), დრო წინა ჩანაწერიდან µs (u32),
+ *            payload-ის ზომა (u16), payload;
+ *          - `'L'` ჩანაწერი: ჩაწერის რიგის გადავსებით დაკარგული ივენთების რაოდენობა (u32).
+ */
+
+#ifndef SYNAPSE_EVENT_CAPTURE_H
+#define SYNAPSE_EVENT_CAPTURE_H
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+#include "framework_events.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct event_data_wrapper_t;
+
+/** @brief ჩაწერილი ივენთის დროშა: payload არ დაეტია `CONFIG_SYNAPSE_EVENT_CAPTURE_MAX_PAYLOAD`-ში და არ ჩაიწერა. */
+#define SYNAPSE_EVENT_CAPTURE_FLAG_TRUNCATED (1U << 0)
+/** @brief ჩაწერილი ივენთის დროშა: wrapper-ის payload-ის ზომა უცნობია და encoder არ არის რეგისტრირებული. */
+#define SYNAPSE_EVENT_CAPTURE_FLAG_OPAQUE (1U << 1)
+/** @brief ჩაწერილი ივენთის დროშა: ივენთი გამოქვეყნდა ISR-იდან. */
+#define SYNAPSE_EVENT_CAPTURE_FLAG_FROM_ISR (1U << 2)
+
+/**
+ * @brief payload-ის encoder: წერს payload-ს `buffer`-ში.
+ * @details იძახება გამომქვეყნებლის კონტექსტში (არა ISR-დან), ამიტომ უნდა
+ *          იყოს სწრაფი და არ უნდა დაელოდოს.
+ * @param[in] payload ივენთის payload (wrapper-ის ან ინლაინ ბაიტები).
+ * @param[out] buffer სამიზნე ბუფერი.
+ * @param[in] capacity ბუფერის ზომა.
+ * @return საჭირო ბაიტების რაოდენობა (როგორც `snprintf`); თუ ის `capacity`-ზე
+ *         მეტია, payload არ ჩაიწერება და ჩანაწერი მოინიშნება TRUNCATED-ად.
+ */
+typedef size_t (*synapse_event_capture_encode_fn_t)(const void *payload, uint8_t *buffer, size_t capacity);
+
+/**
+ * @brief payload-ის decoder: ჩაწერილი ბაიტებიდან ქმნის wrapper-ს გადათამაშებისთვის.
+ * @param[in] data ჩაწერილი payload.
+ * @param[in] size payload-ის ზომა.
+ * @param[out] wrapper_out ახალი wrapper (reference-ს ფლობს replay, რომელიც მას გამოქვეყნების შემდეგ ათავისუფლებს).
+ */
+typedef esp_err_t (*synapse_event_capture_decode_fn_t)(const uint8_t *data, size_t size,
+                                                       struct event_data_wrapper_t **wrapper_out);
+
+/**
+ * @brief ჩაწერის სამიზნე (sink).
+ * @details `write` იძახება მხოლოდ writer ტასკიდან; `close` - ჩაწერის დასრულებისას.
+ */
+typedef struct
+{
+    esp_err_t (*write)(void *context, const void *data, size_t size); /**< @brief წერს ბაიტებს. */
+    void (*close)(void *context);                                      /**< @brief (Optional) ხურავს sink-ს. */
+    void *context;                                                     /**< @brief sink-ის კონტექსტი. */
+} synapse_event_capture_sink_t;
+
+/**
+ * @brief ჩაწერის სტატისტიკა.
+ */
+typedef struct
+{
+    bool active;            /**< @brief ჩაწერა მიმდინარეობს. */
+    uint32_t captured;      /**< @brief ჩაწერის რიგში მოხვედრილი ივენთები. */
+    uint32_t dropped;       /**< @brief რიგის გადავსებით დაკარგული ივენთები (ფაილში `'L'` ჩანაწერად). */
+    uint32_t truncated;     /**< @brief ივენთები, რომელთა payload არ დაეტია. */
+    uint32_t opaque;        /**< @brief ივენთები უცნობი ზომის payload-ით (encoder-ის გარეშე). */
+    uint32_t bytes_written; /**< @brief sink-ში ჩაწერილი ბაიტები. */
+    uint32_t write_errors;  /**< @brief sink-ის ჩაწერის შეცდომები. */
+} synapse_event_capture_stats_t;
+
+/**
+ * @brief გადათამაშების პარამეტრები.
+ */
+typedef struct
+{
+    uint32_t speed; /**< @brief 1 = ორიგინალი ტემპი, N = N-ჯერ სწრაფად, 0 = მაქსიმალური სიჩქარე (პაუზების გარეშე). */
+} synapse_event_replay_config_t;
+
+/**
+ * @brief გადათამაშების შედეგი.
+ */
+typedef struct
+{
+    uint32_t replayed;         /**< @brief წარმატებით გამოქვეყნებული ივენთები. */
+    uint32_t failed;           /**< @brief ივენთები, რომლებიც Event Bus-მა უარყო (მაგ. გადავსება). */
+    uint32_t skipped;          /**< @brief ივენთები, რომელთა payload ვერ აღდგა (TRUNCATED/OPAQUE/decoder-ის შეცდომა). */
+    uint32_t capture_lost;     /**< @brief ჩაწერისას დაკარგული ივენთები (`'L'` ჩანაწერები). */
+    uint64_t captured_span_us; /**< @brief ჩაწერილი ნაკადის ხანგრძლივობა. */
+    uint64_t duration_us;      /**< @brief გადათამაშების რეალური ხანგრძლივობა. */
+} synapse_event_replay_stats_t;
+
+/**
+ * @brief არეგისტრირებს ივენთის payload-ის encoder/decoder წყვილს.
+ * @details encoder-ის გარეშე ინლაინ payload (და ISR-იდან გამოქვეყნებული)
+ *          იწერება როგორც არის, wrapper-ის payload კი - OPAQUE-ად, რადგან მისი
+ *          ზომა უცნობია. decoder-ის გარეშე replay აქვეყნებს ბაიტებს ინლაინ
+ *          (თუ ეტევა) ან `malloc`-ით შექმნილ wrapper-ში.
+ * @param[in] event_id ივენთის ID.
+ * @param[in] encode_fn encoder ან NULL.
+ * @param[in] decode_fn decoder ან NULL.
+ * @return ESP_OK ან ESP_ERR_INVALID_ARG.
+ */
+esp_err_t synapse_event_capture_set_codec(synapse_event_id_t event_id,
+                                          synapse_event_capture_encode_fn_t encode_fn,
+                                          synapse_event_capture_decode_fn_t decode_fn);
+
+/**
+ * @brief იწყებს ჩაწერას მომხმარებლის sink-ში.
+ * @param[in] sink sink-ის აღწერა (კოპირდება).
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, ESP_ERR_INVALID_STATE (ჩაწერა უკვე მიმდინარეობს),
+ *         ESP_ERR_NO_MEM ან ESP_ERR_NOT_SUPPORTED (`CONFIG_SYNAPSE_EVENT_CAPTURE_ENABLE=n`).
+ */
+esp_err_t synapse_event_capture_start(const synapse_event_capture_sink_t *sink);
+
+/**
+ * @brief იწყებს ჩაწერას ფაილში (VFS: `/spiffs/...`, `/sdcard/...` ან ჰოსტის გზა).
+ * @return როგორც `synapse_event_capture_start()`, ან ESP_FAIL თუ ფაილი ვერ გაიხსნა.
+ */
+esp_err_t synapse_event_capture_start_file(const char *path);
+
+/**
+ * @brief აჩერებს ჩაწერას, წერს რიგში დარჩენილ ჩანაწერებს და ხურავს sink-ს.
+ * @return ESP_OK, ESP_ERR_INVALID_STATE (ჩაწერა არ მიმდინარეობს) ან ESP_ERR_TIMEOUT.
+ */
+esp_err_t synapse_event_capture_stop(void);
+
+/**
+ * @brief აბრუნებს ჩაწერის სტატისტიკას (ბოლო `start`-იდან).
+ */
+esp_err_t synapse_event_capture_get_stats(synapse_event_capture_stats_t *stats);
+
+/**
+ * @brief გადათამაშებს ჩაწერილ ფაილს Event Bus-ში (ბლოკავს დასრულებამდე).
+ * @details ივენთების სახელები ხელახლა interning-დება, ამიტომ ფაილი ვარგისია
+ *          სხვა build-ზეც. ივენთი ქვეყნდება ჩაწერილ ზოლში. 1x/Nx რეჟიმში
+ *          პაუზები ტიკის სიზუსტისაა - ტიკზე მოკლე ინტერვალით გამოქვეყნებული
+ *          ივენთები ერთ პაკეტად გადის. გადათამაშებისას ჩაწერა უნდა იყოს გამორთული.
+ * @param[in] path ფაილის გზა.
+ * @param[in] config (Optional) პარამეტრები; NULL = 1x.
+ * @param[out] stats_out (Optional) შედეგი.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, ESP_ERR_NOT_FOUND (ფაილი), ESP_ERR_INVALID_VERSION,
+ *         ESP_ERR_INVALID_SIZE (დაზიანებული ფაილი), ESP_ERR_INVALID_STATE ან ESP_ERR_NO_MEM.
+ */
+esp_err_t synapse_event_replay_file(const char *path, const synapse_event_replay_config_t *config,
+                                    synapse_event_replay_stats_t *stats_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SYNAPSE_EVENT_CAPTURE_H
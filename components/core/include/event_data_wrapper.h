@@ -1,14 +1,16 @@
 /**
  * @file event_data_wrapper.h
  * @brief Event Bus-ისთვის მონაცემთა შეფუთვის (Wrapper) და Reference Counting-ის API.
- * @version 2.0
- * @date 2025-06-25
+ * @version 2.1
+ * @date 2025-10-07
  * @author Giorgi Magradze
  * @details ეს კომპონენტი უზრუნველყოფს მექანიზმს, რომლის საშუალებითაც შესაძლებელია
  *          დინამიურად გამოყოფილი მეხსიერების უსაფრთხოდ გადაცემა Event Bus-ის
  *          საშუალებით მრავალი მიმღებისთვის. ის იყენებს Reference Counting-ის
  *          პატერნს, რათა მეხსიერება ავტომატურად განთავისუფლდეს მხოლოდ მაშინ,
  *          როდესაც მასზე ბოლო მომხმარებელი დაასრულებს მუშაობას.
+ *          მრიცხველი იცვლება ატომური ოპერაციებით (lock-free) - `acquire`/`release`
+ *          არასდროს ბლოკავს და ISR-იდანაც უსაფრთხოა.
  */
 
 #ifndef SYNAPSE_EVENT_DATA_WRAPPER_H
@@ -17,24 +19,73 @@
 #include "esp_err.h"
 #include <stdint.h>
 #include <stddef.h>
-#include "freertos/FreeRTOS.h"
-#include "freertos/semphr.h"
+#include <stdbool.h>
+#include "sdkconfig.h"
+
+/**
+ * @brief wrapper-ის დროშა: payload ეკუთვნის Event Bus-ს და ვალიდურია მხოლოდ `handle_event`-ის დროს.
+ * @details ასეთ wrapper-ს Event Bus ქმნის ინლაინ payload-ის მქონე ივენთებისთვის
+ *          (მაგ. `synapse_event_bus_post_from_isr()`). `release` მასზე არაფერს აკეთებს,
+ *          ხოლო `acquire` აბრუნებს ESP_ERR_NOT_SUPPORTED-ს - მონაცემების შესანახად
+ *          ისინი უნდა დაკოპირდეს. ასეთი wrapper-ის ხელახლა გამოქვეყნება უსაფრთხოა:
+ *          Event Bus მის payload-ს დააკოპირებს.
+ */
+#define SYNAPSE_EVENT_DATA_FLAG_BORROWED (1U << 0)
+
+/**
+ * @brief `event_data_wrapper_t::magic` ცოცხალი wrapper-ისთვის (`CONFIG_SYNAPSE_EVENT_DATA_DEBUG`).
+ */
+#define SYNAPSE_EVENT_DATA_MAGIC_LIVE 0x57524150U
+
+/**
+ * @brief `event_data_wrapper_t::magic` გათავისუფლებული wrapper-ისთვის (`CONFIG_SYNAPSE_EVENT_DATA_DEBUG`).
+ */
+#define SYNAPSE_EVENT_DATA_MAGIC_FREED 0x44454144U
 
 /**
  * @brief ზოგადი "შეფუთვა" (wrapper) ნებისმიერი ივენთის მონაცემებისთვის.
  *
  * @details ეს სტრუქტურა ამატებს Reference Counting მექანიზმს
  *          ნებისმიერი ტიპის დინამიურად შექმნილ მონაცემებზე (payload),
- *          რომლებიც Event Bus-ით გადაიცემა.
+ *          რომლებიც Event Bus-ით გადაიცემა. wrapper ერთი heap ბლოკია;
+ *          `ref_count`-ს ცვლის მხოლოდ `acquire`/`release` (ატომურად).
  */
 typedef struct event_data_wrapper_t
 {
-    int32_t ref_count;                      /**< @brief მრიცხველი, რომელიც აჩვენებს, რამდენი მომხმარებელი იყენებს ამ მონაცემს. */
-    SemaphoreHandle_t mutex;                /**< @brief Mutex, რომელიც უზრუნველყოფს ref_count-ის ატომურ (thread-safe) ცვლილებას. */
+    int32_t ref_count;                      /**< @brief მრიცხველი, რომელიც აჩვენებს, რამდენი მომხმარებელი იყენებს ამ მონაცემს (ატომური). */
+#if CONFIG_SYNAPSE_EVENT_DATA_DEBUG
+    uint32_t magic;                         /**< @brief `SYNAPSE_EVENT_DATA_MAGIC_*`: ორმაგი release-ის აღმოსაჩენად. */
+#endif
     void *payload;                          /**< @brief მაჩვენებელი რეალურ მონაცემებზე (მაგ., telemetry_data_t*). */
     void (*free_payload_fn)(void *payload); /**< @brief ფუნქციის მაჩვენებელი, რომელიც გამოიძახება payload-ის მეხსიერების გასათავისუფლებლად. */
+    uint16_t payload_size;                  /**< @brief payload-ის ზომა ბაიტებში (ცნობილია მხოლოდ ინლაინ payload-ისთვის, სხვაგან 0). */
+    uint8_t flags;                          /**< @brief `SYNAPSE_EVENT_DATA_FLAG_*` დროშები. */
+    uint32_t correlation_id;                /**< @brief მოთხოვნის ID (`synapse_event_bus_request()`); 0 = ჩვეულებრივი ივენთი. */
 } event_data_wrapper_t;
 
+/**
+ * @brief wrapper-ების გამოყოფის სტატისტიკა.
+ * @details თითოეული `synapse_event_data_wrap()` ნიშნავს ერთ გამოყოფას (wrapper,
+ *          ფიქსირებული ბლოკების აუზიდან - იხ. synapse_pool.h) და ერთ გათავისუფლებას
+ *          (payload-ის გამოყოფა, რომელსაც გამომძახებელი აკეთებს, აქ არ ითვლება). ინლაინ
+ *          ივენთები (`synapse_event_bus_post_inline()`) wrapper-ს არ ქმნიან.
+ */
+typedef struct
+{
+    uint32_t wrappers_created; /**< @brief შექმნილი wrapper-ები. */
+    uint32_t wrappers_freed;   /**< @brief გათავისუფლებული wrapper-ები; `created - freed` = ცოცხალი wrapper-ები. */
+    uint32_t wrap_failures;    /**< @brief მეხსიერების ნაკლებობის გამო წარუმატებელი `wrap` გამოძახებები. */
+    uint32_t refcount_errors;  /**< @brief ზედმეტი `release` (მრიცხველი 0-ზე ქვემოთ) ან გათავისუფლებულ wrapper-ზე `acquire`/`release`. */
+} synapse_event_data_stats_t;
+
+/**
+ * @brief ამოწმებს, არის თუ არა wrapper Event Bus-ის მიერ "ნასესხები" (იხ. SYNAPSE_EVENT_DATA_FLAG_BORROWED).
+ */
+static inline bool synapse_event_data_is_borrowed(const event_data_wrapper_t *wrapper)
+{
+    return wrapper && (wrapper->flags & SYNAPSE_EVENT_DATA_FLAG_BORROWED);
+}
+
 /**
  * @brief ქმნის ახალ "შეფუთულ" მონაცემთა ობიექტს (wrapper) და ამყარებს საწყის მფლობელობას.
  *
@@ -63,12 +114,15 @@ esp_err_t synapse_event_data_wrap(const void *payload, void (*free_fn)(void *pay
  *
  * @details ამ ფუნქციას, როგორც წესი, იძახებს Event Bus-ი, როდესაც ივენთს გადასცემს
  *          ახალ გამომწერ მოდულს. თითოეული `acquire` გამოძახება უნდა დაწყვილდეს
- *          `release` გამოძახებასთან.
+ *          `release` გამოძახებასთან. გამომძახებელს უკვე უნდა ეკავოს reference -
+ *          გათავისუფლებული wrapper-ის "გაცოცხლება" შეუძლებელია.
  *
  * @param[in] wrapper მაჩვენებელი wrapper ობიექტზე.
  * @return esp_err_t
  * @retval ESP_OK თუ ოპერაცია წარმატებით შესრულდა.
  * @retval ESP_ERR_INVALID_ARG თუ `wrapper` არის NULL.
+ * @retval ESP_ERR_INVALID_STATE თუ wrapper უკვე გათავისუფლებულია (მხოლოდ `CONFIG_SYNAPSE_EVENT_DATA_DEBUG`).
+ * @retval ESP_ERR_NOT_SUPPORTED თუ wrapper ნასესხებია (`SYNAPSE_EVENT_DATA_FLAG_BORROWED`).
  */
 esp_err_t synapse_event_data_acquire(event_data_wrapper_t *wrapper);
 
@@ -79,12 +133,26 @@ esp_err_t synapse_event_data_acquire(event_data_wrapper_t *wrapper);
  *          ასრულებენ მონაცემებზე მუშაობას. თუ `ref_count` ამ გამოძახების
  *          შემდეგ 0 ხდება, ეს ფუნქცია ავტომატურად ათავისუფლებს ყველა
  *          დაკავშირებულ მეხსიერებას (თავად payload-ს და wrapper-ს).
+ *          ზედმეტი `release` ლოგავს შეცდომას და ითვლება `refcount_errors`-ში.
  *
  * @param[in] wrapper მაჩვენებელი wrapper ობიექტზე.
  * @return esp_err_t
  * @retval ESP_OK თუ ოპერაცია წარმატებით შესრულდა.
  * @retval ESP_ERR_INVALID_ARG თუ `wrapper` არის NULL.
+ * @retval ESP_ERR_INVALID_STATE თუ ეს ზედმეტი `release` იყო (მრიცხველი უკვე 0 იყო).
  */
 esp_err_t synapse_event_data_release(event_data_wrapper_t *wrapper);
 
+/**
+ * @brief კითხულობს wrapper-ების გამოყოფის სტატისტიკას.
+ * @param[out] stats დანიშნულების სტრუქტურა.
+ * @return ESP_OK ან ESP_ERR_INVALID_ARG, თუ `stats` არის NULL.
+ */
+esp_err_t synapse_event_data_get_stats(synapse_event_data_stats_t *stats);
+
+/**
+ * @brief ანულებს wrapper-ების გამოყოფის სტატისტიკას.
+ */
+void synapse_event_data_reset_stats(void);
+
 #endif // SYNAPSE_EVENT_DATA_WRAPPER_H
\ No newline at end of file
@@ -0,0 +1,65 @@
+/**
+ * @file event_mailbox_internal.h
+ * @brief Internal Core API of the per-module event mailboxes and handler statistics.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-10-06
+ * @details A module with a mailbox (`synapse_event_bus_enable_mailbox()`)
+ *          receives its asynchronous events through a bounded queue drained
+ *          by its own executor task, so a slow handler delays only that
+ *          module. The dispatcher reaches the mailbox through
+ *          `module_t::mailbox` inside a read-side section; disabling a
+ *          mailbox unpublishes the pointer and waits for those sections
+ *          before the executor is stopped.
+ *
+ *          This header is used only by the Core.
+ */
+
+#ifndef SYNAPSE_EVENT_MAILBOX_INTERNAL_H
+#define SYNAPSE_EVENT_MAILBOX_INTERNAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "framework_events.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  struct module_t;
+  struct event_data_wrapper_t;
+
+  /**
+   * @brief Hands an asynchronous event to the module's mailbox.
+   * @details A counted wrapper gets one extra reference, which the executor
+   *          passes on to `handle_event`; a borrowed (inline) payload is
+   *          copied into the queue slot. When the mailbox stays full for the
+   *          configured timeout the event is dropped and counted.
+   * @note Opens its own read-side section of the subscription store.
+   * @return true if the mailbox took over the event (queued or dropped);
+   *         false if the caller must call the handler itself (no mailbox, or a
+   *         borrowed payload larger than the inline area).
+   */
+  bool synapse_event_mailbox_post(struct module_t *module, synapse_event_id_t event_id,
+                                  struct event_data_wrapper_t *data_wrapper, bool counted);
+
+  /**
+   * @brief Returns true if the calling task is the mailbox executor of `module`.
+   */
+  bool synapse_event_mailbox_is_executor(const struct module_t *module);
+
+  /**
+   * @brief Adds one `handle_event` duration to the module's counters.
+   */
+  void synapse_event_module_record_handler(struct module_t *module, uint32_t duration_us);
+
+  /**
+   * @brief Clears the handler and mailbox counters of one module.
+   */
+  void synapse_event_module_reset_stats(struct module_t *module);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SYNAPSE_EVENT_MAILBOX_INTERNAL_H
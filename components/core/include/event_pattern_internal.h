@@ -0,0 +1,99 @@
+/**
+ * @file event_pattern_internal.h
+ * @brief Internal Core API of the Event Bus hierarchical topic patterns.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-09-25
+ * @details Event names may be hierarchical, with segments separated by `.`
+ *          (e.g. `sensor.kitchen.temperature`). A subscription name is a
+ *          pattern if one of its segments is a wildcard:
+ *
+ *          - `+` matches exactly one segment (`sensor.+.temperature`);
+ *          - `*` as the last segment matches one or more segments
+ *            (`SYNAPSE_RELAY.*` matches `SYNAPSE_RELAY.on` and
+ *            `SYNAPSE_RELAY.ch1.on`, but not `SYNAPSE_RELAY` itself).
+ *
+ *          The plain `"*"` subscription is not a pattern: it keeps its own
+ *          fast path (SYNAPSE_EVENT_ID_WILDCARD).
+ *
+ *          All pattern subscriptions are compiled into one immutable trie.
+ *          Matching walks the trie once per topic segment, so its cost depends
+ *          on the depth of the topic and not on the number of subscriptions.
+ */
+
+#ifndef SYNAPSE_EVENT_PATTERN_INTERNAL_H
+#define SYNAPSE_EVENT_PATTERN_INTERNAL_H
+
+#include "esp_err.h"
+#include "event_subscription_internal.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  struct module_t;
+
+  /** @brief Segment separator of hierarchical event names. */
+#define SYNAPSE_EVENT_TOPIC_SEPARATOR '.'
+
+  /**
+   * @brief One pattern subscription, as kept by the subscription store.
+   */
+  typedef struct
+  {
+    const char *pattern;     /**< @brief The pattern (owned by the store). */
+    struct module_t *module; /**< @brief The subscribed module. */
+  } event_pattern_entry_t;
+
+  /**
+   * @brief Compiled, immutable pattern trie.
+   * @details A single heap block that starts with an `event_retired_t` header,
+   *          so it is published and reclaimed like a subscriber snapshot.
+   */
+  typedef struct event_pattern_trie_t event_pattern_trie_t;
+
+  /**
+   * @brief Returns true if `name` contains a `+` or `*` segment (and is not the plain `"*"`).
+   */
+  bool synapse_event_pattern_is_pattern(const char *name);
+
+  /**
+   * @brief Checks the syntax of a pattern.
+   * @return ESP_OK, or ESP_ERR_INVALID_ARG if a segment is empty or `*` is not the last segment.
+   */
+  esp_err_t synapse_event_pattern_validate(const char *pattern);
+
+  /**
+   * @brief Compiles pattern subscriptions into a trie.
+   * @param[in] entries The subscriptions (validated patterns).
+   * @param[in] count Number of entries; must be > 0.
+   * @return The trie (free with `free()` after a grace period), or NULL on allocation failure.
+   */
+  event_pattern_trie_t *synapse_event_pattern_trie_build(const event_pattern_entry_t *entries, size_t count);
+
+  /**
+   * @brief Collects the modules whose patterns match a topic.
+   * @details Each module is reported once, even if several of its patterns match.
+   * @param[in] trie The trie.
+   * @param[in] topic The event name.
+   * @param[out] modules Output array.
+   * @param[in] max Capacity of `modules`.
+   * @param[out] overflow_out (Optional) Set to true if more than `max` modules matched.
+   * @return Number of modules written to `modules`.
+   */
+  size_t synapse_event_pattern_trie_match(const event_pattern_trie_t *trie, const char *topic,
+                                          struct module_t **modules, size_t max, bool *overflow_out);
+
+  /**
+   * @brief Returns the number of nodes and the size in bytes of a compiled trie.
+   */
+  void synapse_event_pattern_trie_get_size(const event_pattern_trie_t *trie, uint32_t *nodes_out, uint32_t *bytes_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SYNAPSE_EVENT_PATTERN_INTERNAL_H
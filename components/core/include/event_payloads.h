@@ -20,6 +20,8 @@
 #include <stdlib.h> // for free(), malloc()
 #include <string.h> // for strncpy()
 #include "cJSON.h"
+#include "synapse_pool.h"
+#include "synapse_buffer.h"
 // =========================================================================
 //                      Payload სტრუქტურები
 // =========================================================================
@@ -27,10 +29,15 @@
 /**
  * @struct synapse_telemetry_payload_t
  * @brief ზოგადი სტრუქტურა ტელემეტრიული მონაცემების გადასაცემად.
+ * @details მონაცემები ინახება ერთ-ერთ ველში: `json_data` (საკუთარი სტრიქონი) ან
+ *          `json_slice` (გაზიარებული ბუფერის ნაჭერი, იხ. `synapse_telemetry_payload_create_from_slice()`).
+ *          მომხმარებლებმა JSON უნდა წაიკითხონ `synapse_telemetry_payload_get_json()`-ით,
+ *          რომელიც ორივე ფორმას ერთნაირად აბრუნებს.
  */
 typedef struct {
     char module_name[CONFIG_SYNAPSE_MODULE_NAME_MAX_LENGTH]; /**< @brief მოდულის სახელი, რომელიც აქვეყნებს მონაცემებს. */
     char *json_data;                                     /**< @brief მონაცემები JSON სტრიქონის სახით (დინამიურად გამოყოფილი). */
+    synapse_buffer_slice_t json_slice;                   /**< @brief მონაცემები გაზიარებული ბუფერის ნაჭრად; `json_data`-სთან ერთად არ გამოიყენება. */
 } synapse_telemetry_payload_t;
 
 /**
@@ -134,23 +141,87 @@ typedef struct
 // =========================================================================
 
 /**
- * @brief ზოგადი cleanup ფუნქცია მარტივი, `malloc`-ით შექმნილი payload-ებისთვის.
+ * @brief ახალი payload-ის სტრუქტურა ფიქსირებული ბლოკების აუზიდან (ნულებით შევსებული).
+ * @details `SYNAPSE_PAYLOAD_NEW(synapse_button_payload_t)` - heap-ის ფრაგმენტაციის
+ *          გარეშე; თავისუფლდება `synapse_payload_common_free`-ით (`free_fn`).
+ */
+#define SYNAPSE_PAYLOAD_NEW(type) SYNAPSE_POOL_NEW(type)
+
+/**
+ * @brief ზოგადი cleanup ფუნქცია მარტივი payload-ებისთვის.
  * @details ეს ფუნქცია გადაეცემა `synapse_event_data_wrap`-ს იმ payload-ებისთვის,
- *          რომლებსაც არ სჭირდებათ სპეციალური გასუფთავების ლოგიკა.
+ *          რომლებსაც არ სჭირდებათ სპეციალური გასუფთავების ლოგიკა. ათავისუფლებს
+ *          როგორც `SYNAPSE_PAYLOAD_NEW()`-ით (აუზიდან), ისე `malloc`-ით შექმნილ payload-ს.
  * @param data void მაჩვენებელი გასათავისუფლებელ ობიექტზე.
  */
 static inline void synapse_payload_common_free(void *data)
 {
-    if (data)
-    {
-        free(data);
-    }
+    synapse_pool_free(data);
 }
 
 /**
  * @brief ათავისუფლებს ტელემეტრიის პეილოდს.
+ * @details `json_data`-ს ათავისუფლებს `free()`-ით, `json_slice`-ს კი უბრუნებს reference-ს.
  * @param data პეილოდის მაჩვენებელი.
  */
 void synapse_telemetry_payload_free(void *data);
 
+// =========================================================================
+//                      ტელემეტრია გაზიარებული ბუფერებიდან
+// =========================================================================
+
+/**
+ * @brief ქმნის ტელემეტრიის payload-ს ბუფერის ნაჭრიდან, JSON-ის კოპირების გარეშე.
+ * @details payload იღებს ნაჭრის საკუთარ reference-ს - გამომძახებლის `json`
+ *          ხელუხლებელი რჩება და მისი გათავისუფლება მისივე პასუხისმგებლობაა.
+ *          payload-ი იქმნება აუზიდან და გადაეცემა `synapse_event_data_wrap`-ს
+ *          `synapse_telemetry_payload_free`-თან ერთად.
+ * @param[in] module_name გამომქვეყნებელი მოდულის სახელი.
+ * @param[in] json ნაჭერი JSON მონაცემებით.
+ * @param[out] payload_out შექმნილი payload.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG ან ESP_ERR_NO_MEM.
+ */
+esp_err_t synapse_telemetry_payload_create_from_slice(const char *module_name, const synapse_buffer_slice_t *json,
+                                                      synapse_telemetry_payload_t **payload_out);
+
+/**
+ * @brief იგივეა, რაც `synapse_telemetry_payload_create_from_slice()`, მთელი ბუფერისთვის.
+ */
+esp_err_t synapse_telemetry_payload_create_from_buffer(const char *module_name, synapse_buffer_t *json,
+                                                       synapse_telemetry_payload_t **payload_out);
+
+/**
+ * @brief აბრუნებს payload-ის JSON-ს და მის სიგრძეს, მიუხედავად შენახვის ფორმისა.
+ * @note ნაჭრის შემთხვევაში შედეგი '\0'-ით მხოლოდ მაშინ მთავრდება, როცა ნაჭერი
+ *       ბუფერის ბოლომდე აღწევს - ყოველთვის გამოიყენეთ `length_out`.
+ * @param[in] payload ტელემეტრიის payload.
+ * @param[out] length_out JSON-ის სიგრძე ბაიტებში (შეიძლება იყოს NULL).
+ * @return JSON-ის დასაწყისი, ან NULL, თუ მონაცემები არ არის.
+ */
+const char *synapse_telemetry_payload_get_json(const synapse_telemetry_payload_t *payload, size_t *length_out);
+
+/**
+ * @brief იღებს payload-ის JSON-ის ნაჭერს, რომელიც handler-ის დასრულების შემდეგაც ცოცხლობს.
+ * @details `json_slice`-ით შექმნილი payload-ისთვის ოპერაცია zero-copy-ა (მხოლოდ
+ *          reference იზრდება); ძველი `json_data` ფორმისთვის მონაცემები ერთხელ
+ *          კოპირდება ახალ ბუფერში. `length == SIZE_MAX` ნიშნავს "ბოლომდე".
+ *          შედეგი თავისუფლდება `synapse_buffer_slice_release()`-ით.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, ESP_ERR_INVALID_SIZE ან ESP_ERR_NO_MEM.
+ */
+esp_err_t synapse_telemetry_payload_get_slice(const synapse_telemetry_payload_t *payload, size_t offset, size_t length,
+                                              synapse_buffer_slice_t *slice_out);
+
+// =========================================================================
+//                      Conflation გასაღების ფუნქციები
+// =========================================================================
+
+/**
+ * @brief conflation-ის გასაღები `synapse_service_status_payload_t`-ისთვის (სერვისის სახელის ჰეში).
+ * @details გადაეცემა `synapse_event_bus_set_conflation()`-ს, რათა
+ *          SERVICE_STATUS_CHANGED ივენთები შეირწყას ცალ-ცალკე თითოეული სერვისისთვის.
+ * @param payload `synapse_service_status_payload_t` ან NULL.
+ * @return გასაღები (NULL payload-ისთვის 0).
+ */
+uint32_t synapse_service_status_conflation_key(const void *payload);
+
 #endif // SYNAPSE_EVENT_PAYLOADS_H
\ No newline at end of file
@@ -0,0 +1,74 @@
+/**
+ * @file event_registry_internal.h
+ * @brief Internal Core API of the Event Bus name-interning registry.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-09-20
+ * @details The registry maps every event name to a dense `synapse_event_id_t`
+ *          and keeps one descriptor per ID. It is used only by the Event Bus
+ *          implementation; modules use the `synapse_event_bus_*` API instead.
+ */
+
+#ifndef SYNAPSE_EVENT_REGISTRY_INTERNAL_H
+#define SYNAPSE_EVENT_REGISTRY_INTERNAL_H
+
+#include "esp_err.h"
+#include "framework_events.h"
+#include "event_bus.h"
+#include "event_capture.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /** @brief The event is conflating (latest-value); see `synapse_event_bus_set_conflation()`. */
+#define EVENT_DESCRIPTOR_FLAG_CONFLATING (1U << 0)
+
+  /**
+   * @brief Describes a single interned event name.
+   */
+  typedef struct
+  {
+    const char *name; /**< @brief The interned name. Valid for the lifetime of the firmware. */
+    uint32_t hash;    /**< @brief FNV-1a hash of the name. */
+    uint8_t default_priority; /**< @brief Lane used by `post`/`post_id` (`synapse_event_priority_t`). */
+    uint8_t flags;            /**< @brief `EVENT_DESCRIPTOR_FLAG_*`. */
+    synapse_event_conflation_key_fn_t conflation_key_fn; /**< @brief Key function of a conflating event, or NULL. */
+    uint32_t conflated;       /**< @brief Posts merged into a pending message. */
+    uint8_t overflow_policy;  /**< @brief `synapse_event_overflow_policy_t`; LANE_DEFAULT uses the lane's policy. */
+    uint32_t block_timeout_ms; /**< @brief Wait limit of the BLOCK policy (0 = Kconfig default). */
+    uint32_t posted;          /**< @brief Messages queued (spilled ones when they are moved to the queue). */
+    uint32_t dropped;         /**< @brief Messages lost to overflow. */
+    uint32_t spilled;         /**< @brief Messages moved to the lane's spill buffer. */
+    uint32_t high_watermark;  /**< @brief Highest lane queue fill observed when this event was queued. */
+    synapse_event_capture_encode_fn_t capture_encode_fn; /**< @brief Capture payload encoder, or NULL. */
+    synapse_event_capture_decode_fn_t capture_decode_fn; /**< @brief Replay payload decoder, or NULL. */
+    synapse_event_partition_key_fn_t partition_key_fn;   /**< @brief Per-core partition key function, or NULL (event ID). */
+    uint8_t dispatch_core;    /**< @brief Pinned dispatcher core + 1; 0 = chosen by the partition key. */
+  } event_descriptor_t;
+
+  /**
+   * @brief Initializes the registry and pre-interns the framework events.
+   * @details After this call every `SYNAPSE_EVENT_ID_*` constant from
+   *          `framework_events.h` resolves to its name.
+   * @return ESP_OK on success, ESP_ERR_NO_MEM if the registry mutex could not be created.
+   */
+  esp_err_t synapse_event_registry_init(void);
+
+  /**
+   * @brief Returns the descriptor of an interned event, or NULL if `event_id` is unknown.
+   * @note Lock-free; safe to call from any task.
+   */
+  event_descriptor_t *synapse_event_registry_get(synapse_event_id_t event_id);
+
+  /**
+   * @brief Returns the number of interned event names (including the reserved IDs).
+   */
+  uint16_t synapse_event_registry_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SYNAPSE_EVENT_REGISTRY_INTERNAL_H
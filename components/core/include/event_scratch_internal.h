@@ -0,0 +1,69 @@
+/**
+ * @file event_scratch_internal.h
+ * @brief Internal Core API of the per-dispatch scratch arenas.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-10-09
+ * @details Every task that calls `handle_event` on behalf of the Event Bus
+ *          (lane dispatchers and module mailbox executors) owns one bump
+ *          arena. The task binds it once at start; handlers reach it through
+ *          `synapse_event_scratch_alloc()`, and the task resets it after each
+ *          event, so scratch memory is never freed individually.
+ *
+ *          This header is used only by the Core.
+ */
+
+#ifndef SYNAPSE_EVENT_SCRATCH_INTERNAL_H
+#define SYNAPSE_EVENT_SCRATCH_INTERNAL_H
+
+#include "esp_err.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /**
+   * @brief One bump arena.
+   */
+  typedef struct
+  {
+    uint8_t *base;        /**< Arena memory (`CONFIG_SYNAPSE_EVENT_SCRATCH_SIZE` bytes), NULL when disabled. */
+    uint32_t used;        /**< Bytes handed out since the last reset. */
+    uint16_t allocations; /**< Allocations since the last reset (flushed to the totals on reset). */
+    uint16_t overflows;   /**< Failed requests since the last reset (flushed to the totals on reset). */
+  } event_scratch_arena_t;
+
+  /**
+   * @brief Allocates the arena memory.
+   * @return ESP_OK (also when scratch arenas are disabled) or ESP_ERR_NO_MEM.
+   */
+  esp_err_t synapse_event_scratch_init(event_scratch_arena_t *arena);
+
+  /**
+   * @brief Frees the arena memory. The owning task must no longer run handlers.
+   */
+  void synapse_event_scratch_deinit(event_scratch_arena_t *arena);
+
+  /**
+   * @brief Makes the arena the scratch space of the calling task.
+   * @note Called once at the start of the dispatcher or executor task.
+   */
+  void synapse_event_scratch_bind(event_scratch_arena_t *arena);
+
+  /**
+   * @brief Releases everything allocated since the last reset and records the high-watermark.
+   * @note Called by the owning task after the handlers of one event returned.
+   */
+  void synapse_event_scratch_reset(event_scratch_arena_t *arena);
+
+  /**
+   * @brief Clears the scratch statistics (the arena count is kept).
+   */
+  void synapse_event_scratch_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SYNAPSE_EVENT_SCRATCH_INTERNAL_H
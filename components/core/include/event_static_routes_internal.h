@@ -0,0 +1,58 @@
+/**
+ * @file event_static_routes_internal.h
+ * @brief Internal Core API of the build-time (module.json `subscribes`) event routes.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-10-04
+ * @details `collect_modules.cmake` compiles the `subscribes` section of every
+ *          module.json into a const `{event, module type, flags}` table that
+ *          stays in flash. Module instances are created at runtime from the
+ *          configuration, so the module registry binds each new instance to
+ *          the routes of its type and seals the result once all instances
+ *          exist. The sealed table is published to the subscription store and
+ *          merged with the dynamic subscriptions at dispatch time.
+ *
+ *          This header is used only by the Core; modules declare static
+ *          subscriptions in module.json or call `synapse_event_bus_subscribe()`.
+ */
+
+#ifndef SYNAPSE_EVENT_STATIC_ROUTES_INTERNAL_H
+#define SYNAPSE_EVENT_STATIC_ROUTES_INTERNAL_H
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  struct module_t;
+
+  /**
+   * @brief Binds a newly registered module instance to the static routes of its type.
+   * @details Event names are interned here. Bindings are collected until
+   *          `synapse_event_static_routes_seal()`; a type without routes costs nothing.
+   * @param[in] module The registered instance.
+   * @param[in] module_type The factory type the instance was created from.
+   * @return ESP_OK, ESP_ERR_INVALID_ARG, ESP_ERR_INVALID_STATE if already sealed, or ESP_ERR_NO_MEM.
+   */
+  esp_err_t synapse_event_static_routes_bind(struct module_t *module, const char *module_type);
+
+  /**
+   * @brief Builds the routing table from the collected bindings and publishes it.
+   * @details Called once by the module registry after every instance is created.
+   * @return ESP_OK (also when there is nothing to route), ESP_ERR_NO_MEM or ESP_ERR_TIMEOUT.
+   */
+  esp_err_t synapse_event_static_routes_seal(void);
+
+  /**
+   * @brief Withdraws every static route and waits until no dispatcher uses them.
+   * @details Called at shutdown before the modules are deinitialized and freed.
+   * @return ESP_OK or ESP_ERR_TIMEOUT.
+   */
+  esp_err_t synapse_event_static_routes_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SYNAPSE_EVENT_STATIC_ROUTES_INTERNAL_H
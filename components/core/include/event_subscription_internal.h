@@ -0,0 +1,247 @@
+/**
+ * @file event_subscription_internal.h
+ * @brief Internal Core API of the Event Bus subscription store.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-09-22
+ * @details Subscriber lists are published as immutable snapshots, one per
+ *          event ID, and replaced atomically on every subscribe/unsubscribe.
+ *          Dispatchers read them inside a lightweight read-side section
+ *          without taking any lock. A replaced snapshot is freed only after
+ *          a grace period, i.e. once every read section that might still
+ *          see it has finished.
+ *
+ *          This header is used only by the Event Bus implementation; modules
+ *          use `synapse_event_bus_subscribe()` / `unsubscribe()` instead.
+ */
+
+#ifndef SYNAPSE_EVENT_SUBSCRIPTION_INTERNAL_H
+#define SYNAPSE_EVENT_SUBSCRIPTION_INTERNAL_H
+
+#include "esp_err.h"
+#include "framework_events.h"
+#include "event_bus.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  struct module_t;
+  struct event_pattern_trie_t;
+
+  /**
+   * @brief Header of every block published to dispatchers (snapshots, pattern tries).
+   * @details Must be the first member, so that a retired block can be freed
+   *          through its header once the grace period has elapsed.
+   */
+  typedef struct event_retired_t
+  {
+    struct event_retired_t *next; /**< @brief Link in the retired list (writer-side only). */
+  } event_retired_t;
+
+  /**
+   * @brief Filter of one subscription (see `synapse_event_bus_subscribe_filtered()`).
+   * @details Owned by the subscription and shared by every snapshot that
+   *          contains it; retired together with the snapshot that drops it.
+   *          A STRING value is copied right after the structure.
+   */
+  typedef struct event_subscription_filter_t
+  {
+    event_retired_t retired;       /**< @brief Retired-list link (writer-side only). */
+    synapse_event_filter_t filter; /**< @brief The filter; `field.value.str` points into this block. */
+    uint32_t evaluated;            /**< @brief Filter evaluations. */
+    uint32_t accepted;             /**< @brief Evaluations that let the event through. */
+  } event_subscription_filter_t;
+
+  /**
+   * @brief Immutable list of the modules subscribed to one event ID.
+   * @details Never modified after publication. Valid only inside the read
+   *          section in which it was obtained.
+   *
+   *          One heap block sized to the actual subscriber count: an 8-byte
+   *          header, then `modules[count]`, then - only if some entry needs
+   *          them - the parallel filter pointers and sync flags (see
+   *          `event_snapshot_filters()` / `event_snapshot_sync()`). An event
+   *          without subscribers has no block at all.
+   */
+  typedef struct event_subscriber_snapshot_t
+  {
+    event_retired_t retired;    /**< @brief Retired-list link (writer-side only). */
+    uint8_t count;              /**< @brief Number of entries in `modules`. */
+    uint8_t filter_count;       /**< @brief Number of filtered entries (0 = no filter array). */
+    uint8_t sync_count;         /**< @brief Number of synchronous entries (0 = no sync flag array). */
+    struct module_t *modules[]; /**< @brief Subscribed modules, in subscription order. */
+  } event_subscriber_snapshot_t;
+
+  /**
+   * @brief Returns the filters parallel to `modules` (NULL entry = unfiltered), or NULL if no entry is filtered.
+   */
+  static inline event_subscription_filter_t **event_snapshot_filters(const event_subscriber_snapshot_t *snapshot)
+  {
+    return snapshot->filter_count ? (event_subscription_filter_t **)&snapshot->modules[snapshot->count] : NULL;
+  }
+
+  /**
+   * @brief Returns the flags parallel to `modules` (1 = synchronous subscriber), or NULL if none is.
+   */
+  static inline uint8_t *event_snapshot_sync(const event_subscriber_snapshot_t *snapshot)
+  {
+    return snapshot->sync_count
+               ? (uint8_t *)&snapshot->modules[snapshot->filter_count ? 2 * snapshot->count : snapshot->count]
+               : NULL;
+  }
+
+  /**
+   * @brief One event of the static routing table: its ID and the modules routed to it.
+   */
+  typedef struct
+  {
+    synapse_event_id_t event_id;                  /**< @brief Event ID. */
+    const event_subscriber_snapshot_t *snapshot; /**< @brief Routed modules (never filtered), inside the same block. */
+  } event_static_route_entry_t;
+
+  /**
+   * @brief Static routes (module.json `subscribes`) bound to the module instances.
+   * @details Built once by `event_static_routes.c` after the module registry
+   *          has created every instance, then published like a snapshot. One
+   *          heap block: this header, `events[count]` sorted by ID, then one
+   *          snapshot per event.
+   */
+  typedef struct event_static_table_t
+  {
+    event_retired_t retired;             /**< @brief Retired-list link (writer-side only). */
+    uint32_t bytes;                      /**< @brief Size of the whole block. */
+    uint16_t bindings;                   /**< @brief Module/event pairs in the table. */
+    uint16_t count;                      /**< @brief Number of entries in `events`. */
+    event_static_route_entry_t events[]; /**< @brief Routed events, sorted by `event_id`. */
+  } event_static_table_t;
+
+  /**
+   * @brief Initializes the subscription store.
+   * @return ESP_OK, ESP_ERR_NO_MEM or ESP_ERR_INVALID_STATE if already initialized.
+   */
+  esp_err_t synapse_event_subscriptions_init(void);
+
+  /**
+   * @brief Enters a read-side section. Lock-free and never blocks.
+   * @details Sections may nest. Every module reached through a snapshot
+   *          obtained inside the section stays subscribed-safe until the
+   *          matching `read_unlock()`: `unsubscribe` waits for such sections
+   *          before returning.
+   * @return A token that must be passed to `synapse_event_subscriptions_read_unlock()`.
+   */
+  uint32_t synapse_event_subscriptions_read_lock(void);
+
+  /**
+   * @brief Leaves a read-side section entered with `synapse_event_subscriptions_read_lock()`.
+   */
+  void synapse_event_subscriptions_read_unlock(uint32_t token);
+
+  /**
+   * @brief Waits until every read-side section active at the call has ended.
+   * @details For objects that dispatchers reach through a module rather than
+   *          a snapshot (e.g. module mailboxes): unpublish the object, call
+   *          this, then free it. Snapshots retired before the call are freed
+   *          on the way.
+   * @return ESP_OK, ESP_ERR_INVALID_STATE inside a read-side section, or ESP_ERR_TIMEOUT.
+   */
+  esp_err_t synapse_event_subscriptions_synchronize(void);
+
+  /**
+   * @brief Returns the current snapshot of an event, or NULL if it has no subscribers.
+   * @note Must be called inside a read-side section.
+   */
+  const event_subscriber_snapshot_t *synapse_event_subscriptions_get(synapse_event_id_t event_id);
+
+  /**
+   * @brief Adds a module to an event's subscribers and publishes the new snapshot.
+   * @param[in] filter (Optional) Delivery filter; copied.
+   * @param[in] sync The module also accepts in-context delivery (`synapse_event_bus_publish_sync()`).
+   * @return ESP_OK, ESP_ERR_INVALID_STATE if already subscribed, ESP_ERR_INVALID_SIZE if
+   *         `CONFIG_SYNAPSE_MAX_SUBSCRIBERS_PER_EVENT` is reached, ESP_ERR_NO_MEM, ESP_ERR_TIMEOUT.
+   */
+  esp_err_t synapse_event_subscriptions_add(synapse_event_id_t event_id, struct module_t *module,
+                                            const synapse_event_filter_t *filter, bool sync);
+
+  /**
+   * @brief Evaluates a subscription filter and counts the result.
+   * @note Dispatcher context, inside a read-side section.
+   * @return true if the event should be delivered.
+   */
+  bool synapse_event_subscription_filter_accepts(event_subscription_filter_t *filter, synapse_event_id_t event_id,
+                                                 const void *payload);
+
+  /**
+   * @brief Reads the counters of a module's filtered subscription to an event.
+   * @return ESP_OK or ESP_ERR_NOT_FOUND.
+   */
+  esp_err_t synapse_event_subscriptions_get_filter_stats(synapse_event_id_t event_id, const struct module_t *module,
+                                                         uint32_t *evaluated_out, uint32_t *accepted_out);
+
+  /**
+   * @brief Removes a module from an event's subscribers.
+   * @details Does not wait for dispatchers: the old snapshot is freed right away
+   *          if no read-side section is open, otherwise by a later writer.
+   *          Dispatchers that copied `module` before the call may still deliver
+   *          to it; the Event Bus waits for them through `module_t::in_dispatch`.
+   * @return ESP_OK, ESP_ERR_NOT_FOUND, ESP_ERR_NO_MEM, ESP_ERR_TIMEOUT.
+   */
+  esp_err_t synapse_event_subscriptions_remove(synapse_event_id_t event_id, struct module_t *module);
+
+  /**
+   * @brief Returns the compiled pattern trie, or NULL if there are no pattern subscriptions.
+   * @note Must be called inside a read-side section.
+   */
+  const struct event_pattern_trie_t *synapse_event_subscriptions_get_patterns(void);
+
+  /**
+   * @brief Adds a pattern subscription (see `event_pattern_internal.h`) and recompiles the trie.
+   * @return ESP_OK, ESP_ERR_INVALID_ARG if the pattern is malformed, ESP_ERR_INVALID_STATE if
+   *         already subscribed, ESP_ERR_NO_MEM, ESP_ERR_TIMEOUT.
+   */
+  esp_err_t synapse_event_subscriptions_add_pattern(const char *pattern, struct module_t *module);
+
+  /**
+   * @brief Removes a pattern subscription. Same reclamation rules as
+   *        `synapse_event_subscriptions_remove()`.
+   * @return ESP_OK, ESP_ERR_NOT_FOUND, ESP_ERR_NO_MEM, ESP_ERR_TIMEOUT.
+   */
+  esp_err_t synapse_event_subscriptions_remove_pattern(const char *pattern, struct module_t *module);
+
+  /**
+   * @brief Returns the number of pattern subscriptions and the size of the compiled trie.
+   */
+  void synapse_event_subscriptions_get_pattern_stats(uint32_t *patterns_out, uint32_t *nodes_out, uint32_t *bytes_out);
+
+  /**
+   * @brief Returns the statically routed modules of an event, or NULL if there are none.
+   * @details Binary search over the sealed static table.
+   * @note Must be called inside a read-side section.
+   */
+  const event_subscriber_snapshot_t *synapse_event_subscriptions_get_static(synapse_event_id_t event_id);
+
+  /**
+   * @brief Replaces the static routing table (NULL removes it) and waits for the grace period.
+   * @details The store takes ownership of `table` in every case: if it cannot be
+   *          published (ESP_FAIL, or ESP_ERR_TIMEOUT on the writer mutex) it is
+   *          freed here. Once published it is never freed by the caller, even if
+   *          the grace period for the old table fails. The old table is freed
+   *          once no dispatcher can still see it, so its modules may be freed afterwards.
+   * @return ESP_OK, ESP_FAIL if not initialized, ESP_ERR_TIMEOUT, or the grace-period
+   *         result of `synapse_event_subscriptions_remove()` when an old table was replaced.
+   */
+  esp_err_t synapse_event_subscriptions_set_static(event_static_table_t *table);
+
+  /**
+   * @brief Measures the RAM used by the subscription store (see `synapse_event_bus_get_memory_stats()`).
+   * @return ESP_OK, ESP_FAIL if not initialized, or ESP_ERR_TIMEOUT.
+   */
+  esp_err_t synapse_event_subscriptions_get_memory_stats(synapse_event_memory_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SYNAPSE_EVENT_SUBSCRIPTION_INTERNAL_H
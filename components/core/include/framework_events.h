@@ -1,6 +1,8 @@
 #ifndef FRAMEWORK_EVENTS_H
 #define FRAMEWORK_EVENTS_H
 
+#include <stdint.h>
+
 /**
  * @file framework_events.h
  * @brief Defines standardized, framework-wide event identifiers.
@@ -63,7 +65,67 @@
 /**
  * @brief Published by the Service Locator whenever a service changes its state.
  * @details The payload should be of type synapse_service_status_payload_t.
+ *          It is posted inline, so handlers receive a borrowed wrapper and must
+ *          copy the payload if they need it after `handle_event` returns.
  */
 #define SYNAPSE_EVENT_SERVICE_STATUS_CHANGED "SERVICE_STATUS_CHANGED"
 
+// =========================================================================
+//                      Interned Event IDs
+// =========================================================================
+
+/**
+ * @brief Compact, interned identifier of an event name.
+ * @details The Event Bus maps every event name to a dense `uint16_t` ID once.
+ *          Posting and dispatching by ID needs no heap allocation and no string
+ *          comparison. See `synapse_event_bus_intern()`.
+ */
+typedef uint16_t synapse_event_id_t;
+
+/**
+ * @brief Returned when an event name cannot be resolved to an ID.
+ */
+#define SYNAPSE_EVENT_ID_INVALID ((synapse_event_id_t)0xFFFF)
+
+/**
+ * @brief X-macro list of the framework events whose IDs are fixed at build time.
+ * @details Each entry is `X(ID_SUFFIX, EVENT_NAME)`. The Event Bus pre-interns
+ *          these names during initialization in exactly this order, so
+ *          `SYNAPSE_EVENT_ID_<ID_SUFFIX>` can be used without a runtime lookup.
+ *          New framework events must be appended to the end of the list.
+ */
+#define SYNAPSE_FRAMEWORK_EVENT_LIST(X)                                      \
+    X(EXECUTE_COMMAND_STRING, SYNAPSE_EVENT_EXECUTE_COMMAND_STRING)          \
+    X(SYSTEM_START_COMPLETE, SYNAPSE_EVENT_SYSTEM_START_COMPLETE)            \
+    X(CONFIG_UPDATED, SYNAPSE_EVENT_CONFIG_UPDATED)                          \
+    X(MODULE_ENABLED, SYNAPSE_EVENT_MODULE_ENABLED)                          \
+    X(MODULE_DISABLED, SYNAPSE_EVENT_MODULE_DISABLED)                        \
+    X(WIFI_STATUS_READY, SYNAPSE_EVENT_WIFI_STATUS_READY)                    \
+    X(DEVICE_INFO_READY, SYNAPSE_EVENT_DEVICE_INFO_READY)                    \
+    X(SELF_TEST_REPORT_READY, SYNAPSE_EVENT_SELF_TEST_REPORT_READY)          \
+    X(AGGREGATED_SENSOR_REPORT, SYNAPSE_EVENT_AGGREGATED_SENSOR_REPORT)      \
+    X(SECURITY_STATUS_READY, SYNAPSE_EVENT_SECURITY_STATUS_READY)            \
+    X(RELAY_STATE_CHANGED, SYNAPSE_EVENT_RELAY_STATE_CHANGED)                \
+    X(WATCHDOG_CHECK_TICK, SYNAPSE_EVENT_WATCHDOG_CHECK_TICK)                \
+    X(HEARTBEAT_MISSED, SYNAPSE_EVENT_HEARTBEAT_MISSED)                      \
+    X(WATCHDOG_ALL_OK, SYNAPSE_EVENT_WATCHDOG_ALL_OK)                        \
+    X(BUTTON_PRESSED, SYNAPSE_EVENT_BUTTON_PRESSED)                          \
+    X(CONNECTIVITY_ESTABLISHED, SYNAPSE_EVENT_CONNECTIVITY_ESTABLISHED)      \
+    X(CONNECTIVITY_LOST, SYNAPSE_EVENT_CONNECTIVITY_LOST)                    \
+    X(SYSTEM_SHUTDOWN_REQUESTED, SYNAPSE_EVENT_SYSTEM_SHUTDOWN_REQUESTED)    \
+    X(SERVICE_STATUS_CHANGED, SYNAPSE_EVENT_SERVICE_STATUS_CHANGED)
+
+/**
+ * @brief Build-time IDs of the framework events.
+ * @details ID 0 is reserved for the wildcard subscription (`"*"`).
+ */
+enum
+{
+    SYNAPSE_EVENT_ID_WILDCARD = 0,
+#define SYNAPSE_EVENT_ID_ENUM_ENTRY(id_suffix, event_name) SYNAPSE_EVENT_ID_##id_suffix,
+    SYNAPSE_FRAMEWORK_EVENT_LIST(SYNAPSE_EVENT_ID_ENUM_ENTRY)
+#undef SYNAPSE_EVENT_ID_ENUM_ENTRY
+    SYNAPSE_EVENT_ID_FRAMEWORK_COUNT /**< @brief The first ID available for runtime-interned names. */
+};
+
 #endif // FRAMEWORK_EVENTS_H
\ No newline at end of file
@@ -50,6 +50,16 @@ extern "C" {
    */
   esp_err_t synapse_promise_reject(promise_handle_t handle, void *error_data, void (*free_fn)(void *));
 
+  /**
+   * @brief Discards a pending promise without invoking its callbacks.
+   * @details For providers whose operation failed to start after the promise
+   *          was created (e.g. the request event could not be posted). The
+   *          handle must not be used afterwards.
+   * @param[in] handle The handle of the promise to discard.
+   * @return ESP_OK, ESP_ERR_INVALID_ARG, or ESP_ERR_INVALID_STATE if the promise is already settled.
+   */
+  esp_err_t synapse_promise_cancel(promise_handle_t handle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -3,8 +3,13 @@
  * @brief Framework-ის სერვის ლოკატორის საჯარო API
  *
  * @author Giorgi Magradze
- * @date 2025-09-12
- * @version 2.0
+ * @date 2025-10-10
+ * @version 2.1
+ * @details რეესტრი ჰეშირებულია სახელით (O(1) მოძიება) და იტევს
+ *          `CONFIG_SYNAPSE_MAX_SERVICES` სერვისს. ცხელი გზებისთვის (hot paths)
+ *          `synapse_service_resolve()` აბრუნებს token-ს, რომლის გამოყენებაც
+ *          mutex-ს არ საჭიროებს და რომელიც სერვისის ხელახალი რეგისტრაციისას
+ *          ავტომატურად ძველდება.
  */
 
 #ifndef SYNAPSE_SERVICE_LOCATOR_H
@@ -13,6 +18,8 @@
 #include "service_types.h"
 #include "service_status.h"
 #include "esp_err.h"
+#include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -21,6 +28,24 @@ extern "C"
 
   typedef void *service_handle_t;
 
+  /**
+   * @brief სერვისის ქეშირებადი მისამართი (token).
+   * @details ინახავს რეესტრის სლოტის ინდექსსა და თაობას (generation). თაობა
+   *          იცვლება სერვისის ყოველი რეგისტრაციისა და გაუქმებისას, ამიტომ token
+   *          ვალიდურია მხოლოდ იმ რეგისტრაციისთვის, რომლისთვისაც მიიღეს.
+   *          ნულებით ინიციალიზებული token (მაგ. `static` ცვლადი) ცარიელია.
+   */
+  typedef struct
+  {
+    uint16_t slot;       /**< @brief რეესტრის სლოტის ინდექსი. */
+    uint32_t generation; /**< @brief სლოტის თაობა `resolve`-ის მომენტში (კენტი - ვალიდური). */
+  } synapse_service_token_t;
+
+  /**
+   * @brief ცარიელი token-ის ინიციალიზატორი.
+   */
+#define SYNAPSE_SERVICE_TOKEN_INVALID ((synapse_service_token_t){ .slot = 0, .generation = 0 })
+
   esp_err_t synapse_service_locator_init(void);
 
   /**
@@ -76,6 +101,56 @@ extern "C"
 
   service_handle_t synapse_service_get(const char *service_name);
 
+  /**
+   * @brief ეძებს სერვისს სახელით და აბრუნებს მის token-ს.
+   * @details token-ის შენახვა შეიძლება (მაგ. მოდულის `private_data`-ში ან `static`
+   *          ცვლადში) და შემდეგ `synapse_service_token_get()`-ით გამოყენება
+   *          mutex-ისა და სახელით ძებნის გარეშე. `synapse_service_get()`-ისგან
+   *          განსხვავებით, ვერ პოვნისას WARN ლოგს არ წერს.
+   *
+   * @param[in] service_name სერვისის სახელი.
+   * @param[out] token_out token; შეცდომისას - ცარიელი.
+   * @return esp_err_t
+   * @retval ESP_OK სერვისი ნაპოვნია.
+   * @retval ESP_ERR_NOT_FOUND სერვისი რეგისტრირებული არ არის.
+   * @retval ESP_ERR_INVALID_ARG არასწორი არგუმენტი.
+   * @retval ESP_ERR_TIMEOUT რეესტრის mutex-ის დაკავება ვერ მოხერხდა.
+   */
+  esp_err_t synapse_service_resolve(const char *service_name, synapse_service_token_t *token_out);
+
+  /**
+   * @brief აბრუნებს token-ის სერვისის handle-ს, mutex-ის გარეშე.
+   * @details რამდენიმე ატომური წაკითხვაა და ISR-იდანაც უსაფრთხოა. თუ სერვისი
+   *          მას შემდეგ გაუქმდა ან ხელახლა დარეგისტრირდა, აბრუნებს NULL-ს - ამ
+   *          შემთხვევაში გამოიძახეთ `synapse_service_resolve()` თავიდან (ან
+   *          გამოიყენეთ `synapse_service_get_cached()`).
+   * @note ისევე როგორც `synapse_service_get()`-ის შედეგი, handle-ის სიცოცხლეს
+   *       token არ ახანგრძლივებს: სერვისი შეიძლება გაუქმდეს დაბრუნებისთანავე.
+   * @param[in] token `synapse_service_resolve()`-ის შედეგი.
+   * @return handle, ან NULL, თუ token ცარიელია ან მოძველებულია.
+   */
+  service_handle_t synapse_service_token_get(const synapse_service_token_t *token);
+
+  /**
+   * @brief ამოწმებს, ისევ ვალიდურია თუ არა token (mutex-ის გარეშე).
+   */
+  static inline bool synapse_service_token_is_valid(const synapse_service_token_t *token)
+  {
+    return synapse_service_token_get(token) != NULL;
+  }
+
+  /**
+   * @brief აბრუნებს სერვისს ქეშირებული token-ით; მოძველების შემთხვევაში ხელახლა ეძებს.
+   * @details ტიპური გამოყენება ცხელ გზაზე:
+   *          `static synapse_service_token_t s_mqtt;`
+   *          `mqtt_api_t *api = synapse_service_get_cached("main_mqtt", &s_mqtt);`
+   *          ვალიდური token-ისთვის mutex არ იღება.
+   * @param[in] service_name სერვისის სახელი (გამოიყენება მხოლოდ ხელახალი ძებნისას).
+   * @param[in,out] token ქეში; ხელახალი ძებნისას ახლდება.
+   * @return handle, ან NULL, თუ სერვისი რეგისტრირებული არ არის.
+   */
+  service_handle_t synapse_service_get_cached(const char *service_name, synapse_service_token_t *token);
+
   esp_err_t synapse_service_get_type(const char *service_name, synapse_service_type_t *out_service_type);
 
   service_handle_t synapse_service_lookup_by_type(synapse_service_type_t service_type);
@@ -62,9 +62,13 @@ extern "C" {
 
 #include "logging.h"            // Provides the essential macro for logging (DEFINE_COMPONENT_TAG).
 #include "event_data_wrapper.h" // For safe, reference-counted management of event data (synapse_event_data_*).
+#include "synapse_pool.h"       // For fixed-block allocation of event payloads (synapse_pool_*, SYNAPSE_POOL_NEW).
+#include "synapse_buffer.h"     // For shared, reference-counted byte buffers and zero-copy slices (synapse_buffer_*).
 #include "module_helpers.h"     // Provides standard, reusable implementations for enable/disable/get_status.
 #include "module_factory.h"     // For dynamically creating modules at runtime (synapse_module_create).
 #include "module_registry.h"    // For accessing the module registry (synapse_module_registry_*).
+#include "synapse_trace.h"      // For the core binary trace recorder (synapse_trace_*).
+#include "event_capture.h"      // For Event Bus stream capture and replay (synapse_event_capture_*, synapse_event_replay_*).
 
 // --- For Service Providers Only ---
 // The following header is intended for modules that PROVIDE promise-based asynchronous services.
@@ -0,0 +1,174 @@
+/**
+ * @file synapse_buffer.h
+ * @brief Reference-counted, უცვლელი ბაიტების ბუფერი და მისი zero-copy ნაჭრები (slices).
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-10-09
+ * @details `synapse_buffer_t` ერთხელ ივსება (შექმნისას) და შემდეგ მხოლოდ იკითხება,
+ *          ამიტომ მისი გაზიარება რამდენიმე task-ს შორის ლოკს არ საჭიროებს.
+ *          სიცოცხლის ხანგრძლივობას მართავს ატომური reference counter - ბოლო
+ *          `release` ათავისუფლებს მეხსიერებას.
+ *
+ *          `synapse_buffer_slice_t` არის მნიშვნელობით გადასაცემი `{buffer, offset, length}`
+ *          წყვილი, რომელიც ფლობს ერთ reference-ს ბუფერზე. ქვე-ნაჭრის აღება მონაცემებს
+ *          არ აკოპირებს - ის მხოლოდ ზრდის მრიცხველს. ასე MQTT publisher-ს, logger-სა და
+ *          storage sink-ს შეუძლიათ ერთი და იმავე JSON-ის სხვადასხვა ნაწილის შენახვა ან
+ *          გადაგზავნა დუბლირების გარეშე.
+ *
+ *          ბუფერის თავი (header) და პატარა მონაცემები ერთ ბლოკში გამოიყოფა
+ *          `synapse_pool`-იდან; დიდი ბუფერები ავტომატურად heap-ზე გადადის.
+ */
+
+#ifndef SYNAPSE_BUFFER_H
+#define SYNAPSE_BUFFER_H
+
+#include "esp_err.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief გაუმჭვირვალე (opaque) ბუფერის ტიპი.
+ */
+typedef struct synapse_buffer_t synapse_buffer_t;
+
+/**
+ * @brief ბუფერის ნაჭერი: ფლობს ერთ reference-ს `buffer`-ზე.
+ * @details ცარიელი ნაჭერი (`buffer == NULL`) ვალიდურია და არაფერს ფლობს.
+ *          სტრუქტურის უბრალო კოპირება reference-ს არ ზრდის - მეორე მფლობელისთვის
+ *          გამოიყენეთ `synapse_buffer_slice_sub()`.
+ */
+typedef struct
+{
+    synapse_buffer_t *buffer; /**< @brief ბუფერი, რომელზეც ნაჭერი ფლობს reference-ს (ან NULL). */
+    uint32_t offset;          /**< @brief ნაჭრის დასაწყისი ბუფერის მონაცემებში. */
+    uint32_t length;          /**< @brief ნაჭრის სიგრძე ბაიტებში. */
+} synapse_buffer_slice_t;
+
+/**
+ * @brief ცარიელი ნაჭრის ინიციალიზატორი.
+ */
+#define SYNAPSE_BUFFER_SLICE_EMPTY ((synapse_buffer_slice_t){ .buffer = NULL, .offset = 0, .length = 0 })
+
+/**
+ * @brief ბუფერების მრიცხველები (იხ. `synapse_buffer_get_stats()`).
+ * @details მრიცხველები იცვლება მხოლოდ ბუფერის შექმნისა და გათავისუფლებისას -
+ *          ნაჭრის აღება დამატებით ატომურ ოპერაციას არ ჯდება.
+ */
+typedef struct
+{
+    uint32_t live_buffers; /**< @brief ამჟამად ცოცხალი ბუფერები. */
+    uint32_t live_bytes;   /**< @brief ცოცხალი ბუფერების მონაცემების ჯამური ზომა. */
+    uint32_t live_peak;    /**< @brief `live_bytes`-ის მაქსიმუმი ბოლო reset-ის შემდეგ. */
+    uint32_t created;      /**< @brief შექმნილი ბუფერები ბოლო reset-ის შემდეგ. */
+} synapse_buffer_stats_t;
+
+/**
+ * @brief ქმნის ბუფერს `length` ბაიტით, რომელიც გამომძახებელმა უნდა შეავსოს.
+ * @details `*data_out` ჩაწერადია მხოლოდ ბუფერის გაზიარებამდე (ნაჭრის აღებამდე ან
+ *          ივენთით გაგზავნამდე). მონაცემების ბოლოს ყოველთვის ემატება '\0', რომელიც
+ *          `length`-ში არ ითვლება - ასე სტრიქონის ბუფერი პირდაპირ C სტრიქონადაც იკითხება.
+ * @param[in] length მონაცემების ზომა ბაიტებში.
+ * @param[out] buffer_out შექმნილი ბუფერი (reference count = 1).
+ * @param[out] data_out ჩასაწერი მეხსიერება (შეიძლება იყოს NULL).
+ * @return ESP_OK, ESP_ERR_INVALID_ARG ან ESP_ERR_NO_MEM.
+ */
+esp_err_t synapse_buffer_create(size_t length, synapse_buffer_t **buffer_out, uint8_t **data_out);
+
+/**
+ * @brief ქმნის ბუფერს `data`-ს ასლით.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG ან ESP_ERR_NO_MEM.
+ */
+esp_err_t synapse_buffer_copy(const void *data, size_t length, synapse_buffer_t **buffer_out);
+
+/**
+ * @brief ქმნის ბუფერს უკვე გამოყოფილი მეხსიერების საფუძველზე, კოპირების გარეშე.
+ * @details ბუფერი იღებს `data`-ს ფლობას: წარმატების შემთხვევაში ის თავისუფლდება
+ *          `free_fn(data)`-ით ბოლო `release`-ისას. ტიპური გამოყენება -
+ *          `cJSON_PrintUnformatted()`-ის შედეგი `free`-ით. შეცდომისას `data` კვლავ
+ *          გამომძახებლის საკუთრებაა.
+ * @param[in] data მონაცემები (გაზიარების შემდეგ აღარ უნდა შეიცვალოს).
+ * @param[in] length მონაცემების ზომა ბაიტებში.
+ * @param[in] free_fn `data`-ს გამათავისუფლებელი ფუნქცია (NULL - სტატიკური მონაცემები).
+ * @param[out] buffer_out შექმნილი ბუფერი (reference count = 1).
+ * @return ESP_OK, ESP_ERR_INVALID_ARG ან ESP_ERR_NO_MEM.
+ */
+esp_err_t synapse_buffer_adopt(void *data, size_t length, void (*free_fn)(void *data), synapse_buffer_t **buffer_out);
+
+/**
+ * @brief ზრდის reference counter-ს. გამომძახებელი უკვე უნდა ფლობდეს reference-ს.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG ან ESP_ERR_INVALID_STATE.
+ */
+esp_err_t synapse_buffer_acquire(synapse_buffer_t *buffer);
+
+/**
+ * @brief ამცირებს reference counter-ს; 0-ზე ათავისუფლებს ბუფერს. NULL იგნორირებულია.
+ * @return ESP_OK ან ESP_ERR_INVALID_STATE (counter უარყოფითი გახდა).
+ */
+esp_err_t synapse_buffer_release(synapse_buffer_t *buffer);
+
+/**
+ * @brief აბრუნებს ბუფერის მონაცემებს (NULL ბუფერისთვის NULL).
+ */
+const uint8_t *synapse_buffer_data(const synapse_buffer_t *buffer);
+
+/**
+ * @brief აბრუნებს ბუფერის ზომას ბაიტებში (NULL ბუფერისთვის 0).
+ */
+size_t synapse_buffer_length(const synapse_buffer_t *buffer);
+
+/**
+ * @brief იღებს ბუფერის ნაჭერს კოპირების გარეშე.
+ * @details ნაჭერი იღებს საკუთარ reference-ს; გამომძახებლის reference ხელუხლებელი რჩება.
+ *          `length == SIZE_MAX` ნიშნავს "ბუფერის ბოლომდე".
+ * @param[in] buffer წყარო ბუფერი.
+ * @param[in] offset ნაჭრის დასაწყისი.
+ * @param[in] length ნაჭრის სიგრძე.
+ * @param[out] slice_out შედეგი; შეცდომისას - ცარიელი ნაჭერი.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG ან ESP_ERR_INVALID_SIZE (დიაპაზონი ბუფერს სცდება).
+ */
+esp_err_t synapse_buffer_slice(synapse_buffer_t *buffer, size_t offset, size_t length, synapse_buffer_slice_t *slice_out);
+
+/**
+ * @brief იღებს არსებული ნაჭრის ქვე-ნაჭერს (offset ითვლება `slice`-ის დასაწყისიდან).
+ * @details `synapse_buffer_slice_sub(s, 0, SIZE_MAX, &copy)` ქმნის იმავე დიაპაზონის
+ *          მეორე, დამოუკიდებელ მფლობელს - მაგალითად, ივენთის payload-იდან ნაჭრის
+ *          შესანახად handler-ის დასრულების შემდეგაც.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG ან ESP_ERR_INVALID_SIZE.
+ */
+esp_err_t synapse_buffer_slice_sub(const synapse_buffer_slice_t *slice, size_t offset, size_t length,
+                                   synapse_buffer_slice_t *slice_out);
+
+/**
+ * @brief ათავისუფლებს ნაჭრის reference-ს და ნაჭერს ცარიელს ხდის. ცარიელი ნაჭერი იგნორირებულია.
+ */
+void synapse_buffer_slice_release(synapse_buffer_slice_t *slice);
+
+/**
+ * @brief აბრუნებს ნაჭრის პირველი ბაიტის მისამართს (ცარიელი ნაჭრისთვის NULL).
+ * @note ნაჭერი '\0'-ით არ მთავრდება, თუ ის ბუფერის ბოლომდე არ აღწევს - გამოიყენეთ `length`.
+ */
+static inline const uint8_t *synapse_buffer_slice_data(const synapse_buffer_slice_t *slice)
+{
+    return (slice && slice->buffer) ? synapse_buffer_data(slice->buffer) + slice->offset : NULL;
+}
+
+/**
+ * @brief კითხულობს ბუფერების მრიცხველებს.
+ * @return ESP_OK ან ESP_ERR_INVALID_ARG.
+ */
+esp_err_t synapse_buffer_get_stats(synapse_buffer_stats_t *stats);
+
+/**
+ * @brief ანულებს `created`-ს; `live_peak` ხდება მიმდინარე `live_bytes`.
+ */
+void synapse_buffer_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SYNAPSE_BUFFER_H
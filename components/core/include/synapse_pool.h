@@ -0,0 +1,104 @@
+/**
+ * @file synapse_pool.h
+ * @brief ფიქსირებული ზომის ბლოკების აუზი (slab) ივენთების wrapper-ებისა და payload-ებისთვის.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-10-08
+ * @details ხშირად გამოყოფილი პატარა ობიექტები (`event_data_wrapper_t`,
+ *          `event_payloads.h`-ის სტრუქტურები) heap-ის ნაცვლად იღებენ ბლოკს
+ *          სტატიკური აუზიდან. აუზი შედგება რამდენიმე ზომის კლასისგან (small,
+ *          medium, large - Kconfig); თითოეული კლასი არის ერთი უწყვეტი მასივი და
+ *          lock-free სია თავისუფალი ბლოკებისა. `alloc`/`free` არის O(1) - ერთი
+ *          ატომური compare-and-swap, ლოკისა და heap-ის გარეშე - ამიტომ აუზის ბლოკის
+ *          გათავისუფლება ISR-იდანაც დასაშვებია.
+ *
+ *          აუზი არ ფრაგმენტდება: ბლოკები მხოლოდ თავის კლასს უბრუნდება. თუ შესაბამისი
+ *          კლასი ამოწურულია, გამოიყენება შემდეგი დიდი კლასი, ბოლოს კი ჩვეულებრივი
+ *          heap - ეს შემთხვევები ითვლება (`exhausted`, `heap_fallbacks`) და
+ *          მიუთითებს, რომელი კლასი უნდა გაიზარდოს.
+ */
+
+#ifndef SYNAPSE_POOL_H
+#define SYNAPSE_POOL_H
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief ერთი ზომის კლასის მდგომარეობა და მრიცხველები.
+ */
+typedef struct
+{
+    uint16_t block_size;     /**< @brief ბლოკის ზომა ბაიტებში (8-ის ჯერადი). */
+    uint16_t block_count;    /**< @brief ბლოკების რაოდენობა კლასში. */
+    uint16_t in_use;         /**< @brief ამჟამად გამოყოფილი ბლოკები. */
+    uint16_t high_watermark; /**< @brief `in_use`-ის მაქსიმუმი ბოლო reset-ის შემდეგ. */
+    uint32_t allocs;         /**< @brief ამ კლასიდან გაცემული ბლოკები. */
+    uint32_t exhausted;      /**< @brief მოთხოვნები, რომლებიც ამ კლასს ეკუთვნოდა, მაგრამ თავისუფალი ბლოკი არ იყო. */
+} synapse_pool_stats_t;
+
+/**
+ * @brief გამოყოფს `size` ბაიტს აუზიდან.
+ * @details ირჩევს უმცირეს კლასს, რომელშიც `size` ეტევა. ამოწურული კლასის
+ *          შემთხვევაში ცდის უფრო დიდ კლასებს, შემდეგ `malloc()`-ს. შედეგი
+ *          8 ბაიტზეა გასწორებული და ყოველთვის `synapse_pool_free()`-ით თავისუფლდება.
+ * @param[in] size საჭირო ზომა ბაიტებში.
+ * @return ბლოკის მაჩვენებელი, ან NULL, თუ არც აუზში და არც heap-ში ადგილი არ არის.
+ */
+void *synapse_pool_alloc(size_t size);
+
+/**
+ * @brief იგივეა, რაც `synapse_pool_alloc()`, ოღონდ ბლოკს ნულებით ავსებს.
+ */
+void *synapse_pool_calloc(size_t size);
+
+/**
+ * @brief აბრუნებს ბლოკს აუზში.
+ * @details მაჩვენებლის მისამართით ადგენს კლასს; აუზის გარეთ გამოყოფილ მეხსიერებას
+ *          (heap fallback ან ჩვეულებრივი `malloc()`) `free()`-ით ათავისუფლებს, ამიტომ
+ *          ფუნქცია გამოდგება ნებისმიერი payload-ის `free_fn`-ად. აუზის ბლოკისთვის
+ *          ISR-safe. NULL იგნორირებულია.
+ * @param[in] ptr გასათავისუფლებელი მაჩვენებელი.
+ */
+void synapse_pool_free(void *ptr);
+
+/**
+ * @brief ტიპიზებული გამოყოფა: `synapse_button_payload_t *p = SYNAPSE_POOL_NEW(synapse_button_payload_t);`
+ */
+#define SYNAPSE_POOL_NEW(type) ((type *)synapse_pool_calloc(sizeof(type)))
+
+/**
+ * @brief აბრუნებს ზომის კლასების რაოდენობას (0, თუ `CONFIG_SYNAPSE_POOL_ENABLE` გამორთულია).
+ */
+uint8_t synapse_pool_get_class_count(void);
+
+/**
+ * @brief კითხულობს ერთი კლასის მრიცხველებს.
+ * @param[in] class_index კლასის ინდექსი, 0 .. `synapse_pool_get_class_count()` - 1 (ზომის ზრდით).
+ * @param[out] stats დანიშნულების სტრუქტურა.
+ * @return ESP_OK ან ESP_ERR_INVALID_ARG.
+ */
+esp_err_t synapse_pool_get_stats(uint8_t class_index, synapse_pool_stats_t *stats);
+
+/**
+ * @brief აბრუნებს heap-ზე გადამისამართებული გამოყოფების რაოდენობას (ზედმეტად დიდი
+ *        ზომა ან ყველა შესაბამისი კლასის ამოწურვა).
+ */
+uint32_t synapse_pool_get_heap_fallbacks(void);
+
+/**
+ * @brief ანულებს მრიცხველებს; `high_watermark` ხდება მიმდინარე `in_use`.
+ */
+void synapse_pool_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SYNAPSE_POOL_H
@@ -0,0 +1,130 @@
+/**
+ * @file synapse_trace.h
+ * @brief ბირთვის ბინარული trace ჩამწერი (Event Bus, Task Pool, Promise Manager).
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-09-27
+ * @details ბირთვი მუდმივად წერს მოკლე (16 ბაიტიან) ჩანაწერებს წრიულ ბუფერში:
+ *          ივენთის გამოქვეყნება, რიგიდან ამოღება, handler-ის დაწყება/დასრულება,
+ *          Task Pool-ის job-ის დაწყება/დასრულება და Promise-ის შესრულება.
+ *          ჩაწერა არის ერთი ატომური ინდექსის გაზრდა და სტრუქტურის შევსება -
+ *          ლოკის, ლოგირებისა და heap-ის გარეშე, ამიტომ ის ISR-იდანაც დასაშვებია.
+ *
+ *          ბუფერის ამოღება შესაძლებელია `synapse_trace_dump()`-ით (კონსოლზე,
+ *          ტექსტურ ფორმატში) ან Command Router-ის `trace dump` ბრძანებით.
+ *          ჰოსტზე `tools/synapse_trace_decode.py` გარდაქმნის მას Chrome/Perfetto
+ *          trace JSON-ად.
+ */
+
+#ifndef SYNAPSE_TRACE_H
+#define SYNAPSE_TRACE_H
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief ჩანაწერის ტიპი.
+ * @details მნიშვნელობები ბინარული ფორმატის ნაწილია - ახალი ტიპები მხოლოდ ბოლოში დაამატეთ.
+ */
+typedef enum
+{
+    SYNAPSE_TRACE_EVENT_POST = 1,        /**< @brief ივენთი დაემატა რიგს. id = event ID, arg = რიგის შევსება. */
+    SYNAPSE_TRACE_EVENT_DEQUEUE = 2,     /**< @brief დისპეტჩერმა ამოიღო ივენთი. id = event ID, arg = დაყოვნება (µs). */
+    SYNAPSE_TRACE_HANDLER_ENTER = 3,     /**< @brief მოდულის `handle_event` დაიწყო. id = event ID, arg = მოდული. */
+    SYNAPSE_TRACE_HANDLER_EXIT = 4,      /**< @brief მოდულის `handle_event` დასრულდა. id = event ID, arg = მოდული. */
+    SYNAPSE_TRACE_JOB_START = 5,         /**< @brief Task Pool-ის job დაიწყო. arg = job-ის ფუნქცია. */
+    SYNAPSE_TRACE_JOB_END = 6,           /**< @brief Task Pool-ის job დასრულდა. arg = job-ის ფუნქცია. */
+    SYNAPSE_TRACE_PROMISE_SETTLE = 7,    /**< @brief Promise შესრულდა. id = 1 (resolve) / 0 (reject), arg = promise ID. */
+    SYNAPSE_TRACE_PROMISE_CB_START = 8,  /**< @brief Promise-ის then/catch callback დაიწყო. arg = promise ID. */
+    SYNAPSE_TRACE_PROMISE_CB_END = 9,    /**< @brief Promise-ის then/catch callback დასრულდა. arg = promise ID. */
+    SYNAPSE_TRACE_EVENT_DROP = 10,       /**< @brief ივენთი დაიკარგა გადავსების გამო. id = event ID. */
+} synapse_trace_type_t;
+
+/**
+ * @brief ერთი trace ჩანაწერი (16 ბაიტი, little-endian).
+ */
+typedef struct
+{
+    uint32_t timestamp; /**< @brief CPU-ს ციკლების მთვლელი (ბირთვზე დამოკიდებული, 32 ბიტზე გადატვირთვადი). */
+    uint8_t type;       /**< @brief `synapse_trace_type_t`. */
+    uint8_t core;       /**< @brief ბირთვი, რომელზეც ჩანაწერი გაკეთდა. */
+    uint16_t id;        /**< @brief ტიპზე დამოკიდებული იდენტიფიკატორი (ჩვეულებრივ event ID). */
+    uint32_t arg;       /**< @brief ტიპზე დამოკიდებული არგუმენტი. */
+    uint32_t task;      /**< @brief მიმდინარე ტასკის handle (ქვედა 32 ბიტი). */
+} synapse_trace_record_t;
+
+_Static_assert(sizeof(synapse_trace_record_t) == 16, "synapse_trace_record_t must stay 16 bytes");
+
+#if defined(CONFIG_SYNAPSE_TRACE_ENABLE)
+
+/**
+ * @brief წერს ერთ ჩანაწერს წრიულ ბუფერში. ISR-safe.
+ * @note პირდაპირ ნაკლებად გამოიყენება - ბირთვის კოდი იყენებს `SYNAPSE_TRACE()` მაკროს.
+ */
+void synapse_trace_record(synapse_trace_type_t type, uint16_t id, uint32_t arg);
+
+/**
+ * @brief ჩაწერის მაკრო: გამორთული `CONFIG_SYNAPSE_TRACE_ENABLE`-ისას არაფერში კომპილირდება.
+ */
+#define SYNAPSE_TRACE(type, id, arg) synapse_trace_record((type), (uint16_t)(id), (uint32_t)(arg))
+
+#else
+
+#define SYNAPSE_TRACE(type, id, arg) \
+    do                               \
+    {                                \
+    } while (0)
+
+#endif // CONFIG_SYNAPSE_TRACE_ENABLE
+
+/**
+ * @brief რთავს ან აჩერებს ჩაწერას (ნაგულისხმევად ჩართულია).
+ * @return ESP_OK, ან ESP_ERR_NOT_SUPPORTED თუ trace კომპილაციიდან გამორთულია.
+ */
+esp_err_t synapse_trace_set_enabled(bool enabled);
+
+/**
+ * @brief ასუფთავებს ბუფერს.
+ */
+void synapse_trace_clear(void);
+
+/**
+ * @brief აკოპირებს ბუფერის ჩანაწერებს (უძველესიდან უახლესამდე).
+ * @details კოპირების დროს ჩაწერა დროებით ჩერდება, რათა ჩანაწერები არ გადაიწეროს.
+ * @param[out] records გამოსატანი მასივი.
+ * @param[in] max მასივის ტევადობა; თუ ჩანაწერები მეტია, კოპირდება უახლესი `max`.
+ * @param[out] count_out კოპირებული ჩანაწერების რაოდენობა.
+ * @param[out] lost_out (Optional) გადაწერილი (დაკარგული) ჩანაწერების რაოდენობა ბოლო გასუფთავებიდან.
+ * @return ESP_OK, ESP_ERR_INVALID_ARG ან ESP_ERR_NOT_SUPPORTED.
+ */
+esp_err_t synapse_trace_snapshot(synapse_trace_record_t *records, size_t max, size_t *count_out, uint32_t *lost_out);
+
+/**
+ * @brief ბეჭდავს ბუფერს კონსოლზე ტექსტურ ფორმატში (`SYNTRACE` ხაზები).
+ * @details ფორმატი შეიცავს ივენთებისა და მოდულების სახელების ცხრილს და
+ *          hex-ით კოდირებულ ჩანაწერებს; `tools/synapse_trace_decode.py`
+ *          მას Chrome/Perfetto trace JSON-ად გარდაქმნის.
+ * @return ESP_OK, ESP_ERR_NO_MEM ან ESP_ERR_NOT_SUPPORTED.
+ */
+esp_err_t synapse_trace_dump(void);
+
+/**
+ * @brief არეგისტრირებს `trace` ბრძანებას Command Router-ში, თუ ის სისტემაშია.
+ * @details იძახებს System Manager მოდულების გაშვების შემდეგ. ბრძანება:
+ *          `trace <dump|clear|on|off>`.
+ * @return ESP_OK, ESP_ERR_NOT_FOUND (Command Router არ არის) ან რეგისტრაციის შეცდომა.
+ */
+esp_err_t synapse_trace_register_command(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SYNAPSE_TRACE_H
@@ -1,490 +1,2449 @@
 /**
  * @file event_bus.c
  * @brief Event Bus კომპონენტის იმპლემენტაცია.
- * @version 2.1
+ * @version 2.2
  * @date 2025-06-27
  * @author Giorgi Magradze
  * @details ეს ფაილი შეიცავს Event Bus-ის იმპლემენტაციას, რომელიც ამუშავებს
  *          ასინქრონულ ივენთებს FreeRTOS-ის რიგებისა და ტასკების გამოყენებით.
+ *          გამომწერების სიებს ინახავს `event_subscriptions.c` (უცვლელი snapshot-ები),
+ *          ამიტომ დისპეტჩერიზაცია Mutex-ს არ იყენებს.
  */
 #include "event_bus.h"
 #include "logging.h"
 #include "base_module.h"
 #include "event_data_wrapper.h" // <--- დამატებულია სრული განმარტებისთვის
+#include "event_bus_internal.h"
+#include "event_registry_internal.h"
+#include "event_subscription_internal.h"
+#include "event_pattern_internal.h"
+#include "event_mailbox_internal.h"
+#include "event_scratch_internal.h"
+#include "module_registry.h"
+#include "synapse_pool.h"
+#include "synapse_buffer.h"
+#include "synapse_trace.h"
 #include "framework_config.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 #include "freertos/semphr.h"
 #include "freertos/task.h"
+#include "esp_timer.h"
+#include "cJSON.h"
 #include <string.h>
 #include <stdlib.h>
+#include <stdio.h>
 
 DEFINE_COMPONENT_TAG("EVENT_BUS", SYNAPSE_LOG_COLOR_BLUE);
 
+// --- Kconfig Definitions ---
+#if defined(CONFIG_SYNAPSE_EVENT_CRITICAL_OVERFLOW_DROP_NEWEST)
+#define EVENT_LANE_CRITICAL_OVERFLOW SYNAPSE_EVENT_OVERFLOW_DROP_NEWEST
+#elif defined(CONFIG_SYNAPSE_EVENT_CRITICAL_OVERFLOW_DROP_OLDEST)
+#define EVENT_LANE_CRITICAL_OVERFLOW SYNAPSE_EVENT_OVERFLOW_DROP_OLDEST
+#else
+#define EVENT_LANE_CRITICAL_OVERFLOW SYNAPSE_EVENT_OVERFLOW_BLOCK
+#endif
+
+#if defined(CONFIG_SYNAPSE_EVENT_NORMAL_OVERFLOW_DROP_NEWEST)
+#define EVENT_LANE_NORMAL_OVERFLOW SYNAPSE_EVENT_OVERFLOW_DROP_NEWEST
+#elif defined(CONFIG_SYNAPSE_EVENT_NORMAL_OVERFLOW_DROP_OLDEST)
+#define EVENT_LANE_NORMAL_OVERFLOW SYNAPSE_EVENT_OVERFLOW_DROP_OLDEST
+#else
+#define EVENT_LANE_NORMAL_OVERFLOW SYNAPSE_EVENT_OVERFLOW_BLOCK
+#endif
+
+#if defined(CONFIG_SYNAPSE_EVENT_BULK_OVERFLOW_BLOCK)
+#define EVENT_LANE_BULK_OVERFLOW SYNAPSE_EVENT_OVERFLOW_BLOCK
+#elif defined(CONFIG_SYNAPSE_EVENT_BULK_OVERFLOW_DROP_NEWEST)
+#define EVENT_LANE_BULK_OVERFLOW SYNAPSE_EVENT_OVERFLOW_DROP_NEWEST
+#else
+#define EVENT_LANE_BULK_OVERFLOW SYNAPSE_EVENT_OVERFLOW_DROP_OLDEST
+#endif
+
+#define EVENT_DISPATCH_BATCH_SIZE CONFIG_SYNAPSE_EVENT_DISPATCH_BATCH_SIZE
+#define EVENT_MAX_PATTERN_MATCHES CONFIG_SYNAPSE_EVENT_MAX_PATTERN_MATCHES
+#define EVENT_POST_BATCH_CHUNK 8
+#define EVENT_SPILL_BUFFER_LENGTH CONFIG_SYNAPSE_EVENT_SPILL_BUFFER_LENGTH
+/** @brief ერთი ივენთის მიმღებების მაქსიმუმი: კონკრეტული, სტატიკური, `*` და pattern-ის გამომწერები. */
+#define EVENT_MAX_DELIVERY_TARGETS (3 * CONFIG_SYNAPSE_MAX_SUBSCRIBERS_PER_EVENT + EVENT_MAX_PATTERN_MATCHES)
+
+/** @brief დისპეტჩერების რაოდენობა თითო ზოლზე: per-core რეჟიმში - თითო ბირთვზე ერთი. */
+#ifdef CONFIG_SYNAPSE_EVENT_PER_CORE_DISPATCH
+#define EVENT_LANE_DISPATCHERS portNUM_PROCESSORS
+#else
+#define EVENT_LANE_DISPATCHERS 1
+#endif
+
+/** @brief DROP_OLDEST პოლიტიკისას ჩაწერის მცდელობების ლიმიტი (კონკურენტი მწარმოებლებისთვის). */
+#define EVENT_LANE_DROP_OLDEST_ATTEMPTS 3
+
 // --- შიდა სტრუქტურები ---
 
 /**
  * @internal
- * @brief აღწერს ერთ გამომწერს (მოდულს).
+ * @brief snapshot-ის რომელ ჩანაწერებს მიეწოდოს ივენთი.
  */
-typedef struct {
-    module_t *module; /**< @brief მაჩვენებელი გამომწერ მოდულზე. */
-} event_subscriber_t;
+typedef enum {
+    EVENT_DELIVER_ALL = 0,    /**< @brief ყველას (ჩვეულებრივი `post`). */
+    EVENT_DELIVER_ASYNC_ONLY, /**< @brief მხოლოდ asynchronous გამომწერებს (sync-ებმა `publish_sync`-ში მიიღეს). */
+    EVENT_DELIVER_SYNC_ONLY,  /**< @brief მხოლოდ synchronous გამომწერებს (`publish_sync`-ის კონტექსტში). */
+} event_deliver_mode_t;
 
 /**
  * @internal
- * @brief აღწერს ერთი ივენთის ყველა გამომწერის სიას.
+ * @brief `synapse_event_bus_publish_sync()`-ის მრიცხველები.
  */
 typedef struct {
-    event_subscriber_t subscribers[CONFIG_SYNAPSE_MAX_SUBSCRIBERS_PER_EVENT]; /**< @brief გამომწერების მასივი. */
-    uint8_t count;                                                      /**< @brief გამომწერების მიმდინარე რაოდენობა. */
-} event_subscription_list_t;
+    uint32_t published;       /**< @brief `publish_sync` გამოძახებები. */
+    uint32_t handler_calls;   /**< @brief გამომქვეყნებლის კონტექსტში გამოძახებული handler-ები. */
+    uint32_t forwarded;       /**< @brief ივენთები, რომლებიც asynchronous გამომწერებისთვის რიგშიც ჩაიწერა. */
+    uint32_t failed;          /**< @brief რიგმა უარყო გადაგზავნა. */
+    uint32_t max_dispatch_us; /**< @brief sync handler-ების ყველაზე ხანგრძლივი გამოძახება (ერთ გამოქვეყნებაზე). */
+} event_sync_stats_t;
+
+struct event_lane_t;
 
 /**
  * @internal
- * @brief გამოწერის კვანძი, რომელიც აკავშირებს ივენთის სახელს გამომწერების სიასთან.
- *        გამოიყენება დაკავშირებულ სიაში.
+ * @brief ზოლის ერთი დისპეტჩერი: საკუთარი რიგი, ტასკი და სამუშაო ბუფერი.
+ * @details per-core რეჟიმში ზოლს თითო ბირთვზე ერთი დისპეტჩერი ჰყავს; ივენთი
+ *          მიდის იმ დისპეტჩერთან, რომელსაც მისი partition key ირჩევს.
  */
-typedef struct event_subscription_node_t
-{
-    char *event_name;                            /**< @brief ივენთის უნიკალური სახელი. */
-    event_subscription_list_t subscription_list; /**< @brief ამ ივენთის გამომწერების სია. */
-    struct event_subscription_node_t *next;      /**< @brief მაჩვენებელი შემდეგ კვანძზე სიაში. */
-} event_subscription_node_t;
+typedef struct {
+    struct event_lane_t *lane;               /**< @brief ზოლი, რომელსაც დისპეტჩერი ეკუთვნის. */
+    QueueHandle_t queue;                     /**< @brief დისპეტჩერის რიგი. */
+    TaskHandle_t task;                       /**< @brief დისპეტჩერ-ტასკი. */
+    event_message_t *batch;                  /**< @brief სამუშაო ბუფერი (`EVENT_DISPATCH_BATCH_SIZE` შეტყობინება). */
+    event_scratch_arena_t scratch;           /**< @brief handler-ების დროებითი არენა; ნულდება ყოველი ივენთის შემდეგ. */
+    uint32_t dispatched;                     /**< @brief ამ დისპეტჩერის მიერ დამუშავებული ივენთები. */
+    char task_name[configMAX_TASK_NAME_LEN]; /**< @brief ტასკის სახელი (per-core რეჟიმში ბირთვის ნომრით). */
+} event_dispatcher_t;
 
 /**
  * @internal
- * @brief აღწერს ერთ ივენთს, რომელიც იგზავნება რიგში.
+ * @brief აღწერს ერთ პრიორიტეტულ ზოლს: საკუთარი რიგი(ები), დისპეტჩერ(ებ)ი და სტატისტიკა.
  */
-typedef struct {
-    char *event_name;                   /**< @brief ივენთის სახელი (დინამიურად გამოყოფილი). */
-    event_data_wrapper_t *data_wrapper; /**< @brief მაჩვენებელი ივენთის მონაცემებზე. */
-} event_message_t;
+typedef struct event_lane_t {
+    const char *task_name;                           /**< @brief დისპეტჩერ-ტასკის სახელი. */
+    uint32_t queue_length;                           /**< @brief ერთი დისპეტჩერის რიგის ტევადობა. */
+    UBaseType_t task_priority;                       /**< @brief დისპეტჩერ-ტასკის პრიორიტეტი. */
+    synapse_event_overflow_policy_t overflow_policy; /**< @brief ქცევა სავსე რიგის დროს. */
+    event_dispatcher_t dispatchers[EVENT_LANE_DISPATCHERS]; /**< @brief ზოლის დისპეტჩერები. */
+    uint32_t posted;                                 /**< @brief წარმატებით დამატებული ივენთები. */
+    uint32_t dispatched;                             /**< @brief დამუშავებული ივენთები. */
+    uint32_t dropped;                                /**< @brief დაკარგული ივენთები. */
+    uint32_t dispatch_batches;                       /**< @brief დისპეტჩერის გაღვიძებების რაოდენობა. */
+    uint32_t max_latency_us;                         /**< @brief უდიდესი დაყოვნება რიგში. */
+    uint32_t conflated;                              /**< @brief conflation-ით შერწყმული ივენთები. */
+    uint32_t inline_posted;                          /**< @brief ინლაინ payload-ით დამატებული ივენთები. */
+    uint32_t high_watermark;                         /**< @brief რიგის შევსების მაქსიმუმი. */
+    event_message_t *spill;                          /**< @brief სათადარიგო (spill) ბუფერი - წრიული, `EVENT_SPILL_BUFFER_LENGTH` შეტყობინება. */
+    uint32_t spill_head;                             /**< @brief spill ბუფერის უძველესი შეტყობინების ინდექსი. */
+    uint32_t spill_count;                            /**< @brief spill ბუფერში მყოფი შეტყობინებები. */
+    uint32_t spill_refilling;                        /**< @brief 1, როცა ვინმე spill ბუფერს რიგში აბრუნებს. */
+    portMUX_TYPE spill_lock;                         /**< @brief იცავს spill ბუფერის ინდექსებს. */
+    uint32_t spilled;                                /**< @brief spill ბუფერში გადატანილი ივენთები. */
+    uint32_t spill_high_watermark;                   /**< @brief spill ბუფერის შევსების მაქსიმუმი. */
+#ifdef CONFIG_SYNAPSE_EVENT_LATENCY_HISTOGRAM
+    event_latency_histogram_t latency;               /**< @brief post → handler დაყოვნების ჰისტოგრამა. */
+#endif
+} event_lane_t;
 
 // --- კომპონენტის შიდა ცვლადები ---
 
 /**
  * @internal
- * @brief გამოწერების დაკავშირებული სიის თავი.
+ * @brief პრიორიტეტული ზოლები, ინდექსირებული `synapse_event_priority_t`-ით.
+ */
+static event_lane_t s_lanes[SYNAPSE_EVENT_PRIORITY_MAX] = {
+    [SYNAPSE_EVENT_PRIORITY_CRITICAL] = {
+        .task_name = "evbus_critical",
+        .queue_length = CONFIG_SYNAPSE_EVENT_CRITICAL_QUEUE_LENGTH,
+        .task_priority = CONFIG_SYNAPSE_EVENT_CRITICAL_TASK_PRIORITY,
+        .overflow_policy = EVENT_LANE_CRITICAL_OVERFLOW,
+        .spill_lock = portMUX_INITIALIZER_UNLOCKED,
+    },
+    [SYNAPSE_EVENT_PRIORITY_NORMAL] = {
+        .task_name = "evbus_normal",
+        .queue_length = CONFIG_SYNAPSE_EVENT_QUEUE_LENGTH,
+        .task_priority = CONFIG_SYNAPSE_EVENT_BUS_TASK_PRIORITY,
+        .overflow_policy = EVENT_LANE_NORMAL_OVERFLOW,
+        .spill_lock = portMUX_INITIALIZER_UNLOCKED,
+    },
+    [SYNAPSE_EVENT_PRIORITY_BULK] = {
+        .task_name = "evbus_bulk",
+        .queue_length = CONFIG_SYNAPSE_EVENT_BULK_QUEUE_LENGTH,
+        .task_priority = CONFIG_SYNAPSE_EVENT_BULK_TASK_PRIORITY,
+        .overflow_policy = EVENT_LANE_BULK_OVERFLOW,
+        .spill_lock = portMUX_INITIALIZER_UNLOCKED,
+    },
+};
+
+static bool s_initialized = false;
+
+/** @internal @brief `publish_sync`-ის სტატისტიკა (ატომური მრიცხველები). */
+static event_sync_stats_t s_sync_stats;
+
+/** @internal @brief ზოლების სახელები JSON ანგარიშისთვის. */
+static const char *const s_lane_names[SYNAPSE_EVENT_PRIORITY_MAX] = {
+    [SYNAPSE_EVENT_PRIORITY_CRITICAL] = "critical",
+    [SYNAPSE_EVENT_PRIORITY_NORMAL] = "normal",
+    [SYNAPSE_EVENT_PRIORITY_BULK] = "bulk",
+};
+
+/** @internal @brief სტატისტიკის ფანჯრის დასაწყისი (init ან ბოლო reset), esp_timer µs. */
+static int64_t s_stats_since_us = 0;
+
+#if EVENT_LANE_DISPATCHERS > 1
+/** @brief `module_t::dispatch_slot`-ის მნიშვნელობა მოდულისთვის, რომლის handler-ი პარალელურ გამოძახებებს უძლებს. */
+#define EVENT_MODULE_SLOT_CONCURRENT UINT16_MAX
+
+/**
+ * @internal
+ * @brief მოდულების handler-ების mutex-ები per-core რეჟიმში.
+ * @details დისპეტჩერი მოდულის `handle_event`-ს მისი mutex-ით იძახებს, ამიტომ
+ *          ერთ მოდულს ერთდროულად მხოლოდ ერთი დისპეტჩერი ამუშავებს. მოდული
+ *          სლოტს პირველ მიწოდებაზე იღებს; mutex-ები init-ში იქმნება და
+ *          მოდულის გათავისუფლებას არაფერი რჩება. `CONFIG_SYNAPSE_MAX_MODULES`-ზე
+ *          მეტი მოდულის შემდეგ სლოტები წრიულად მეორდება - ასეთი მოდულები
+ *          ერთმანეთს ელოდებიან, მაგრამ თანმიმდევრობა არ ირღვევა.
+ */
+static SemaphoreHandle_t s_module_locks[CONFIG_SYNAPSE_MAX_MODULES];
+static uint32_t s_module_lock_next = 0;
+#endif
+
+/**
+ * @internal
+ * @brief ერთი ივენთის მიწოდება: read სექციაში შედგენილი მიმღებების სია.
+ * @details handler-ები სიით, read სექციის გარეთ იძახება, ამიტომ grace period-ი
+ *          handler-ების ხანგრძლივობას აღარ ელოდება. სიაში ჩაწერილ მოდულს
+ *          `in_dispatch` ეზრდება და მცირდება მისი გამოძახების (ან გაუქმების)
+ *          შემდეგ - `unsubscribe` სწორედ ამ მრიცხველს ელოდება. ერთი ტასკის
+ *          ჩადგმული მიწოდებები (handler -> `publish_sync`) `outer`-ით არის
+ *          დაკავშირებული, რომ handler-იდან გამოძახებულმა `unsubscribe`-მა ამავე
+ *          ტასკის ჯერ გამოუძახებელი ჩანაწერები გააუქმოს.
  */
-static event_subscription_node_t *subscription_head = NULL;
+typedef struct event_delivery_t
+{
+    struct event_delivery_t *outer;                  /**< @brief ამავე ტასკის გარე მიწოდება ან NULL. */
+    module_t *targets[EVENT_MAX_DELIVERY_TARGETS];   /**< @brief მიმღებები; გაუქმებული ჩანაწერი NULL-ია. */
+    uint16_t count;                                  /**< @brief ჩანაწერების რაოდენობა. */
+    uint16_t current;                                /**< @brief ჩანაწერი, რომლის handler-იც ახლა სრულდება. */
+} event_delivery_t;
 
-static QueueHandle_t event_bus_queue = NULL;
-static SemaphoreHandle_t subscription_mutex = NULL;
+/** @internal @brief მიმდინარე ტასკის ყველაზე შიდა მიწოდება. */
+static __thread event_delivery_t *s_delivery = NULL;
 
 // --- შიდა ფუნქციების წინასწარი დეკლარაცია ---
 static void event_bus_task(void *pvParameters);
-static void remove_subscriber(event_subscription_list_t *sub_list, int index);
-static void dispatch_event_to_subscribers(const event_message_t *msg);
-static event_subscription_node_t *find_subscription_node(const char *event_name, bool create_if_not_found);
+static esp_err_t enqueue_event(event_lane_t *lane, const event_message_t *msg);
+static void destroy_lanes(void);
+static esp_err_t prepare_message(synapse_event_id_t event_id, event_data_wrapper_t *data_wrapper, event_message_t *msg);
+static size_t drain_lane(event_dispatcher_t *dispatcher, event_message_t *messages);
+static uint8_t partition_message(const event_message_t *msg, bool from_isr);
+static QueueHandle_t message_queue(const event_lane_t *lane, const event_message_t *msg);
+static uint32_t lane_pending(const event_lane_t *lane);
+static void deliver_event(const event_message_t *msg);
+static void deliver_to_module(module_t *module, synapse_event_id_t event_id, const char *event_name,
+                              event_data_wrapper_t *data_wrapper, bool counted, bool direct);
+static bool snapshot_contains(const event_subscriber_snapshot_t *snapshot, const module_t *module);
+static void collect_snapshot(event_delivery_t *delivery, const event_subscriber_snapshot_t *snapshot,
+                             const event_subscriber_snapshot_t *skip_a, const event_subscriber_snapshot_t *skip_b,
+                             synapse_event_id_t event_id, const void *payload, event_deliver_mode_t mode,
+                             bool initialized_only);
+static uint32_t run_delivery(event_delivery_t *delivery, synapse_event_id_t event_id, const char *event_name,
+                             event_data_wrapper_t *data_wrapper, bool counted, bool direct);
+static esp_err_t wait_for_module_idle(module_t *module);
+static bool has_async_subscribers(const event_subscriber_snapshot_t *specific, const event_subscriber_snapshot_t *routed,
+                                  const event_subscriber_snapshot_t *wildcard, const event_pattern_trie_t *patterns,
+                                  const char *event_name);
+static esp_err_t subscribe_module(synapse_event_id_t event_id, module_t *module, const synapse_event_filter_t *filter,
+                                  bool sync);
+static esp_err_t subscribe_pattern(const char *pattern, module_t *module);
+static esp_err_t unsubscribe_pattern(const char *pattern, module_t *module);
+static bool conflate_message(event_lane_t *lane, event_message_t *msg);
+static void discard_message(event_message_t *msg);
+static esp_err_t resolve_lane(synapse_event_id_t event_id, synapse_event_priority_t priority, event_lane_t **lane_out);
+static esp_err_t resolve_post_name(const char *event_name, synapse_event_id_t *event_id_out);
+static esp_err_t submit_message(event_lane_t *lane, event_message_t *msg);
+static void note_enqueued(event_lane_t *lane, const event_message_t *msg, uint32_t pending);
+static void note_dropped(event_lane_t *lane, synapse_event_id_t event_id);
+static esp_err_t spill_message(event_lane_t *lane, const event_message_t *msg);
+static void refill_from_spill(event_lane_t *lane);
+static void atomic_store_max(uint32_t *target, uint32_t value);
+static void record_latency(event_lane_t *lane, const event_message_t *msg);
+static cJSON *lane_stats_to_json(synapse_event_priority_t priority, int64_t window_us);
 
 /**
  * @internal
- * @brief Event Bus-ის მთავარი ტასკი, რომელიც ამუშავებს ივენთებს რიგიდან.
+ * @brief ზოლის დისპეტჩერ-ტასკი, რომელიც ამუშავებს ივენთებს თავისი რიგიდან.
+ * @details ყოველ გაღვიძებაზე ტასკი იღებს `EVENT_DISPATCH_BATCH_SIZE`-მდე ივენთს და
+ *          მათ სათითაოდ აგზავნის. გამომწერების სიები იკითხება უცვლელი
+ *          snapshot-ებიდან, Mutex-ის გარეშე; read სექცია მოიცავს მხოლოდ ერთი
+ *          ივენთის მიმღებების სიის შედგენას და არა handler-ებს (`deliver_event()`).
+ * @param pvParameters მაჩვენებელი დისპეტჩერზე (`event_dispatcher_t`).
  */
 static void event_bus_task(void *pvParameters)
 {
-    (void)pvParameters; // კომპილერის გაფრთხილების თავიდან ასაცილებლად
-    event_message_t msg;
+    event_dispatcher_t *dispatcher = (event_dispatcher_t *)pvParameters;
+    event_lane_t *lane = dispatcher->lane;
+    event_message_t *batch = dispatcher->batch;
+    synapse_event_scratch_bind(&dispatcher->scratch);
     while (1)
     {
-        if (xQueueReceive(event_bus_queue, &msg, portMAX_DELAY) == pdPASS)
+        size_t count = drain_lane(dispatcher, batch);
+        if (count == 0)
         {
-            ESP_LOGD(TAG, "Processing event: '%s'", msg.event_name);
+            continue;
+        }
 
-            dispatch_event_to_subscribers(&msg);
+        for (size_t i = 0; i < count; i++)
+        {
+            record_latency(lane, &batch[i]);
+            deliver_event(&batch[i]);
+            synapse_event_scratch_reset(&dispatcher->scratch);
+        }
 
-            // გავათავისუფლოთ ივენთის სახელისთვის გამოყოფილი მეხსიერება
-            free(msg.event_name);
-            msg.event_name = NULL;
+        __atomic_fetch_add(&lane->dispatched, count, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&dispatcher->dispatched, count, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&lane->dispatch_batches, 1, __ATOMIC_RELAXED);
 
-            // გავათავისუფლოთ საწყისი reference, რომელიც `post` ფუნქციამ შექმნა
-            if (msg.data_wrapper)
-            {
-                synapse_event_data_release(msg.data_wrapper);
-            }
+        // რიგში ადგილი გათავისუფლდა - დავაბრუნოთ სათადარიგო ბუფერში გადატანილი ივენთები
+        if (__atomic_load_n(&lane->spill_count, __ATOMIC_ACQUIRE) > 0)
+        {
+            refill_from_spill(lane);
         }
     }
 }
 
 /**
  * @internal
- * @brief აგზავნის ერთ ივენთს ყველა შესაბამის გამომწერთან.
- * @details ეს ფუნქცია ეძებს როგორც კონკრეტულ (`event_name`), ისე ზოგად (`*`)
- *          გამომწერებს. რათა მინიმუმამდე დაიყვანოს Mutex-ის დაკავების დრო
- *          და თავიდან აიცილოს `race condition`-ები, ის ჯერ ქმნის გამომწერების
- *          სიების ლოკალურ ასლებს და მხოლოდ ამის შემდეგ იძახებს მათ `handle_event`
- *          ფუნქციებს.
- *
- * @param[in] msg მაჩვენებელი გასაგზავნ ივენთის შეტყობინებაზე (`event_message_t`).
+ * @brief ითვლის ივენთის დაყოვნებას გამოქვეყნებიდან handler-ების გამოძახებამდე.
+ * @details per-core რეჟიმში ზოლის სტატისტიკას რამდენიმე დისპეტჩერი წერს, ამიტომ
+ *          მაქსიმუმი ატომურად ახლდება.
  */
-static void dispatch_event_to_subscribers(const event_message_t *msg)
+static void record_latency(event_lane_t *lane, const event_message_t *msg)
 {
-    if (!msg || !msg->event_name)
+    uint32_t latency_us = (uint32_t)esp_timer_get_time() - msg->posted_at_us;
+    SYNAPSE_TRACE(SYNAPSE_TRACE_EVENT_DEQUEUE, msg->event_id, latency_us);
+    atomic_store_max(&lane->max_latency_us, latency_us);
+#ifdef CONFIG_SYNAPSE_EVENT_LATENCY_HISTOGRAM
+    synapse_event_latency_record(&lane->latency, latency_us);
+#endif
+}
+
+/**
+ * @internal
+ * @brief იღებს დისპეტჩერის რიგიდან ერთ ივენთს (ელოდება) და მის უკან მდგომ `EVENT_DISPATCH_BATCH_SIZE - 1`-მდე ივენთს (ლოდინის გარეშე).
+ * @return მიღებული ივენთების რაოდენობა.
+ */
+static size_t drain_lane(event_dispatcher_t *dispatcher, event_message_t *messages)
+{
+    if (xQueueReceive(dispatcher->queue, &messages[0], portMAX_DELAY) != pdPASS)
     {
-        return; // დავიცვათ თავი NULL მაჩვენებლებისგან
+        return 0;
     }
 
-    event_subscription_list_t specific_subs_copy;
-    event_subscription_list_t wildcard_subs_copy;
-    bool specific_found = false;
-    bool wildcard_found = false;
-
-    // --- კრიტიკული სექციის დასაწყისი ---
-    if (xSemaphoreTake(subscription_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) == pdTRUE)
+    size_t count = 1;
+    while (count < EVENT_DISPATCH_BATCH_SIZE && xQueueReceive(dispatcher->queue, &messages[count], 0) == pdPASS)
     {
-        event_subscription_node_t *node = subscription_head;
-        while (node != NULL)
-        {
-            // 1. ვეძებთ კონკრეტული ივენთის გამომწერებს
-            if (strcmp(node->event_name, msg->event_name) == 0)
-            {
-                memcpy(&specific_subs_copy, &node->subscription_list, sizeof(event_subscription_list_t));
-                specific_found = true;
-            }
-            // 2. ვეძებთ wildcard ("*") გამომწერებს
-            if (strcmp(node->event_name, "*") == 0)
-            {
-                memcpy(&wildcard_subs_copy, &node->subscription_list, sizeof(event_subscription_list_t));
-                wildcard_found = true;
-            }
-            node = node->next;
-        }
-        xSemaphoreGive(subscription_mutex);
+        count++;
     }
-    else
+
+    // conflation token-ები ამოღებისთანავე ბრუნდება ჩვეულებრივ შეტყობინებად - ამ მომენტიდან
+    // ახალი გამოქვეყნება ახალ შეტყობინებას ჩააყენებს რიგში
+    for (size_t i = 0; i < count; i++)
     {
-        ESP_LOGE(TAG, "დისპეტჩერმა ვერ შეძლო Mutex-ის დაკავება ივენთისთვის: '%s'", msg->event_name);
-        return; // თუ Mutex-ს ვერ ვიღებთ, ოპერაციას ვაუქმებთ
+        synapse_event_conflation_claim(&messages[i]);
     }
-    // --- კრიტიკული სექციის დასასრული ---
-
-    // --- ივენთების გაგზავნა (Mutex-ის გარეთ) ---
+    return count;
+}
 
-    // 3. ჯერ ვუგზავნით კონკრეტულ გამომწერებს
-    if (specific_found)
+/**
+ * @internal
+ * @brief აბრუნებს true-ს, თუ მოდული snapshot-შია.
+ */
+static bool snapshot_contains(const event_subscriber_snapshot_t *snapshot, const module_t *module)
+{
+    for (uint8_t i = 0; snapshot && i < snapshot->count; i++)
     {
-        ESP_LOGD(TAG, "ივენთის '%s' გაგზავნა %d კონკრეტულ გამომწერზე", msg->event_name, specific_subs_copy.count);
-        for (int i = 0; i < specific_subs_copy.count; i++)
+        if (snapshot->modules[i] == module)
         {
-            event_subscriber_t *sub = &specific_subs_copy.subscribers[i];
-            if (sub->module && sub->module->base.handle_event)
-            {
-                if (msg->data_wrapper)
-                {
-                    synapse_event_data_acquire(msg->data_wrapper);
-                }
-                sub->module->base.handle_event(sub->module, msg->event_name, msg->data_wrapper);
-            }
+            return true;
         }
     }
+    return false;
+}
 
-    // 4. შემდეგ ვუგზავნით wildcard გამომწერებს (მაგ. ლოგერს)
-    if (wildcard_found)
+#if EVENT_LANE_DISPATCHERS > 1
+/**
+ * @internal
+ * @brief აბრუნებს მოდულის handler-ის mutex-ს; პირველ გამოძახებაზე მოდულს სლოტს ანიჭებს.
+ * @return mutex ან NULL, თუ მოდული პარალელურ გამოძახებებს უძლებს.
+ */
+static SemaphoreHandle_t module_dispatch_lock(module_t *module)
+{
+    uint16_t slot = __atomic_load_n(&module->dispatch_slot, __ATOMIC_ACQUIRE);
+    if (slot == 0)
     {
-        ESP_LOGD(TAG, "ივენთის '%s' გაგზავნა %d ზოგად (wildcard) გამომწერზე", msg->event_name, wildcard_subs_copy.count);
-        for (int i = 0; i < wildcard_subs_copy.count; i++)
+        uint16_t assigned =
+            (uint16_t)(__atomic_fetch_add(&s_module_lock_next, 1, __ATOMIC_RELAXED) % CONFIG_SYNAPSE_MAX_MODULES + 1);
+        // სხვა დისპეტჩერმა შეიძლება სლოტი უკვე მიანიჭა - მაშინ `slot` მის მნიშვნელობას იღებს
+        if (__atomic_compare_exchange_n(&module->dispatch_slot, &slot, assigned, false, __ATOMIC_ACQ_REL,
+                                        __ATOMIC_ACQUIRE))
         {
-            event_subscriber_t *sub = &wildcard_subs_copy.subscribers[i];
-            // დავრწმუნდეთ, რომ კონკრეტულმა გამომწერმა ივენთი მეორედ არ მიიღო
-            bool already_sent = false;
-            if (specific_found)
-            {
-                for (int j = 0; j < specific_subs_copy.count; j++)
-                {
-                    if (specific_subs_copy.subscribers[j].module == sub->module)
-                    {
-                        already_sent = true;
-                        break;
-                    }
-                }
-            }
-
-            if (!already_sent && sub->module && sub->module->base.handle_event)
-            {
-                if (msg->data_wrapper)
-                {
-                    synapse_event_data_acquire(msg->data_wrapper);
-                }
-                sub->module->base.handle_event(sub->module, msg->event_name, msg->data_wrapper);
-            }
+            slot = assigned;
         }
     }
+    return (slot == EVENT_MODULE_SLOT_CONCURRENT) ? NULL : s_module_locks[slot - 1];
 }
+#endif
 
 /**
  * @internal
- * @brief პოულობს გამოწერის კვანძს ივენთის სახელის მიხედვით.
- * @param event_name მოსაძებნი ივენთის სახელი.
- * @param create_if_not_found თუ true, შექმნის ახალ კვანძს თუ ვერ იპოვა.
- * @return მაჩვენებელი ნაპოვნ ან ახლად შექმნილ კვანძზე, ან NULL თუ ვერ იპოვა და create_if_not_found არის false.
- * @note ეს ფუნქცია უნდა გამოიძახოს მხოლოდ subscription_mutex-ის დაცულ კრიტიკულ სექციაში.
+ * @brief აბრუნებს true-ს, თუ მოდულის `init` წარმატებით დასრულდა და ის გამორთული არ არის.
+ * @details დინამიური გამოწერა `init`-ში კეთდება, სტატიკური მარშრუტი კი მანამდე
+ *          ქვეყნდება, ამიტომ მისი მიწოდება სტატუსს ამოწმებს. `start()`-ის გარეშე
+ *          მოდული `MODULE_STATUS_INITIALIZED`-ში რჩება და ივენთებს მაინც იღებს.
  */
-static event_subscription_node_t *find_subscription_node(const char *event_name, bool create_if_not_found)
+static inline bool module_accepts_routed(const module_t *module)
 {
-    event_subscription_node_t *node = subscription_head;
-    event_subscription_node_t *prev = NULL;
+    return module->status == MODULE_STATUS_INITIALIZED || module->status == MODULE_STATUS_RUNNING;
+}
 
-    // კვანძის ძებნა
-    while (node != NULL)
+/**
+ * @internal
+ * @brief იძახებს ერთი მოდულის `handle_event`-ს; დათვლილ wrapper-ზე ჯერ იღებს reference-ს.
+ * @details საფოსტო ყუთიან მოდულს ივენთი ედება ყუთში და handler-ს მისი
+ *          შემსრულებელი იძახებს. per-core რეჟიმში handler სრულდება მოდულის
+ *          mutex-ით (`module_dispatch_lock()`), რომ ორმა დისპეტჩერმა ის
+ *          ერთდროულად არ გამოიძახოს; `direct` გამოძახება mutex-ს არ იღებს.
+ * @param direct true - handler გამოიძახება აქვე, ყუთის მიუხედავად (`publish_sync`).
+ */
+static void deliver_to_module(module_t *module, synapse_event_id_t event_id, const char *event_name,
+                              event_data_wrapper_t *data_wrapper, bool counted, bool direct)
+{
+    if (!module || !module->base.handle_event)
     {
-        if (strcmp(node->event_name, event_name) == 0)
-        {
-            return node;
-        }
-        prev = node;
-        node = node->next;
+        return;
     }
+    if (!direct && synapse_event_mailbox_post(module, event_id, data_wrapper, counted))
+    {
+        return;
+    }
+    if (counted)
+    {
+        synapse_event_data_acquire(data_wrapper);
+    }
+#if EVENT_LANE_DISPATCHERS > 1
+    SemaphoreHandle_t lock = direct ? NULL : module_dispatch_lock(module);
+    if (lock)
+    {
+        xSemaphoreTake(lock, portMAX_DELAY);
+    }
+#endif
+    SYNAPSE_TRACE(SYNAPSE_TRACE_HANDLER_ENTER, event_id, (uintptr_t)module);
+#ifdef CONFIG_SYNAPSE_EVENT_MODULE_STATS
+    int64_t started_us = esp_timer_get_time();
+#endif
+    module->base.handle_event(module, event_name, data_wrapper);
+#ifdef CONFIG_SYNAPSE_EVENT_MODULE_STATS
+    synapse_event_module_record_handler(module, (uint32_t)(esp_timer_get_time() - started_us));
+#endif
+    SYNAPSE_TRACE(SYNAPSE_TRACE_HANDLER_EXIT, event_id, (uintptr_t)module);
+#if EVENT_LANE_DISPATCHERS > 1
+    if (lock)
+    {
+        xSemaphoreGive(lock);
+    }
+#endif
+}
 
-    // თუ კვანძი ვერ მოიძებნა და საჭიროა მისი შექმნა
-    if (create_if_not_found)
+/**
+ * @internal
+ * @brief ამატებს snapshot-ის მოდულებს მიწოდების სიაში, ფილტრების გათვალისწინებით.
+ * @details ფილტრი მოწმდება read სექციაში, wrapper-ის reference-ის აღებამდე, ამიტომ
+ *          უარყოფილი ივენთი მოდულს არაფერი უჯდება predicate-ის გარდა. სიაში
+ *          ჩაწერილ მოდულს `in_dispatch` ეზრდება.
+ * @note უნდა გამოიძახოს მხოლოდ read სექციის შიგნით.
+ * @param skip_a (Optional) snapshot, რომლის მოდულებიც გამოიტოვება (უკვე მიიღეს).
+ * @param skip_b (Optional) მეორე ასეთი snapshot.
+ * @param mode რომელ (sync/async) ჩანაწერებს მიეწოდოს.
+ * @param initialized_only true - მხოლოდ წარმატებით ინიციალიზებულ მოდულებს (სტატიკური მარშრუტები).
+ */
+static void collect_snapshot(event_delivery_t *delivery, const event_subscriber_snapshot_t *snapshot,
+                             const event_subscriber_snapshot_t *skip_a, const event_subscriber_snapshot_t *skip_b,
+                             synapse_event_id_t event_id, const void *payload, event_deliver_mode_t mode,
+                             bool initialized_only)
+{
+    if (!snapshot)
+    {
+        return;
+    }
+    event_subscription_filter_t **filters = event_snapshot_filters(snapshot);
+    const uint8_t *sync = event_snapshot_sync(snapshot);
+    for (uint8_t i = 0; i < snapshot->count && delivery->count < EVENT_MAX_DELIVERY_TARGETS; i++)
     {
-        event_subscription_node_t *new_node = (event_subscription_node_t *)calloc(1, sizeof(event_subscription_node_t));
-        if (!new_node)
+        if (mode != EVENT_DELIVER_ALL)
         {
-            ESP_LOGE(TAG, "Failed to allocate memory for new subscription node for event '%s'", event_name);
-            return NULL;
+            bool is_sync = sync && sync[i];
+            if (is_sync != (mode == EVENT_DELIVER_SYNC_ONLY))
+            {
+                continue;
+            }
         }
-
-        new_node->event_name = strdup(event_name);
-        if (!new_node->event_name)
+        if (snapshot_contains(skip_a, snapshot->modules[i]) || snapshot_contains(skip_b, snapshot->modules[i]))
         {
-            ESP_LOGE(TAG, "Failed to duplicate event name string for '%s'", event_name);
-            free(new_node);
-            return NULL;
+            continue;
         }
-
-        // ახალი კვანძის დამატება სიის ბოლოში (ან თავში თუ სია ცარიელია)
-        if (prev == NULL)
+        // სტატიკური მარშრუტი init-მდე ქვეყნდება: init-მდე, შეცდომისას და გამორთულ მოდულს ივენთი არ მიეწოდება
+        if (initialized_only && !module_accepts_routed(snapshot->modules[i]))
         {
-            subscription_head = new_node;
+            continue;
         }
-        else
+        if (filters && filters[i] && !synapse_event_subscription_filter_accepts(filters[i], event_id, payload))
         {
-            prev->next = new_node;
+            continue;
         }
-        ESP_LOGD(TAG, "Created new subscription node for event '%s'", event_name);
-        return new_node;
+        __atomic_fetch_add(&snapshot->modules[i]->in_dispatch, 1, __ATOMIC_RELAXED);
+        delivery->targets[delivery->count++] = snapshot->modules[i];
     }
-
-    return NULL;
 }
 
 /**
  * @internal
- * @brief შლის გამომწერს სიიდან მითითებულ ინდექსზე.
+ * @brief იძახებს მიწოდების სიის handler-ებს read სექციის გარეთ.
+ * @details სია რეგისტრირდება ტასკის `s_delivery` ჯაჭვში, რომ handler-იდან
+ *          გამოძახებულმა `unsubscribe`-მა მოდულის დარჩენილი ჩანაწერები გააუქმოს.
+ * @param direct true - handler გამოიძახება აქვე, ყუთის მიუხედავად (`publish_sync`).
+ * @return გამოძახებული handler-ების რაოდენობა.
  */
-static void remove_subscriber(event_subscription_list_t *sub_list, int index)
+static uint32_t run_delivery(event_delivery_t *delivery, synapse_event_id_t event_id, const char *event_name,
+                             event_data_wrapper_t *data_wrapper, bool counted, bool direct)
 {
-    if (sub_list == NULL || index < 0 || (unsigned int)index >= sub_list->count)
+    uint32_t delivered = 0;
+    delivery->outer = s_delivery;
+    s_delivery = delivery;
+    for (uint16_t i = 0; i < delivery->count; i++)
     {
-        return;
-    }
-    // ელემენტების მარცხნივ გადაწევა სიცარიელის ამოსავსებლად
-    for (uint8_t i = (uint8_t)index; i < sub_list->count - 1; i++)
-    {
-        sub_list->subscribers[i] = sub_list->subscribers[i + 1];
+        module_t *module = delivery->targets[i];
+        if (!module)
+        {
+            continue; // handler-იდან გაუქმებული გამოწერა
+        }
+        delivery->current = i;
+        deliver_to_module(module, event_id, event_name, data_wrapper, counted, direct);
+        __atomic_fetch_sub(&module->in_dispatch, 1, __ATOMIC_RELEASE);
+        delivered++;
     }
-    sub_list->count--;
+    s_delivery = delivery->outer;
+    return delivered;
 }
 
-// --- საჯარო API ფუნქციები ---
-
-esp_err_t synapse_event_bus_init(void)
+/**
+ * @internal
+ * @brief ელოდება, სანამ გაუქმებული გამოწერის მოდული აღარცერთ მიწოდებაში აღარ იქნება.
+ * @details ჯერ უქმდება ამავე ტასკის ჯერ გამოუძახებელი ჩანაწერები. მოდულის
+ *          საკუთარი handler-იდან ლოდინი შეუძლებელია (მისი გამოძახება თავად
+ *          ითვლება), ამიტომ ასეთი გამოძახება მაშინვე ბრუნდება - სხვა დისპეტჩერზე
+ *          უკვე დაწყებული მიწოდება შეიძლება მაინც მოვიდეს. სხვა შემთხვევაში
+ *          grace period-ის შემდეგ ახალი მიწოდება აღარ იწყება და რჩება უკვე
+ *          აღებულების დასრულების ლოდინი.
+ * @return ESP_OK; ESP_ERR_TIMEOUT - მოდულის handler-ი ჯერ კიდევ სრულდება;
+ *         ESP_ERR_INVALID_STATE - გამოძახება read სექციიდანაა.
+ */
+static esp_err_t wait_for_module_idle(module_t *module)
 {
-    ESP_LOGI(TAG, "Initializing Event Bus...");
-    if (subscription_mutex != NULL)
+    // საფოსტო ყუთის შემსრულებელი თავის ივენთს `in_dispatch`-ში ითვლის
+    bool own_handler = synapse_event_mailbox_is_executor(module);
+    for (event_delivery_t *delivery = s_delivery; delivery; delivery = delivery->outer)
     {
-        ESP_LOGW(TAG, "Event Bus is already initialized.");
-        return ESP_ERR_INVALID_STATE;
+        for (uint16_t i = 0; i < delivery->count; i++)
+        {
+            if (delivery->targets[i] != module)
+            {
+                continue;
+            }
+            // ჯაჭვის ყველა მიწოდება ახლა handler-ს იძახებს: `current`-მდე ჩანაწერები უკვე დასრულდა
+            if (i == delivery->current)
+            {
+                own_handler = true;
+                continue;
+            }
+            if (i > delivery->current)
+            {
+                delivery->targets[i] = NULL;
+                __atomic_fetch_sub(&module->in_dispatch, 1, __ATOMIC_RELEASE);
+            }
+        }
     }
-
-    subscription_mutex = xSemaphoreCreateMutex();
-    if (!subscription_mutex) {
-        ESP_LOGE(TAG, "Failed to create subscription mutex.");
-        return ESP_ERR_NO_MEM;
+    if (own_handler)
+    {
+        return ESP_OK;
     }
 
-    event_bus_queue = xQueueCreate(CONFIG_SYNAPSE_EVENT_QUEUE_LENGTH, sizeof(event_message_t));
-    if (!event_bus_queue) {
-        ESP_LOGE(TAG, "Failed to create event queue.");
-        vSemaphoreDelete(subscription_mutex);
-        subscription_mutex = NULL;
-        return ESP_ERR_NO_MEM;
+    esp_err_t err = synapse_event_subscriptions_synchronize();
+    if (err != ESP_OK)
+    {
+        return err;
     }
-
-    // აღარ არის საჭირო `event_subscriptions` მასივის წინასწარი გამოყოფა
-    subscription_head = NULL;
-
-    BaseType_t result = xTaskCreate(event_bus_task, "event_bus_task", CONFIG_SYNAPSE_EVENT_BUS_TASK_STACK_SIZE, NULL, CONFIG_SYNAPSE_EVENT_BUS_TASK_PRIORITY, NULL);
-    if (result != pdPASS) {
-        ESP_LOGE(TAG, "Failed to create event bus task.");
-        // აქ საჭიროა გამოწერების სიის გასუფთავება, თუმცა ამ ეტაპზე ის ყოველთვის ცარიელია.
-        vQueueDelete(event_bus_queue);
-        vSemaphoreDelete(subscription_mutex);
-        return ESP_FAIL;
+    int64_t deadline = esp_timer_get_time() + (int64_t)CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS * 1000;
+    while (__atomic_load_n(&module->in_dispatch, __ATOMIC_ACQUIRE) != 0)
+    {
+        if (esp_timer_get_time() > deadline)
+        {
+            return ESP_ERR_TIMEOUT;
+        }
+        vTaskDelay(1);
     }
-    ESP_LOGI(TAG, "Event Bus initialized and task started.");
     return ESP_OK;
 }
 
-esp_err_t synapse_event_bus_post(const char *event_name, event_data_wrapper_t *data_wrapper)
+/**
+ * @internal
+ * @brief აბრუნებს true-ს, თუ ივენთს ჰყავს გამომწერი, რომელიც მას მხოლოდ რიგიდან იღებს.
+ * @details მოდული იღებს ივენთს პირველი გზით, რომლითაც გამოწერილია (კონკრეტული,
+ *          შემდეგ module.json-ის სტატიკური მარშრუტი, შემდეგ `*`, შემდეგ pattern),
+ *          ამიტომ მისი რეჟიმიც ამ გზით განისაზღვრება.
+ * @note უნდა გამოიძახოს მხოლოდ read სექციის შიგნით.
+ */
+static bool has_async_subscribers(const event_subscriber_snapshot_t *specific, const event_subscriber_snapshot_t *routed,
+                                  const event_subscriber_snapshot_t *wildcard, const event_pattern_trie_t *patterns,
+                                  const char *event_name)
 {
-    if (!event_name || strlen(event_name) == 0)
+    if (specific && specific->count > specific->sync_count)
     {
-        ESP_LOGE(TAG, "Invalid event name: NULL or empty string.");
-        return ESP_ERR_INVALID_ARG;
+        return true;
     }
-
-    char *event_name_copy = strdup(event_name);
-    if (!event_name_copy)
+    const uint8_t *routed_sync = routed ? event_snapshot_sync(routed) : NULL;
+    for (uint8_t i = 0; routed && i < routed->count; i++)
     {
-        ESP_LOGE(TAG, "Failed to duplicate event name '%s'. Out of memory.", event_name);
-        return ESP_ERR_NO_MEM;
+        if (!(routed_sync && routed_sync[i]) && module_accepts_routed(routed->modules[i]) &&
+            !snapshot_contains(specific, routed->modules[i]))
+        {
+            return true;
+        }
     }
-
-    event_message_t msg = {
-        .event_name = event_name_copy,
-        .data_wrapper = data_wrapper,
-    };
-
-    if (data_wrapper) {
-        synapse_event_data_acquire(data_wrapper);
+    const uint8_t *wildcard_sync = wildcard ? event_snapshot_sync(wildcard) : NULL;
+    for (uint8_t i = 0; wildcard && i < wildcard->count; i++)
+    {
+        if (!(wildcard_sync && wildcard_sync[i]) && !snapshot_contains(specific, wildcard->modules[i]) &&
+            !snapshot_contains(routed, wildcard->modules[i]))
+        {
+            return true;
+        }
     }
-
-    if (xQueueSend(event_bus_queue, &msg, pdMS_TO_TICKS(CONFIG_SYNAPSE_TASK_QUEUE_TIMEOUT_MS)) != pdPASS)
+    if (patterns)
     {
-        ESP_LOGE(TAG, "Failed to post event '%s'. Queue might be full.", event_name);
-        free(event_name_copy); // გავათავისუფლოთ ასლი თუ რიგში ვერ ჩაიწერა
-        if (data_wrapper) {
-            synapse_event_data_release(data_wrapper);
+        module_t *matched[EVENT_MAX_PATTERN_MATCHES];
+        bool overflow = false;
+        size_t matched_count = synapse_event_pattern_trie_match(patterns, event_name, matched,
+                                                                EVENT_MAX_PATTERN_MATCHES, &overflow);
+        for (size_t i = 0; i < matched_count; i++)
+        {
+            if (!snapshot_contains(specific, matched[i]) && !snapshot_contains(routed, matched[i]) &&
+                !snapshot_contains(wildcard, matched[i]))
+            {
+                return true;
+            }
         }
-        return ESP_FAIL;
     }
-    return ESP_OK;
+    return false;
 }
 
-esp_err_t synapse_event_bus_subscribe(const char *event_name, module_t *module)
+/**
+ * @internal
+ * @brief პოულობს სახელით გამოსაქვეყნებელი ივენთის ID-ს.
+ * @details უცნობ სახელს ID ენიჭება მხოლოდ მაშინ, თუ მას მიმღები ჰყავს (`*`-ის ან
+ *          შესაბამისი pattern-ის გამომწერი) ან ჩაწერა მიმდინარეობს. ასე
+ *          დინამიკური სახელები (მაგ. მოწყობილობების topic-ები), რომლებსაც
+ *          არავინ უსმენს, სახელების ცხრილს (`CONFIG_SYNAPSE_EVENT_MAX_NAMES`) არ ავსებს.
+ * @return ESP_OK და ID `event_id_out`-ში; ESP_ERR_NOT_FOUND თუ ივენთს მიმღები
+ *         არ ჰყავს; ESP_ERR_NO_MEM თუ სახელის რეგისტრაცია ვერ მოხერხდა.
+ */
+static esp_err_t resolve_post_name(const char *event_name, synapse_event_id_t *event_id_out)
 {
-    if (!event_name || strlen(event_name) == 0)
+    *event_id_out = synapse_event_bus_find_id(event_name);
+    if (*event_id_out != SYNAPSE_EVENT_ID_INVALID)
     {
-        ESP_LOGE(TAG, "Subscribe failed: event_name is NULL or empty.");
-        return ESP_ERR_INVALID_ARG;
+        return ESP_OK;
     }
 
-    if (!module || !module->base.handle_event)
+    bool has_receivers = EVENT_CAPTURE_ACTIVE();
+    if (!has_receivers)
     {
-        ESP_LOGE(TAG, "Subscribe failed: module or its event handler is NULL.");
-        return ESP_ERR_INVALID_ARG;
+        uint32_t read_token = synapse_event_subscriptions_read_lock();
+        const event_subscriber_snapshot_t *wildcard = synapse_event_subscriptions_get(SYNAPSE_EVENT_ID_WILDCARD);
+        const event_pattern_trie_t *patterns = synapse_event_subscriptions_get_patterns();
+        module_t *matched = NULL;
+        has_receivers = (wildcard && wildcard->count > 0) ||
+                        (patterns && synapse_event_pattern_trie_match(patterns, event_name, &matched, 1, NULL) > 0);
+        synapse_event_subscriptions_read_unlock(read_token);
+    }
+    if (!has_receivers)
+    {
+        ESP_LOGV(TAG, "Event '%s' has no subscribers; not posted.", event_name);
+        return ESP_ERR_NOT_FOUND;
     }
 
-    esp_err_t ret = ESP_OK;
-    if (xSemaphoreTake(subscription_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) == pdTRUE)
+    *event_id_out = synapse_event_bus_intern(event_name);
+    if (*event_id_out == SYNAPSE_EVENT_ID_INVALID)
     {
-        event_subscription_node_t *node = find_subscription_node(event_name, true);
+        ESP_LOGE(TAG, "Failed to intern event name '%s'.", event_name);
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
 
-        if (!node)
-        {
-            ESP_LOGE(TAG, "Failed to find or create subscription node for event '%s'", event_name);
-            xSemaphoreGive(subscription_mutex);
-            return ESP_ERR_NO_MEM; // find_subscription_node-მა უკვე დაწერა ლოგი
-        }
+/**
+ * @internal
+ * @brief აგზავნის ერთ ივენთს ყველა შესაბამის გამომწერთან და ათავისუფლებს მის საწყის reference-ს.
+ * @details ჯერ იძახებს კონკრეტულ (`event_id`), შემდეგ module.json-ით სტატიკურად
+ *          მიბმულ, შემდეგ ზოგად (`*`) და ბოლოს pattern-ის (`a.+.c`, `a.*`)
+ *          გამომწერებს. მოდული, რომელიც რამდენიმე გზით არის გამოწერილი, ივენთს
+ *          მხოლოდ ერთხელ იღებს. მიმღებების სია read სექციაში დგება, handler-ები
+ *          კი მისი დასრულების შემდეგ იძახება.
+ * @param[in] msg ივენთის შეტყობინება.
+ */
+static void deliver_event(const event_message_t *msg)
+{
+    const char *event_name = synapse_event_bus_get_name(msg->event_id);
 
-        event_subscription_list_t *sub_list = &node->subscription_list;
+    // ინლაინ payload ცოცხლობს მხოლოდ ამ გამოძახების განმავლობაში, ამიტომ wrapper "ნასესხებია"
+    event_data_wrapper_t borrowed = {
+        .ref_count = 1,
+        .payload = (void *)msg->inline_data.bytes,
+        .payload_size = msg->inline_size,
+        .flags = SYNAPSE_EVENT_DATA_FLAG_BORROWED,
+    };
+    event_data_wrapper_t *data_wrapper = (msg->inline_size > 0) ? &borrowed : msg->data_wrapper;
+    // ნასესხებ wrapper-ს reference counting არ აქვს - მას დისპეტჩერი ფლობს
+    bool counted = (msg->inline_size == 0) && data_wrapper;
 
-        // შევამოწმოთ, მოდული უკვე გამოწერილი ხომ არ არის
-        for (uint8_t i = 0; i < sub_list->count; i++) {
-            if (sub_list->subscribers[i].module == module) {
-                ESP_LOGW(TAG, "Module '%s' is already subscribed to event '%s'", module->name, event_name);
-                xSemaphoreGive(subscription_mutex);
-                return ESP_OK; // არ არის შეცდომა, უბრალოდ უკვე გამოწერილია
-            }
-        }
+    if (event_name)
+    {
+        // wildcard ID-ზე გამოქვეყნებული ივენთი მხოლოდ wildcard-ებს მიდის
+        bool is_wildcard = (msg->event_id == SYNAPSE_EVENT_ID_WILDCARD);
+        // `publish_sync`-ით გამოქვეყნებული ივენთი sync გამომწერებმა უკვე მიიღეს
+        event_deliver_mode_t mode = (msg->flags & EVENT_MESSAGE_FLAG_SYNC_DELIVERED) ? EVENT_DELIVER_ASYNC_ONLY
+                                                                                     : EVENT_DELIVER_ALL;
+        const void *payload = data_wrapper ? data_wrapper->payload : NULL;
+        event_delivery_t delivery = {0};
 
-        // ახალი გამომწერის დამატება
-        if (sub_list->count < CONFIG_SYNAPSE_MAX_SUBSCRIBERS_PER_EVENT)
-        {
-            sub_list->subscribers[sub_list->count].module = module;
-            sub_list->count++;
-            ESP_LOGI(TAG, "Module '%s' subscribed successfully to event '%s'", module->name, event_name);
-        }
-        else
+        uint32_t read_token = synapse_event_subscriptions_read_lock();
+        const event_subscriber_snapshot_t *specific = is_wildcard ? NULL : synapse_event_subscriptions_get(msg->event_id);
+        const event_subscriber_snapshot_t *routed = is_wildcard ? NULL : synapse_event_subscriptions_get_static(msg->event_id);
+        const event_subscriber_snapshot_t *wildcard = synapse_event_subscriptions_get(SYNAPSE_EVENT_ID_WILDCARD);
+        const event_pattern_trie_t *patterns = is_wildcard ? NULL : synapse_event_subscriptions_get_patterns();
+
+        collect_snapshot(&delivery, specific, NULL, NULL, msg->event_id, payload, mode, false);
+        // დინამიური გამოწერა (და მისი ფილტრი) სტატიკურ მარშრუტზე უპირატესია
+        collect_snapshot(&delivery, routed, specific, NULL, msg->event_id, payload, mode, true);
+        // დავრწმუნდეთ, რომ კონკრეტულმა გამომწერმა ივენთი მეორედ არ მიიღო
+        collect_snapshot(&delivery, wildcard, specific, routed, msg->event_id, payload, mode, false);
+
+        if (patterns)
         {
-            ESP_LOGE(TAG, "Cannot subscribe module '%s' to event '%s'. Subscriber limit reached.", module->name, event_name);
-            ret = ESP_ERR_NO_MEM;
+            // trie-ს გავლა სეგმენტების რაოდენობის პროპორციულია და არა გამოწერების
+            module_t *matched[EVENT_MAX_PATTERN_MATCHES];
+            bool overflow = false;
+            size_t matched_count = synapse_event_pattern_trie_match(patterns, event_name, matched,
+                                                                    EVENT_MAX_PATTERN_MATCHES, &overflow);
+            if (overflow)
+            {
+                ESP_LOGW(TAG, "More than %d pattern subscribers match '%s'; the rest are skipped.",
+                         EVENT_MAX_PATTERN_MATCHES, event_name);
+            }
+            for (size_t i = 0; i < matched_count && delivery.count < EVENT_MAX_DELIVERY_TARGETS; i++)
+            {
+                if (!snapshot_contains(specific, matched[i]) && !snapshot_contains(routed, matched[i]) &&
+                    !snapshot_contains(wildcard, matched[i]))
+                {
+                    __atomic_fetch_add(&matched[i]->in_dispatch, 1, __ATOMIC_RELAXED);
+                    delivery.targets[delivery.count++] = matched[i];
+                }
+            }
         }
+        synapse_event_subscriptions_read_unlock(read_token);
 
-        xSemaphoreGive(subscription_mutex);
+        run_delivery(&delivery, msg->event_id, event_name, data_wrapper, counted, false);
     }
-    else
+
+    // გავათავისუფლოთ საწყისი reference, რომელიც `post` ფუნქციამ შექმნა
+    if (msg->data_wrapper)
     {
-        ESP_LOGE(TAG, "Failed to acquire subscription mutex for module '%s' and event '%s'", module->name, event_name);
-        ret = ESP_ERR_TIMEOUT;
+        synapse_event_data_release(msg->data_wrapper);
     }
-    return ret;
 }
 
-esp_err_t synapse_event_bus_unsubscribe(const char *event_name, module_t *module)
+/**
+ * @internal
+ * @brief ატომურად ზრდის `*target`-ს `value`-მდე (high-watermark-ებისთვის).
+ */
+static void atomic_store_max(uint32_t *target, uint32_t value)
 {
-    if (!event_name || strlen(event_name) == 0 || !module)
+    uint32_t current = __atomic_load_n(target, __ATOMIC_RELAXED);
+    while (value > current &&
+           !__atomic_compare_exchange_n(target, &current, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
     {
-        return ESP_ERR_INVALID_ARG;
     }
+}
+
+/**
+ * @internal
+ * @brief ირჩევს დისპეტჩერს, რომელიც შეტყობინებას დაამუშავებს.
+ * @details ივენთის დაფიქსირებული ბირთვი (`synapse_event_bus_set_dispatch_core()`)
+ *          უპირატესია; სხვა შემთხვევაში დისპეტჩერს ირჩევს partition key-ის hash-ი.
+ *          გასაღები ნაგულისხმევად ივენთის ID-ია, ამიტომ ერთი ივენთის ყველა
+ *          გამოქვეყნება ერთ რიგში ხვდება და თანმიმდევრობა ნარჩუნდება.
+ * @param from_isr ISR-იდან გასაღების ფუნქცია არ იძახება - გამოიყენება ID.
+ */
+static uint8_t partition_message(const event_message_t *msg, bool from_isr)
+{
+#if EVENT_LANE_DISPATCHERS > 1
+    const event_descriptor_t *desc = synapse_event_registry_get(msg->event_id);
+    if (!desc)
+    {
+        return 0;
+    }
+    uint8_t core = __atomic_load_n(&desc->dispatch_core, __ATOMIC_ACQUIRE);
+    if (core != 0)
+    {
+        return (uint8_t)((core - 1) % EVENT_LANE_DISPATCHERS);
+    }
+
+    uint32_t key = msg->event_id;
+    synapse_event_partition_key_fn_t key_fn = __atomic_load_n(&desc->partition_key_fn, __ATOMIC_ACQUIRE);
+    if (key_fn && !from_isr)
+    {
+        const void *payload = (msg->inline_size > 0) ? (const void *)msg->inline_data.bytes
+                              : (msg->data_wrapper ? msg->data_wrapper->payload : NULL);
+        key = key_fn(payload);
+    }
+    // Fibonacci hashing: მიმდევრობითი გასაღებებიც თანაბრად ნაწილდება
+    return (uint8_t)(((key * 2654435769U) >> 16) % EVENT_LANE_DISPATCHERS);
+#else
+    (void)msg;
+    (void)from_isr;
+    return 0;
+#endif
+}
+
+/**
+ * @internal
+ * @brief აბრუნებს დისპეტჩერის რიგს, რომელსაც შეტყობინება `partition_message()`-ით მიეკუთვნა.
+ */
+static QueueHandle_t message_queue(const event_lane_t *lane, const event_message_t *msg)
+{
+    return lane->dispatchers[msg->dispatcher % EVENT_LANE_DISPATCHERS].queue;
+}
 
-    if (xSemaphoreTake(subscription_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) != pdTRUE)
+/**
+ * @internal
+ * @brief აბრუნებს ზოლის ყველა რიგში მყოფი ივენთების ჯამს.
+ */
+static uint32_t lane_pending(const event_lane_t *lane)
+{
+    uint32_t pending = 0;
+    for (int i = 0; i < EVENT_LANE_DISPATCHERS; i++)
     {
-        ESP_LOGE(TAG, "Failed to acquire subscription mutex for unsubscribe (module '%s', event '%s')", module->name, event_name);
-        return ESP_ERR_TIMEOUT;
+        pending += (uint32_t)uxQueueMessagesWaiting(lane->dispatchers[i].queue);
     }
+    return pending;
+}
 
-    esp_err_t ret = ESP_ERR_NOT_FOUND;
-    event_subscription_node_t *node = subscription_head;
-    event_subscription_node_t *prev = NULL;
+/**
+ * @internal
+ * @brief აღრიცხავს რიგში დამატებულ შეტყობინებას ზოლისა და ივენთის სტატისტიკაში.
+ * @param pending რიგის შევსება დამატების შემდეგ.
+ */
+static void note_enqueued(event_lane_t *lane, const event_message_t *msg, uint32_t pending)
+{
+    __atomic_fetch_add(&lane->posted, 1, __ATOMIC_RELAXED);
+    if (msg->inline_size > 0)
+    {
+        __atomic_fetch_add(&lane->inline_posted, 1, __ATOMIC_RELAXED);
+    }
+    atomic_store_max(&lane->high_watermark, pending);
+    // arg: ზოლის ინდექსი (ზედა 16 ბიტი) და რიგის შევსება
+    SYNAPSE_TRACE(SYNAPSE_TRACE_EVENT_POST, msg->event_id, ((uint32_t)(lane - s_lanes) << 16) | (pending & 0xFFFF));
 
-    while (node != NULL)
+    event_descriptor_t *desc = synapse_event_registry_get(msg->event_id);
+    if (desc)
     {
-        if (strcmp(node->event_name, event_name) == 0)
-        {
-            event_subscription_list_t *sub_list = &node->subscription_list;
-            for (int i = 0; i < sub_list->count; i++)
-            {
-                if (sub_list->subscribers[i].module == module)
-                {
-                    remove_subscriber(sub_list, i);
-                    ESP_LOGI(TAG, "Module '%s' unsubscribed successfully from event '%s'", module->name, event_name);
-                    ret = ESP_OK;
-
-                    // თუ ამ ივენთს გამომწერები აღარ დარჩა, წავშალოთ კვანძი
-                    if (sub_list->count == 0)
-                    {
-                        ESP_LOGD(TAG, "Removing empty subscription node for event '%s'", event_name);
-                        if (prev == NULL)
-                        { // თუ პირველი ელემენტია
-                            subscription_head = node->next;
-                        }
-                        else
-                        {
-                            prev->next = node->next;
-                        }
-                        free(node->event_name);
-                        free(node);
-                    }
-                    goto cleanup; // გამოვიდეთ ორივე ციკლიდან
-                }
-            }
-            // თუ ციკლი დასრულდა და მოდული ვერ ვიპოვეთ ამ კვანძში
-            goto cleanup;
-        }
-        prev = node;
-        node = node->next;
+        __atomic_fetch_add(&desc->posted, 1, __ATOMIC_RELAXED);
+        atomic_store_max(&desc->high_watermark, pending);
     }
+}
 
-cleanup:
-    if (ret == ESP_ERR_NOT_FOUND)
+/**
+ * @internal
+ * @brief აღრიცხავს გადავსების გამო დაკარგულ ივენთს.
+ */
+static void note_dropped(event_lane_t *lane, synapse_event_id_t event_id)
+{
+    __atomic_fetch_add(&lane->dropped, 1, __ATOMIC_RELAXED);
+    SYNAPSE_TRACE(SYNAPSE_TRACE_EVENT_DROP, event_id, (uint32_t)(lane - s_lanes));
+    event_descriptor_t *desc = synapse_event_registry_get(event_id);
+    if (desc)
     {
-        ESP_LOGW(TAG, "Module '%s' was not subscribed to event '%s'", module->name, event_name);
+        __atomic_fetch_add(&desc->dropped, 1, __ATOMIC_RELAXED);
     }
+}
 
-    xSemaphoreGive(subscription_mutex);
-    return ret;
-}
\ No newline at end of file
+/**
+ * @internal
+ * @brief გადააქვს შეტყობინება ზოლის სათადარიგო ბუფერში.
+ * @return ESP_OK, ან ESP_FAIL თუ ბუფერი სავსეა (ან გამორთულია).
+ */
+static esp_err_t spill_message(event_lane_t *lane, const event_message_t *msg)
+{
+    uint32_t fill = 0;
+    bool stored = false;
+
+    taskENTER_CRITICAL(&lane->spill_lock);
+    if (lane->spill && lane->spill_count < EVENT_SPILL_BUFFER_LENGTH)
+    {
+        uint32_t tail = (lane->spill_head + lane->spill_count) % EVENT_SPILL_BUFFER_LENGTH;
+        lane->spill[tail] = *msg;
+        fill = __atomic_add_fetch(&lane->spill_count, 1, __ATOMIC_RELEASE);
+        stored = true;
+    }
+    taskEXIT_CRITICAL(&lane->spill_lock);
+
+    if (!stored)
+    {
+        return ESP_FAIL;
+    }
+
+    __atomic_fetch_add(&lane->spilled, 1, __ATOMIC_RELAXED);
+    atomic_store_max(&lane->spill_high_watermark, fill);
+    event_descriptor_t *desc = synapse_event_registry_get(msg->event_id);
+    if (desc)
+    {
+        __atomic_fetch_add(&desc->spilled, 1, __ATOMIC_RELAXED);
+    }
+    // დისპეტჩერმა რიგი შეიძლება უკვე დაცალა - ვცადოთ დაბრუნება, რომ ივენთი ბუფერში არ "გაიჭედოს"
+    refill_from_spill(lane);
+    return ESP_OK;
+}
+
+/**
+ * @internal
+ * @brief აბრუნებს spill ბუფერის ივენთებს მათი დისპეტჩერების რიგებში (FIFO), სანამ რიგში ადგილია.
+ * @details ერთდროულად ბუფერს მხოლოდ ერთი ტასკი აბრუნებს (`spill_refilling`), ამიტომ
+ *          სათადარიგო ივენთების ურთიერთთანმიმდევრობა ნარჩუნდება. დროშის
+ *          გათავისუფლების შემდეგ მდგომარეობა ხელახლა მოწმდება, რათა ამ დროს
+ *          დამატებული ივენთი არ დარჩეს ბუფერში მომდევნო გამოქვეყნებამდე.
+ */
+static void refill_from_spill(event_lane_t *lane)
+{
+    while (__atomic_load_n(&lane->spill_count, __ATOMIC_ACQUIRE) > 0)
+    {
+        if (__atomic_exchange_n(&lane->spill_refilling, 1, __ATOMIC_ACQUIRE) != 0)
+        {
+            return; // სხვა ტასკი უკვე აბრუნებს
+        }
+
+        QueueHandle_t blocked = NULL;
+        while (true)
+        {
+            event_message_t msg;
+            bool have = false;
+            taskENTER_CRITICAL(&lane->spill_lock);
+            if (lane->spill_count > 0)
+            {
+                msg = lane->spill[lane->spill_head];
+                have = true;
+            }
+            taskEXIT_CRITICAL(&lane->spill_lock);
+
+            if (!have)
+            {
+                break;
+            }
+            // ბუფერის თავი თავის დისპეტჩერს ელოდება - მის უკან მდგომები არ გადაასწრებენ
+            QueueHandle_t queue = message_queue(lane, &msg);
+            if (xQueueSend(queue, &msg, 0) != pdPASS)
+            {
+                blocked = queue;
+                break;
+            }
+
+            taskENTER_CRITICAL(&lane->spill_lock);
+            lane->spill_head = (lane->spill_head + 1) % EVENT_SPILL_BUFFER_LENGTH;
+            __atomic_sub_fetch(&lane->spill_count, 1, __ATOMIC_RELEASE);
+            taskEXIT_CRITICAL(&lane->spill_lock);
+            // რიგში დამატებულად ივენთი მხოლოდ ახლა ითვლება - რიგის რეალური შევსებით
+            note_enqueued(lane, &msg, (uint32_t)uxQueueMessagesWaiting(queue));
+        }
+
+        __atomic_store_n(&lane->spill_refilling, 0, __ATOMIC_RELEASE);
+        if (blocked && uxQueueSpacesAvailable(blocked) == 0)
+        {
+            return; // რიგი ისევ სავსეა - დისპეტჩერი გააგრძელებს შემდეგი პაკეტის შემდეგ
+        }
+    }
+}
+
+/**
+ * @internal
+ * @brief ამატებს შეტყობინებას ზოლის რიგში გადავსების პოლიტიკის მიხედვით.
+ * @details პოლიტიკა აიღება ივენთის დესკრიპტორიდან, ხოლო თუ ის
+ *          `SYNAPSE_EVENT_OVERFLOW_LANE_DEFAULT`-ია - ზოლიდან. დაკარგული ივენთები
+ *          აღირიცხება იმ ივენთზე, რომელიც რეალურად დაიკარგა (DROP_OLDEST-ისას -
+ *          რიგიდან ამოღებულზე).
+ * @note DROP_OLDEST-ისას ამოღებული ივენთის მონაცემები თავისუფლდება გამომქვეყნებლის კონტექსტში.
+ * @return ESP_OK თუ შეტყობინება რიგში (ან spill ბუფერში) დაემატა, ESP_FAIL თუ პოლიტიკამ ის უარყო.
+ */
+static esp_err_t enqueue_event(event_lane_t *lane, const event_message_t *msg)
+{
+    QueueHandle_t queue = message_queue(lane, msg);
+    const event_descriptor_t *desc = synapse_event_registry_get(msg->event_id);
+    synapse_event_overflow_policy_t policy = lane->overflow_policy;
+    uint32_t timeout_ms = CONFIG_SYNAPSE_TASK_QUEUE_TIMEOUT_MS;
+    if (desc)
+    {
+        uint8_t event_policy = __atomic_load_n(&desc->overflow_policy, __ATOMIC_ACQUIRE);
+        if (event_policy != SYNAPSE_EVENT_OVERFLOW_LANE_DEFAULT)
+        {
+            policy = (synapse_event_overflow_policy_t)event_policy;
+            uint32_t event_timeout_ms = __atomic_load_n(&desc->block_timeout_ms, __ATOMIC_ACQUIRE);
+            if (event_timeout_ms > 0)
+            {
+                timeout_ms = event_timeout_ms;
+            }
+        }
+    }
+
+    switch (policy)
+    {
+    case SYNAPSE_EVENT_OVERFLOW_DROP_NEWEST:
+        if (xQueueSend(queue, msg, 0) == pdPASS)
+        {
+            note_enqueued(lane, msg, (uint32_t)uxQueueMessagesWaiting(queue));
+            return ESP_OK;
+        }
+        break;
+
+    case SYNAPSE_EVENT_OVERFLOW_DROP_OLDEST:
+        for (int attempt = 0; attempt < EVENT_LANE_DROP_OLDEST_ATTEMPTS; attempt++)
+        {
+            if (xQueueSend(queue, msg, 0) == pdPASS)
+            {
+                note_enqueued(lane, msg, (uint32_t)uxQueueMessagesWaiting(queue));
+                return ESP_OK;
+            }
+            event_message_t oldest;
+            if (xQueueReceive(queue, &oldest, 0) == pdPASS)
+            {
+                ESP_LOGD(TAG, "[%s] Lane full, dropping oldest event '%s'",
+                         lane->task_name, synapse_event_bus_get_name(oldest.event_id));
+                note_dropped(lane, oldest.event_id);
+                discard_message(&oldest);
+            }
+        }
+        break;
+
+    case SYNAPSE_EVENT_OVERFLOW_SPILL:
+        // სათადარიგო ბუფერში მდგომ ივენთებს ახალი გამოქვეყნება არ უსწრებს: ჯერ ბუფერი ბრუნდება რიგში,
+        // ხოლო თუ ის ბოლომდე ვერ დაიცალა, ივენთი ბუფერის ბოლოში დგება
+        if (__atomic_load_n(&lane->spill_count, __ATOMIC_ACQUIRE) > 0)
+        {
+            refill_from_spill(lane);
+        }
+        if (__atomic_load_n(&lane->spill_count, __ATOMIC_ACQUIRE) == 0 && xQueueSend(queue, msg, 0) == pdPASS)
+        {
+            note_enqueued(lane, msg, (uint32_t)uxQueueMessagesWaiting(queue));
+            return ESP_OK;
+        }
+        if (spill_message(lane, msg) == ESP_OK)
+        {
+            // spill მრიცხველები spill_message()-შია; posted და high_watermark რიგში დაბრუნებისას აღირიცხება
+            return ESP_OK;
+        }
+        ESP_LOGD(TAG, "[%s] Spill buffer full, dropping event '%s'",
+                 lane->task_name, synapse_event_bus_get_name(msg->event_id));
+        break;
+
+    case SYNAPSE_EVENT_OVERFLOW_BLOCK:
+    default:
+        if (xQueueSend(queue, msg, pdMS_TO_TICKS(timeout_ms)) == pdPASS)
+        {
+            note_enqueued(lane, msg, (uint32_t)uxQueueMessagesWaiting(queue));
+            return ESP_OK;
+        }
+        ESP_LOGE(TAG, "[%s] Failed to post event '%s'. Queue might be full.",
+                 lane->task_name, synapse_event_bus_get_name(msg->event_id));
+        break;
+    }
+
+    note_dropped(lane, msg->event_id);
+    return ESP_FAIL;
+}
+
+/**
+ * @internal
+ * @brief ათავისუფლებს შეტყობინებას, რომელიც აღარ გაიგზავნება (conflation სლოტის ჩათვლით).
+ */
+static void discard_message(event_message_t *msg)
+{
+    synapse_event_conflation_claim(msg);
+    if (msg->data_wrapper)
+    {
+        synapse_event_data_release(msg->data_wrapper);
+        msg->data_wrapper = NULL;
+    }
+}
+
+/**
+ * @internal
+ * @brief conflating ივენთისთვის ცდილობს შეტყობინების შერწყმას რიგში მდგომთან.
+ * @details თუ იგივე ივენთი (იგივე გასაღებით) უკვე რიგშია, მას უბრალოდ ეცვლება
+ *          payload და ძველი მონაცემები თავისუფლდება. წინააღმდეგ შემთხვევაში
+ *          შეტყობინება შეიძლება გადაიქცეს token-ად, რომელიც რიგში უნდა ჩაიწეროს.
+ * @return true თუ შეტყობინება შეირწყა და რიგში აღარ უნდა ჩაიწეროს.
+ */
+static bool conflate_message(event_lane_t *lane, event_message_t *msg)
+{
+    event_descriptor_t *desc = synapse_event_registry_get(msg->event_id);
+    if (!desc || !(__atomic_load_n(&desc->flags, __ATOMIC_ACQUIRE) & EVENT_DESCRIPTOR_FLAG_CONFLATING))
+    {
+        return false;
+    }
+
+    synapse_event_conflation_key_fn_t key_fn = __atomic_load_n(&desc->conflation_key_fn, __ATOMIC_ACQUIRE);
+    uint32_t key = 0;
+    if (key_fn)
+    {
+        const void *payload = (msg->inline_size > 0) ? (const void *)msg->inline_data.bytes
+                              : (msg->data_wrapper ? msg->data_wrapper->payload : NULL);
+        key = key_fn(payload);
+    }
+
+    event_data_wrapper_t *replaced = NULL;
+    if (synapse_event_conflation_offer(msg, key, &replaced) != EVENT_CONFLATION_MERGED)
+    {
+        return false;
+    }
+
+    if (replaced)
+    {
+        synapse_event_data_release(replaced);
+    }
+    __atomic_fetch_add(&desc->conflated, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&lane->conflated, 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+/**
+ * @internal
+ * @brief ამოწმებს ID-ს და პრიორიტეტს და აბრუნებს შესაბამის (ინიციალიზებულ) ზოლს.
+ */
+static esp_err_t resolve_lane(synapse_event_id_t event_id, synapse_event_priority_t priority, event_lane_t **lane_out)
+{
+    if (event_id >= synapse_event_registry_count())
+    {
+        ESP_LOGE(TAG, "Invalid event ID: %u", event_id);
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (priority >= SYNAPSE_EVENT_PRIORITY_MAX)
+    {
+        ESP_LOGE(TAG, "Invalid priority %d for event '%s'", (int)priority, synapse_event_bus_get_name(event_id));
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_lanes[priority].dispatchers[0].queue)
+    {
+        ESP_LOGE(TAG, "Event Bus is not initialized.");
+        return ESP_ERR_INVALID_STATE;
+    }
+    *lane_out = &s_lanes[priority];
+    return ESP_OK;
+}
+
+/**
+ * @internal
+ * @brief აგზავნის მომზადებულ შეტყობინებას ზოლში (conflation-ის გათვალისწინებით).
+ * @details წარუმატებლობისას შეტყობინების მონაცემები თავისუფლდება.
+ * @return ESP_OK ან ESP_FAIL, თუ ზოლის პოლიტიკამ ივენთი უარყო.
+ */
+static esp_err_t submit_message(event_lane_t *lane, event_message_t *msg)
+{
+    EVENT_CAPTURE(msg, lane - s_lanes);
+    msg->dispatcher = partition_message(msg, false);
+    if (conflate_message(lane, msg))
+    {
+        return ESP_OK;
+    }
+
+    if (enqueue_event(lane, msg) != ESP_OK)
+    {
+        discard_message(msg);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @internal
+ * @brief ავსებს რიგის შეტყობინებას და იღებს wrapper-ის reference-ს.
+ * @details ნასესხები wrapper-ის payload კოპირდება ინლაინ არეში, რადგან ის
+ *          მიმდინარე handler-ის დასრულების შემდეგ აღარ იარსებებს.
+ * @return ESP_OK ან ESP_ERR_INVALID_SIZE, თუ ნასესხები payload ინლაინ არეში არ ეტევა.
+ */
+static esp_err_t prepare_message(synapse_event_id_t event_id, event_data_wrapper_t *data_wrapper, event_message_t *msg)
+{
+    msg->event_id = event_id;
+    msg->inline_size = 0;
+    msg->flags = 0;
+    msg->dispatcher = 0;
+    msg->conflation_slot = 0;
+    msg->data_wrapper = data_wrapper;
+    msg->posted_at_us = (uint32_t)esp_timer_get_time();
+
+    if (synapse_event_data_is_borrowed(data_wrapper))
+    {
+        if (data_wrapper->payload_size == 0 || data_wrapper->payload_size > EVENT_INLINE_PAYLOAD_SIZE)
+        {
+            ESP_LOGE(TAG, "Cannot re-post borrowed payload of event '%s' (%u bytes).",
+                     synapse_event_bus_get_name(event_id), data_wrapper->payload_size);
+            return ESP_ERR_INVALID_SIZE;
+        }
+        memcpy(msg->inline_data.bytes, data_wrapper->payload, data_wrapper->payload_size);
+        msg->inline_size = (uint8_t)data_wrapper->payload_size;
+        msg->data_wrapper = NULL;
+    }
+    else if (data_wrapper)
+    {
+        synapse_event_data_acquire(data_wrapper);
+    }
+    return ESP_OK;
+}
+
+/**
+ * @internal
+ * @brief არეგისტრირებს pattern-ის გამოწერას (`sensor.+.temperature`, `SYNAPSE_RELAY.*`).
+ */
+static esp_err_t subscribe_pattern(const char *pattern, module_t *module)
+{
+    if (!module || !module->base.handle_event)
+    {
+        ESP_LOGE(TAG, "Subscribe failed: module or its event handler is NULL.");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = synapse_event_subscriptions_add_pattern(pattern, module);
+    switch (ret)
+    {
+    case ESP_OK:
+        ESP_LOGI(TAG, "Module '%s' subscribed successfully to pattern '%s'", module->name, pattern);
+        break;
+    case ESP_ERR_INVALID_STATE:
+        ESP_LOGW(TAG, "Module '%s' is already subscribed to pattern '%s'", module->name, pattern);
+        ret = ESP_OK;
+        break;
+    case ESP_ERR_INVALID_ARG:
+        ESP_LOGE(TAG, "Invalid pattern '%s': empty segment or '*' not in the last segment.", pattern);
+        break;
+    default:
+        ESP_LOGE(TAG, "Failed to subscribe module '%s' to pattern '%s': %s", module->name, pattern, esp_err_to_name(ret));
+        break;
+    }
+    return ret;
+}
+
+/**
+ * @internal
+ * @brief აუქმებს pattern-ის გამოწერას.
+ */
+static esp_err_t unsubscribe_pattern(const char *pattern, module_t *module)
+{
+    esp_err_t ret = synapse_event_subscriptions_remove_pattern(pattern, module);
+    if (ret == ESP_OK)
+    {
+        ret = wait_for_module_idle(module);
+        if (ret == ESP_OK)
+        {
+            ESP_LOGI(TAG, "Module '%s' unsubscribed successfully from pattern '%s'", module->name, pattern);
+        }
+        else
+        {
+            ESP_LOGW(TAG, "Module '%s' unsubscribed from pattern '%s', but a dispatcher may still call it (%s)",
+                     module->name, pattern, esp_err_to_name(ret));
+        }
+    }
+    else if (ret == ESP_ERR_NOT_FOUND)
+    {
+        ESP_LOGW(TAG, "Module '%s' was not subscribed to pattern '%s'", module->name, pattern);
+    }
+    else
+    {
+        ESP_LOGE(TAG, "Failed to unsubscribe module '%s' from pattern '%s': %s", module->name, pattern, esp_err_to_name(ret));
+    }
+    return ret;
+}
+
+/**
+ * @internal
+ * @brief ამატებს მოდულს ივენთის გამომწერებში (ფილტრით ან მის გარეშე, sync ან async) და ლოგავს შედეგს.
+ * @details უკვე გამოწერილი მოდული შეცდომა არ არის: არსებული გამოწერა (მისი ფილტრი
+ *          და რეჟიმი) უცვლელი რჩება და ბრუნდება ESP_OK, როგორც pattern-ებისას.
+ * @return ESP_OK ან შეცდომა.
+ */
+static esp_err_t subscribe_module(synapse_event_id_t event_id, module_t *module, const synapse_event_filter_t *filter,
+                                  bool sync)
+{
+    const char *event_name = synapse_event_bus_get_name(event_id);
+    if (!event_name)
+    {
+        ESP_LOGE(TAG, "Subscribe failed: invalid event ID %u.", event_id);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!module || !module->base.handle_event)
+    {
+        ESP_LOGE(TAG, "Subscribe failed: module or its event handler is NULL.");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = synapse_event_subscriptions_add(event_id, module, filter, sync);
+    switch (ret)
+    {
+    case ESP_OK:
+        ESP_LOGI(TAG, "Module '%s' subscribed successfully to event '%s'%s%s", module->name, event_name,
+                 filter ? " (filtered)" : "", sync ? " (sync)" : "");
+        break;
+    case ESP_ERR_INVALID_STATE:
+        ESP_LOGW(TAG, "Module '%s' is already subscribed to event '%s'", module->name, event_name);
+        ret = ESP_OK; // არ არის შეცდომა, უბრალოდ უკვე გამოწერილია
+        break;
+    case ESP_ERR_INVALID_SIZE:
+        ESP_LOGE(TAG, "Cannot subscribe module '%s' to event '%s'. Subscriber limit reached.", module->name, event_name);
+        ret = ESP_ERR_NO_MEM;
+        break;
+    case ESP_ERR_TIMEOUT:
+        ESP_LOGE(TAG, "Failed to acquire subscription mutex for module '%s' and event '%s'", module->name, event_name);
+        break;
+    default:
+        ESP_LOGE(TAG, "Failed to subscribe module '%s' to event '%s': %s", module->name, event_name, esp_err_to_name(ret));
+        break;
+    }
+    return ret;
+}
+
+/**
+ * @internal
+ * @brief აჩერებს დისპეტჩერებს და შლის ზოლების რიგებს (ინიციალიზაციის შეცდომისას).
+ */
+static void destroy_lanes(void)
+{
+    for (int i = 0; i < SYNAPSE_EVENT_PRIORITY_MAX; i++)
+    {
+        for (int d = 0; d < EVENT_LANE_DISPATCHERS; d++)
+        {
+            event_dispatcher_t *dispatcher = &s_lanes[i].dispatchers[d];
+            if (dispatcher->task)
+            {
+                vTaskDelete(dispatcher->task);
+                dispatcher->task = NULL;
+            }
+            if (dispatcher->queue)
+            {
+                vQueueDelete(dispatcher->queue);
+                dispatcher->queue = NULL;
+            }
+            free(dispatcher->batch);
+            dispatcher->batch = NULL;
+            synapse_event_scratch_deinit(&dispatcher->scratch);
+        }
+        free(s_lanes[i].spill);
+        s_lanes[i].spill = NULL;
+        s_lanes[i].spill_head = 0;
+        s_lanes[i].spill_count = 0;
+    }
+#if EVENT_LANE_DISPATCHERS > 1
+    for (int i = 0; i < CONFIG_SYNAPSE_MAX_MODULES; i++)
+    {
+        if (s_module_locks[i])
+        {
+            vSemaphoreDelete(s_module_locks[i]);
+            s_module_locks[i] = NULL;
+        }
+    }
+#endif
+}
+
+// --- შიდა API ფუნქციები ---
+
+bool synapse_event_bus_is_routed(const module_t *module, synapse_event_id_t event_id)
+{
+    const char *event_name = synapse_event_bus_get_name(event_id);
+    if (!module || !event_name)
+    {
+        return false;
+    }
+    bool is_wildcard = (event_id == SYNAPSE_EVENT_ID_WILDCARD);
+    uint32_t read_token = synapse_event_subscriptions_read_lock();
+    bool routed = snapshot_contains(synapse_event_subscriptions_get(SYNAPSE_EVENT_ID_WILDCARD), module);
+    if (!routed && !is_wildcard)
+    {
+        const event_subscriber_snapshot_t *statics = synapse_event_subscriptions_get_static(event_id);
+        routed = snapshot_contains(synapse_event_subscriptions_get(event_id), module) ||
+                 (module_accepts_routed(module) && snapshot_contains(statics, module));
+    }
+    const event_pattern_trie_t *patterns = is_wildcard ? NULL : synapse_event_subscriptions_get_patterns();
+    if (!routed && patterns)
+    {
+        module_t *matched[EVENT_MAX_PATTERN_MATCHES];
+        bool overflow = false;
+        size_t matched_count = synapse_event_pattern_trie_match(patterns, event_name, matched,
+                                                                EVENT_MAX_PATTERN_MATCHES, &overflow);
+        for (size_t i = 0; i < matched_count && !routed; i++)
+        {
+            routed = (matched[i] == module);
+        }
+    }
+    synapse_event_subscriptions_read_unlock(read_token);
+    return routed;
+}
+
+// --- საჯარო API ფუნქციები ---
+
+esp_err_t synapse_event_bus_init(void)
+{
+    ESP_LOGI(TAG, "Initializing Event Bus...");
+    if (s_initialized)
+    {
+        ESP_LOGW(TAG, "Event Bus is already initialized.");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t err = synapse_event_registry_init();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize event registry: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    err = synapse_event_subscriptions_init();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize subscription store: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    err = synapse_event_conflation_init();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize conflation slots: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    err = synapse_event_timer_init();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize timing wheel: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    err = synapse_event_request_init();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize request table: %s", esp_err_to_name(err));
+        return err;
+    }
+
+#if EVENT_LANE_DISPATCHERS > 1
+    for (int i = 0; i < CONFIG_SYNAPSE_MAX_MODULES; i++)
+    {
+        s_module_locks[i] = xSemaphoreCreateMutex();
+        if (!s_module_locks[i])
+        {
+            ESP_LOGE(TAG, "Failed to create module dispatch locks.");
+            destroy_lanes();
+            return ESP_ERR_NO_MEM;
+        }
+    }
+#endif
+
+    for (int i = 0; i < SYNAPSE_EVENT_PRIORITY_MAX; i++)
+    {
+        bool created = true;
+        for (int d = 0; d < EVENT_LANE_DISPATCHERS; d++)
+        {
+            event_dispatcher_t *dispatcher = &s_lanes[i].dispatchers[d];
+            dispatcher->lane = &s_lanes[i];
+            // per-core რეჟიმში თითო დისპეტჩერს ზოლის სრული სიგრძის საკუთარი რიგი აქვს
+            dispatcher->queue = xQueueCreate(s_lanes[i].queue_length, sizeof(event_message_t));
+            dispatcher->batch = (event_message_t *)calloc(EVENT_DISPATCH_BATCH_SIZE, sizeof(event_message_t));
+            created = created && dispatcher->queue && dispatcher->batch &&
+                      synapse_event_scratch_init(&dispatcher->scratch) == ESP_OK;
+        }
+#if EVENT_SPILL_BUFFER_LENGTH > 0
+        s_lanes[i].spill = (event_message_t *)calloc(EVENT_SPILL_BUFFER_LENGTH, sizeof(event_message_t));
+        if (!s_lanes[i].spill) {
+            ESP_LOGE(TAG, "Failed to allocate spill buffer for lane '%s'.", s_lanes[i].task_name);
+            destroy_lanes();
+            return ESP_ERR_NO_MEM;
+        }
+#endif
+        if (!created) {
+            ESP_LOGE(TAG, "Failed to create event queue for lane '%s'.", s_lanes[i].task_name);
+            destroy_lanes();
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    for (int i = 0; i < SYNAPSE_EVENT_PRIORITY_MAX; i++)
+    {
+        for (int d = 0; d < EVENT_LANE_DISPATCHERS; d++)
+        {
+            event_dispatcher_t *dispatcher = &s_lanes[i].dispatchers[d];
+#if EVENT_LANE_DISPATCHERS > 1
+            snprintf(dispatcher->task_name, sizeof(dispatcher->task_name), "%s%d", s_lanes[i].task_name, d);
+            BaseType_t result = xTaskCreatePinnedToCore(event_bus_task, dispatcher->task_name,
+                                                        CONFIG_SYNAPSE_EVENT_BUS_TASK_STACK_SIZE, dispatcher,
+                                                        s_lanes[i].task_priority, &dispatcher->task, d);
+#else
+            snprintf(dispatcher->task_name, sizeof(dispatcher->task_name), "%s", s_lanes[i].task_name);
+            BaseType_t result = xTaskCreate(event_bus_task, dispatcher->task_name, CONFIG_SYNAPSE_EVENT_BUS_TASK_STACK_SIZE,
+                                            dispatcher, s_lanes[i].task_priority, &dispatcher->task);
+#endif
+            if (result != pdPASS) {
+                ESP_LOGE(TAG, "Failed to create dispatcher task '%s'.", dispatcher->task_name);
+                destroy_lanes();
+                return ESP_FAIL;
+            }
+        }
+    }
+    s_stats_since_us = esp_timer_get_time();
+    s_initialized = true;
+    ESP_LOGI(TAG, "Event Bus initialized with %d priority lanes, %d dispatcher(s) each.", SYNAPSE_EVENT_PRIORITY_MAX,
+             EVENT_LANE_DISPATCHERS);
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_bus_post(const char *event_name, event_data_wrapper_t *data_wrapper)
+{
+    if (!event_name || strlen(event_name) == 0)
+    {
+        ESP_LOGE(TAG, "Invalid event name: NULL or empty string.");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    synapse_event_id_t event_id = SYNAPSE_EVENT_ID_INVALID;
+    esp_err_t err = resolve_post_name(event_name, &event_id);
+    if (err != ESP_OK)
+    {
+        // მიმღები არავინ ჰყავს - ივენთი ისე "მიწოდებულია", როგორც გამომწერების გარეშე ცნობილი სახელი
+        return (err == ESP_ERR_NOT_FOUND) ? ESP_OK : err;
+    }
+
+    return synapse_event_bus_post_id(event_id, data_wrapper);
+}
+
+esp_err_t synapse_event_bus_post_id(synapse_event_id_t event_id, event_data_wrapper_t *data_wrapper)
+{
+    return synapse_event_bus_post_id_with_priority(event_id, data_wrapper,
+                                                   synapse_event_bus_get_default_priority(event_id));
+}
+
+esp_err_t synapse_event_bus_post_with_priority(const char *event_name,
+                                               event_data_wrapper_t *data_wrapper,
+                                               synapse_event_priority_t priority)
+{
+    if (!event_name || strlen(event_name) == 0)
+    {
+        ESP_LOGE(TAG, "Invalid event name: NULL or empty string.");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    synapse_event_id_t event_id = SYNAPSE_EVENT_ID_INVALID;
+    esp_err_t err = resolve_post_name(event_name, &event_id);
+    if (err != ESP_OK)
+    {
+        // მიმღები არავინ ჰყავს - ივენთი ისე "მიწოდებულია", როგორც გამომწერების გარეშე ცნობილი სახელი
+        return (err == ESP_ERR_NOT_FOUND) ? ESP_OK : err;
+    }
+
+    return synapse_event_bus_post_id_with_priority(event_id, data_wrapper, priority);
+}
+
+esp_err_t synapse_event_bus_post_id_with_priority(synapse_event_id_t event_id,
+                                                  event_data_wrapper_t *data_wrapper,
+                                                  synapse_event_priority_t priority)
+{
+    event_lane_t *lane = NULL;
+    esp_err_t err = resolve_lane(event_id, priority, &lane);
+    if (err != ESP_OK)
+    {
+        return err;
+    }
+
+    event_message_t msg;
+    err = prepare_message(event_id, data_wrapper, &msg);
+    if (err != ESP_OK)
+    {
+        return err;
+    }
+    return submit_message(lane, &msg);
+}
+
+esp_err_t synapse_event_bus_post_inline(synapse_event_id_t event_id, const void *payload, size_t payload_size)
+{
+    return synapse_event_bus_post_inline_with_priority(event_id, payload, payload_size,
+                                                       synapse_event_bus_get_default_priority(event_id));
+}
+
+esp_err_t synapse_event_bus_post_inline_with_priority(synapse_event_id_t event_id,
+                                                      const void *payload,
+                                                      size_t payload_size,
+                                                      synapse_event_priority_t priority)
+{
+    if (payload_size > 0 && !payload)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (payload_size > EVENT_INLINE_PAYLOAD_SIZE)
+    {
+        ESP_LOGE(TAG, "Payload of event '%s' (%u bytes) exceeds the inline limit of %d bytes.",
+                 synapse_event_bus_get_name(event_id), (unsigned)payload_size, EVENT_INLINE_PAYLOAD_SIZE);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    event_lane_t *lane = NULL;
+    esp_err_t err = resolve_lane(event_id, priority, &lane);
+    if (err != ESP_OK)
+    {
+        return err;
+    }
+
+    // იგივე ფორმატი, რასაც ISR-იდან გამოქვეყნება იყენებს: payload კოპირდება რიგის სლოტში, heap-ის გარეშე
+    event_message_t msg = {
+        .event_id = event_id,
+        .inline_size = (uint8_t)payload_size,
+        .flags = 0,
+        .data_wrapper = NULL,
+        .posted_at_us = (uint32_t)esp_timer_get_time(),
+    };
+    if (payload_size > 0)
+    {
+        memcpy(msg.inline_data.bytes, payload, payload_size);
+    }
+    return submit_message(lane, &msg);
+}
+
+esp_err_t synapse_event_bus_post_batch(const synapse_event_batch_entry_t *entries, size_t count, size_t *posted_out)
+{
+    if (posted_out)
+    {
+        *posted_out = 0;
+    }
+    if (!entries || count == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        if (entries[i].event_id >= synapse_event_registry_count())
+        {
+            ESP_LOGE(TAG, "Batch rejected: invalid event ID %u at index %u", entries[i].event_id, (unsigned)i);
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    event_message_t chunk[EVENT_POST_BATCH_CHUNK];
+    uint8_t chunk_lane[EVENT_POST_BATCH_CHUNK];
+    size_t posted = 0;
+    size_t next = 0;
+    esp_err_t ret = ESP_OK;
+
+    while (next < count && ret == ESP_OK)
+    {
+        // 1. მომზადება scheduler-ის შეჩერებამდე: აქ სრულდება ლოგირება, გასაღების ფუნქცია, capture-ის encoder
+        //    და შერწყმისას ძველი payload-ის გათავისუფლება - არცერთი არ არის დასაშვები შეჩერებულ scheduler-ზე
+        size_t prepared = 0;
+        while (prepared < EVENT_POST_BATCH_CHUNK && next < count)
+        {
+            const synapse_event_batch_entry_t *entry = &entries[next];
+            chunk_lane[prepared] = (uint8_t)synapse_event_bus_get_default_priority(entry->event_id);
+            if (!s_lanes[chunk_lane[prepared]].dispatchers[0].queue)
+            {
+                ret = ESP_ERR_INVALID_STATE;
+                break;
+            }
+            if (prepare_message(entry->event_id, entry->data_wrapper, &chunk[prepared]) != ESP_OK)
+            {
+                ret = ESP_ERR_INVALID_SIZE;
+                break;
+            }
+            next++;
+            EVENT_CAPTURE(&chunk[prepared], chunk_lane[prepared]);
+            chunk[prepared].dispatcher = partition_message(&chunk[prepared], false);
+            // შერწყმული ივენთი რიგში მდგომ შეტყობინებას ჩაენაცვლა - გამოქვეყნებულად ითვლება, პაკეტში აღარ რჩება
+            if (conflate_message(&s_lanes[chunk_lane[prepared]], &chunk[prepared]))
+            {
+                posted++;
+                continue;
+            }
+            prepared++;
+        }
+
+        // 2. ჩაწერა scheduler-ის შეჩერებით: დისპეტჩერები იღვიძებენ ერთხელ, მთელი პაკეტის შემდეგ
+        size_t sent = 0;
+        vTaskSuspendAll();
+        while (sent < prepared)
+        {
+            event_lane_t *lane = &s_lanes[chunk_lane[sent]];
+            QueueHandle_t queue = message_queue(lane, &chunk[sent]);
+            // spill ბუფერში მდგომ ივენთებს რიგს ვერ გადაასწრებს - ასეთი ზოლი მე-3 ნაბიჯზე გადადის
+            if (__atomic_load_n(&lane->spill_count, __ATOMIC_ACQUIRE) > 0 || xQueueSend(queue, &chunk[sent], 0) != pdPASS)
+            {
+                break;
+            }
+            note_enqueued(lane, &chunk[sent], (uint32_t)uxQueueMessagesWaiting(queue));
+            sent++;
+        }
+        xTaskResumeAll();
+        posted += sent;
+
+        // 3. დარჩენილები (სავსე ზოლი) გადის ზოლის ჩვეულებრივ გადავსების პოლიტიკაზე, თანმიმდევრობის შენარჩუნებით.
+        //    პირველი უარის შემდეგ დანარჩენი ივენთები აღარ იგზავნება.
+        bool rejected = false;
+        for (; sent < prepared; sent++)
+        {
+            event_lane_t *lane = &s_lanes[chunk_lane[sent]];
+            if (!rejected && enqueue_event(lane, &chunk[sent]) == ESP_OK)
+            {
+                posted++;
+                continue;
+            }
+            rejected = true;
+            discard_message(&chunk[sent]);
+        }
+        if (rejected && ret == ESP_OK)
+        {
+            ret = ESP_FAIL;
+        }
+    }
+
+    if (posted_out)
+    {
+        *posted_out = posted;
+    }
+    return ret;
+}
+
+esp_err_t synapse_event_bus_post_from_isr(synapse_event_id_t event_id,
+                                          const void *payload,
+                                          size_t payload_size,
+                                          BaseType_t *higher_priority_task_woken)
+{
+    // ISR კონტექსტში ლოგირება აკრძალულია - შეცდომები მხოლოდ კოდით ბრუნდება
+    if (event_id >= synapse_event_registry_count() || payload_size > EVENT_INLINE_PAYLOAD_SIZE ||
+        (payload_size > 0 && !payload))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    event_lane_t *lane = &s_lanes[synapse_event_bus_get_default_priority(event_id)];
+    if (!lane->dispatchers[0].queue)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // ISR-დან გამოქვეყნება არასდროს ერწყმის (conflation სლოტები spinlock-ით და wrapper-ის გათავისუფლებით მუშაობს)
+    event_message_t msg = {
+        .event_id = event_id,
+        .inline_size = (uint8_t)payload_size,
+        .flags = 0,
+        .data_wrapper = NULL,
+        .posted_at_us = (uint32_t)esp_timer_get_time(),
+    };
+    if (payload_size > 0)
+    {
+        memcpy(msg.inline_data.bytes, payload, payload_size);
+    }
+    EVENT_CAPTURE_FROM_ISR(&msg, lane - s_lanes, higher_priority_task_woken);
+    msg.dispatcher = partition_message(&msg, true);
+    QueueHandle_t queue = message_queue(lane, &msg);
+
+    // ISR-ს არ შეუძლია დალოდება ან უძველესი ივენთის გათავისუფლება, ამიტომ სავსე ზოლში ახალი ივენთი იკარგება
+    if (xQueueSendFromISR(queue, &msg, higher_priority_task_woken) != pdPASS)
+    {
+        note_dropped(lane, event_id);
+        return ESP_FAIL;
+    }
+    note_enqueued(lane, &msg, (uint32_t)uxQueueMessagesWaitingFromISR(queue));
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_bus_publish_sync(const char *event_name, event_data_wrapper_t *data_wrapper)
+{
+    if (!event_name || strlen(event_name) == 0)
+    {
+        ESP_LOGE(TAG, "Invalid event name: NULL or empty string.");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    synapse_event_id_t event_id = SYNAPSE_EVENT_ID_INVALID;
+    esp_err_t err = resolve_post_name(event_name, &event_id);
+    if (err != ESP_OK)
+    {
+        // მიმღები არავინ ჰყავს - ივენთი ისე "მიწოდებულია", როგორც გამომწერების გარეშე ცნობილი სახელი
+        return (err == ESP_ERR_NOT_FOUND) ? ESP_OK : err;
+    }
+
+    return synapse_event_bus_publish_sync_id(event_id, data_wrapper);
+}
+
+esp_err_t synapse_event_bus_publish_sync_id(synapse_event_id_t event_id, event_data_wrapper_t *data_wrapper)
+{
+    const char *event_name = synapse_event_bus_get_name(event_id);
+    if (!event_name)
+    {
+        ESP_LOGE(TAG, "Invalid event ID: %u", event_id);
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_initialized || xPortInIsrContext())
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    synapse_event_priority_t priority = synapse_event_bus_get_default_priority(event_id);
+    event_message_t msg = {
+        .event_id = event_id,
+        .data_wrapper = data_wrapper,
+        .posted_at_us = (uint32_t)esp_timer_get_time(),
+    };
+    // ჩაწერა payload-ს მაშინვე აკოპირებს, ამიტომ wrapper-ის reference აქ საჭირო არ არის
+    EVENT_CAPTURE(&msg, priority);
+
+    // გამომქვეყნებლის wrapper ცოცხალია მთელი გამოძახების განმავლობაში; ნასესხებს reference counting არ აქვს
+    bool counted = data_wrapper && !synapse_event_data_is_borrowed(data_wrapper);
+    bool is_wildcard = (event_id == SYNAPSE_EVENT_ID_WILDCARD);
+
+    const void *payload = data_wrapper ? data_wrapper->payload : NULL;
+    event_delivery_t delivery = {0};
+
+    uint32_t read_token = synapse_event_subscriptions_read_lock();
+    const event_subscriber_snapshot_t *specific = is_wildcard ? NULL : synapse_event_subscriptions_get(event_id);
+    const event_subscriber_snapshot_t *routed = is_wildcard ? NULL : synapse_event_subscriptions_get_static(event_id);
+    const event_subscriber_snapshot_t *wildcard = synapse_event_subscriptions_get(SYNAPSE_EVENT_ID_WILDCARD);
+    const event_pattern_trie_t *patterns = is_wildcard ? NULL : synapse_event_subscriptions_get_patterns();
+
+    collect_snapshot(&delivery, specific, NULL, NULL, event_id, payload, EVENT_DELIVER_SYNC_ONLY, false);
+    collect_snapshot(&delivery, routed, specific, NULL, event_id, payload, EVENT_DELIVER_SYNC_ONLY, true);
+    collect_snapshot(&delivery, wildcard, specific, routed, event_id, payload, EVENT_DELIVER_SYNC_ONLY, false);
+    bool forward = has_async_subscribers(specific, routed, wildcard, patterns, event_name);
+    synapse_event_subscriptions_read_unlock(read_token);
+
+    uint32_t delivered = run_delivery(&delivery, event_id, event_name, data_wrapper, counted, true);
+
+    uint32_t elapsed_us = (uint32_t)esp_timer_get_time() - msg.posted_at_us;
+    __atomic_fetch_add(&s_sync_stats.published, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&s_sync_stats.handler_calls, delivered, __ATOMIC_RELAXED);
+    atomic_store_max(&s_sync_stats.max_dispatch_us, elapsed_us);
+
+    if (!forward)
+    {
+        return ESP_OK;
+    }
+
+    // დანარჩენი გამომწერები ივენთს ჩვეულებრივად, ზოლის დისპეტჩერიდან იღებენ
+    esp_err_t err = prepare_message(event_id, data_wrapper, &msg);
+    if (err != ESP_OK)
+    {
+        __atomic_fetch_add(&s_sync_stats.failed, 1, __ATOMIC_RELAXED);
+        return err;
+    }
+    msg.flags |= EVENT_MESSAGE_FLAG_SYNC_DELIVERED;
+    msg.dispatcher = partition_message(&msg, false);
+
+    // conflation-ს გვერდს ვუვლით: რიგში მდგომ შეტყობინებასთან შერწყმისას sync გამომწერები ივენთს მეორედ მიიღებდნენ
+    if (enqueue_event(&s_lanes[priority], &msg) != ESP_OK)
+    {
+        discard_message(&msg);
+        __atomic_fetch_add(&s_sync_stats.failed, 1, __ATOMIC_RELAXED);
+        return ESP_FAIL;
+    }
+    __atomic_fetch_add(&s_sync_stats.forwarded, 1, __ATOMIC_RELAXED);
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_bus_publish_sync_inline(synapse_event_id_t event_id, const void *payload, size_t payload_size)
+{
+    if (payload_size > 0 && !payload)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (payload_size > EVENT_INLINE_PAYLOAD_SIZE)
+    {
+        ESP_LOGE(TAG, "Payload of event '%s' (%u bytes) exceeds the inline limit of %d bytes.",
+                 synapse_event_bus_get_name(event_id), (unsigned)payload_size, EVENT_INLINE_PAYLOAD_SIZE);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    // სტეკზე აგებული ნასესხები wrapper: sync handler-ები payload-ს პირდაპირ კითხულობენ,
+    // რიგში გადაგზავნისას კი `prepare_message` მას ინლაინ არეში აკოპირებს
+    event_data_wrapper_t borrowed = {
+        .ref_count = 1,
+        .payload = (void *)payload,
+        .payload_size = (uint16_t)payload_size,
+        .flags = SYNAPSE_EVENT_DATA_FLAG_BORROWED,
+    };
+    return synapse_event_bus_publish_sync_id(event_id, payload_size > 0 ? &borrowed : NULL);
+}
+
+esp_err_t synapse_event_bus_get_sync_stats(synapse_event_sync_stats_t *stats)
+{
+    if (!stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    stats->published = __atomic_load_n(&s_sync_stats.published, __ATOMIC_RELAXED);
+    stats->handler_calls = __atomic_load_n(&s_sync_stats.handler_calls, __ATOMIC_RELAXED);
+    stats->forwarded = __atomic_load_n(&s_sync_stats.forwarded, __ATOMIC_RELAXED);
+    stats->failed = __atomic_load_n(&s_sync_stats.failed, __ATOMIC_RELAXED);
+    stats->max_dispatch_us = __atomic_load_n(&s_sync_stats.max_dispatch_us, __ATOMIC_RELAXED);
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_bus_get_lane_stats(synapse_event_priority_t priority, synapse_event_lane_stats_t *stats)
+{
+    if (priority >= SYNAPSE_EVENT_PRIORITY_MAX || !stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const event_lane_t *lane = &s_lanes[priority];
+    if (!lane->dispatchers[0].queue)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    stats->queue_length = lane->queue_length * EVENT_LANE_DISPATCHERS;
+    stats->pending = lane_pending(lane);
+    stats->posted = __atomic_load_n(&lane->posted, __ATOMIC_RELAXED);
+    stats->dispatched = __atomic_load_n(&lane->dispatched, __ATOMIC_RELAXED);
+    stats->dropped = __atomic_load_n(&lane->dropped, __ATOMIC_RELAXED);
+    stats->max_latency_us = __atomic_load_n(&lane->max_latency_us, __ATOMIC_RELAXED);
+    stats->dispatch_batches = __atomic_load_n(&lane->dispatch_batches, __ATOMIC_RELAXED);
+    stats->conflated = __atomic_load_n(&lane->conflated, __ATOMIC_RELAXED);
+    stats->inline_posted = __atomic_load_n(&lane->inline_posted, __ATOMIC_RELAXED);
+    stats->high_watermark = __atomic_load_n(&lane->high_watermark, __ATOMIC_RELAXED);
+    stats->spilled = __atomic_load_n(&lane->spilled, __ATOMIC_RELAXED);
+    stats->spill_pending = __atomic_load_n(&lane->spill_count, __ATOMIC_RELAXED);
+    stats->spill_high_watermark = __atomic_load_n(&lane->spill_high_watermark, __ATOMIC_RELAXED);
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_bus_get_dispatcher_stats(synapse_event_priority_t priority, uint8_t index,
+                                                 synapse_event_dispatcher_stats_t *stats)
+{
+    if (priority >= SYNAPSE_EVENT_PRIORITY_MAX || index >= EVENT_LANE_DISPATCHERS || !stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const event_dispatcher_t *dispatcher = &s_lanes[priority].dispatchers[index];
+    if (!dispatcher->queue)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // ერთი დისპეტჩერი ბირთვზე მიბმული არ არის
+    stats->core = (EVENT_LANE_DISPATCHERS > 1) ? index : SYNAPSE_EVENT_DISPATCHER_UNPINNED;
+    stats->pending = (uint32_t)uxQueueMessagesWaiting(dispatcher->queue);
+    stats->dispatched = __atomic_load_n(&dispatcher->dispatched, __ATOMIC_RELAXED);
+    return ESP_OK;
+}
+
+uint8_t synapse_event_bus_get_dispatcher_count(void)
+{
+    return EVENT_LANE_DISPATCHERS;
+}
+
+esp_err_t synapse_event_bus_set_module_concurrent(module_t *module, bool concurrent)
+{
+    if (!module)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+#if EVENT_LANE_DISPATCHERS > 1
+    // 0 - სლოტი ხელახლა მიენიჭება შემდეგ მიწოდებაზე
+    __atomic_store_n(&module->dispatch_slot, concurrent ? EVENT_MODULE_SLOT_CONCURRENT : 0, __ATOMIC_RELEASE);
+#endif
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_bus_get_latency_stats(synapse_event_priority_t priority, synapse_event_latency_stats_t *stats)
+{
+    if (priority >= SYNAPSE_EVENT_PRIORITY_MAX || !stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+#ifdef CONFIG_SYNAPSE_EVENT_LATENCY_HISTOGRAM
+    const event_lane_t *lane = &s_lanes[priority];
+    stats->samples = __atomic_load_n(&lane->latency.samples, __ATOMIC_RELAXED);
+    stats->max_us = __atomic_load_n(&lane->max_latency_us, __ATOMIC_RELAXED);
+    // bucket-ის ზედა საზღვარი შეიძლება აღემატებოდეს ზუსტ მაქსიმუმს
+    uint32_t p50 = synapse_event_latency_percentile(&lane->latency, 500);
+    uint32_t p99 = synapse_event_latency_percentile(&lane->latency, 990);
+    uint32_t p999 = synapse_event_latency_percentile(&lane->latency, 999);
+    stats->p50_us = (p50 < stats->max_us) ? p50 : stats->max_us;
+    stats->p99_us = (p99 < stats->max_us) ? p99 : stats->max_us;
+    stats->p999_us = (p999 < stats->max_us) ? p999 : stats->max_us;
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+/**
+ * @internal
+ * @brief აგებს ერთი ზოლის სტატისტიკის JSON ობიექტს.
+ */
+static cJSON *lane_stats_to_json(synapse_event_priority_t priority, int64_t window_us)
+{
+    synapse_event_lane_stats_t st;
+    if (synapse_event_bus_get_lane_stats(priority, &st) != ESP_OK)
+    {
+        return NULL;
+    }
+
+    cJSON *obj = cJSON_CreateObject();
+    if (!obj)
+    {
+        return NULL;
+    }
+    cJSON_AddStringToObject(obj, "lane", s_lane_names[priority]);
+    cJSON_AddNumberToObject(obj, "queue_length", st.queue_length);
+    cJSON_AddNumberToObject(obj, "pending", st.pending);
+    cJSON_AddNumberToObject(obj, "high_watermark", st.high_watermark);
+    cJSON_AddNumberToObject(obj, "posted", st.posted);
+    cJSON_AddNumberToObject(obj, "dispatched", st.dispatched);
+    cJSON_AddNumberToObject(obj, "dropped", st.dropped);
+    cJSON_AddNumberToObject(obj, "spilled", st.spilled);
+    cJSON_AddNumberToObject(obj, "conflated", st.conflated);
+    cJSON_AddNumberToObject(obj, "inline_posted", st.inline_posted);
+    cJSON_AddNumberToObject(obj, "dispatch_batches", st.dispatch_batches);
+    cJSON_AddNumberToObject(obj, "events_per_sec", window_us > 0 ? (double)st.dispatched * 1e6 / (double)window_us : 0.0);
+
+    synapse_event_latency_stats_t lat;
+    if (synapse_event_bus_get_latency_stats(priority, &lat) == ESP_OK)
+    {
+        cJSON *latency = cJSON_AddObjectToObject(obj, "latency_us");
+        if (latency)
+        {
+            cJSON_AddNumberToObject(latency, "samples", lat.samples);
+            cJSON_AddNumberToObject(latency, "p50", lat.p50_us);
+            cJSON_AddNumberToObject(latency, "p99", lat.p99_us);
+            cJSON_AddNumberToObject(latency, "p999", lat.p999_us);
+            cJSON_AddNumberToObject(latency, "max", lat.max_us);
+        }
+    }
+
+#if EVENT_LANE_DISPATCHERS > 1
+    cJSON *dispatchers = cJSON_AddArrayToObject(obj, "dispatchers");
+    for (uint8_t d = 0; dispatchers && d < EVENT_LANE_DISPATCHERS; d++)
+    {
+        synapse_event_dispatcher_stats_t ds;
+        cJSON *item = (synapse_event_bus_get_dispatcher_stats(priority, d, &ds) == ESP_OK) ? cJSON_CreateObject() : NULL;
+        if (!item)
+        {
+            continue;
+        }
+        cJSON_AddNumberToObject(item, "core", ds.core);
+        cJSON_AddNumberToObject(item, "pending", ds.pending);
+        cJSON_AddNumberToObject(item, "dispatched", ds.dispatched);
+        cJSON_AddItemToArray(dispatchers, item);
+    }
+#endif
+    return obj;
+}
+
+esp_err_t synapse_event_bus_get_stats_json(char **json_out)
+{
+    if (!json_out)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *json_out = NULL;
+    if (!s_initialized)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    int64_t window_us = esp_timer_get_time() - s_stats_since_us;
+    cJSON *root = cJSON_CreateObject();
+    if (!root)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    cJSON_AddNumberToObject(root, "window_us", (double)window_us);
+    cJSON *lanes = cJSON_AddArrayToObject(root, "lanes");
+    cJSON *data = cJSON_AddObjectToObject(root, "data");
+    cJSON *sync = cJSON_AddObjectToObject(root, "sync");
+    cJSON *subs = cJSON_AddObjectToObject(root, "subscriptions");
+    if (!lanes || !data || !sync || !subs)
+    {
+        cJSON_Delete(root);
+        return ESP_ERR_NO_MEM;
+    }
+
+    uint32_t posted_total = 0;
+    for (int i = 0; i < SYNAPSE_EVENT_PRIORITY_MAX; i++)
+    {
+        cJSON *lane = lane_stats_to_json((synapse_event_priority_t)i, window_us);
+        if (!lane)
+        {
+            cJSON_Delete(root);
+            return ESP_ERR_NO_MEM;
+        }
+        cJSON_AddItemToArray(lanes, lane);
+        posted_total += __atomic_load_n(&s_lanes[i].posted, __ATOMIC_RELAXED);
+    }
+
+    // wrapper = ერთი გამოყოფა; აუზით heap-ს აღწევს მხოლოდ ის, რაც აუზში ვერ დაეტია
+    synapse_event_data_stats_t ds;
+    synapse_event_data_get_stats(&ds);
+    uint32_t heap_allocs = (synapse_pool_get_class_count() > 0) ? synapse_pool_get_heap_fallbacks() : ds.wrappers_created;
+    cJSON_AddNumberToObject(data, "wrappers_created", ds.wrappers_created);
+    cJSON_AddNumberToObject(data, "wrappers_freed", ds.wrappers_freed);
+    cJSON_AddNumberToObject(data, "wrap_failures", ds.wrap_failures);
+    cJSON_AddNumberToObject(data, "refcount_errors", ds.refcount_errors);
+    cJSON_AddNumberToObject(data, "heap_allocs_per_event",
+                            posted_total > 0 ? (double)heap_allocs / (double)posted_total : 0.0);
+
+    cJSON *pool_classes = synapse_pool_get_class_count() > 0 ? cJSON_AddArrayToObject(data, "pool") : NULL;
+    for (uint8_t i = 0; pool_classes && i < synapse_pool_get_class_count(); i++)
+    {
+        synapse_pool_stats_t ps;
+        cJSON *item = cJSON_CreateObject();
+        if (!item || synapse_pool_get_stats(i, &ps) != ESP_OK)
+        {
+            cJSON_Delete(item);
+            break;
+        }
+        cJSON_AddNumberToObject(item, "block_size", ps.block_size);
+        cJSON_AddNumberToObject(item, "blocks", ps.block_count);
+        cJSON_AddNumberToObject(item, "in_use", ps.in_use);
+        cJSON_AddNumberToObject(item, "high_watermark", ps.high_watermark);
+        cJSON_AddNumberToObject(item, "allocs", ps.allocs);
+        cJSON_AddNumberToObject(item, "exhausted", ps.exhausted);
+        cJSON_AddItemToArray(pool_classes, item);
+    }
+    cJSON_AddNumberToObject(data, "pool_heap_fallbacks", synapse_pool_get_heap_fallbacks());
+
+    synapse_event_scratch_stats_t scs;
+    synapse_event_bus_get_scratch_stats(&scs);
+    cJSON *scratch = cJSON_AddObjectToObject(data, "scratch");
+    if (scratch)
+    {
+        cJSON_AddNumberToObject(scratch, "arena_size", scs.arena_size);
+        cJSON_AddNumberToObject(scratch, "arenas", scs.arenas);
+        cJSON_AddNumberToObject(scratch, "high_watermark", scs.high_watermark);
+        cJSON_AddNumberToObject(scratch, "allocations", scs.allocations);
+        cJSON_AddNumberToObject(scratch, "overflows", scs.overflows);
+    }
+
+    synapse_buffer_stats_t bs;
+    synapse_buffer_get_stats(&bs);
+    cJSON *buffers = cJSON_AddObjectToObject(data, "buffers");
+    if (buffers)
+    {
+        cJSON_AddNumberToObject(buffers, "live", bs.live_buffers);
+        cJSON_AddNumberToObject(buffers, "live_bytes", bs.live_bytes);
+        cJSON_AddNumberToObject(buffers, "live_peak", bs.live_peak);
+        cJSON_AddNumberToObject(buffers, "created", bs.created);
+    }
+
+    synapse_event_sync_stats_t ss;
+    synapse_event_bus_get_sync_stats(&ss);
+    cJSON_AddNumberToObject(sync, "published", ss.published);
+    cJSON_AddNumberToObject(sync, "handler_calls", ss.handler_calls);
+    cJSON_AddNumberToObject(sync, "forwarded", ss.forwarded);
+    cJSON_AddNumberToObject(sync, "failed", ss.failed);
+    cJSON_AddNumberToObject(sync, "max_dispatch_us", ss.max_dispatch_us);
+
+    // interned სახელები არასოდეს თავისუფლდება: ზრდადი `names` დინამიკურ სახელებზე მიუთითებს
+    cJSON_AddNumberToObject(subs, "names", synapse_event_registry_count());
+    cJSON_AddNumberToObject(subs, "names_capacity", CONFIG_SYNAPSE_EVENT_MAX_NAMES);
+
+    synapse_event_memory_stats_t ms;
+    if (synapse_event_subscriptions_get_memory_stats(&ms) == ESP_OK)
+    {
+        cJSON_AddNumberToObject(subs, "events", ms.events);
+        cJSON_AddNumberToObject(subs, "subscriptions", ms.subscriptions);
+        cJSON_AddNumberToObject(subs, "pattern_subscriptions", ms.pattern_subscriptions);
+        cJSON_AddNumberToObject(subs, "static_subscriptions", ms.static_subscriptions);
+        cJSON_AddNumberToObject(subs, "heap_bytes",
+                                ms.snapshot_bytes + ms.filter_bytes + ms.pattern_bytes + ms.static_bytes);
+        cJSON_AddNumberToObject(subs, "table_bytes", ms.table_bytes);
+        cJSON_AddNumberToObject(subs, "bytes_per_subscription", ms.bytes_per_subscription);
+    }
+
+    // მოდულები, რომლებმაც ივენთი დაამუშავეს ან ყუთი აქვთ - ნელი handler-ების მოსაძებნად
+    const module_t **modules = NULL;
+    uint8_t module_count = 0;
+    cJSON *modules_json = (synapse_module_registry_get_all(&modules, &module_count) == ESP_OK)
+                              ? cJSON_AddArrayToObject(root, "modules")
+                              : NULL;
+    for (uint8_t i = 0; modules_json && i < module_count; i++)
+    {
+        synapse_event_module_stats_t mst;
+        if (synapse_event_bus_get_module_stats(modules[i], &mst) != ESP_OK || (mst.handled == 0 && !mst.mailbox))
+        {
+            continue;
+        }
+        cJSON *item = cJSON_CreateObject();
+        if (!item)
+        {
+            break;
+        }
+        cJSON_AddStringToObject(item, "name", modules[i]->name);
+        cJSON_AddNumberToObject(item, "handled", mst.handled);
+        cJSON_AddNumberToObject(item, "avg_handler_us", mst.avg_handler_us);
+        cJSON_AddNumberToObject(item, "max_handler_us", mst.max_handler_us);
+        if (mst.mailbox)
+        {
+            cJSON_AddNumberToObject(item, "mailbox_length", mst.queue_length);
+            cJSON_AddNumberToObject(item, "mailbox_pending", mst.pending);
+            cJSON_AddNumberToObject(item, "mailbox_high_watermark", mst.high_watermark);
+            cJSON_AddNumberToObject(item, "mailbox_dropped", mst.dropped);
+            cJSON_AddNumberToObject(item, "mailbox_max_wait_us", mst.max_wait_us);
+        }
+        cJSON_AddItemToArray(modules_json, item);
+    }
+
+    *json_out = cJSON_PrintUnformatted(root);
+    cJSON_Delete(root);
+    return *json_out ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+esp_err_t synapse_event_bus_get_pattern_stats(synapse_event_pattern_stats_t *stats)
+{
+    if (!stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    synapse_event_subscriptions_get_pattern_stats(&stats->patterns, &stats->trie_nodes, &stats->trie_bytes);
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_bus_get_memory_stats(synapse_event_memory_stats_t *stats)
+{
+    if (!stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_initialized)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return synapse_event_subscriptions_get_memory_stats(stats);
+}
+
+void synapse_event_bus_reset_lane_stats(void)
+{
+    for (int i = 0; i < SYNAPSE_EVENT_PRIORITY_MAX; i++)
+    {
+        __atomic_store_n(&s_lanes[i].posted, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s_lanes[i].dispatched, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s_lanes[i].dropped, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s_lanes[i].max_latency_us, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s_lanes[i].dispatch_batches, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s_lanes[i].conflated, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s_lanes[i].inline_posted, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s_lanes[i].high_watermark, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s_lanes[i].spilled, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s_lanes[i].spill_high_watermark, 0, __ATOMIC_RELAXED);
+#ifdef CONFIG_SYNAPSE_EVENT_LATENCY_HISTOGRAM
+        synapse_event_latency_reset(&s_lanes[i].latency);
+#endif
+    }
+    __atomic_store_n(&s_sync_stats.published, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_sync_stats.handler_calls, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_sync_stats.forwarded, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_sync_stats.failed, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_sync_stats.max_dispatch_us, 0, __ATOMIC_RELAXED);
+    synapse_event_scratch_reset_stats();
+
+    const module_t **modules = NULL;
+    uint8_t module_count = 0;
+    if (synapse_module_registry_get_all(&modules, &module_count) == ESP_OK)
+    {
+        for (uint8_t i = 0; i < module_count; i++)
+        {
+            synapse_event_module_reset_stats((module_t *)modules[i]);
+        }
+    }
+    s_stats_since_us = esp_timer_get_time();
+}
+
+esp_err_t synapse_event_bus_subscribe(const char *event_name, module_t *module)
+{
+    if (!event_name || strlen(event_name) == 0)
+    {
+        ESP_LOGE(TAG, "Subscribe failed: event_name is NULL or empty.");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (synapse_event_pattern_is_pattern(event_name))
+    {
+        return subscribe_pattern(event_name, module);
+    }
+
+    synapse_event_id_t event_id = synapse_event_bus_intern(event_name);
+    if (event_id == SYNAPSE_EVENT_ID_INVALID)
+    {
+        ESP_LOGE(TAG, "Subscribe failed: cannot intern event name '%s'.", event_name);
+        return ESP_ERR_NO_MEM;
+    }
+
+    return synapse_event_bus_subscribe_id(event_id, module);
+}
+
+esp_err_t synapse_event_bus_subscribe_id(synapse_event_id_t event_id, module_t *module)
+{
+    return subscribe_module(event_id, module, NULL, false);
+}
+
+esp_err_t synapse_event_bus_subscribe_filtered(const char *event_name, module_t *module,
+                                               const synapse_event_filter_t *filter)
+{
+    if (!event_name || strlen(event_name) == 0)
+    {
+        ESP_LOGE(TAG, "Subscribe failed: event_name is NULL or empty.");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (synapse_event_pattern_is_pattern(event_name))
+    {
+        ESP_LOGE(TAG, "Pattern subscription '%s' cannot be filtered.", event_name);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    synapse_event_id_t event_id = synapse_event_bus_intern(event_name);
+    if (event_id == SYNAPSE_EVENT_ID_INVALID)
+    {
+        ESP_LOGE(TAG, "Subscribe failed: cannot intern event name '%s'.", event_name);
+        return ESP_ERR_NO_MEM;
+    }
+    return synapse_event_bus_subscribe_id_filtered(event_id, module, filter);
+}
+
+esp_err_t synapse_event_bus_subscribe_id_filtered(synapse_event_id_t event_id, module_t *module,
+                                                  const synapse_event_filter_t *filter)
+{
+    if (!filter || (!filter->predicate && filter->field.type == SYNAPSE_EVENT_FIELD_NONE) ||
+        (filter->field.type == SYNAPSE_EVENT_FIELD_STRING && !filter->field.value.str))
+    {
+        ESP_LOGE(TAG, "Subscribe failed: filter needs a predicate or a field match.");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (event_id == SYNAPSE_EVENT_ID_WILDCARD && filter->field.type != SYNAPSE_EVENT_FIELD_NONE)
+    {
+        // "*" იღებს სხვადასხვა ტიპის payload-ებს - ველის offset მხოლოდ ერთ სტრუქტურას აღწერს
+        ESP_LOGE(TAG, "Subscribe failed: a field match cannot be used with '*'; use a predicate.");
+        return ESP_ERR_INVALID_ARG;
+    }
+    return subscribe_module(event_id, module, filter, false);
+}
+
+esp_err_t synapse_event_bus_get_filter_stats(synapse_event_id_t event_id, module_t *module,
+                                             synapse_event_filter_stats_t *stats)
+{
+    if (!module || !stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint32_t evaluated = 0;
+    uint32_t accepted = 0;
+    esp_err_t ret = synapse_event_subscriptions_get_filter_stats(event_id, module, &evaluated, &accepted);
+    if (ret == ESP_OK)
+    {
+        stats->evaluated = evaluated;
+        stats->accepted = accepted;
+        stats->rejected = evaluated - accepted;
+    }
+    return ret;
+}
+
+esp_err_t synapse_event_bus_subscribe_sync(const char *event_name, module_t *module)
+{
+    if (!event_name || strlen(event_name) == 0)
+    {
+        ESP_LOGE(TAG, "Subscribe failed: event_name is NULL or empty.");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (synapse_event_pattern_is_pattern(event_name))
+    {
+        ESP_LOGE(TAG, "Pattern subscription '%s' cannot be synchronous.", event_name);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    synapse_event_id_t event_id = synapse_event_bus_intern(event_name);
+    if (event_id == SYNAPSE_EVENT_ID_INVALID)
+    {
+        ESP_LOGE(TAG, "Subscribe failed: cannot intern event name '%s'.", event_name);
+        return ESP_ERR_NO_MEM;
+    }
+    return synapse_event_bus_subscribe_id_sync(event_id, module);
+}
+
+esp_err_t synapse_event_bus_subscribe_id_sync(synapse_event_id_t event_id, module_t *module)
+{
+    return subscribe_module(event_id, module, NULL, true);
+}
+
+esp_err_t synapse_event_bus_unsubscribe(const char *event_name, module_t *module)
+{
+    if (!event_name || strlen(event_name) == 0 || !module)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (synapse_event_pattern_is_pattern(event_name))
+    {
+        return unsubscribe_pattern(event_name, module);
+    }
+
+    synapse_event_id_t event_id = synapse_event_bus_find_id(event_name);
+    if (event_id == SYNAPSE_EVENT_ID_INVALID)
+    {
+        ESP_LOGW(TAG, "Module '%s' was not subscribed to event '%s'", module->name, event_name);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    return synapse_event_bus_unsubscribe_id(event_id, module);
+}
+
+esp_err_t synapse_event_bus_unsubscribe_id(synapse_event_id_t event_id, module_t *module)
+{
+    const char *event_name = synapse_event_bus_get_name(event_id);
+    if (!event_name || !module)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = synapse_event_subscriptions_remove(event_id, module);
+    if (ret == ESP_OK)
+    {
+        ret = wait_for_module_idle(module);
+        if (ret == ESP_OK)
+        {
+            ESP_LOGI(TAG, "Module '%s' unsubscribed successfully from event '%s'", module->name, event_name);
+        }
+        else
+        {
+            ESP_LOGW(TAG, "Module '%s' unsubscribed from event '%s', but a dispatcher may still call it (%s)",
+                     module->name, event_name, esp_err_to_name(ret));
+        }
+    }
+    else if (ret == ESP_ERR_NOT_FOUND)
+    {
+        ESP_LOGW(TAG, "Module '%s' was not subscribed to event '%s'", module->name, event_name);
+    }
+    else
+    {
+        ESP_LOGE(TAG, "Failed to unsubscribe module '%s' from event '%s': %s", module->name, event_name, esp_err_to_name(ret));
+    }
+    return ret;
+}
@@ -0,0 +1,729 @@
+/**
+ * @file event_capture.c
+ * @brief Event Bus-ის ნაკადის ჩაწერისა და გადათამაშების იმპლემენტაცია.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-09-28
+ * @details გამოქვეყნების გზაზე `synapse_event_capture_record()` მხოლოდ ავსებს
+ *          ფიქსირებული ზომის ჩანაწერს (payload-ის encoder-ით) და ამატებს მას
+ *          ჩაწერის რიგში დალოდების გარეშე; სავსე რიგისას ივენთი ითვლება
+ *          დაკარგულად და ფაილში აღინიშნება `'L'` ჩანაწერით. writer ტასკი
+ *          ასერიალიზებს ჩანაწერებს და წერს sink-ში.
+ *
+ *          ჩაწერის რიგი იქმნება პირველ `start`-ზე და აღარ იშლება: გამომქვეყნებელი,
+ *          რომელმაც `stop`-მდე დაინახა აქტიური ჩაწერა, შეიძლება რიგს მოგვიანებით
+ *          მიმართოს.
+ */
+#include "event_capture.h"
+#include "event_bus.h"
+#include "event_bus_internal.h"
+#include "event_registry_internal.h"
+#include "event_data_wrapper.h"
+#include "synapse_pool.h"
+#include "logging.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+DEFINE_COMPONENT_TAG("EVENT_CAPTURE", SYNAPSE_LOG_COLOR_BLUE);
+
+/** @brief ფაილის სათაურის magic (`"SCAP"`). */
+#define CAPTURE_MAGIC "SCAP"
+/** @brief ფაილის ფორმატის ვერსია. */
+#define CAPTURE_FORMAT_VERSION 1
+/** @brief სათაურის ზომა: magic + ვერსია + რეზერვი. */
+#define CAPTURE_HEADER_SIZE 8
+/** @brief `'E'` ჩანაწერის სათაურის ზომა payload-ის გარეშე. */
+#define CAPTURE_EVENT_HEADER_SIZE 11
+
+#define CAPTURE_TAG_NAME 'N'
+#define CAPTURE_TAG_EVENT 'E'
+#define CAPTURE_TAG_LOST 'L'
+
+// --- Internal Helper Functions (serialization) ---
+
+static void put_u16(uint8_t *dst, uint16_t value)
+{
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+}
+
+static void put_u32(uint8_t *dst, uint32_t value)
+{
+    put_u16(dst, (uint16_t)value);
+    put_u16(dst + 2, (uint16_t)(value >> 16));
+}
+
+static uint16_t get_u16(const uint8_t *src)
+{
+    return (uint16_t)(src[0] | (src[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *src)
+{
+    return (uint32_t)get_u16(src) | ((uint32_t)get_u16(src + 2) << 16);
+}
+
+esp_err_t synapse_event_capture_set_codec(synapse_event_id_t event_id,
+                                          synapse_event_capture_encode_fn_t encode_fn,
+                                          synapse_event_capture_decode_fn_t decode_fn)
+{
+    event_descriptor_t *desc = synapse_event_registry_get(event_id);
+    if (!desc || event_id == SYNAPSE_EVENT_ID_WILDCARD)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    __atomic_store_n(&desc->capture_encode_fn, encode_fn, __ATOMIC_RELEASE);
+    __atomic_store_n(&desc->capture_decode_fn, decode_fn, __ATOMIC_RELEASE);
+    return ESP_OK;
+}
+
+#if defined(CONFIG_SYNAPSE_EVENT_CAPTURE_ENABLE)
+
+// --- Kconfig Definitions ---
+#define CAPTURE_QUEUE_LENGTH CONFIG_SYNAPSE_EVENT_CAPTURE_QUEUE_LENGTH
+#define CAPTURE_MAX_PAYLOAD CONFIG_SYNAPSE_EVENT_CAPTURE_MAX_PAYLOAD
+
+#define CAPTURE_TASK_STACK_SIZE 3072
+#define CAPTURE_TASK_PRIORITY (tskIDLE_PRIORITY + 1)
+
+// --- Internal Structures ---
+
+/**
+ * @internal
+ * @brief ჩაწერის რიგის ერთი ელემენტი (გამომქვეყნებლიდან writer ტასკამდე).
+ * @details `event_id == SYNAPSE_EVENT_ID_INVALID` არის გაჩერების სიგნალი.
+ */
+typedef struct
+{
+    synapse_event_id_t event_id; /**< @brief ივენთის ID. */
+    uint8_t priority;            /**< @brief ზოლი. */
+    uint8_t flags;               /**< @brief `SYNAPSE_EVENT_CAPTURE_FLAG_*`. */
+    uint16_t payload_size;       /**< @brief payload-ის ზომა (0 TRUNCATED/OPAQUE-ისას). */
+    uint32_t posted_at_us;       /**< @brief გამოქვეყნების დრო (esp_timer, 32 ბიტი). */
+    uint8_t payload[CAPTURE_MAX_PAYLOAD];
+} capture_entry_t;
+
+// --- Static Globals ---
+static QueueHandle_t s_queue = NULL;
+static SemaphoreHandle_t s_stopped = NULL;    /**< @brief writer ტასკი აძლევს დასრულებისას. */
+static uint32_t s_active = 0;                 /**< @brief 1, როცა გამოქვეყნებები იწერება. */
+static synapse_event_capture_sink_t s_sink;
+static synapse_event_capture_stats_t s_stats;
+static uint8_t *s_names_written = NULL;       /**< @brief ბიტური რუკა: ID-ის `'N'` ჩანაწერი უკვე ჩაიწერა. */
+static capture_entry_t s_isr_entry;           /**< @brief ISR-იდან ჩაწერის ჩანაწერი (`s_isr_entry_lock`-ით). */
+static portMUX_TYPE s_isr_entry_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// --- Forward Declarations ---
+static void capture_writer_task(void *pvParameters);
+
+// --- Internal Helper Functions ---
+
+/**
+ * @internal
+ * @brief წერს ბაიტებს sink-ში და აღრიცხავს შედეგს.
+ */
+static void sink_write(const void *data, size_t size)
+{
+    if (s_sink.write(s_sink.context, data, size) == ESP_OK)
+    {
+        s_stats.bytes_written += size;
+    }
+    else
+    {
+        s_stats.write_errors++;
+    }
+}
+
+/**
+ * @internal
+ * @brief წერს `'L'` ჩანაწერს, თუ ბოლო ჩანაწერის შემდეგ ივენთები დაიკარგა.
+ */
+static void write_lost_marker(uint32_t *lost_reported)
+{
+    uint32_t dropped = __atomic_load_n(&s_stats.dropped, __ATOMIC_RELAXED);
+    if (dropped == *lost_reported)
+    {
+        return;
+    }
+    uint8_t record[5] = {CAPTURE_TAG_LOST};
+    put_u32(&record[1], dropped - *lost_reported);
+    sink_write(record, sizeof(record));
+    *lost_reported = dropped;
+}
+
+/**
+ * @internal
+ * @brief წერს ივენთის ჩანაწერს (და სახელს, თუ ის ჯერ არ ჩაწერილა).
+ */
+static void write_event(const capture_entry_t *entry, uint32_t delta_us)
+{
+    uint16_t id = entry->event_id;
+    if (!(s_names_written[id / 8] & (1U << (id % 8))))
+    {
+        const char *name = synapse_event_bus_get_name(id);
+        size_t name_len = strlen(name);
+        name_len = (name_len > UINT8_MAX) ? UINT8_MAX : name_len;
+        uint8_t header[4] = {CAPTURE_TAG_NAME};
+        put_u16(&header[1], id);
+        header[3] = (uint8_t)name_len;
+        sink_write(header, sizeof(header));
+        sink_write(name, name_len);
+        s_names_written[id / 8] |= (uint8_t)(1U << (id % 8));
+    }
+
+    uint8_t header[CAPTURE_EVENT_HEADER_SIZE] = {CAPTURE_TAG_EVENT};
+    put_u16(&header[1], id);
+    header[3] = entry->priority;
+    header[4] = entry->flags;
+    put_u32(&header[5], delta_us);
+    put_u16(&header[9], entry->payload_size);
+    sink_write(header, sizeof(header));
+    if (entry->payload_size > 0)
+    {
+        sink_write(entry->payload, entry->payload_size);
+    }
+}
+
+/**
+ * @internal
+ * @brief writer ტასკი: რიგიდან იღებს ჩანაწერებს და წერს sink-ში გაჩერების სიგნალამდე.
+ */
+static void capture_writer_task(void *pvParameters)
+{
+    capture_entry_t entry;
+    uint32_t last_posted_at = 0;
+    bool first = true;
+    uint32_t lost_reported = 0;
+
+    while (xQueueReceive(s_queue, &entry, portMAX_DELAY) == pdPASS)
+    {
+        if (entry.event_id == SYNAPSE_EVENT_ID_INVALID)
+        {
+            break;
+        }
+        write_lost_marker(&lost_reported);
+
+        // 32-ბიტიანი დროის სხვაობა ნიშნით: ითვალისწინებს გადავსებას და სხვადასხვა ტასკის მცირე არეულ თანმიმდევრობას
+        int32_t delta = first ? 0 : (int32_t)(entry.posted_at_us - last_posted_at);
+        if (delta > 0 || first)
+        {
+            last_posted_at = entry.posted_at_us;
+        }
+        first = false;
+        write_event(&entry, delta > 0 ? (uint32_t)delta : 0);
+    }
+
+    write_lost_marker(&lost_reported);
+    if (s_sink.close)
+    {
+        s_sink.close(s_sink.context);
+    }
+    free(s_names_written);
+    s_names_written = NULL;
+    ESP_LOGI(TAG, "Capture stopped: %lu events, %lu dropped, %lu bytes written.",
+             (unsigned long)s_stats.captured, (unsigned long)s_stats.dropped, (unsigned long)s_stats.bytes_written);
+
+    xSemaphoreGive(s_stopped);
+    vTaskDelete(NULL);
+}
+
+/** @internal @brief ფაილის sink: ჩაწერა. */
+static esp_err_t file_sink_write(void *context, const void *data, size_t size)
+{
+    return (fwrite(data, 1, size, (FILE *)context) == size) ? ESP_OK : ESP_FAIL;
+}
+
+/** @internal @brief ფაილის sink: დახურვა. */
+static void file_sink_close(void *context)
+{
+    fclose((FILE *)context);
+}
+
+/**
+ * @internal
+ * @brief ავსებს ჩანაწერის სათაურს და payload-ს.
+ * @details `entry->payload`-ში იწერება მხოლოდ `payload_size` ბაიტი, ამიტომ
+ *          ISR-იდან (ინლაინ payload) შევსება მოკლეა ჩანაწერის ზომის მიუხედავად.
+ */
+static void fill_entry(capture_entry_t *entry, const event_message_t *msg, uint8_t priority, bool from_isr)
+{
+    entry->event_id = msg->event_id;
+    entry->priority = priority;
+    entry->flags = from_isr ? SYNAPSE_EVENT_CAPTURE_FLAG_FROM_ISR : 0;
+    entry->payload_size = 0;
+    entry->posted_at_us = msg->posted_at_us;
+
+    const void *payload = (msg->inline_size > 0) ? (const void *)msg->inline_data.bytes
+                          : (msg->data_wrapper ? msg->data_wrapper->payload : NULL);
+    size_t known_size = (msg->inline_size > 0) ? msg->inline_size
+                        : (msg->data_wrapper ? msg->data_wrapper->payload_size : 0);
+
+    // encoder შეიძლება არ იყოს ISR-safe, ამიტომ ISR-იდან ინლაინ ბაიტები იწერება როგორც არის
+    const event_descriptor_t *desc = synapse_event_registry_get(msg->event_id);
+    synapse_event_capture_encode_fn_t encode_fn =
+        (desc && !from_isr) ? __atomic_load_n(&desc->capture_encode_fn, __ATOMIC_ACQUIRE) : NULL;
+
+    size_t size = 0;
+    if (payload && encode_fn)
+    {
+        size = encode_fn(payload, entry->payload, CAPTURE_MAX_PAYLOAD);
+    }
+    else if (payload && known_size > 0)
+    {
+        size = known_size;
+        if (size <= CAPTURE_MAX_PAYLOAD)
+        {
+            memcpy(entry->payload, payload, size);
+        }
+    }
+    else if (payload)
+    {
+        entry->flags |= SYNAPSE_EVENT_CAPTURE_FLAG_OPAQUE;
+        __atomic_fetch_add(&s_stats.opaque, 1, __ATOMIC_RELAXED);
+    }
+
+    if (size > CAPTURE_MAX_PAYLOAD)
+    {
+        entry->flags |= SYNAPSE_EVENT_CAPTURE_FLAG_TRUNCATED;
+        __atomic_fetch_add(&s_stats.truncated, 1, __ATOMIC_RELAXED);
+        size = 0;
+    }
+    entry->payload_size = (uint16_t)size;
+}
+
+// --- Internal (Event Bus) API ---
+
+bool synapse_event_capture_is_active(void)
+{
+    return __atomic_load_n(&s_active, __ATOMIC_ACQUIRE) != 0;
+}
+
+void synapse_event_capture_record(const event_message_t *msg, uint8_t priority)
+{
+    if (!__atomic_load_n(&s_active, __ATOMIC_ACQUIRE))
+    {
+        return;
+    }
+
+    capture_entry_t entry;
+    fill_entry(&entry, msg, priority, false);
+
+    // რიგში ჩასმა დალოდების გარეშე: ჩაწერამ გამომქვეყნებელი არ უნდა შეანელოს
+    BaseType_t sent = xQueueSend(s_queue, &entry, 0);
+    __atomic_fetch_add((sent == pdPASS) ? &s_stats.captured : &s_stats.dropped, 1, __ATOMIC_RELAXED);
+}
+
+void synapse_event_capture_record_from_isr(const event_message_t *msg, uint8_t priority,
+                                           BaseType_t *higher_priority_task_woken)
+{
+    if (!__atomic_load_n(&s_active, __ATOMIC_ACQUIRE))
+    {
+        return;
+    }
+
+    // ჩანაწერი (`CAPTURE_MAX_PAYLOAD` ბაიტამდე) ISR-ის სტეკზე არ იქმნება: გამოიყენება
+    // წინასწარ გამოყოფილი ერთი ჩანაწერი, რომელსაც spinlock იცავს ორივე ბირთვისა
+    // და ჩადგმული შეწყვეტებისგან; რიგი მას კოპირებს `xQueueSendFromISR`-ში
+    portENTER_CRITICAL_ISR(&s_isr_entry_lock);
+    fill_entry(&s_isr_entry, msg, priority, true);
+    BaseType_t sent = xQueueSendFromISR(s_queue, &s_isr_entry, higher_priority_task_woken);
+    portEXIT_CRITICAL_ISR(&s_isr_entry_lock);
+    __atomic_fetch_add((sent == pdPASS) ? &s_stats.captured : &s_stats.dropped, 1, __ATOMIC_RELAXED);
+}
+
+// --- Public API Implementation ---
+
+esp_err_t synapse_event_capture_start(const synapse_event_capture_sink_t *sink)
+{
+    if (!sink || !sink->write)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (__atomic_load_n(&s_active, __ATOMIC_ACQUIRE) || s_names_written)
+    {
+        ESP_LOGW(TAG, "Capture is already running.");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (!s_queue)
+    {
+        s_queue = xQueueCreate(CAPTURE_QUEUE_LENGTH, sizeof(capture_entry_t));
+        s_stopped = xSemaphoreCreateBinary();
+        if (!s_queue || !s_stopped)
+        {
+            ESP_LOGE(TAG, "Failed to create the capture queue.");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    xQueueReset(s_queue);
+
+    s_names_written = calloc((CONFIG_SYNAPSE_EVENT_MAX_NAMES + 7) / 8, 1);
+    if (!s_names_written)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    s_sink = *sink;
+    memset(&s_stats, 0, sizeof(s_stats));
+
+    uint8_t header[CAPTURE_HEADER_SIZE] = {0};
+    memcpy(header, CAPTURE_MAGIC, 4);
+    put_u16(&header[4], CAPTURE_FORMAT_VERSION);
+    if (s_sink.write(s_sink.context, header, sizeof(header)) != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to write the capture header.");
+        free(s_names_written);
+        s_names_written = NULL;
+        return ESP_FAIL;
+    }
+    s_stats.bytes_written = sizeof(header);
+
+    if (xTaskCreate(capture_writer_task, "evbus_capture", CAPTURE_TASK_STACK_SIZE, NULL,
+                    CAPTURE_TASK_PRIORITY, NULL) != pdPASS)
+    {
+        ESP_LOGE(TAG, "Failed to create the capture writer task.");
+        free(s_names_written);
+        s_names_written = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+
+    __atomic_store_n(&s_active, 1, __ATOMIC_RELEASE);
+    ESP_LOGI(TAG, "Event capture started.");
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_capture_start_file(const char *path)
+{
+    if (!path)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    FILE *file = fopen(path, "wb");
+    if (!file)
+    {
+        ESP_LOGE(TAG, "Failed to open capture file '%s'.", path);
+        return ESP_FAIL;
+    }
+
+    synapse_event_capture_sink_t sink = {
+        .write = file_sink_write,
+        .close = file_sink_close,
+        .context = file,
+    };
+    esp_err_t err = synapse_event_capture_start(&sink);
+    if (err != ESP_OK)
+    {
+        fclose(file);
+    }
+    return err;
+}
+
+esp_err_t synapse_event_capture_stop(void)
+{
+    if (!__atomic_exchange_n(&s_active, 0, __ATOMIC_ACQ_REL))
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // გაჩერების სიგნალი რიგის ბოლოში: მანამდე ჩამდგარი ყველა ჩანაწერი ჩაიწერება
+    capture_entry_t stop = {.event_id = SYNAPSE_EVENT_ID_INVALID};
+    if (xQueueSend(s_queue, &stop, pdMS_TO_TICKS(CONFIG_SYNAPSE_DEINIT_TIMEOUT_MS)) != pdPASS ||
+        xSemaphoreTake(s_stopped, pdMS_TO_TICKS(CONFIG_SYNAPSE_DEINIT_TIMEOUT_MS)) != pdTRUE)
+    {
+        ESP_LOGE(TAG, "Capture writer did not stop in time.");
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_capture_get_stats(synapse_event_capture_stats_t *stats)
+{
+    if (!stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *stats = s_stats;
+    stats->active = __atomic_load_n(&s_active, __ATOMIC_ACQUIRE) != 0;
+    return ESP_OK;
+}
+
+#else // !CONFIG_SYNAPSE_EVENT_CAPTURE_ENABLE
+
+esp_err_t synapse_event_capture_start(const synapse_event_capture_sink_t *sink)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t synapse_event_capture_start_file(const char *path)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t synapse_event_capture_stop(void)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t synapse_event_capture_get_stats(synapse_event_capture_stats_t *stats)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif // CONFIG_SYNAPSE_EVENT_CAPTURE_ENABLE
+
+// --- Replay ---
+
+/**
+ * @internal
+ * @brief გადათამაშების მდგომარეობა: ფაილის ID → ლოკალური ID რუკა და payload-ის ბუფერი.
+ */
+typedef struct
+{
+    FILE *file;
+    synapse_event_id_t *id_map;
+    size_t id_map_size;
+    uint8_t *payload;
+    size_t payload_capacity;
+} replay_state_t;
+
+/**
+ * @internal
+ * @brief კითხულობს ზუსტად `size` ბაიტს.
+ */
+static bool read_exact(FILE *file, void *dst, size_t size)
+{
+    return size == 0 || fread(dst, 1, size, file) == size;
+}
+
+/**
+ * @internal
+ * @brief ამუშავებს `'N'` ჩანაწერს: ივენთის სახელი interning-დება ლოკალურ რეესტრში.
+ */
+static esp_err_t replay_read_name(replay_state_t *state)
+{
+    uint8_t header[3];
+    char name[UINT8_MAX + 1];
+    if (!read_exact(state->file, header, sizeof(header)) || !read_exact(state->file, name, header[2]))
+    {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    name[header[2]] = '\0';
+
+    uint16_t file_id = get_u16(header);
+    if (file_id >= state->id_map_size)
+    {
+        size_t new_size = (size_t)file_id + 1;
+        synapse_event_id_t *map = realloc(state->id_map, new_size * sizeof(*map));
+        if (!map)
+        {
+            return ESP_ERR_NO_MEM;
+        }
+        for (size_t i = state->id_map_size; i < new_size; i++)
+        {
+            map[i] = SYNAPSE_EVENT_ID_INVALID;
+        }
+        state->id_map = map;
+        state->id_map_size = new_size;
+    }
+    state->id_map[file_id] = synapse_event_bus_intern(name);
+    return ESP_OK;
+}
+
+/**
+ * @internal
+ * @brief აქვეყნებს ერთ ჩაწერილ ივენთს (payload-ის აღდგენით).
+ * @return ESP_OK, ESP_ERR_NOT_SUPPORTED (payload ვერ აღდგა) ან Event Bus-ის შეცდომა.
+ */
+static esp_err_t replay_post(synapse_event_id_t event_id, uint8_t priority, uint8_t flags,
+                             const uint8_t *payload, size_t size)
+{
+    if (flags & (SYNAPSE_EVENT_CAPTURE_FLAG_TRUNCATED | SYNAPSE_EVENT_CAPTURE_FLAG_OPAQUE))
+    {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    synapse_event_priority_t lane = (priority < SYNAPSE_EVENT_PRIORITY_MAX)
+                                        ? (synapse_event_priority_t)priority
+                                        : synapse_event_bus_get_default_priority(event_id);
+
+    const event_descriptor_t *desc = synapse_event_registry_get(event_id);
+    synapse_event_capture_decode_fn_t decode_fn =
+        desc ? __atomic_load_n(&desc->capture_decode_fn, __ATOMIC_ACQUIRE) : NULL;
+
+    event_data_wrapper_t *wrapper = NULL;
+    if (decode_fn)
+    {
+        if (decode_fn(payload, size, &wrapper) != ESP_OK)
+        {
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+    }
+    else if (size == 0)
+    {
+        return synapse_event_bus_post_id_with_priority(event_id, NULL, lane);
+    }
+    else if (size <= EVENT_INLINE_PAYLOAD_SIZE)
+    {
+        return synapse_event_bus_post_inline_with_priority(event_id, payload, size, lane);
+    }
+    else
+    {
+        void *copy = synapse_pool_alloc(size);
+        if (!copy)
+        {
+            return ESP_ERR_NO_MEM;
+        }
+        memcpy(copy, payload, size);
+        if (synapse_event_data_wrap(copy, synapse_pool_free, &wrapper) != ESP_OK)
+        {
+            synapse_pool_free(copy);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    // Event Bus იღებს საკუთარ reference-ს; ჩვენსას ვათავისუფლებთ
+    esp_err_t err = synapse_event_bus_post_id_with_priority(event_id, wrapper, lane);
+    if (wrapper)
+    {
+        synapse_event_data_release(wrapper);
+    }
+    return err;
+}
+
+/**
+ * @internal
+ * @brief ელოდება, სანამ გადათამაშების დრო ჩაწერილ დროს დაეწევა.
+ */
+static void replay_pace(int64_t start_us, uint64_t captured_us, uint32_t speed)
+{
+    if (speed == 0)
+    {
+        return;
+    }
+    int64_t target_us = start_us + (int64_t)(captured_us / speed);
+    int64_t ahead_us = target_us - esp_timer_get_time();
+    TickType_t ticks = (TickType_t)(ahead_us / (portTICK_PERIOD_MS * 1000));
+    if (ahead_us > 0 && ticks > 0)
+    {
+        vTaskDelay(ticks);
+    }
+}
+
+esp_err_t synapse_event_replay_file(const char *path, const synapse_event_replay_config_t *config,
+                                    synapse_event_replay_stats_t *stats_out)
+{
+    if (!path)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint32_t speed = config ? config->speed : 1;
+
+    replay_state_t state = {.file = fopen(path, "rb")};
+    if (!state.file)
+    {
+        ESP_LOGE(TAG, "Failed to open replay file '%s'.", path);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    uint8_t header[CAPTURE_HEADER_SIZE];
+    if (!read_exact(state.file, header, sizeof(header)) || memcmp(header, CAPTURE_MAGIC, 4) != 0 ||
+        get_u16(&header[4]) != CAPTURE_FORMAT_VERSION)
+    {
+        ESP_LOGE(TAG, "'%s' is not a capture file of version %d.", path, CAPTURE_FORMAT_VERSION);
+        fclose(state.file);
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    synapse_event_replay_stats_t stats = {0};
+    esp_err_t ret = ESP_OK;
+    int64_t start_us = esp_timer_get_time();
+    int tag;
+
+    while (ret == ESP_OK && (tag = fgetc(state.file)) != EOF)
+    {
+        if (tag == CAPTURE_TAG_NAME)
+        {
+            ret = replay_read_name(&state);
+        }
+        else if (tag == CAPTURE_TAG_LOST)
+        {
+            uint8_t count[4];
+            ret = read_exact(state.file, count, sizeof(count)) ? ESP_OK : ESP_ERR_INVALID_SIZE;
+            stats.capture_lost += get_u32(count);
+        }
+        else if (tag == CAPTURE_TAG_EVENT)
+        {
+            uint8_t rec[CAPTURE_EVENT_HEADER_SIZE - 1];
+            if (!read_exact(state.file, rec, sizeof(rec)))
+            {
+                ret = ESP_ERR_INVALID_SIZE;
+                break;
+            }
+            uint16_t file_id = get_u16(&rec[0]);
+            uint16_t size = get_u16(&rec[8]);
+            if (size > state.payload_capacity)
+            {
+                uint8_t *buffer = realloc(state.payload, size);
+                if (!buffer)
+                {
+                    ret = ESP_ERR_NO_MEM;
+                    break;
+                }
+                state.payload = buffer;
+                state.payload_capacity = size;
+            }
+            if (!read_exact(state.file, state.payload, size) || file_id >= state.id_map_size)
+            {
+                ret = ESP_ERR_INVALID_SIZE;
+                break;
+            }
+
+            stats.captured_span_us += get_u32(&rec[4]);
+            replay_pace(start_us, stats.captured_span_us, speed);
+
+            // სახელი, რომელიც ლოკალურ რეესტრში ვერ დაემატა (სავსეა), გამოიტოვება
+            esp_err_t err = (state.id_map[file_id] == SYNAPSE_EVENT_ID_INVALID)
+                                ? ESP_ERR_NOT_SUPPORTED
+                                : replay_post(state.id_map[file_id], rec[2], rec[3], state.payload, size);
+            if (err == ESP_OK)
+            {
+                stats.replayed++;
+            }
+            else if (err == ESP_ERR_NOT_SUPPORTED)
+            {
+                stats.skipped++;
+            }
+            else
+            {
+                stats.failed++;
+            }
+        }
+        else
+        {
+            ret = ESP_ERR_INVALID_SIZE;
+        }
+    }
+
+    stats.duration_us = (uint64_t)(esp_timer_get_time() - start_us);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Replay of '%s' aborted: %s", path, esp_err_to_name(ret));
+    }
+    ESP_LOGI(TAG, "Replayed %lu events (%lu failed, %lu skipped) in %llu us; captured span %llu us.",
+             (unsigned long)stats.replayed, (unsigned long)stats.failed, (unsigned long)stats.skipped,
+             (unsigned long long)stats.duration_us, (unsigned long long)stats.captured_span_us);
+
+    fclose(state.file);
+    free(state.id_map);
+    free(state.payload);
+    if (stats_out)
+    {
+        *stats_out = stats;
+    }
+    return ret;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file event_conflation.c
+ * @brief Event Bus-ის conflation (latest-value) სლოტების იმპლემენტაცია.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-09-24
+ * @details Conflating ივენთისთვის (event ID + key) რიგში ყოველთვის მაქსიმუმ ერთი
+ *          შეტყობინება დგას. პირველი გამოქვეყნებისას payload გადადის სლოტში,
+ *          ხოლო რიგში იწერება მხოლოდ "token" (სლოტის ინდექსი). სანამ დისპეტჩერი
+ *          token-ს ამოიღებს, ყოველი ახალი გამოქვეყნება უბრალოდ ანაცვლებს
+ *          სლოტის payload-ს - ამიტომ გამომწერი იღებს მხოლოდ უახლეს მნიშვნელობას.
+ *
+ *          სლოტების ცხრილი დაცულია spinlock-ით (portMUX); კრიტიკულ სექციაში
+ *          მხოლოდ მოკლე ძებნა და კოპირება ხდება, wrapper-ების გათავისუფლება კი
+ *          მის გარეთ.
+ */
+#include "event_bus_internal.h"
+#include "event_data_wrapper.h"
+#include "logging.h"
+#include "framework_config.h"
+#include "freertos/FreeRTOS.h"
+#include <string.h>
+
+DEFINE_COMPONENT_TAG("EVENT_CONFLATE", SYNAPSE_LOG_COLOR_BLUE);
+
+// --- Kconfig Definitions ---
+#define CONFLATION_SLOT_COUNT CONFIG_SYNAPSE_EVENT_CONFLATION_SLOTS
+
+_Static_assert(CONFLATION_SLOT_COUNT < UINT16_MAX, "CONFIG_SYNAPSE_EVENT_CONFLATION_SLOTS must fit into uint16_t");
+
+/**
+ * @internal
+ * @brief ერთი მომლოდინე conflating ივენთის სლოტი.
+ */
+typedef struct
+{
+    bool in_use;                  /**< @brief სლოტს რიგში token შეესაბამება. */
+    synapse_event_id_t event_id;  /**< @brief ივენთის ID. */
+    uint32_t key;                 /**< @brief conflation-ის გასაღები (მაგ. სერვისის სახელის ჰეში). */
+    event_data_wrapper_t *data_wrapper; /**< @brief უახლესი payload (wrapper) ან NULL. */
+    uint8_t inline_size;          /**< @brief უახლესი ინლაინ payload-ის ზომა. */
+    uint8_t inline_bytes[EVENT_INLINE_PAYLOAD_SIZE]; /**< @brief უახლესი ინლაინ payload. */
+} conflation_slot_t;
+
+// --- Static Globals ---
+static conflation_slot_t s_slots[CONFLATION_SLOT_COUNT];
+static portMUX_TYPE s_slots_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// --- Internal Helper Functions ---
+
+/**
+ * @internal
+ * @brief გადააქვს შეტყობინების payload სლოტში.
+ */
+static void store_payload(conflation_slot_t *slot, const event_message_t *msg)
+{
+    slot->data_wrapper = msg->data_wrapper;
+    slot->inline_size = msg->inline_size;
+    if (msg->inline_size > 0)
+    {
+        memcpy(slot->inline_bytes, msg->inline_data.bytes, msg->inline_size);
+    }
+}
+
+// --- Internal API Implementation ---
+
+esp_err_t synapse_event_conflation_init(void)
+{
+    taskENTER_CRITICAL(&s_slots_lock);
+    memset(s_slots, 0, sizeof(s_slots));
+    taskEXIT_CRITICAL(&s_slots_lock);
+    return ESP_OK;
+}
+
+event_conflation_result_t synapse_event_conflation_offer(event_message_t *msg, uint32_t key,
+                                                         event_data_wrapper_t **replaced_out)
+{
+    event_conflation_result_t result = EVENT_CONFLATION_BYPASS;
+    int free_index = -1;
+    *replaced_out = NULL;
+
+    taskENTER_CRITICAL(&s_slots_lock);
+    for (int i = 0; i < CONFLATION_SLOT_COUNT; i++)
+    {
+        conflation_slot_t *slot = &s_slots[i];
+        if (!slot->in_use)
+        {
+            if (free_index < 0)
+            {
+                free_index = i;
+            }
+            continue;
+        }
+        if (slot->event_id == msg->event_id && slot->key == key)
+        {
+            // რიგში უკვე დგას ამ ივენთის token - ვანაცვლებთ მხოლოდ payload-ს
+            *replaced_out = slot->data_wrapper;
+            store_payload(slot, msg);
+            result = EVENT_CONFLATION_MERGED;
+            break;
+        }
+    }
+
+    if (result == EVENT_CONFLATION_BYPASS && free_index >= 0)
+    {
+        conflation_slot_t *slot = &s_slots[free_index];
+        slot->in_use = true;
+        slot->event_id = msg->event_id;
+        slot->key = key;
+        store_payload(slot, msg);
+
+        msg->flags |= EVENT_MESSAGE_FLAG_CONFLATED;
+        msg->conflation_slot = (uint16_t)free_index;
+        msg->data_wrapper = NULL;
+        msg->inline_size = 0;
+        result = EVENT_CONFLATION_RESERVED;
+    }
+    taskEXIT_CRITICAL(&s_slots_lock);
+
+    if (result == EVENT_CONFLATION_BYPASS)
+    {
+        ESP_LOGD(TAG, "No free conflation slot for event ID %u; posting without conflation.", msg->event_id);
+    }
+    return result;
+}
+
+void synapse_event_conflation_claim(event_message_t *msg)
+{
+    if (!(msg->flags & EVENT_MESSAGE_FLAG_CONFLATED) || msg->conflation_slot >= CONFLATION_SLOT_COUNT)
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL(&s_slots_lock);
+    conflation_slot_t *slot = &s_slots[msg->conflation_slot];
+    msg->data_wrapper = slot->data_wrapper;
+    msg->inline_size = slot->inline_size;
+    if (slot->inline_size > 0)
+    {
+        memcpy(msg->inline_data.bytes, slot->inline_bytes, slot->inline_size);
+    }
+    slot->in_use = false;
+    slot->data_wrapper = NULL;
+    taskEXIT_CRITICAL(&s_slots_lock);
+
+    msg->flags &= (uint8_t)~EVENT_MESSAGE_FLAG_CONFLATED;
+}
@@ -1,23 +1,53 @@
 /**
  * @file event_data_wrapper.c
  * @brief Event Bus-ისთვის მონაცემთა შეფუთვის (Wrapper) იმპლემენტაცია.
- * @version 2.0
- * @date 2025-06-25
+ * @version 2.1
+ * @date 2025-10-07
  * @author Giorgi Magradze
  * @details ეს ფაილი შეიცავს ფუნქციების იმპლემენტაციას, რომლებიც მართავენ
  *          მონაცემთა "შეფუთვას" და Reference Counting-ს, რაც უზრუნველყოფს
- *          მეხსიერების უსაფრთხო მართვას ასინქრონულ გარემოში.
+ *          მეხსიერების უსაფრთხო მართვას ასინქრონულ გარემოში. მრიცხველი
+ *          ატომურია: `acquire` მხოლოდ ზრდის მას, `release` კი ამცირებს და
+ *          wrapper-ს ათავისუფლებს ზუსტად ერთხელ - იმ გამომძახებელში, რომელმაც
+ *          ის 0-მდე ჩამოიყვანა.
  */
 
 #include "event_data_wrapper.h"
 #include "logging.h"
 #include "framework_config.h" // Kconfig-ის პარამეტრებისთვის
+#include "synapse_pool.h"     // wrapper-ები ფიქსირებული ბლოკების აუზიდან
 #include <stdlib.h>
 #include <string.h>
 #include <inttypes.h> // PRId32-სთვის
 
 DEFINE_COMPONENT_TAG("EVENT_WRAPPER", SYNAPSE_LOG_COLOR_BLUE);
 
+/** @internal @brief გამოყოფის მრიცხველები (იხ. `synapse_event_data_stats_t`). */
+static synapse_event_data_stats_t s_stats;
+
+// --- Internal Helper Functions ---
+
+/**
+ * @internal
+ * @brief ამოწმებს, ცოცხალია თუ არა wrapper (მხოლოდ `CONFIG_SYNAPSE_EVENT_DATA_DEBUG`).
+ */
+static bool wrapper_is_live(const event_data_wrapper_t *wrapper, const char *operation)
+{
+#if CONFIG_SYNAPSE_EVENT_DATA_DEBUG
+    uint32_t magic = __atomic_load_n(&wrapper->magic, __ATOMIC_ACQUIRE);
+    if (magic != SYNAPSE_EVENT_DATA_MAGIC_LIVE)
+    {
+        __atomic_fetch_add(&s_stats.refcount_errors, 1, __ATOMIC_RELAXED);
+        ESP_LOGE(TAG, "%s on %s wrapper %p (magic 0x%08" PRIx32 ").", operation,
+                 magic == SYNAPSE_EVENT_DATA_MAGIC_FREED ? "freed" : "invalid", wrapper, magic);
+        return false;
+    }
+#endif
+    return true;
+}
+
+// --- Public API Implementation ---
+
 esp_err_t synapse_event_data_wrap(const void *payload, void (*free_fn)(void *payload), event_data_wrapper_t **wrapper_out)
 {
     if (!payload || !wrapper_out)
@@ -26,24 +56,21 @@ esp_err_t synapse_event_data_wrap(const void *payload, void (*free_fn)(void *pay
         return ESP_ERR_INVALID_ARG;
     }
 
-    event_data_wrapper_t *wrapper = calloc(1, sizeof(event_data_wrapper_t));
+    event_data_wrapper_t *wrapper = SYNAPSE_POOL_NEW(event_data_wrapper_t);
     if (!wrapper)
     {
         ESP_LOGE(TAG, "Failed to allocate memory for wrapper.");
+        __atomic_fetch_add(&s_stats.wrap_failures, 1, __ATOMIC_RELAXED);
         return ESP_ERR_NO_MEM;
     }
-
-    wrapper->mutex = xSemaphoreCreateMutex();
-    if (!wrapper->mutex)
-    {
-        ESP_LOGE(TAG, "Failed to create mutex for wrapper.");
-        free(wrapper);
-        return ESP_ERR_NO_MEM;
-    }
+    __atomic_fetch_add(&s_stats.wrappers_created, 1, __ATOMIC_RELAXED);
 
     wrapper->payload = (void *)payload;
     wrapper->ref_count = 1; // საწყისი მფლობელი არის გამომძახებელი.
     wrapper->free_payload_fn = free_fn;
+#if CONFIG_SYNAPSE_EVENT_DATA_DEBUG
+    wrapper->magic = SYNAPSE_EVENT_DATA_MAGIC_LIVE;
+#endif
 
     *wrapper_out = wrapper;
 
@@ -54,22 +81,34 @@ esp_err_t synapse_event_data_wrap(const void *payload, void (*free_fn)(void *pay
 
 esp_err_t synapse_event_data_acquire(event_data_wrapper_t *wrapper)
 {
-    if (!wrapper || !wrapper->mutex)
+    if (synapse_event_data_is_borrowed(wrapper))
+    {
+        ESP_LOGE(TAG, "Acquire failed: wrapper %p is borrowed; copy its payload instead.", wrapper);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    if (!wrapper)
     {
-        ESP_LOGE(TAG, "Acquire failed: wrapper or its mutex is NULL.");
+        ESP_LOGE(TAG, "Acquire failed: wrapper is NULL.");
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (xSemaphoreTake(wrapper->mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) == pdTRUE)
+    if (!wrapper_is_live(wrapper, "Acquire"))
     {
-        wrapper->ref_count++;
-        ESP_LOGD(TAG, "Acquired wrapper %p, ref_count is now %" PRId32, wrapper, wrapper->ref_count);
-        xSemaphoreGive(wrapper->mutex);
-        return ESP_OK;
+        return ESP_ERR_INVALID_STATE;
     }
-    
-    ESP_LOGW(TAG, "Failed to take mutex for acquiring wrapper %p", wrapper);
-    return ESP_ERR_TIMEOUT;
+
+    // გამომძახებელი უკვე ფლობს reference-ს, ამიტომ მრიცხველი აქ 0 ვერ იქნება - საკმარისია relaxed
+    int32_t previous = __atomic_fetch_add(&wrapper->ref_count, 1, __ATOMIC_RELAXED);
+    ESP_LOGD(TAG, "Acquired wrapper %p, ref_count is now %" PRId32, wrapper, previous + 1);
+#if CONFIG_SYNAPSE_EVENT_DATA_DEBUG
+    if (previous <= 0)
+    {
+        __atomic_fetch_add(&s_stats.refcount_errors, 1, __ATOMIC_RELAXED);
+        ESP_LOGE(TAG, "Acquire on wrapper %p with ref_count %" PRId32 "; it is being freed.", wrapper, previous);
+    }
+#endif
+    return ESP_OK;
 }
 
 esp_err_t synapse_event_data_release(event_data_wrapper_t *wrapper)
@@ -80,53 +119,68 @@ esp_err_t synapse_event_data_release(event_data_wrapper_t *wrapper)
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (!wrapper->mutex)
+    if (synapse_event_data_is_borrowed(wrapper))
+    {
+        return ESP_OK; // ნასესხებ payload-ს Event Bus ფლობს
+    }
+
+    if (!wrapper_is_live(wrapper, "Release"))
     {
-        ESP_LOGE(TAG, "Release failed: wrapper's mutex is NULL. Memory will be leaked.");
         return ESP_ERR_INVALID_STATE;
     }
 
-    bool should_free = false;
+    // release: ჩვენი ჩანაწერები payload-ში ჩანს იმისთვის, ვინც ბოლო reference-ს ათავისუფლებს;
+    // acquire: ბოლო მფლობელი ხედავს ყველა დანარჩენის ჩანაწერს გათავისუფლებამდე
+    int32_t remaining = __atomic_sub_fetch(&wrapper->ref_count, 1, __ATOMIC_ACQ_REL);
+    ESP_LOGD(TAG, "Released wrapper %p, ref_count is now %" PRId32, wrapper, remaining);
 
-    if (xSemaphoreTake(wrapper->mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) == pdTRUE)
+    if (remaining > 0)
     {
-        wrapper->ref_count--;
-        ESP_LOGD(TAG, "Released wrapper %p, ref_count is now %" PRId32, wrapper, wrapper->ref_count);
-
-        if (wrapper->ref_count == 0)
-        {
-            should_free = true;
-        }
-        else if (wrapper->ref_count < 0)
-        {
-            ESP_LOGE(TAG, "CRITICAL: ref_count for wrapper %p dropped below zero! Memory corruption likely.", wrapper);
-        }
-        
-        xSemaphoreGive(wrapper->mutex);
+        return ESP_OK;
     }
-    else
+    if (remaining < 0)
     {
-        ESP_LOGW(TAG, "Failed to take mutex for releasing wrapper %p. Potential memory leak.", wrapper);
-        return ESP_ERR_TIMEOUT;
+        __atomic_fetch_add(&s_stats.refcount_errors, 1, __ATOMIC_RELAXED);
+        ESP_LOGE(TAG, "CRITICAL: ref_count for wrapper %p dropped below zero! Memory corruption likely.", wrapper);
+        return ESP_ERR_INVALID_STATE;
     }
 
-    if (should_free)
+    ESP_LOGD(TAG, "ref_count is zero. Freeing wrapper %p and its payload %p.", wrapper, wrapper->payload);
+
+    if (wrapper->payload && wrapper->free_payload_fn)
     {
-        ESP_LOGI(TAG, "ref_count is zero. Freeing wrapper %p and its payload %p.", wrapper, wrapper->payload);
+        // Call the provided free function only if it's not NULL.
+        // If free_fn is NULL, it implies the payload is static or managed
+        // elsewhere and should not be freed by the wrapper.
+        wrapper->free_payload_fn(wrapper->payload);
+    }
 
-       if (wrapper->payload && wrapper->free_payload_fn)
-        {
-            // Call the provided free function only if it's not NULL.
-            // If free_fn is NULL, it implies the payload is static or managed
-            // elsewhere and should not be freed by the wrapper.
-            wrapper->free_payload_fn(wrapper->payload);
-        }
+#if CONFIG_SYNAPSE_EVENT_DATA_DEBUG
+    __atomic_store_n(&wrapper->magic, SYNAPSE_EVENT_DATA_MAGIC_FREED, __ATOMIC_RELEASE);
+#endif
+    synapse_pool_free(wrapper);
+    __atomic_fetch_add(&s_stats.wrappers_freed, 1, __ATOMIC_RELAXED);
 
-        vSemaphoreDelete(wrapper->mutex);
-        wrapper->mutex = NULL;
+    return ESP_OK;
+}
 
-        free(wrapper);
+esp_err_t synapse_event_data_get_stats(synapse_event_data_stats_t *stats)
+{
+    if (!stats)
+    {
+        return ESP_ERR_INVALID_ARG;
     }
-    
+    stats->wrappers_created = __atomic_load_n(&s_stats.wrappers_created, __ATOMIC_RELAXED);
+    stats->wrappers_freed = __atomic_load_n(&s_stats.wrappers_freed, __ATOMIC_RELAXED);
+    stats->wrap_failures = __atomic_load_n(&s_stats.wrap_failures, __ATOMIC_RELAXED);
+    stats->refcount_errors = __atomic_load_n(&s_stats.refcount_errors, __ATOMIC_RELAXED);
     return ESP_OK;
-}
\ No newline at end of file
+}
+
+void synapse_event_data_reset_stats(void)
+{
+    __atomic_store_n(&s_stats.wrappers_created, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_stats.wrappers_freed, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_stats.wrap_failures, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_stats.refcount_errors, 0, __ATOMIC_RELAXED);
+}
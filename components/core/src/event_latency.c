@@ -0,0 +1,97 @@
+/**
+ * @file event_latency.c
+ * @brief Event Bus-ის დაყოვნების ჰისტოგრამა (post → handler).
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-09-26
+ * @details ჰისტოგრამა ლოგ-წრფივია: ყოველი ოქტავა (2^n .. 2^(n+1)-1 µs) იყოფა
+ *          ოთხ თანაბარ ნაწილად. ასე ფიქსირებული ზომის (`EVENT_LATENCY_BUCKETS`)
+ *          მასივით იზომება როგორც მიკროწამები, ისე წამები, ხოლო პერცენტილის
+ *          ცდომილება 25%-ს არ აღემატება. ჩაწერა მხოლოდ ინდექსის გამოთვლა და
+ *          ერთი მთვლელის გაზრდაა - დისპეტჩერისთვის ის პრაქტიკულად უფასოა.
+ */
+#include "event_bus_internal.h"
+#include <string.h>
+
+// --- Internal Helper Functions ---
+
+/**
+ * @internal
+ * @brief აბრუნებს მნიშვნელობის bucket-ის ინდექსს.
+ */
+static uint32_t bucket_index(uint32_t value)
+{
+    if (value < EVENT_LATENCY_SUB_BUCKETS)
+    {
+        return value;
+    }
+    uint32_t bit = 31U - (uint32_t)__builtin_clz(value); // უმაღლესი ბიტი, >= 2
+    if (bit > EVENT_LATENCY_MAX_BIT)
+    {
+        return EVENT_LATENCY_BUCKETS - 1;
+    }
+    uint32_t sub = (value >> (bit - 2)) & (EVENT_LATENCY_SUB_BUCKETS - 1);
+    return (bit - 1) * EVENT_LATENCY_SUB_BUCKETS + sub;
+}
+
+/**
+ * @internal
+ * @brief აბრუნებს bucket-ის ზედა საზღვარს (ჩათვლით).
+ */
+static uint32_t bucket_upper_bound(uint32_t index)
+{
+    if (index < EVENT_LATENCY_SUB_BUCKETS)
+    {
+        return index;
+    }
+    uint32_t bit = index / EVENT_LATENCY_SUB_BUCKETS + 1;
+    uint32_t sub = index % EVENT_LATENCY_SUB_BUCKETS;
+    uint32_t width = 1U << (bit - 2);
+    return (1U << bit) + (sub + 1) * width - 1;
+}
+
+// --- Internal API Implementation ---
+
+void synapse_event_latency_record(event_latency_histogram_t *histogram, uint32_t latency_us)
+{
+    // per-core რეჟიმში ზოლის ჰისტოგრამას რამდენიმე დისპეტჩერი წერს, ამიტომ მრიცხველები ატომურად იზრდება
+    __atomic_fetch_add(&histogram->buckets[bucket_index(latency_us)], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&histogram->samples, 1, __ATOMIC_RELAXED);
+}
+
+uint32_t synapse_event_latency_percentile(const event_latency_histogram_t *histogram, uint32_t per_mille)
+{
+    uint32_t samples = __atomic_load_n(&histogram->samples, __ATOMIC_RELAXED);
+    if (samples == 0)
+    {
+        return 0;
+    }
+
+    // rank = ceil(samples * per_mille / 1000), მინიმუმ 1
+    uint64_t rank = ((uint64_t)samples * per_mille + 999) / 1000;
+    if (rank == 0)
+    {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < EVENT_LATENCY_BUCKETS; i++)
+    {
+        seen += __atomic_load_n(&histogram->buckets[i], __ATOMIC_RELAXED);
+        if (seen >= rank)
+        {
+            return bucket_upper_bound(i);
+        }
+    }
+    // ჩაწერა მიმდინარეობს და bucket-ები ჯერ არ "დაეწია" samples-ს
+    return bucket_upper_bound(EVENT_LATENCY_BUCKETS - 1);
+}
+
+void synapse_event_latency_reset(event_latency_histogram_t *histogram)
+{
+    for (uint32_t i = 0; i < EVENT_LATENCY_BUCKETS; i++)
+    {
+        __atomic_store_n(&histogram->buckets[i], 0, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&histogram->samples, 0, __ATOMIC_RELAXED);
+}
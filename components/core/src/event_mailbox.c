@@ -0,0 +1,425 @@
+/**
+ * @file event_mailbox.c
+ * @brief მოდულების საფოსტო ყუთები (mailbox) და handler-ების სტატისტიკა.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-10-06
+ * @details ჩვეულებრივ ყველა `handle_event` ზოლის დისპეტჩერზე სრულდება, ამიტომ
+ *          ერთი ნელი handler (I2C, NVS) ყველა სხვა მოდულის ივენთებს აყოვნებს.
+ *          საფოსტო ყუთიან მოდულს დისპეტჩერი ივენთს მხოლოდ უდებს მის შეზღუდულ
+ *          რიგში, ხოლო handler-ს იძახებს მოდულის საკუთარი შემსრულებელი ტასკი
+ *          (actor), ივენთების მოსვლის თანმიმდევრობით.
+ *
+ *          დისპეტჩერი ყუთს `module_t::mailbox`-ით პოულობს read სექციის შიგნით;
+ *          გათიშვისას მაჩვენებელი ჯერ ნულდება, შემდეგ ველოდებით ამ სექციების
+ *          დასრულებას და მხოლოდ ამის მერე ვაჩერებთ შემსრულებელს.
+ */
+#include "event_mailbox_internal.h"
+#include "event_bus_internal.h"
+#include "event_subscription_internal.h"
+#include "event_bus.h"
+#include "event_data_wrapper.h"
+#include "event_scratch_internal.h"
+#include "base_module.h"
+#include "synapse_trace.h"
+#include "logging.h"
+#include "framework_config.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+DEFINE_COMPONENT_TAG("EVENT_MAILBOX", SYNAPSE_LOG_COLOR_BLUE);
+
+// --- Kconfig Definitions ---
+#define MAILBOX_DEFAULT_QUEUE_LENGTH CONFIG_SYNAPSE_EVENT_MAILBOX_QUEUE_LENGTH
+#define MAILBOX_DEFAULT_STACK_SIZE CONFIG_SYNAPSE_EVENT_BUS_TASK_STACK_SIZE
+#define MAILBOX_DEFAULT_TASK_PRIORITY CONFIG_SYNAPSE_EVENT_BULK_TASK_PRIORITY
+#define MAILBOX_STOP_TIMEOUT_MS CONFIG_SYNAPSE_DEINIT_TIMEOUT_MS
+
+/**
+ * @internal
+ * @brief ერთი მოდულის საფოსტო ყუთი: რიგი, შემსრულებელი ტასკი და სტატისტიკა.
+ * @details რიგის ელემენტი ზოლის შეტყობინებაა (`event_message_t`); `event_id ==
+ *          SYNAPSE_EVENT_ID_INVALID` შემსრულებლის გაჩერების სიგნალია.
+ */
+typedef struct module_mailbox_t
+{
+    module_t *module;                        /**< @brief ყუთის მფლობელი მოდული. */
+    QueueHandle_t queue;                     /**< @brief შეზღუდული რიგი. */
+    TaskHandle_t task;                       /**< @brief შემსრულებელი ტასკი. */
+    SemaphoreHandle_t stopped;               /**< @brief შემსრულებელი გასვლისას გასცემს. */
+    uint32_t queue_length;                   /**< @brief რიგის ტევადობა. */
+    uint32_t block_timeout_ms;               /**< @brief სავსე რიგზე დისპეტჩერის ლოდინის ზღვარი. */
+    uint32_t high_watermark;                 /**< @brief რიგის შევსების მაქსიმუმი. */
+    uint32_t dropped;                        /**< @brief სავსე რიგის გამო დაკარგული ივენთები. */
+    uint32_t max_wait_us;                    /**< @brief უდიდესი დაყოვნება რიგში. */
+    event_scratch_arena_t scratch;           /**< @brief handler-ის დროებითი არენა; ნულდება ყოველი ივენთის შემდეგ. */
+    char task_name[configMAX_TASK_NAME_LEN]; /**< @brief შემსრულებლის სახელი (`mb_<მოდული>`, საჭიროებისას შეკვეცილი). */
+} module_mailbox_t;
+
+// --- Internal Helper Functions ---
+
+/**
+ * @internal
+ * @brief ატომურად ზრდის `*target`-ს `value`-მდე.
+ */
+static void update_max(uint32_t *target, uint32_t value)
+{
+    uint32_t current = __atomic_load_n(target, __ATOMIC_RELAXED);
+    while (value > current &&
+           !__atomic_compare_exchange_n(target, &current, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+}
+
+/**
+ * @internal
+ * @brief იძახებს მოდულის handler-ს რიგიდან ამოღებული შეტყობინებით.
+ */
+static void handle_message(module_t *module, const event_message_t *msg)
+{
+    // ინლაინ payload შემსრულებლის stack-ზე ცოცხლობს, ამიტომ wrapper "ნასესხებია" - ისევე, როგორც დისპეტჩერზე
+    event_data_wrapper_t borrowed = {
+        .ref_count = 1,
+        .payload = (void *)msg->inline_data.bytes,
+        .payload_size = msg->inline_size,
+        .flags = SYNAPSE_EVENT_DATA_FLAG_BORROWED,
+    };
+    event_data_wrapper_t *data_wrapper = (msg->inline_size > 0) ? &borrowed : msg->data_wrapper;
+
+    SYNAPSE_TRACE(SYNAPSE_TRACE_HANDLER_ENTER, msg->event_id, (uintptr_t)module);
+#ifdef CONFIG_SYNAPSE_EVENT_MODULE_STATS
+    int64_t started_us = esp_timer_get_time();
+#endif
+    module->base.handle_event(module, synapse_event_bus_get_name(msg->event_id), data_wrapper);
+#ifdef CONFIG_SYNAPSE_EVENT_MODULE_STATS
+    synapse_event_module_record_handler(module, (uint32_t)(esp_timer_get_time() - started_us));
+#endif
+    SYNAPSE_TRACE(SYNAPSE_TRACE_HANDLER_EXIT, msg->event_id, (uintptr_t)module);
+}
+
+/**
+ * @internal
+ * @brief მოდულის შემსრულებელი ტასკი: ამუშავებს ყუთის ივენთებს, სანამ გაჩერების სიგნალს არ მიიღებს.
+ * @details handler-ის წინ მოწმდება, რომ მოდული ივენთს ჯერ კიდევ იღებს: რიგში
+ *          მდგომი ივენთები, რომელთა გამოწერაც გაუქმდა, handler-ის გარეშე იშლება.
+ * @param pvParameters მაჩვენებელი ყუთზე (`module_mailbox_t`).
+ */
+static void mailbox_task(void *pvParameters)
+{
+    module_mailbox_t *mailbox = (module_mailbox_t *)pvParameters;
+    event_message_t msg;
+    synapse_event_scratch_bind(&mailbox->scratch);
+    while (1)
+    {
+        if (xQueueReceive(mailbox->queue, &msg, portMAX_DELAY) != pdPASS)
+        {
+            continue;
+        }
+        if (msg.event_id == SYNAPSE_EVENT_ID_INVALID)
+        {
+            break; // გაჩერების სიგნალი - მის წინ მდგომი ივენთები უკვე დამუშავდა
+        }
+        update_max(&mailbox->max_wait_us, (uint32_t)esp_timer_get_time() - msg.posted_at_us);
+        // `unsubscribe` ამ მრიცხველს ელოდება: შემოწმებიდან handler-ის დასრულებამდე ივენთი მიწოდებაშია
+        __atomic_fetch_add(&mailbox->module->in_dispatch, 1, __ATOMIC_RELAXED);
+        if (synapse_event_bus_is_routed(mailbox->module, msg.event_id))
+        {
+            handle_message(mailbox->module, &msg);
+        }
+        else if (msg.data_wrapper)
+        {
+            // გამოწერა ივენთის რიგში ყოფნისას გაუქმდა
+            synapse_event_data_release(msg.data_wrapper);
+        }
+        __atomic_fetch_sub(&mailbox->module->in_dispatch, 1, __ATOMIC_RELEASE);
+        synapse_event_scratch_reset(&mailbox->scratch);
+    }
+
+    // ამის შემდეგ ყუთს აღარ ვეხებით - გამთიშველი მას ათავისუფლებს
+    xSemaphoreGive(mailbox->stopped);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @internal
+ * @brief ათავისუფლებს რიგში დარჩენილი შეტყობინებების reference-ებს.
+ */
+static void drain_mailbox(module_mailbox_t *mailbox)
+{
+    event_message_t msg;
+    while (xQueueReceive(mailbox->queue, &msg, 0) == pdPASS)
+    {
+        if (msg.event_id != SYNAPSE_EVENT_ID_INVALID && msg.data_wrapper)
+        {
+            synapse_event_data_release(msg.data_wrapper);
+        }
+    }
+}
+
+/**
+ * @internal
+ * @brief ათავისუფლებს ყუთის რესურსებს (შემსრულებელი უკვე გაჩერებულია ან არ შექმნილა).
+ */
+static void free_mailbox(module_mailbox_t *mailbox)
+{
+    if (mailbox->queue)
+    {
+        drain_mailbox(mailbox);
+        vQueueDelete(mailbox->queue);
+    }
+    if (mailbox->stopped)
+    {
+        vSemaphoreDelete(mailbox->stopped);
+    }
+    synapse_event_scratch_deinit(&mailbox->scratch);
+    free(mailbox);
+}
+
+/**
+ * @internal
+ * @brief აჩერებს შემსრულებელს: რიგში მდგომი ივენთები ჯერ მუშავდება, შემდეგ ტასკი გადის.
+ * @details ტასკი იძულებით არ იშლება - ის შეიძლება უკვე გადიოდეს და ყუთს ეხებოდეს.
+ *          თუ handler ტაიმაუტში ვერ სრულდება, ვლოგავთ გაფრთხილებას და ვაგრძელებთ ლოდინს.
+ */
+static void stop_mailbox(module_mailbox_t *mailbox)
+{
+    event_message_t stop = {.event_id = SYNAPSE_EVENT_ID_INVALID};
+    TickType_t timeout = pdMS_TO_TICKS(MAILBOX_STOP_TIMEOUT_MS);
+    bool sent = xQueueSend(mailbox->queue, &stop, timeout) == pdPASS;
+    if (!sent || xSemaphoreTake(mailbox->stopped, timeout) != pdTRUE)
+    {
+        ESP_LOGW(TAG, "Mailbox executor of '%s' did not stop in %d ms; still waiting for its handler.",
+                 mailbox->module->name, MAILBOX_STOP_TIMEOUT_MS);
+        if (!sent)
+        {
+            xQueueSend(mailbox->queue, &stop, portMAX_DELAY);
+        }
+        xSemaphoreTake(mailbox->stopped, portMAX_DELAY);
+    }
+    free_mailbox(mailbox);
+}
+
+/**
+ * @internal
+ * @brief დებს ივენთს ყუთის რიგში; სავსე რიგში (ტაიმაუტის შემდეგ) ივენთი იკარგება.
+ * @note უნდა გამოიძახოს მხოლოდ read სექციის შიგნით.
+ * @return false, თუ ნასესხები payload ინლაინ არეში არ ეტევა - მაშინ handler-ს დისპეტჩერი იძახებს.
+ */
+static bool post_to_mailbox(module_mailbox_t *mailbox, synapse_event_id_t event_id, event_data_wrapper_t *data_wrapper,
+                            bool counted)
+{
+    event_message_t msg = {
+        .event_id = event_id,
+        .posted_at_us = (uint32_t)esp_timer_get_time(),
+    };
+    if (counted)
+    {
+        synapse_event_data_acquire(data_wrapper);
+        msg.data_wrapper = data_wrapper;
+    }
+    else if (data_wrapper && data_wrapper->payload_size > 0)
+    {
+        // ნასესხები payload დისპეტჩერის გამოძახების შემდეგ აღარ იარსებებს, ამიტომ კოპირდება
+        if (data_wrapper->payload_size > EVENT_INLINE_PAYLOAD_SIZE)
+        {
+            return false;
+        }
+        memcpy(msg.inline_data.bytes, data_wrapper->payload, data_wrapper->payload_size);
+        msg.inline_size = (uint8_t)data_wrapper->payload_size;
+    }
+
+    if (xQueueSend(mailbox->queue, &msg, pdMS_TO_TICKS(mailbox->block_timeout_ms)) != pdPASS)
+    {
+        if (__atomic_fetch_add(&mailbox->dropped, 1, __ATOMIC_RELAXED) == 0)
+        {
+            // შემდეგი დანაკარგები მხოლოდ `dropped`-ში ითვლება, რომ ლოგი დისპეტჩერს არ აყოვნებდეს
+            ESP_LOGW(TAG, "Mailbox of '%s' is full (%u slots); dropping events. See mailbox_dropped.",
+                     mailbox->module->name, (unsigned)mailbox->queue_length);
+        }
+        if (msg.data_wrapper)
+        {
+            synapse_event_data_release(msg.data_wrapper);
+        }
+        return true;
+    }
+    update_max(&mailbox->high_watermark, (uint32_t)uxQueueMessagesWaiting(mailbox->queue));
+    return true;
+}
+
+// --- Internal API Implementation ---
+
+bool synapse_event_mailbox_post(module_t *module, synapse_event_id_t event_id, event_data_wrapper_t *data_wrapper,
+                                bool counted)
+{
+    // ყუთი read სექციის შიგნით არ გათავისუფლდება
+    uint32_t read_token = synapse_event_subscriptions_read_lock();
+    module_mailbox_t *mailbox = __atomic_load_n(&module->mailbox, __ATOMIC_ACQUIRE);
+    bool posted = mailbox && post_to_mailbox(mailbox, event_id, data_wrapper, counted);
+    synapse_event_subscriptions_read_unlock(read_token);
+    return posted;
+}
+
+bool synapse_event_mailbox_is_executor(const module_t *module)
+{
+    uint32_t read_token = synapse_event_subscriptions_read_lock();
+    const module_mailbox_t *mailbox = __atomic_load_n(&module->mailbox, __ATOMIC_ACQUIRE);
+    bool executor = mailbox && mailbox->task == xTaskGetCurrentTaskHandle();
+    synapse_event_subscriptions_read_unlock(read_token);
+    return executor;
+}
+
+void synapse_event_module_record_handler(module_t *module, uint32_t duration_us)
+{
+    __atomic_fetch_add(&module->event_stats.handled, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&module->event_stats.total_handler_us, duration_us, __ATOMIC_RELAXED);
+    update_max(&module->event_stats.max_handler_us, duration_us);
+}
+
+void synapse_event_module_reset_stats(module_t *module)
+{
+    if (!module)
+    {
+        return;
+    }
+    __atomic_store_n(&module->event_stats.handled, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&module->event_stats.total_handler_us, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&module->event_stats.max_handler_us, 0, __ATOMIC_RELAXED);
+
+    // ყუთი read სექციის შიგნით არ გათავისუფლდება
+    uint32_t read_token = synapse_event_subscriptions_read_lock();
+    module_mailbox_t *mailbox = __atomic_load_n(&module->mailbox, __ATOMIC_ACQUIRE);
+    if (mailbox)
+    {
+        __atomic_store_n(&mailbox->high_watermark, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&mailbox->dropped, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&mailbox->max_wait_us, 0, __ATOMIC_RELAXED);
+    }
+    synapse_event_subscriptions_read_unlock(read_token);
+}
+
+// --- Public API Implementation ---
+
+esp_err_t synapse_event_bus_enable_mailbox(module_t *module, const synapse_event_mailbox_config_t *config)
+{
+    if (!module || !module->base.handle_event)
+    {
+        ESP_LOGE(TAG, "Cannot enable a mailbox: module is NULL or has no event handler.");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (__atomic_load_n(&module->mailbox, __ATOMIC_ACQUIRE))
+    {
+        ESP_LOGW(TAG, "Module '%s' already has a mailbox.", module->name);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    synapse_event_mailbox_config_t cfg = config ? *config : (synapse_event_mailbox_config_t){0};
+    module_mailbox_t *mailbox = calloc(1, sizeof(module_mailbox_t));
+    if (!mailbox)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    mailbox->module = module;
+    mailbox->queue_length = cfg.queue_length ? cfg.queue_length : MAILBOX_DEFAULT_QUEUE_LENGTH;
+    mailbox->block_timeout_ms = cfg.block_timeout_ms;
+    mailbox->queue = xQueueCreate(mailbox->queue_length, sizeof(event_message_t));
+    mailbox->stopped = xSemaphoreCreateBinary();
+    if (!mailbox->queue || !mailbox->stopped || synapse_event_scratch_init(&mailbox->scratch) != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to create the mailbox of '%s'.", module->name);
+        free_mailbox(mailbox);
+        return ESP_ERR_NO_MEM;
+    }
+
+    // FreeRTOS-ის სახელის ზღვარში "mb_" + მოდულის სახელის დასაწყისი ეტევა - დანარჩენს შეგნებულად ვჭრით
+    snprintf(mailbox->task_name, sizeof(mailbox->task_name), "mb_%.*s", (int)(sizeof(mailbox->task_name) - 4),
+             module->name);
+    if (xTaskCreate(mailbox_task, mailbox->task_name, cfg.stack_size ? cfg.stack_size : MAILBOX_DEFAULT_STACK_SIZE,
+                    mailbox, cfg.task_priority ? cfg.task_priority : MAILBOX_DEFAULT_TASK_PRIORITY,
+                    &mailbox->task) != pdPASS)
+    {
+        ESP_LOGE(TAG, "Failed to create the mailbox executor of '%s'.", module->name);
+        free_mailbox(mailbox);
+        return ESP_ERR_NO_MEM;
+    }
+
+    // ამ მომენტიდან დისპეტჩერი მოდულის ასინქრონულ ივენთებს ყუთში დებს
+    module_mailbox_t *expected = NULL;
+    if (!__atomic_compare_exchange_n(&module->mailbox, &expected, mailbox, false, __ATOMIC_RELEASE,
+                                     __ATOMIC_RELAXED))
+    {
+        stop_mailbox(mailbox);
+        return ESP_ERR_INVALID_STATE;
+    }
+    ESP_LOGI(TAG, "Mailbox enabled for '%s' (%u slots).", module->name, (unsigned)mailbox->queue_length);
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_bus_disable_mailbox(module_t *module)
+{
+    if (!module)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    module_mailbox_t *mailbox = __atomic_load_n(&module->mailbox, __ATOMIC_ACQUIRE);
+    if (!mailbox)
+    {
+        return ESP_OK;
+    }
+    if (xTaskGetCurrentTaskHandle() == mailbox->task)
+    {
+        ESP_LOGE(TAG, "'%s' cannot disable its mailbox from its own handler.", module->name);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    mailbox = __atomic_exchange_n(&module->mailbox, NULL, __ATOMIC_ACQ_REL);
+    if (!mailbox)
+    {
+        return ESP_OK; // პარალელურმა გამოძახებამ დაგვასწრო
+    }
+
+    // დავრწმუნდეთ, რომ ყუთში აღარცერთი დისპეტჩერი აღარ დებს ივენთს
+    esp_err_t err = synapse_event_subscriptions_synchronize();
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Cannot disable the mailbox of '%s': %s", module->name, esp_err_to_name(err));
+        __atomic_store_n(&module->mailbox, mailbox, __ATOMIC_RELEASE);
+        return err;
+    }
+
+    stop_mailbox(mailbox);
+    ESP_LOGI(TAG, "Mailbox disabled for '%s'.", module->name);
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_bus_get_module_stats(const module_t *module, synapse_event_module_stats_t *stats)
+{
+    if (!module || !stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->handled = __atomic_load_n(&module->event_stats.handled, __ATOMIC_RELAXED);
+    uint32_t total_us = __atomic_load_n(&module->event_stats.total_handler_us, __ATOMIC_RELAXED);
+    stats->avg_handler_us = stats->handled ? total_us / stats->handled : 0;
+    stats->max_handler_us = __atomic_load_n(&module->event_stats.max_handler_us, __ATOMIC_RELAXED);
+
+    uint32_t read_token = synapse_event_subscriptions_read_lock();
+    const module_mailbox_t *mailbox = __atomic_load_n(&module->mailbox, __ATOMIC_ACQUIRE);
+    if (mailbox)
+    {
+        stats->mailbox = true;
+        stats->queue_length = mailbox->queue_length;
+        stats->pending = (uint32_t)uxQueueMessagesWaiting(mailbox->queue);
+        stats->high_watermark = __atomic_load_n(&mailbox->high_watermark, __ATOMIC_RELAXED);
+        stats->dropped = __atomic_load_n(&mailbox->dropped, __ATOMIC_RELAXED);
+        stats->max_wait_us = __atomic_load_n(&mailbox->max_wait_us, __ATOMIC_RELAXED);
+    }
+    synapse_event_subscriptions_read_unlock(read_token);
+    return ESP_OK;
+}
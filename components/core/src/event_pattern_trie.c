@@ -0,0 +1,549 @@
+/**
+ * @file event_pattern_trie.c
+ * @brief Event Bus-ის იერარქიული pattern-ების trie-ს კომპილაცია და დამთხვევა.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-09-25
+ * @details pattern-ების გამოწერები კომპილირდება ერთ უცვლელ (immutable) ბლოკად:
+ *          თითოეული კვანძის ლიტერალური შვილები მიმდევრობით და დალაგებულად ინახება,
+ *          ამიტომ დამთხვევისას თითო სეგმენტზე სრულდება ერთი ორობითი ძებნა და
+ *          მაქსიმუმ ერთი `+` გადასვლა. `*` გამომწერები ინახება იმ კვანძზე,
+ *          რომლის შემდეგაც `*` დგას.
+ *
+ *          ფაილი არ იყენებს lock-ებს: trie-ს ქმნის გამოწერების საცავი (ჩამწერის
+ *          mutex-ის ქვეშ), ხოლო დისპეტჩერები მას კითხულობენ read სექციაში.
+ */
+#include "event_pattern_internal.h"
+#include "base_module.h"
+#include "logging.h"
+#include <string.h>
+#include <stdlib.h>
+
+DEFINE_COMPONENT_TAG("EVENT_PATTERN", SYNAPSE_LOG_COLOR_BLUE);
+
+#define TRIE_NO_CHILD UINT32_MAX
+
+/**
+ * @internal
+ * @brief კომპილირებული trie-ს ერთი კვანძი (ერთი სეგმენტი).
+ */
+typedef struct
+{
+    uint32_t label_offset; /**< @brief სეგმენტის ტექსტის offset `labels`-ში. */
+    uint32_t label_length; /**< @brief სეგმენტის სიგრძე (root-ისთვის 0). */
+    uint32_t first_child;  /**< @brief პირველი ლიტერალური შვილის ინდექსი; შვილები დალაგებულია. */
+    uint32_t child_count;  /**< @brief ლიტერალური შვილების რაოდენობა. */
+    uint32_t plus_child;   /**< @brief `+` შვილის ინდექსი ან TRIE_NO_CHILD. */
+    uint32_t exact_first;  /**< @brief აქ დასრულებული pattern-ების მოდულები (`modules`-ში). */
+    uint32_t exact_count;
+    uint32_t star_first;   /**< @brief `<ეს კვანძი>.*` pattern-ების მოდულები. */
+    uint32_t star_count;
+} trie_node_t;
+
+struct event_pattern_trie_t
+{
+    event_retired_t retired; /**< @brief უნდა იყოს პირველი ველი (იხ. event_retired_t). */
+    uint32_t node_count;
+    uint32_t total_bytes;
+    module_t **modules;
+    const trie_node_t *nodes;
+    const char *labels;
+};
+
+/**
+ * @internal
+ * @brief კომპილაციის დროებითი კვანძი.
+ */
+typedef struct build_node_t
+{
+    const char *label;
+    uint32_t label_length;
+    struct build_node_t *first_child;  /**< @brief ლიტერალური შვილები, დალაგებული სია. */
+    struct build_node_t *last_child;   /**< @brief ბოლოს დამატებული ლიტერალური შვილი. */
+    struct build_node_t *next_sibling;
+    struct build_node_t *plus;
+    uint32_t exact_count;
+    uint32_t star_count;
+    uint32_t exact_fill; /**< @brief მოდულების ჩაწერის კურსორი (მეორე გავლისთვის). */
+    uint32_t star_fill;
+} build_node_t;
+
+/**
+ * @internal
+ * @brief pattern-ის ადგილი დროებით ხეში (მოდულების განთავსებისთვის).
+ */
+typedef struct
+{
+    build_node_t *node; /**< @brief ბოლო კვანძი (`*`-ისას - მისი მშობელი). */
+    bool star;          /**< @brief pattern მთავრდება `*`-ით. */
+} build_placement_t;
+
+/**
+ * @internal
+ * @brief კომპილაციის კონტექსტი.
+ */
+typedef struct
+{
+    build_node_t *pool;
+    uint32_t pool_used;
+    uint32_t label_bytes;
+    event_pattern_trie_t *trie;
+    trie_node_t *nodes;
+    char *labels;
+    uint32_t next_index;
+    uint32_t label_used;
+    uint32_t module_cursor;
+} build_ctx_t;
+
+/**
+ * @internal
+ * @brief დამთხვევის კონტექსტი.
+ */
+typedef struct
+{
+    const event_pattern_trie_t *trie;
+    module_t **out;
+    size_t max;
+    size_t count;
+    bool overflow;
+} match_ctx_t;
+
+// --- Internal Helper Functions ---
+
+/**
+ * @internal
+ * @brief ადარებს სეგმენტებს (ჯერ შინაარსით, მერე სიგრძით) - trie-ს დალაგების წესი.
+ */
+static int compare_segments(const char *a, uint32_t a_len, const char *b, uint32_t b_len)
+{
+    int cmp = memcmp(a, b, a_len < b_len ? a_len : b_len);
+    if (cmp != 0)
+    {
+        return cmp;
+    }
+    return (a_len > b_len) - (a_len < b_len);
+}
+
+/**
+ * @internal
+ * @brief აბრუნებს მიმდინარე სეგმენტის სიგრძეს და შემდეგი სეგმენტის დასაწყისს (NULL, თუ ეს ბოლოა).
+ */
+static uint32_t next_segment(const char *segment, const char **next_out)
+{
+    const char *end = strchr(segment, SYNAPSE_EVENT_TOPIC_SEPARATOR);
+    if (end)
+    {
+        *next_out = end + 1;
+        return (uint32_t)(end - segment);
+    }
+    *next_out = NULL;
+    return (uint32_t)strlen(segment);
+}
+
+static bool is_plus(const char *segment, uint32_t length)
+{
+    return length == 1 && segment[0] == '+';
+}
+
+static bool is_star(const char *segment, uint32_t length)
+{
+    return length == 1 && segment[0] == '*';
+}
+
+static build_node_t *build_node_new(build_ctx_t *ctx, const char *label, uint32_t length)
+{
+    build_node_t *node = &ctx->pool[ctx->pool_used++];
+    memset(node, 0, sizeof(*node));
+    node->label = label;
+    node->label_length = length;
+    ctx->label_bytes += length;
+    return node;
+}
+
+/**
+ * @internal
+ * @brief ადარებს ორ pattern-ს სეგმენტ-სეგმენტ (`compare_segments`-ის წესით); ტოლობისას - გამოწერის თანმიმდევრობით.
+ */
+static int compare_entries(const void *a, const void *b)
+{
+    const event_pattern_entry_t *entry_a = *(const event_pattern_entry_t *const *)a;
+    const event_pattern_entry_t *entry_b = *(const event_pattern_entry_t *const *)b;
+    const char *seg_a = entry_a->pattern;
+    const char *seg_b = entry_b->pattern;
+    while (seg_a && seg_b)
+    {
+        const char *next_a = NULL;
+        const char *next_b = NULL;
+        uint32_t len_a = next_segment(seg_a, &next_a);
+        uint32_t len_b = next_segment(seg_b, &next_b);
+        int cmp = compare_segments(seg_a, len_a, seg_b, len_b);
+        if (cmp != 0)
+        {
+            return cmp;
+        }
+        seg_a = next_a;
+        seg_b = next_b;
+    }
+    if (seg_a != seg_b)
+    {
+        return seg_a ? 1 : -1; // უფრო მოკლე pattern პირველია
+    }
+    return (entry_a > entry_b) - (entry_a < entry_b);
+}
+
+/**
+ * @internal
+ * @brief პოულობს (ან ქმნის) ლიტერალურ შვილს.
+ * @details pattern-ები დალაგებული თანმიმდევრობით ემატება, ამიტომ არსებული
+ *          შვილი შეიძლება იყოს მხოლოდ ბოლოს დამატებული, ახალი კი ყოველთვის
+ *          სიის ბოლოში ჩადგება - სია დალაგებული რჩება დამატებითი ძებნის გარეშე.
+ */
+static build_node_t *build_literal_child(build_ctx_t *ctx, build_node_t *parent, const char *label, uint32_t length)
+{
+    build_node_t *last = parent->last_child;
+    if (last && compare_segments(last->label, last->label_length, label, length) == 0)
+    {
+        return last;
+    }
+    build_node_t *node = build_node_new(ctx, label, length);
+    if (last)
+    {
+        last->next_sibling = node;
+    }
+    else
+    {
+        parent->first_child = node;
+    }
+    parent->last_child = node;
+    return node;
+}
+
+/**
+ * @internal
+ * @brief გადის pattern-ს დროებით ხეში და ქმნის გამოტოვებულ კვანძებს.
+ * @param[out] star_out true, თუ pattern მთავრდება `*`-ით (დაბრუნებული კვანძი `*`-ის მშობელია).
+ */
+static build_node_t *build_walk(build_ctx_t *ctx, build_node_t *root, const char *pattern, bool *star_out)
+{
+    build_node_t *node = root;
+    const char *segment = pattern;
+    *star_out = false;
+    while (segment)
+    {
+        const char *next = NULL;
+        uint32_t length = next_segment(segment, &next);
+        if (is_star(segment, length))
+        {
+            *star_out = true;
+            break;
+        }
+        if (is_plus(segment, length))
+        {
+            if (!node->plus)
+            {
+                node->plus = build_node_new(ctx, segment, length);
+            }
+            node = node->plus;
+        }
+        else
+        {
+            node = build_literal_child(ctx, node, segment, length);
+        }
+        segment = next;
+    }
+    return node;
+}
+
+/**
+ * @internal
+ * @brief გადაიტანს დროებით კვანძს (და მის ქვეხეს) საბოლოო მასივში `index` პოზიციაზე.
+ */
+static void flatten_node(build_ctx_t *ctx, build_node_t *bn, uint32_t index)
+{
+    trie_node_t *node = &ctx->nodes[index];
+
+    node->label_offset = ctx->label_used;
+    node->label_length = bn->label_length;
+    memcpy(&ctx->labels[ctx->label_used], bn->label, bn->label_length);
+    ctx->label_used += bn->label_length;
+
+    node->child_count = 0;
+    for (build_node_t *child = bn->first_child; child; child = child->next_sibling)
+    {
+        node->child_count++;
+    }
+    node->first_child = ctx->next_index;
+    ctx->next_index += node->child_count;
+    node->plus_child = bn->plus ? ctx->next_index++ : TRIE_NO_CHILD;
+
+    node->exact_first = ctx->module_cursor;
+    node->exact_count = bn->exact_count;
+    ctx->module_cursor += bn->exact_count;
+    node->star_first = ctx->module_cursor;
+    node->star_count = bn->star_count;
+    ctx->module_cursor += bn->star_count;
+    bn->exact_fill = node->exact_first;
+    bn->star_fill = node->star_first;
+
+    uint32_t child_index = node->first_child;
+    for (build_node_t *child = bn->first_child; child; child = child->next_sibling)
+    {
+        flatten_node(ctx, child, child_index++);
+    }
+    if (bn->plus)
+    {
+        flatten_node(ctx, bn->plus, node->plus_child);
+    }
+}
+
+/**
+ * @internal
+ * @brief ამატებს დამთხვეულ მოდულებს შედეგში (დუბლიკატების გარეშე).
+ */
+static void match_collect(match_ctx_t *ctx, uint32_t first, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        module_t *module = ctx->trie->modules[first + i];
+        bool duplicate = false;
+        for (size_t j = 0; j < ctx->count; j++)
+        {
+            if (ctx->out[j] == module)
+            {
+                duplicate = true;
+                break;
+            }
+        }
+        if (duplicate)
+        {
+            continue;
+        }
+        if (ctx->count >= ctx->max)
+        {
+            ctx->overflow = true;
+            return;
+        }
+        ctx->out[ctx->count++] = module;
+    }
+}
+
+/**
+ * @internal
+ * @brief პოულობს ლიტერალურ შვილს ორობითი ძებნით.
+ */
+static uint32_t match_find_child(const event_pattern_trie_t *trie, const trie_node_t *node, const char *segment, uint32_t length)
+{
+    uint32_t low = node->first_child;
+    uint32_t high = node->first_child + node->child_count;
+    while (low < high)
+    {
+        uint32_t mid = low + (high - low) / 2;
+        const trie_node_t *child = &trie->nodes[mid];
+        int cmp = compare_segments(&trie->labels[child->label_offset], child->label_length, segment, length);
+        if (cmp == 0)
+        {
+            return mid;
+        }
+        if (cmp < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return TRIE_NO_CHILD;
+}
+
+/**
+ * @internal
+ * @brief რეკურსიული დამთხვევა: `segment` არის თემის დარჩენილი ნაწილი (NULL - თემა ამოიწურა).
+ */
+static void match_node(match_ctx_t *ctx, uint32_t index, const char *segment)
+{
+    const trie_node_t *node = &ctx->trie->nodes[index];
+    if (!segment)
+    {
+        match_collect(ctx, node->exact_first, node->exact_count);
+        return;
+    }
+
+    // `*` ემთხვევა ერთ ან მეტ დარჩენილ სეგმენტს
+    match_collect(ctx, node->star_first, node->star_count);
+
+    const char *next = NULL;
+    uint32_t length = next_segment(segment, &next);
+    uint32_t child = match_find_child(ctx->trie, node, segment, length);
+    if (child != TRIE_NO_CHILD)
+    {
+        match_node(ctx, child, next);
+    }
+    if (node->plus_child != TRIE_NO_CHILD)
+    {
+        match_node(ctx, node->plus_child, next);
+    }
+}
+
+// --- Internal API Implementation ---
+
+bool synapse_event_pattern_is_pattern(const char *name)
+{
+    if (!name || strcmp(name, "*") == 0)
+    {
+        return false;
+    }
+    for (const char *segment = name; segment;)
+    {
+        const char *next = NULL;
+        uint32_t length = next_segment(segment, &next);
+        if (is_plus(segment, length) || is_star(segment, length))
+        {
+            return true;
+        }
+        segment = next;
+    }
+    return false;
+}
+
+esp_err_t synapse_event_pattern_validate(const char *pattern)
+{
+    if (!pattern || pattern[0] == '\0')
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (const char *segment = pattern; segment;)
+    {
+        const char *next = NULL;
+        uint32_t length = next_segment(segment, &next);
+        if (length == 0 || (is_star(segment, length) && next))
+        {
+            return ESP_ERR_INVALID_ARG;
+        }
+        segment = next;
+    }
+    return ESP_OK;
+}
+
+event_pattern_trie_t *synapse_event_pattern_trie_build(const event_pattern_entry_t *entries, size_t count)
+{
+    if (!entries || count == 0)
+    {
+        return NULL;
+    }
+
+    // 1. დროებითი ხე (კვანძების მაქსიმალური რაოდენობა = სეგმენტების ჯამი + root)
+    uint32_t max_nodes = 1;
+    for (size_t i = 0; i < count; i++)
+    {
+        max_nodes++;
+        for (const char *p = entries[i].pattern; *p; p++)
+        {
+            max_nodes += (*p == SYNAPSE_EVENT_TOPIC_SEPARATOR);
+        }
+    }
+
+    build_ctx_t ctx = {0};
+    ctx.pool = malloc(max_nodes * sizeof(build_node_t));
+    const event_pattern_entry_t **sorted = malloc(count * sizeof(*sorted));
+    build_placement_t *placements = malloc(count * sizeof(*placements));
+    if (!ctx.pool || !sorted || !placements)
+    {
+        free(ctx.pool);
+        free(sorted);
+        free(placements);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        sorted[i] = &entries[i];
+    }
+    qsort(sorted, count, sizeof(*sorted), compare_entries);
+
+    build_node_t *root = build_node_new(&ctx, "", 0);
+    for (size_t i = 0; i < count; i++)
+    {
+        build_placement_t *placement = &placements[i];
+        placement->node = build_walk(&ctx, root, sorted[i]->pattern, &placement->star);
+        if (placement->star)
+        {
+            placement->node->star_count++;
+        }
+        else
+        {
+            placement->node->exact_count++;
+        }
+    }
+
+    // 2. ერთი ბლოკის გამოყოფა: header | modules | nodes | labels
+    uint32_t node_count = ctx.pool_used;
+    size_t total = sizeof(event_pattern_trie_t) + count * sizeof(module_t *) + node_count * sizeof(trie_node_t) + ctx.label_bytes;
+    event_pattern_trie_t *trie = malloc(total);
+    if (!trie)
+    {
+        free(ctx.pool);
+        free(sorted);
+        free(placements);
+        return NULL;
+    }
+    trie->retired.next = NULL;
+    trie->node_count = node_count;
+    trie->total_bytes = (uint32_t)total;
+    trie->modules = (module_t **)(trie + 1);
+    ctx.nodes = (trie_node_t *)(trie->modules + count);
+    ctx.labels = (char *)(ctx.nodes + node_count);
+    trie->nodes = ctx.nodes;
+    trie->labels = ctx.labels;
+
+    ctx.trie = trie;
+    ctx.next_index = 1;
+    flatten_node(&ctx, root, 0);
+
+    // 3. მოდულების განთავსება კვანძების დიაპაზონებში (ტოლ pattern-ებში - გამოწერის თანმიმდევრობით)
+    for (size_t i = 0; i < count; i++)
+    {
+        build_node_t *node = placements[i].node;
+        uint32_t slot = placements[i].star ? node->star_fill++ : node->exact_fill++;
+        trie->modules[slot] = sorted[i]->module;
+    }
+
+    free(sorted);
+    free(placements);
+    free(ctx.pool);
+    ESP_LOGD(TAG, "Compiled %u patterns into %u trie nodes (%u bytes)", (unsigned)count, (unsigned)node_count, (unsigned)total);
+    return trie;
+}
+
+size_t synapse_event_pattern_trie_match(const event_pattern_trie_t *trie, const char *topic,
+                                        module_t **modules, size_t max, bool *overflow_out)
+{
+    match_ctx_t ctx = {
+        .trie = trie,
+        .out = modules,
+        .max = max,
+        .count = 0,
+        .overflow = false,
+    };
+    if (trie && topic && topic[0] != '\0')
+    {
+        match_node(&ctx, 0, topic);
+    }
+    if (overflow_out)
+    {
+        *overflow_out = ctx.overflow;
+    }
+    return ctx.count;
+}
+
+void synapse_event_pattern_trie_get_size(const event_pattern_trie_t *trie, uint32_t *nodes_out, uint32_t *bytes_out)
+{
+    if (nodes_out)
+    {
+        *nodes_out = trie ? trie->node_count : 0;
+    }
+    if (bytes_out)
+    {
+        *bytes_out = trie ? trie->total_bytes : 0;
+    }
+}
@@ -10,6 +10,9 @@
  */
 
 #include "event_payloads.h" // ამ ფაილის შესაბამისი ჰედერი
+#include "synapse_pool.h"   // payload-ები ფიქსირებული ბლოკების აუზიდან
+#include "synapse_buffer.h" // გაზიარებული JSON ბუფერები
+#include "synapse_utils.h"  // synapse_safe_strncpy()
 #include <stdlib.h>         // free() ფუნქციისთვის
 
 /**
@@ -17,8 +20,8 @@
  *
  * @details ეს ფუნქცია გადაეცემა `synapse_event_data_wrap`-ს ტელემეტრიული ივენთების
  *          შექმნისას, რათა Event Bus-მა შეძლოს მეხსიერების უსაფრთხოდ გათავისუფლება.
- *          ფუნქცია ჯერ ათავისუფლებს შიდა, დინამიურად გამოყოფილ `json_data` სტრიქონს,
- *          შემდეგ კი თავად კონტეინერ სტრუქტურას.
+ *          ფუნქცია ჯერ ათავისუფლებს შიდა, დინამიურად გამოყოფილ `json_data` სტრიქონს
+ *          ან `json_slice`-ის reference-ს, შემდეგ კი თავად კონტეინერ სტრუქტურას.
  *
  * @param payload void მაჩვენებელი გასათავისუფლებელ `synapse_telemetry_payload_t` ობიექტზე.
  *                NULL მნიშვნელობა უსაფრთხოდ იგნორირებულია.
@@ -37,7 +40,130 @@ void synapse_telemetry_payload_free(void *payload)
     {
         free(telemetry_payload->json_data);
     }
+    synapse_buffer_slice_release(&telemetry_payload->json_slice);
 
-    // შემდეგ ვათავისუფლებთ თავად კონტეინერ სტრუქტურას
-    free(telemetry_payload);
-}
\ No newline at end of file
+    // შემდეგ ვათავისუფლებთ თავად კონტეინერ სტრუქტურას (აუზიდან ან heap-იდან)
+    synapse_pool_free(telemetry_payload);
+}
+
+esp_err_t synapse_telemetry_payload_create_from_slice(const char *module_name, const synapse_buffer_slice_t *json,
+                                                      synapse_telemetry_payload_t **payload_out)
+{
+    if (!module_name || !json || !json->buffer || !payload_out)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *payload_out = NULL;
+
+    synapse_telemetry_payload_t *payload = SYNAPSE_PAYLOAD_NEW(synapse_telemetry_payload_t);
+    if (!payload)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    // payload-ს საკუთარი reference სჭირდება - გამომძახებელი თავისას თავად ათავისუფლებს
+    esp_err_t err = synapse_buffer_slice_sub(json, 0, SIZE_MAX, &payload->json_slice);
+    if (err != ESP_OK)
+    {
+        synapse_pool_free(payload);
+        return err;
+    }
+
+    synapse_safe_strncpy(payload->module_name, module_name, sizeof(payload->module_name));
+    *payload_out = payload;
+    return ESP_OK;
+}
+
+esp_err_t synapse_telemetry_payload_create_from_buffer(const char *module_name, synapse_buffer_t *json,
+                                                       synapse_telemetry_payload_t **payload_out)
+{
+    synapse_buffer_slice_t whole = {
+        .buffer = json,
+        .offset = 0,
+        .length = (uint32_t)synapse_buffer_length(json),
+    };
+    return synapse_telemetry_payload_create_from_slice(module_name, &whole, payload_out);
+}
+
+const char *synapse_telemetry_payload_get_json(const synapse_telemetry_payload_t *payload, size_t *length_out)
+{
+    const char *json = NULL;
+    size_t length = 0;
+
+    if (payload && payload->json_slice.buffer)
+    {
+        json = (const char *)synapse_buffer_slice_data(&payload->json_slice);
+        length = payload->json_slice.length;
+    }
+    else if (payload && payload->json_data)
+    {
+        json = payload->json_data;
+        length = strlen(json);
+    }
+
+    if (length_out)
+    {
+        *length_out = length;
+    }
+    return json;
+}
+
+esp_err_t synapse_telemetry_payload_get_slice(const synapse_telemetry_payload_t *payload, size_t offset, size_t length,
+                                              synapse_buffer_slice_t *slice_out)
+{
+    if (!payload || !slice_out)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *slice_out = SYNAPSE_BUFFER_SLICE_EMPTY;
+
+    if (payload->json_slice.buffer)
+    {
+        return synapse_buffer_slice_sub(&payload->json_slice, offset, length, slice_out);
+    }
+    if (!payload->json_data)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // ძველი ფორმა: სტრიქონი payload-ს ეკუთვნის, ამიტომ ერთხელ ვაკოპირებთ
+    size_t total = strlen(payload->json_data);
+    if (offset > total || (length != SIZE_MAX && length > total - offset))
+    {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (length == SIZE_MAX)
+    {
+        length = total - offset;
+    }
+
+    synapse_buffer_t *copy = NULL;
+    esp_err_t err = synapse_buffer_copy(payload->json_data + offset, length, &copy);
+    if (err != ESP_OK)
+    {
+        return err;
+    }
+    err = synapse_buffer_slice(copy, 0, SIZE_MAX, slice_out);
+    synapse_buffer_release(copy); // ნაჭერი ინარჩუნებს საკუთარ reference-ს
+    return err;
+}
+
+/**
+ * @brief აბრუნებს სერვისის სახელის FNV-1a ჰეშს conflation-ის გასაღებად.
+ */
+uint32_t synapse_service_status_conflation_key(const void *payload)
+{
+    const synapse_service_status_payload_t *status = (const synapse_service_status_payload_t *)payload;
+    if (!status)
+    {
+        return 0;
+    }
+
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(status->service_name) && status->service_name[i] != '\0'; i++)
+    {
+        hash ^= (uint8_t)status->service_name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
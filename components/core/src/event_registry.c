@@ -0,0 +1,402 @@
+/**
+ * @file event_registry.c
+ * @brief Event Bus-ის ივენთების სახელების interning რეესტრის იმპლემენტაცია.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-09-20
+ * @details რეესტრი ყოველ ივენთის სახელს ერთხელ უთანხმებს კომპაქტურ
+ *          `synapse_event_id_t` იდენტიფიკატორს. სახელი კოპირდება მხოლოდ
+ *          პირველი რეგისტრაციისას და შემდეგ რჩება უცვლელი, ამიტომ Event Bus-ს
+ *          ივენთის გამოქვეყნებისას აღარ სჭირდება `strdup()` და `strcmp()`.
+ *
+ *          - სახელით ძებნა ხდება open-addressing ჰეშ-ცხრილში (FNV-1a, linear probing).
+ *          - ძებნა არის lock-free; mutex-ს იყენებს მხოლოდ ახალი სახელის დამატება.
+ *          - `framework_events.h`-ის ივენთები რეგისტრირდება ინიციალიზაციისას
+ *            ფიქსირებული თანმიმდევრობით, ამიტომ მათი ID ცნობილია build-time-ზე.
+ */
+#include "event_registry_internal.h"
+#include "event_bus.h"
+#include "logging.h"
+#include "framework_config.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <string.h>
+#include <stdlib.h>
+
+DEFINE_COMPONENT_TAG("EVENT_REGISTRY", SYNAPSE_LOG_COLOR_BLUE);
+
+// --- Kconfig Definitions ---
+#define EVENT_REGISTRY_MAX_NAMES CONFIG_SYNAPSE_EVENT_MAX_NAMES
+#define EVENT_REGISTRY_HASH_SLOTS (EVENT_REGISTRY_MAX_NAMES * 2)
+/** @brief შევსება, რომლის მიღწევისას ერთხელ იწერება გაფრთხილება (სახელები არასოდეს თავისუფლდება). */
+#define EVENT_REGISTRY_WARN_NAMES (EVENT_REGISTRY_MAX_NAMES * 3 / 4)
+
+_Static_assert(EVENT_REGISTRY_MAX_NAMES > SYNAPSE_EVENT_ID_FRAMEWORK_COUNT,
+               "CONFIG_SYNAPSE_EVENT_MAX_NAMES must leave room for runtime event names");
+_Static_assert(EVENT_REGISTRY_MAX_NAMES < SYNAPSE_EVENT_ID_INVALID,
+               "CONFIG_SYNAPSE_EVENT_MAX_NAMES must fit into synapse_event_id_t");
+
+// --- Static Globals ---
+
+/**
+ * @internal
+ * @brief ივენთების დესკრიპტორები, ინდექსირებული ID-ით.
+ */
+static event_descriptor_t s_descriptors[EVENT_REGISTRY_MAX_NAMES];
+
+/**
+ * @internal
+ * @brief ჰეშ-ცხრილი: ინახავს `ID + 1`-ს, 0 ნიშნავს ცარიელ სლოტს.
+ */
+static uint16_t s_hash_slots[EVENT_REGISTRY_HASH_SLOTS];
+
+static uint16_t s_descriptor_count = 0;
+static SemaphoreHandle_t s_registry_mutex = NULL;
+
+/**
+ * @internal
+ * @brief framework_events.h-ის სახელები იმავე თანმიმდევრობით, რაც enum-ში.
+ */
+static const char *const s_framework_event_names[] = {
+    "*",
+#define EVENT_REGISTRY_NAME_ENTRY(id_suffix, event_name) event_name,
+    SYNAPSE_FRAMEWORK_EVENT_LIST(EVENT_REGISTRY_NAME_ENTRY)
+#undef EVENT_REGISTRY_NAME_ENTRY
+};
+
+_Static_assert(sizeof(s_framework_event_names) / sizeof(s_framework_event_names[0]) == SYNAPSE_EVENT_ID_FRAMEWORK_COUNT,
+               "Framework event name table is out of sync with SYNAPSE_FRAMEWORK_EVENT_LIST");
+
+// --- Forward Declarations ---
+static uint32_t hash_event_name(const char *event_name);
+static synapse_event_id_t find_event_id(const char *event_name, uint32_t hash, uint32_t *free_slot_out);
+static void insert_descriptor(const char *name, uint32_t hash, uint32_t slot);
+
+// --- Internal Helper Functions ---
+
+/**
+ * @internal
+ * @brief FNV-1a ჰეში ივენთის სახელისთვის.
+ */
+static uint32_t hash_event_name(const char *event_name)
+{
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)event_name; *p; p++)
+    {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @internal
+ * @brief ეძებს სახელს ჰეშ-ცხრილში.
+ * @param[out] free_slot_out (არასავალდებულო) პირველი ცარიელი სლოტი, სადაც სახელი უნდა ჩაიწეროს.
+ * @return ნაპოვნი ID ან SYNAPSE_EVENT_ID_INVALID.
+ */
+static synapse_event_id_t find_event_id(const char *event_name, uint32_t hash, uint32_t *free_slot_out)
+{
+    uint32_t slot = hash % EVENT_REGISTRY_HASH_SLOTS;
+    for (uint32_t probe = 0; probe < EVENT_REGISTRY_HASH_SLOTS; probe++)
+    {
+        uint16_t entry = __atomic_load_n(&s_hash_slots[slot], __ATOMIC_ACQUIRE);
+        if (entry == 0)
+        {
+            if (free_slot_out)
+            {
+                *free_slot_out = slot;
+            }
+            return SYNAPSE_EVENT_ID_INVALID;
+        }
+
+        const event_descriptor_t *desc = &s_descriptors[entry - 1];
+        if (desc->hash == hash && strcmp(desc->name, event_name) == 0)
+        {
+            return (synapse_event_id_t)(entry - 1);
+        }
+        slot = (slot + 1) % EVENT_REGISTRY_HASH_SLOTS;
+    }
+    return SYNAPSE_EVENT_ID_INVALID;
+}
+
+/**
+ * @internal
+ * @brief ამატებს ახალ დესკრიპტორს და აქვეყნებს მას ჰეშ-ცხრილში.
+ * @note უნდა გამოიძახოს მხოლოდ s_registry_mutex-ის დაცულ სექციაში.
+ */
+static void insert_descriptor(const char *name, uint32_t hash, uint32_t slot)
+{
+    uint16_t id = s_descriptor_count;
+    s_descriptors[id].name = name;
+    s_descriptors[id].hash = hash;
+    s_descriptors[id].default_priority = SYNAPSE_EVENT_PRIORITY_NORMAL;
+    s_descriptors[id].flags = 0;
+    s_descriptors[id].conflation_key_fn = NULL;
+    s_descriptors[id].conflated = 0;
+    s_descriptors[id].overflow_policy = SYNAPSE_EVENT_OVERFLOW_LANE_DEFAULT;
+    s_descriptors[id].block_timeout_ms = 0;
+    s_descriptors[id].posted = 0;
+    s_descriptors[id].dropped = 0;
+    s_descriptors[id].spilled = 0;
+    s_descriptors[id].high_watermark = 0;
+    s_descriptors[id].capture_encode_fn = NULL;
+    s_descriptors[id].capture_decode_fn = NULL;
+
+    // ჯერ ვავსებთ დესკრიპტორს, მერე ვაქვეყნებთ - lock-free მკითხველები ნახევრად შევსებულს ვერ დაინახავენ.
+    __atomic_store_n(&s_hash_slots[slot], (uint16_t)(id + 1), __ATOMIC_RELEASE);
+    __atomic_store_n(&s_descriptor_count, (uint16_t)(id + 1), __ATOMIC_RELEASE);
+}
+
+// --- Internal API Implementation ---
+
+esp_err_t synapse_event_registry_init(void)
+{
+    if (s_registry_mutex != NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    s_registry_mutex = xSemaphoreCreateMutex();
+    if (!s_registry_mutex)
+    {
+        ESP_LOGE(TAG, "Failed to create registry mutex.");
+        return ESP_ERR_NO_MEM;
+    }
+
+    memset(s_descriptors, 0, sizeof(s_descriptors));
+    memset(s_hash_slots, 0, sizeof(s_hash_slots));
+    s_descriptor_count = 0;
+
+    for (uint16_t i = 0; i < SYNAPSE_EVENT_ID_FRAMEWORK_COUNT; i++)
+    {
+        uint32_t hash = hash_event_name(s_framework_event_names[i]);
+        uint32_t slot = 0;
+        if (find_event_id(s_framework_event_names[i], hash, &slot) != SYNAPSE_EVENT_ID_INVALID)
+        {
+            ESP_LOGE(TAG, "Duplicate framework event name '%s'.", s_framework_event_names[i]);
+            return ESP_ERR_INVALID_STATE;
+        }
+        insert_descriptor(s_framework_event_names[i], hash, slot);
+    }
+
+    // სისტემის სიცოცხლისუნარიანობისთვის კრიტიკული ივენთები არ უნდა ელოდონ ტელემეტრიას
+    s_descriptors[SYNAPSE_EVENT_ID_SYSTEM_SHUTDOWN_REQUESTED].default_priority = SYNAPSE_EVENT_PRIORITY_CRITICAL;
+    s_descriptors[SYNAPSE_EVENT_ID_HEARTBEAT_MISSED].default_priority = SYNAPSE_EVENT_PRIORITY_CRITICAL;
+
+    ESP_LOGI(TAG, "Event registry initialized with %d framework events (capacity %d).",
+             SYNAPSE_EVENT_ID_FRAMEWORK_COUNT, EVENT_REGISTRY_MAX_NAMES);
+    return ESP_OK;
+}
+
+event_descriptor_t *synapse_event_registry_get(synapse_event_id_t event_id)
+{
+    if (event_id >= __atomic_load_n(&s_descriptor_count, __ATOMIC_ACQUIRE))
+    {
+        return NULL;
+    }
+    return &s_descriptors[event_id];
+}
+
+uint16_t synapse_event_registry_count(void)
+{
+    return __atomic_load_n(&s_descriptor_count, __ATOMIC_ACQUIRE);
+}
+
+// --- Public API Implementation ---
+
+synapse_event_id_t synapse_event_bus_find_id(const char *event_name)
+{
+    if (!event_name || event_name[0] == '\0')
+    {
+        return SYNAPSE_EVENT_ID_INVALID;
+    }
+    return find_event_id(event_name, hash_event_name(event_name), NULL);
+}
+
+synapse_event_id_t synapse_event_bus_intern(const char *event_name)
+{
+    if (!event_name || event_name[0] == '\0')
+    {
+        ESP_LOGE(TAG, "Cannot intern a NULL or empty event name.");
+        return SYNAPSE_EVENT_ID_INVALID;
+    }
+
+    if (!s_registry_mutex)
+    {
+        ESP_LOGE(TAG, "Event registry is not initialized.");
+        return SYNAPSE_EVENT_ID_INVALID;
+    }
+
+    uint32_t hash = hash_event_name(event_name);
+
+    // სწრაფი გზა: სახელი უკვე რეგისტრირებულია (lock-free)
+    synapse_event_id_t id = find_event_id(event_name, hash, NULL);
+    if (id != SYNAPSE_EVENT_ID_INVALID)
+    {
+        return id;
+    }
+
+    if (xSemaphoreTake(s_registry_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) != pdTRUE)
+    {
+        ESP_LOGE(TAG, "Failed to take registry mutex to intern '%s'.", event_name);
+        return SYNAPSE_EVENT_ID_INVALID;
+    }
+
+    // ხელახლა ვამოწმებთ - სხვა ტასკს შეიძლება უკვე დაემატებინა იგივე სახელი
+    uint32_t slot = 0;
+    id = find_event_id(event_name, hash, &slot);
+    if (id == SYNAPSE_EVENT_ID_INVALID)
+    {
+        if (s_descriptor_count >= EVENT_REGISTRY_MAX_NAMES)
+        {
+            ESP_LOGE(TAG, "Cannot intern '%s': registry is full (%d names).", event_name, EVENT_REGISTRY_MAX_NAMES);
+        }
+        else
+        {
+            char *name_copy = strdup(event_name);
+            if (!name_copy)
+            {
+                ESP_LOGE(TAG, "Failed to duplicate event name '%s'. Out of memory.", event_name);
+            }
+            else
+            {
+                id = s_descriptor_count;
+                insert_descriptor(name_copy, hash, slot);
+                ESP_LOGD(TAG, "Interned event '%s' as ID %u", name_copy, id);
+                if (s_descriptor_count == EVENT_REGISTRY_WARN_NAMES)
+                {
+                    ESP_LOGW(TAG, "Event name registry is %d/%d full; names are never freed (last: '%s').",
+                             EVENT_REGISTRY_WARN_NAMES, EVENT_REGISTRY_MAX_NAMES, name_copy);
+                }
+            }
+        }
+    }
+
+    xSemaphoreGive(s_registry_mutex);
+    return id;
+}
+
+const char *synapse_event_bus_get_name(synapse_event_id_t event_id)
+{
+    const event_descriptor_t *desc = synapse_event_registry_get(event_id);
+    return desc ? desc->name : NULL;
+}
+
+esp_err_t synapse_event_bus_set_default_priority(synapse_event_id_t event_id, synapse_event_priority_t priority)
+{
+    event_descriptor_t *desc = synapse_event_registry_get(event_id);
+    if (!desc || priority >= SYNAPSE_EVENT_PRIORITY_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    __atomic_store_n(&desc->default_priority, (uint8_t)priority, __ATOMIC_RELAXED);
+    return ESP_OK;
+}
+
+synapse_event_priority_t synapse_event_bus_get_default_priority(synapse_event_id_t event_id)
+{
+    const event_descriptor_t *desc = synapse_event_registry_get(event_id);
+    if (!desc)
+    {
+        return SYNAPSE_EVENT_PRIORITY_NORMAL;
+    }
+    return (synapse_event_priority_t)__atomic_load_n(&desc->default_priority, __ATOMIC_RELAXED);
+}
+
+esp_err_t synapse_event_bus_set_conflation(synapse_event_id_t event_id, bool enable,
+                                           synapse_event_conflation_key_fn_t key_fn)
+{
+    event_descriptor_t *desc = synapse_event_registry_get(event_id);
+    if (!desc || event_id == SYNAPSE_EVENT_ID_WILDCARD)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (enable)
+    {
+        // ჯერ გასაღების ფუნქცია, მერე ფლაგი - გამომქვეყნებელი, რომელიც ფლაგს დაინახავს, სწორ ფუნქციასაც დაინახავს
+        __atomic_store_n(&desc->conflation_key_fn, key_fn, __ATOMIC_RELEASE);
+        __atomic_fetch_or(&desc->flags, (uint8_t)EVENT_DESCRIPTOR_FLAG_CONFLATING, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        __atomic_fetch_and(&desc->flags, (uint8_t)~EVENT_DESCRIPTOR_FLAG_CONFLATING, __ATOMIC_RELEASE);
+    }
+    ESP_LOGI(TAG, "Conflation %s for event '%s'", enable ? "enabled" : "disabled", desc->name);
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_bus_set_partition_key(synapse_event_id_t event_id, synapse_event_partition_key_fn_t key_fn)
+{
+    event_descriptor_t *desc = synapse_event_registry_get(event_id);
+    if (!desc || event_id == SYNAPSE_EVENT_ID_WILDCARD)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    __atomic_store_n(&desc->partition_key_fn, key_fn, __ATOMIC_RELEASE);
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_bus_set_dispatch_core(synapse_event_id_t event_id, int core)
+{
+    event_descriptor_t *desc = synapse_event_registry_get(event_id);
+    if (!desc || event_id == SYNAPSE_EVENT_ID_WILDCARD ||
+        (core != SYNAPSE_EVENT_DISPATCH_CORE_ANY && (core < 0 || core >= portNUM_PROCESSORS)))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // 0 ნიშნავს "არ არის დაფიქსირებული", ამიტომ ბირთვი ერთით წანაცვლებით ინახება
+    __atomic_store_n(&desc->dispatch_core, (uint8_t)(core + 1), __ATOMIC_RELEASE);
+    return ESP_OK;
+}
+
+uint32_t synapse_event_bus_get_conflated_count(synapse_event_id_t event_id)
+{
+    const event_descriptor_t *desc = synapse_event_registry_get(event_id);
+    return desc ? __atomic_load_n(&desc->conflated, __ATOMIC_RELAXED) : 0;
+}
+
+esp_err_t synapse_event_bus_set_overflow_policy(synapse_event_id_t event_id,
+                                                synapse_event_overflow_policy_t policy,
+                                                uint32_t block_timeout_ms)
+{
+    event_descriptor_t *desc = synapse_event_registry_get(event_id);
+    if (!desc || (policy > SYNAPSE_EVENT_OVERFLOW_SPILL && policy != SYNAPSE_EVENT_OVERFLOW_LANE_DEFAULT))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // ჯერ ტაიმაუტი, მერე პოლიტიკა - გამომქვეყნებელი BLOCK-ს ძველი ტაიმაუტით ვერ დაინახავს
+    __atomic_store_n(&desc->block_timeout_ms, block_timeout_ms, __ATOMIC_RELEASE);
+    __atomic_store_n(&desc->overflow_policy, (uint8_t)policy, __ATOMIC_RELEASE);
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_bus_get_event_stats(synapse_event_id_t event_id, synapse_event_stats_t *stats)
+{
+    const event_descriptor_t *desc = synapse_event_registry_get(event_id);
+    if (!desc || !stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    stats->posted = __atomic_load_n(&desc->posted, __ATOMIC_RELAXED);
+    stats->dropped = __atomic_load_n(&desc->dropped, __ATOMIC_RELAXED);
+    stats->spilled = __atomic_load_n(&desc->spilled, __ATOMIC_RELAXED);
+    stats->conflated = __atomic_load_n(&desc->conflated, __ATOMIC_RELAXED);
+    stats->high_watermark = __atomic_load_n(&desc->high_watermark, __ATOMIC_RELAXED);
+    return ESP_OK;
+}
+
+void synapse_event_bus_reset_event_stats(void)
+{
+    uint16_t count = synapse_event_registry_count();
+    for (uint16_t id = 0; id < count; id++)
+    {
+        event_descriptor_t *desc = &s_descriptors[id];
+        __atomic_store_n(&desc->posted, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&desc->dropped, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&desc->spilled, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&desc->conflated, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&desc->high_watermark, 0, __ATOMIC_RELAXED);
+    }
+}
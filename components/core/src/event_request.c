@@ -0,0 +1,415 @@
+/**
+ * @file event_request.c
+ * @brief მოთხოვნა/პასუხის (request/response) იმპლემენტაცია Event Bus-ზე.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-09-30
+ * @details მოლოდინში მყოფი მოთხოვნები ინახება ფიქსირებულ ცხრილში.
+ *          `correlation_id` = (თაობა << 16) | (ინდექსი + 1), ამიტომ პასუხი
+ *          სლოტს პოულობს პირდაპირ, ძებნის გარეშე, ხოლო დაგვიანებული პასუხი
+ *          (სლოტი უკვე სხვა მოთხოვნას ეკუთვნის) თაობის შედარებით ვლინდება.
+ *
+ *          ტაიმაუტი არის timing wheel-ის შიდა ტაიმერი. ლოკების რიგი:
+ *          მოთხოვნების mutex -> wheel-ის mutex; ტაიმაუტის callback და `reply`
+ *          wheel-ის ლოკს მოთხოვნების ლოკის გარეშე იღებენ.
+ */
+#include "event_bus.h"
+#include "event_bus_internal.h"
+#include "event_data_wrapper.h"
+#include "promise_manager_internal.h"
+#include "logging.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+DEFINE_COMPONENT_TAG("EVENT_REQUEST", SYNAPSE_LOG_COLOR_BLUE);
+
+#if defined(CONFIG_SYNAPSE_EVENT_TIMER_ENABLE)
+
+// --- Kconfig Definitions ---
+#define REQUEST_MAX_PENDING CONFIG_SYNAPSE_EVENT_REQUEST_MAX_PENDING
+#define REQUEST_DEFAULT_TIMEOUT_MS CONFIG_SYNAPSE_EVENT_REQUEST_DEFAULT_TIMEOUT_MS
+
+/** @brief "არცერთი" ინდექსი თავისუფალ სიაში. */
+#define REQUEST_NIL UINT16_MAX
+
+_Static_assert(REQUEST_MAX_PENDING < REQUEST_NIL, "CONFIG_SYNAPSE_EVENT_REQUEST_MAX_PENDING must fit into a uint16_t index");
+
+// --- Internal Structures ---
+
+/**
+ * @internal
+ * @brief ერთი მოლოდინში მყოფი მოთხოვნა.
+ */
+typedef struct
+{
+    promise_handle_t promise;    /**< @brief მოთხოვნის promise; NULL = სლოტი თავისუფალია. */
+    synapse_event_timer_t timer; /**< @brief ტაიმაუტის ტაიმერი. */
+    uint32_t sent_at_us;         /**< @brief გაგზავნის დრო (esp_timer, 32 ბიტი) round trip-ისთვის. */
+    uint16_t generation;         /**< @brief იზრდება ყოველ გათავისუფლებაზე. */
+    uint16_t next_free;          /**< @brief შემდეგი თავისუფალი სლოტი. */
+} request_slot_t;
+
+// --- Static Globals ---
+static request_slot_t s_slots[REQUEST_MAX_PENDING];
+static uint16_t s_free_head = REQUEST_NIL;
+static SemaphoreHandle_t s_lock = NULL;
+static synapse_event_request_stats_t s_stats;
+static event_latency_histogram_t s_rtt;
+static uint32_t s_rtt_max_us = 0;
+
+/** @brief მნიშვნელობა, რომელსაც ტაიმაუტისას `catch_cb`-ის `error_data` მიუთითებს. */
+static esp_err_t s_timeout_error = ESP_ERR_TIMEOUT;
+/** @brief ცარიელი payload მოთხოვნებისთვის მონაცემების გარეშე. */
+static const uint8_t s_empty_payload = 0;
+
+// --- Internal Helper Functions ---
+
+/**
+ * @internal
+ * @brief აბრუნებს `correlation_id`-ის სლოტს, თუ ის ისევ მოლოდინშია.
+ * @note უნდა გამოიძახოს მხოლოდ s_lock-ის ქვეშ.
+ */
+static request_slot_t *find_pending(uint32_t correlation_id)
+{
+    uint32_t index = (correlation_id & 0xFFFF) - 1;
+    if (correlation_id == 0 || index >= REQUEST_MAX_PENDING)
+    {
+        return NULL;
+    }
+    request_slot_t *slot = &s_slots[index];
+    if (!slot->promise || slot->generation != (uint16_t)(correlation_id >> 16))
+    {
+        return NULL;
+    }
+    return slot;
+}
+
+/**
+ * @internal
+ * @brief ათავისუფლებს სლოტს (ძველი `correlation_id` ინვალიდდება).
+ * @note უნდა გამოიძახოს მხოლოდ s_lock-ის ქვეშ.
+ */
+static void slot_free(request_slot_t *slot)
+{
+    slot->promise = NULL;
+    slot->timer = SYNAPSE_EVENT_TIMER_INVALID;
+    slot->generation++;
+    slot->next_free = s_free_head;
+    s_free_head = (uint16_t)(slot - s_slots);
+    s_stats.pending--;
+}
+
+/**
+ * @internal
+ * @brief ტაიმაუტის callback (timing wheel-ის ტასკში).
+ */
+static void request_timeout(uint32_t correlation_id)
+{
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    request_slot_t *slot = find_pending(correlation_id);
+    promise_handle_t promise = slot ? slot->promise : NULL;
+    if (slot)
+    {
+        slot_free(slot);
+        s_stats.timed_out++;
+    }
+    xSemaphoreGive(s_lock);
+
+    if (promise)
+    {
+        ESP_LOGD(TAG, "Request 0x%08" PRIx32 " timed out.", correlation_id);
+        synapse_promise_reject(promise, &s_timeout_error, NULL);
+    }
+}
+
+/**
+ * @internal
+ * @brief `reply`/`reply_error`-ის საერთო ნაწილი.
+ */
+static esp_err_t settle(uint32_t correlation_id, void *data, void (*free_fn)(void *), bool is_resolve)
+{
+    if (correlation_id == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    promise_handle_t promise = NULL;
+    synapse_event_timer_t timer = SYNAPSE_EVENT_TIMER_INVALID;
+    if (s_lock)
+    {
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        request_slot_t *slot = find_pending(correlation_id);
+        if (slot)
+        {
+            promise = slot->promise;
+            timer = slot->timer;
+            uint32_t rtt_us = (uint32_t)esp_timer_get_time() - slot->sent_at_us;
+            synapse_event_latency_record(&s_rtt, rtt_us);
+            if (rtt_us > s_rtt_max_us)
+            {
+                s_rtt_max_us = rtt_us;
+            }
+            slot_free(slot);
+            if (is_resolve)
+            {
+                s_stats.replied++;
+            }
+            else
+            {
+                s_stats.failed++;
+            }
+        }
+        else
+        {
+            s_stats.late_replies++;
+        }
+        xSemaphoreGive(s_lock);
+    }
+
+    if (!promise)
+    {
+        ESP_LOGD(TAG, "No pending request 0x%08" PRIx32 " (timed out or already answered).", correlation_id);
+        if (data && free_fn)
+        {
+            free_fn(data);
+        }
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    // ტაიმერი შეიძლება უკვე სრულდებოდეს - მაშინ მისი callback სლოტს ვეღარ იპოვის
+    synapse_event_bus_cancel_timer(timer);
+    return is_resolve ? synapse_promise_resolve(promise, data, free_fn) : synapse_promise_reject(promise, data, free_fn);
+}
+
+// --- Public API Implementation ---
+
+esp_err_t synapse_event_request_init(void)
+{
+    if (s_lock)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_lock = xSemaphoreCreateMutex();
+    if (!s_lock)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    for (uint16_t i = 0; i < REQUEST_MAX_PENDING; i++)
+    {
+        s_slots[i].next_free = (i + 1 < REQUEST_MAX_PENDING) ? i + 1 : REQUEST_NIL;
+    }
+    s_free_head = 0;
+    s_stats.capacity = REQUEST_MAX_PENDING;
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_bus_request(const char *event_name, event_data_wrapper_t *data_wrapper, uint32_t timeout_ms,
+                                    promise_then_cb then_cb, promise_catch_cb catch_cb, void *user_context,
+                                    promise_handle_t *promise_out)
+{
+    if (!event_name || strlen(event_name) == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (data_wrapper && (data_wrapper->correlation_id != 0 || synapse_event_data_is_borrowed(data_wrapper)))
+    {
+        ESP_LOGE(TAG, "Request '%s': the wrapper already carries a request or is borrowed.", event_name);
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!s_lock)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    synapse_event_id_t event_id = synapse_event_bus_intern(event_name);
+    if (event_id == SYNAPSE_EVENT_ID_INVALID)
+    {
+        ESP_LOGE(TAG, "Failed to intern event name '%s'.", event_name);
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t err = ESP_OK;
+    event_data_wrapper_t *own_wrapper = NULL;
+    if (!data_wrapper)
+    {
+        err = synapse_event_data_wrap(&s_empty_payload, NULL, &own_wrapper);
+        if (err != ESP_OK)
+        {
+            return err;
+        }
+        data_wrapper = own_wrapper;
+    }
+
+    // promise იქმნება გამოქვეყნებამდე: პასუხი შეიძლება სხვა ტასკიდან მაშინვე მოვიდეს
+    promise_handle_t promise = synapse_promise_create(then_cb, catch_cb, user_context);
+    if (!promise)
+    {
+        err = ESP_ERR_NO_MEM;
+        goto out;
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    if (s_free_head == REQUEST_NIL)
+    {
+        xSemaphoreGive(s_lock);
+        ESP_LOGW(TAG, "Request '%s' rejected: %d requests already pending.", event_name, REQUEST_MAX_PENDING);
+        synapse_promise_cancel(promise);
+        err = ESP_ERR_NO_MEM;
+        goto out;
+    }
+    request_slot_t *slot = &s_slots[s_free_head];
+    uint32_t correlation_id = ((uint32_t)slot->generation << 16) | (uint32_t)(s_free_head + 1);
+    err = synapse_event_timer_schedule_callback(timeout_ms ? timeout_ms : REQUEST_DEFAULT_TIMEOUT_MS,
+                                                request_timeout, correlation_id, &slot->timer);
+    if (err != ESP_OK)
+    {
+        xSemaphoreGive(s_lock);
+        synapse_promise_cancel(promise);
+        goto out;
+    }
+    s_free_head = slot->next_free;
+    slot->promise = promise;
+    slot->sent_at_us = (uint32_t)esp_timer_get_time();
+    s_stats.sent++;
+    s_stats.pending++;
+    if (s_stats.pending > s_stats.high_watermark)
+    {
+        s_stats.high_watermark = s_stats.pending;
+    }
+    xSemaphoreGive(s_lock);
+
+    data_wrapper->correlation_id = correlation_id;
+    err = synapse_event_bus_post_id(event_id, data_wrapper);
+    if (err != ESP_OK)
+    {
+        synapse_event_timer_t timer = SYNAPSE_EVENT_TIMER_INVALID;
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        slot = find_pending(correlation_id);
+        if (slot)
+        {
+            timer = slot->timer;
+            slot_free(slot);
+            s_stats.sent--;
+        }
+        xSemaphoreGive(s_lock);
+        if (slot)
+        {
+            synapse_event_bus_cancel_timer(timer);
+            synapse_promise_cancel(promise);
+        }
+        // slot == NULL: ტაიმაუტი გამოქვეყნებაზე ადრე შესრულდა და promise უკვე უარყო
+        data_wrapper->correlation_id = 0;
+        ESP_LOGW(TAG, "Failed to post request '%s': %s", event_name, esp_err_to_name(err));
+        goto out;
+    }
+
+    if (promise_out)
+    {
+        *promise_out = promise;
+    }
+
+out:
+    if (own_wrapper)
+    {
+        synapse_event_data_release(own_wrapper);
+    }
+    return err;
+}
+
+esp_err_t synapse_event_bus_reply(uint32_t correlation_id, void *result_data, void (*free_fn)(void *))
+{
+    return settle(correlation_id, result_data, free_fn, true);
+}
+
+esp_err_t synapse_event_bus_reply_error(uint32_t correlation_id, void *error_data, void (*free_fn)(void *))
+{
+    return settle(correlation_id, error_data, free_fn, false);
+}
+
+esp_err_t synapse_event_bus_get_request_stats(synapse_event_request_stats_t *stats)
+{
+    if (!stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_lock)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    *stats = s_stats;
+    stats->rtt_p50_us = synapse_event_latency_percentile(&s_rtt, 500);
+    stats->rtt_p99_us = synapse_event_latency_percentile(&s_rtt, 990);
+    stats->rtt_max_us = s_rtt_max_us;
+    xSemaphoreGive(s_lock);
+
+    // ჰისტოგრამა აბრუნებს bucket-ის ზედა საზღვარს, რომელიც შეიძლება რეალურ მაქსიმუმს აღემატებოდეს
+    if (stats->rtt_p50_us > stats->rtt_max_us)
+    {
+        stats->rtt_p50_us = stats->rtt_max_us;
+    }
+    if (stats->rtt_p99_us > stats->rtt_max_us)
+    {
+        stats->rtt_p99_us = stats->rtt_max_us;
+    }
+    return ESP_OK;
+}
+
+void synapse_event_bus_reset_request_stats(void)
+{
+    if (!s_lock)
+    {
+        return;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    uint32_t pending = s_stats.pending;
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_stats.capacity = REQUEST_MAX_PENDING;
+    s_stats.pending = pending;
+    s_stats.high_watermark = pending;
+    synapse_event_latency_reset(&s_rtt);
+    s_rtt_max_us = 0;
+    xSemaphoreGive(s_lock);
+}
+
+#else // !CONFIG_SYNAPSE_EVENT_TIMER_ENABLE
+
+esp_err_t synapse_event_request_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_bus_request(const char *event_name, event_data_wrapper_t *data_wrapper, uint32_t timeout_ms,
+                                    promise_then_cb then_cb, promise_catch_cb catch_cb, void *user_context,
+                                    promise_handle_t *promise_out)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t synapse_event_bus_reply(uint32_t correlation_id, void *result_data, void (*free_fn)(void *))
+{
+    if (result_data && free_fn)
+    {
+        free_fn(result_data);
+    }
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t synapse_event_bus_reply_error(uint32_t correlation_id, void *error_data, void (*free_fn)(void *))
+{
+    return synapse_event_bus_reply(correlation_id, error_data, free_fn);
+}
+
+esp_err_t synapse_event_bus_get_request_stats(synapse_event_request_stats_t *stats)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+void synapse_event_bus_reset_request_stats(void)
+{
+}
+
+#endif // CONFIG_SYNAPSE_EVENT_TIMER_ENABLE
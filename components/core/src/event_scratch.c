@@ -0,0 +1,173 @@
+/**
+ * @file event_scratch.c
+ * @brief ივენთის დამუშავების დროებითი (scratch) bump არენები.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-10-09
+ * @details handler-ებს ხშირად ერთი ივენთის დასამუშავებლად სჭირდებათ დროებითი
+ *          ბუფერი (დაფორმატებული სტრიქონი, თემის სახელი) და მას მაშინვე
+ *          ათავისუფლებენ. არენა ასეთ გამოყოფას ერთი მაჩვენებლის წანაცვლებით
+ *          აკეთებს: გათავისუფლება ცალ-ცალკე არ ხდება - დისპეტჩერი არენას
+ *          ანულებს ყოველი ივენთის შემდეგ. თითოეულ დისპეტჩერსა და საფოსტო ყუთის
+ *          შემსრულებელს საკუთარი არენა აქვს (thread-local მაჩვენებლით), ამიტომ
+ *          ლოკი საჭირო არ არის.
+ */
+
+#include "event_scratch_internal.h"
+#include "event_bus.h"
+#include "logging.h"
+#include "framework_config.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+DEFINE_COMPONENT_TAG("EVENT_SCRATCH", SYNAPSE_LOG_COLOR_BLUE);
+
+// --- Kconfig Definitions ---
+#define SCRATCH_SIZE CONFIG_SYNAPSE_EVENT_SCRATCH_SIZE
+#define SCRATCH_ALIGN(size) (((size) + 7U) & ~(size_t)7U)
+
+// --- Static Globals ---
+
+/** @internal @brief მიმდინარე ტასკის არენა (NULL ტასკებში, რომლებიც ივენთებს არ ამუშავებენ). */
+static __thread event_scratch_arena_t *s_current = NULL;
+
+/** @internal @brief გამოყოფილი არენების რაოდენობა. */
+static uint32_t s_arenas = 0;
+
+/** @internal @brief ერთი ივენთის დამუშავებისას გამოყენებული ბაიტების მაქსიმუმი. */
+static uint32_t s_high_watermark = 0;
+
+/** @internal @brief წარმატებული გამოყოფები. */
+static uint32_t s_allocations = 0;
+
+/** @internal @brief არენაში ვერ დატეული მოთხოვნები. */
+static uint32_t s_overflows = 0;
+
+// --- Internal API Implementation ---
+
+esp_err_t synapse_event_scratch_init(event_scratch_arena_t *arena)
+{
+    *arena = (event_scratch_arena_t){0};
+#if SCRATCH_SIZE > 0
+    arena->base = malloc(SCRATCH_SIZE);
+    if (!arena->base)
+    {
+        ESP_LOGE(TAG, "Failed to allocate a %d-byte scratch arena.", SCRATCH_SIZE);
+        return ESP_ERR_NO_MEM;
+    }
+    __atomic_fetch_add(&s_arenas, 1, __ATOMIC_RELAXED);
+#endif
+    return ESP_OK;
+}
+
+void synapse_event_scratch_deinit(event_scratch_arena_t *arena)
+{
+    if (arena->base)
+    {
+        free(arena->base);
+        arena->base = NULL;
+        __atomic_fetch_sub(&s_arenas, 1, __ATOMIC_RELAXED);
+    }
+    *arena = (event_scratch_arena_t){0};
+}
+
+void synapse_event_scratch_bind(event_scratch_arena_t *arena)
+{
+    s_current = arena;
+}
+
+void synapse_event_scratch_reset(event_scratch_arena_t *arena)
+{
+    uint32_t used = arena->used;
+    if (used == 0 && arena->overflows == 0)
+    {
+        return;
+    }
+
+    // მრიცხველები არენაშია (ტასკის ლოკალური) - გლობალურ ჯამს ვუმატებთ ერთხელ ივენთზე და არა ყოველ გამოყოფაზე
+    __atomic_fetch_add(&s_allocations, arena->allocations, __ATOMIC_RELAXED);
+    if (arena->overflows)
+    {
+        __atomic_fetch_add(&s_overflows, arena->overflows, __ATOMIC_RELAXED);
+    }
+    arena->used = 0;
+    arena->allocations = 0;
+    arena->overflows = 0;
+
+    uint32_t seen = __atomic_load_n(&s_high_watermark, __ATOMIC_RELAXED);
+    while (used > seen &&
+           !__atomic_compare_exchange_n(&s_high_watermark, &seen, used, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+}
+
+void synapse_event_scratch_reset_stats(void)
+{
+    __atomic_store_n(&s_high_watermark, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_allocations, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_overflows, 0, __ATOMIC_RELAXED);
+}
+
+// --- Public API Implementation ---
+
+void *synapse_event_scratch_alloc(size_t size)
+{
+    event_scratch_arena_t *arena = s_current;
+    if (!arena || !arena->base || size == 0)
+    {
+        return NULL;
+    }
+
+    size_t offset = SCRATCH_ALIGN(arena->used);
+    if (size > SCRATCH_SIZE || offset > SCRATCH_SIZE - size)
+    {
+        arena->overflows++;
+        return NULL;
+    }
+
+    arena->used = (uint32_t)(offset + size);
+    arena->allocations++;
+    return arena->base + offset;
+}
+
+char *synapse_event_scratch_printf(const char *format, ...)
+{
+    event_scratch_arena_t *arena = s_current;
+    if (!format || !arena || !arena->base)
+    {
+        return NULL;
+    }
+
+    // ვწერთ პირდაპირ არენის თავისუფალ ნაწილში და ვიტოვებთ მხოლოდ საჭირო ზომას
+    size_t offset = SCRATCH_ALIGN(arena->used);
+    size_t available = (offset < SCRATCH_SIZE) ? SCRATCH_SIZE - offset : 0;
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf((char *)arena->base + offset, available, format, args);
+    va_end(args);
+
+    if (length < 0 || (size_t)length >= available)
+    {
+        arena->overflows++;
+        return NULL;
+    }
+
+    arena->used = (uint32_t)(offset + (size_t)length + 1);
+    arena->allocations++;
+    return (char *)arena->base + offset;
+}
+
+esp_err_t synapse_event_bus_get_scratch_stats(synapse_event_scratch_stats_t *stats)
+{
+    if (!stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    stats->arena_size = SCRATCH_SIZE;
+    stats->arenas = __atomic_load_n(&s_arenas, __ATOMIC_RELAXED);
+    stats->high_watermark = __atomic_load_n(&s_high_watermark, __ATOMIC_RELAXED);
+    stats->allocations = __atomic_load_n(&s_allocations, __ATOMIC_RELAXED);
+    stats->overflows = __atomic_load_n(&s_overflows, __ATOMIC_RELAXED);
+    return ESP_OK;
+}
@@ -0,0 +1,276 @@
+/**
+ * @file event_static_routes.c
+ * @brief module.json-ის `subscribes` სექციიდან აგებული სტატიკური მარშრუტები.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-10-04
+ * @details აგებისას გენერირებული const სია (`synapse_module_factory_get_event_routes()`)
+ *          ტიპებს უკავშირებს ივენთებს და flash-ში რჩება. ინსტანციები runtime-ში
+ *          იქმნება, ამიტომ Module Registry თითოეულ ახალ მოდულს `bind()`-ით
+ *          აბამს მისი ტიპის მარშრუტებზე, ხოლო ყველა ინსტანციის შექმნის შემდეგ
+ *          `seal()` heap-ში აგებს ერთ დალუქულ ბლოკს (მარშრუტიზაციის ცხრილს):
+ *          ID-ით დალაგებულ ინდექსს და თითო ივენთზე ჩვეულებრივ snapshot-ს. დისპეტჩერი მას ორობითი ძებნით პოულობს
+ *          და დინამიურ გამოწერებთან აერთიანებს - გამოწერის გამოძახება, Mutex ან
+ *          ცალკეული ალოკაცია თითო გამოწერაზე საჭირო აღარ არის.
+ */
+#include "event_static_routes_internal.h"
+#include "event_subscription_internal.h"
+#include "generated_module_factory.h"
+#include "base_module.h"
+#include "logging.h"
+#include "framework_config.h"
+#include <string.h>
+#include <stdlib.h>
+
+DEFINE_COMPONENT_TAG("EVENT_ROUTES", SYNAPSE_LOG_COLOR_BLUE);
+
+// --- Kconfig Definitions ---
+#define ROUTES_MAX_PER_EVENT CONFIG_SYNAPSE_MAX_SUBSCRIBERS_PER_EVENT
+
+/**
+ * @internal
+ * @brief ერთი მიბმა: მოდულის ინსტანცია და ივენთი, რომელსაც ის სტატიკურად იღებს.
+ */
+typedef struct
+{
+    module_t *module;            /**< @brief მიბმული ინსტანცია. */
+    synapse_event_id_t event_id; /**< @brief ივენთის ID. */
+    uint8_t flags;               /**< @brief `MODULE_EVENT_ROUTE_FLAG_*`. */
+    uint16_t order;              /**< @brief მიბმის რიგი (დალაგების სტაბილურობისთვის). */
+} event_static_binding_t;
+
+// --- Static Globals ---
+
+/** @internal @brief `seal()`-მდე შეგროვებული მიბმები (მხოლოდ Module Registry-ის ინიციალიზაციისას). */
+static event_static_binding_t *s_bindings = NULL;
+static size_t s_binding_count = 0;
+static size_t s_binding_capacity = 0;
+
+/** @internal @brief ცხრილი უკვე დალუქულია; ახალი მიბმა აღარ მიიღება. */
+static bool s_sealed = false;
+
+// --- Internal Helper Functions ---
+
+/**
+ * @internal
+ * @brief qsort-ის შედარება: ივენთის ID, შემდეგ მიბმის რიგი.
+ */
+static int compare_bindings(const void *a, const void *b)
+{
+    const event_static_binding_t *x = (const event_static_binding_t *)a;
+    const event_static_binding_t *y = (const event_static_binding_t *)b;
+    if (x->event_id != y->event_id)
+    {
+        return (x->event_id < y->event_id) ? -1 : 1;
+    }
+    return (int)x->order - (int)y->order;
+}
+
+/**
+ * @internal
+ * @brief აბრუნებს ერთი ივენთის snapshot-ის ზომას, დამრგვალებულს მაჩვენებლის ზომამდე.
+ */
+static size_t routed_snapshot_size(size_t count, size_t sync_count)
+{
+    size_t size = sizeof(event_subscriber_snapshot_t) + count * sizeof(module_t *) + (sync_count ? count : 0);
+    return (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+}
+
+/**
+ * @internal
+ * @brief ამატებს ერთ მიბმას; იგივე მოდული/ივენთის წყვილი მხოლოდ დროშებს აერთიანებს.
+ */
+static esp_err_t add_binding(module_t *module, synapse_event_id_t event_id, uint8_t flags)
+{
+    for (size_t i = 0; i < s_binding_count; i++)
+    {
+        if (s_bindings[i].module == module && s_bindings[i].event_id == event_id)
+        {
+            s_bindings[i].flags |= flags;
+            return ESP_OK;
+        }
+    }
+
+    if (s_binding_count == s_binding_capacity)
+    {
+        size_t capacity = s_binding_capacity ? s_binding_capacity * 2 : 8;
+        event_static_binding_t *grown = realloc(s_bindings, capacity * sizeof(event_static_binding_t));
+        if (!grown)
+        {
+            return ESP_ERR_NO_MEM;
+        }
+        s_bindings = grown;
+        s_binding_capacity = capacity;
+    }
+
+    s_bindings[s_binding_count] = (event_static_binding_t){
+        .module = module,
+        .event_id = event_id,
+        .flags = flags,
+        .order = (uint16_t)s_binding_count,
+    };
+    s_binding_count++;
+    return ESP_OK;
+}
+
+/**
+ * @internal
+ * @brief ათავისუფლებს შეგროვებულ მიბმებს.
+ */
+static void free_bindings(void)
+{
+    free(s_bindings);
+    s_bindings = NULL;
+    s_binding_count = 0;
+    s_binding_capacity = 0;
+}
+
+// --- Internal API Implementation ---
+
+esp_err_t synapse_event_static_routes_bind(module_t *module, const char *module_type)
+{
+    if (!module || !module_type)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_sealed)
+    {
+        ESP_LOGW(TAG, "Routing table is sealed; module '%s' gets no static routes.", module->name);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const module_event_route_t *routes = synapse_module_factory_get_event_routes();
+    for (size_t i = 0; routes && routes[i].event_name != NULL; i++)
+    {
+        if (strcmp(routes[i].module_type_name, module_type) != 0)
+        {
+            continue;
+        }
+
+        synapse_event_id_t event_id = synapse_event_bus_intern(routes[i].event_name);
+        if (event_id == SYNAPSE_EVENT_ID_INVALID)
+        {
+            ESP_LOGE(TAG, "Cannot intern '%s' for module '%s'.", routes[i].event_name, module->name);
+            return ESP_ERR_NO_MEM;
+        }
+        esp_err_t err = add_binding(module, event_id, routes[i].flags);
+        if (err != ESP_OK)
+        {
+            ESP_LOGE(TAG, "Out of memory binding module '%s' to '%s'.", module->name, routes[i].event_name);
+            return err;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_static_routes_seal(void)
+{
+    s_sealed = true;
+    if (s_binding_count == 0)
+    {
+        free_bindings();
+        return ESP_OK;
+    }
+
+    qsort(s_bindings, s_binding_count, sizeof(event_static_binding_t), compare_bindings);
+
+    // პირველი გავლა: ივენთების რაოდენობა და ბლოკის ზომა
+    size_t event_count = 0;
+    size_t snapshots_size = 0;
+    for (size_t first = 0; first < s_binding_count;)
+    {
+        size_t last = first;
+        size_t sync_count = 0;
+        while (last < s_binding_count && s_bindings[last].event_id == s_bindings[first].event_id)
+        {
+            sync_count += (s_bindings[last].flags & MODULE_EVENT_ROUTE_FLAG_SYNC) ? 1 : 0;
+            last++;
+        }
+        size_t count = last - first;
+        if (count > ROUTES_MAX_PER_EVENT)
+        {
+            ESP_LOGW(TAG, "'%s' has %u static routes; only the first %d are kept.",
+                     synapse_event_bus_get_name(s_bindings[first].event_id), (unsigned)count, ROUTES_MAX_PER_EVENT);
+            count = ROUTES_MAX_PER_EVENT;
+        }
+        snapshots_size += routed_snapshot_size(count, sync_count);
+        event_count++;
+        first = last;
+    }
+
+    size_t index_size = sizeof(event_static_table_t) + event_count * sizeof(event_static_route_entry_t);
+    index_size = (index_size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    event_static_table_t *table = calloc(1, index_size + snapshots_size);
+    if (!table)
+    {
+        ESP_LOGE(TAG, "Failed to allocate the static routing table (%u bytes).",
+                 (unsigned)(index_size + snapshots_size));
+        free_bindings();
+        return ESP_ERR_NO_MEM;
+    }
+    table->bytes = (uint32_t)(index_size + snapshots_size);
+
+    // მეორე გავლა: თითო ივენთზე snapshot, ინდექსის ჩანაწერი მასზე მიუთითებს
+    uint8_t *cursor = (uint8_t *)table + index_size;
+    for (size_t first = 0; first < s_binding_count;)
+    {
+        size_t last = first;
+        size_t sync_count = 0;
+        while (last < s_binding_count && s_bindings[last].event_id == s_bindings[first].event_id)
+        {
+            sync_count += (s_bindings[last].flags & MODULE_EVENT_ROUTE_FLAG_SYNC) ? 1 : 0;
+            last++;
+        }
+        size_t count = last - first;
+        if (count > ROUTES_MAX_PER_EVENT)
+        {
+            count = ROUTES_MAX_PER_EVENT;
+        }
+
+        event_subscriber_snapshot_t *snapshot = (event_subscriber_snapshot_t *)cursor;
+        snapshot->count = (uint8_t)count;
+        snapshot->sync_count = sync_count ? 1 : 0; // საკმარისია sync მასივის მისამართისთვის; ქვემოთ ზუსტდება
+        uint8_t *sync = event_snapshot_sync(snapshot);
+        uint8_t kept_sync = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            snapshot->modules[i] = s_bindings[first + i].module;
+            if (sync && (s_bindings[first + i].flags & MODULE_EVENT_ROUTE_FLAG_SYNC))
+            {
+                sync[i] = 1;
+                kept_sync++;
+            }
+        }
+        // გადაჭარბებისას მოჭრილი ჩანაწერები sync მრიცხველში აღარ ითვლება
+        snapshot->sync_count = kept_sync;
+
+        table->events[table->count].event_id = s_bindings[first].event_id;
+        table->events[table->count].snapshot = snapshot;
+        table->count++;
+        table->bindings += (uint16_t)count;
+        cursor += routed_snapshot_size(count, sync_count);
+        first = last;
+    }
+
+    free_bindings();
+
+    // ცხრილს საცავი ფლობს: გამოქვეყნების შემდეგ მას დისპეტჩერები ხედავენ, ამიტომ აქ აღარ თავისუფლდება
+    uint16_t bindings = table->bindings;
+    uint16_t count = table->count;
+    uint32_t bytes = table->bytes;
+    esp_err_t err = synapse_event_subscriptions_set_static(table);
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to publish the static routing table: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    ESP_LOGI(TAG, "Static routes sealed: %u bindings on %u events (%u bytes).", bindings, count, (unsigned)bytes);
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_static_routes_clear(void)
+{
+    free_bindings();
+    return synapse_event_subscriptions_set_static(NULL);
+}
@@ -0,0 +1,953 @@
+/**
+ * @file event_subscriptions.c
+ * @brief Event Bus-ის გამოწერების საცავის იმპლემენტაცია (RCU-ს მსგავსი snapshot-ები).
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-09-22
+ * @details თითოეული ივენთის გამომწერები ინახება უცვლელ (immutable) snapshot-ში.
+ *          გამოწერა/გაუქმება ქმნის ახალ snapshot-ს და ატომურად ანაცვლებს ძველს,
+ *          ამიტომ დისპეტჩერები სიას კითხულობენ Mutex-ის და კოპირების გარეშე.
+ *
+ *          - მკითხველები: `read_lock()` ზრდის მიმდინარე ეპოქის მრიცხველს, `read_unlock()` ამცირებს.
+ *          - ჩამწერები: სერიალიზდებიან `s_writer_mutex`-ით; ძველი snapshot გადადის "retired" სიაში.
+ *          - Grace period: ჩამწერი ორჯერ ცვლის ეპოქას და ყოველ ჯერზე ელოდება ძველი
+ *            ეპოქის მრიცხველის დაცლას; ამის შემდეგ retired snapshot-ების გათავისუფლება უსაფრთხოა.
+ *          - read სექციის შიგნიდან (მაგ. handler-იდან) ჩამწერი არ ელოდება - ეს
+ *            deadlock-ს გამოიწვევდა; გათავისუფლება გადაიდება შემდეგ ჩამწერზე, ხოლო
+ *            წაშლის ოპერაცია აბრუნებს ESP_ERR_INVALID_STATE-ს (ტაიმაუტისას - ESP_ERR_TIMEOUT-ს).
+ *
+ *          ფილტრიანი გამოწერის ფილტრი ცალკე ბლოკია, რომელსაც snapshot-ები
+ *          მაჩვენებლით იზიარებენ; გაუქმებისას ის retired სიაში გადადის snapshot-თან ერთად.
+ *
+ *          pattern-ების გამოწერები (`sensor.+.temperature`) ინახება ჩამწერის მხარეს
+ *          ცალკე სიაში და ყოველი ცვლილებისას კომპილირდება ახალ trie-ად, რომელიც
+ *          ქვეყნდება და თავისუფლდება ზუსტად ისე, როგორც snapshot-ები.
+ *
+ *          სტატიკური მარშრუტები (module.json-ის `subscribes`) ერთ დალუქულ ბლოკად
+ *          ქვეყნდება (იხ. `event_static_routes.c`) და იგივე grace period-ით ცოცხლობს.
+ */
+#include "event_subscription_internal.h"
+#include "event_pattern_internal.h"
+#include "base_module.h"
+#include "logging.h"
+#include "framework_config.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include <string.h>
+#include <stdlib.h>
+
+DEFINE_COMPONENT_TAG("EVENT_SUBS", SYNAPSE_LOG_COLOR_BLUE);
+
+// --- Kconfig Definitions ---
+#define SUBS_MAX_EVENTS CONFIG_SYNAPSE_EVENT_MAX_NAMES
+#define SUBS_MAX_PER_EVENT CONFIG_SYNAPSE_MAX_SUBSCRIBERS_PER_EVENT
+#define SUBS_GRACE_TIMEOUT_US ((int64_t)CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS * 1000)
+
+_Static_assert(SUBS_MAX_PER_EVENT <= UINT8_MAX, "CONFIG_SYNAPSE_MAX_SUBSCRIBERS_PER_EVENT must fit into uint8_t");
+
+// --- Static Globals ---
+
+/**
+ * @internal
+ * @brief გამოქვეყნებული snapshot-ები, ინდექსირებული ივენთის ID-ით (NULL = გამომწერი არ არის).
+ */
+static event_subscriber_snapshot_t *s_snapshots[SUBS_MAX_EVENTS];
+
+/** @internal @brief ჩანაცვლებული, ჯერ გაუთავისუფლებელი ბლოკები (დაცულია s_writer_mutex-ით). */
+static event_retired_t *s_retired = NULL;
+
+/** @internal @brief გამოქვეყნებული pattern trie (NULL = pattern-ების გამოწერა არ არის). */
+static event_pattern_trie_t *s_pattern_trie = NULL;
+
+/** @internal @brief pattern-ების გამოწერები, გამოწერის თანმიმდევრობით (დაცულია s_writer_mutex-ით). */
+static event_pattern_entry_t *s_patterns = NULL;
+static size_t s_pattern_count = 0;
+static size_t s_pattern_capacity = 0;
+
+/** @internal @brief სტატიკური მარშრუტების ცხრილი (NULL = module.json-ით გამოწერა არ არის). */
+static event_static_table_t *s_static_table = NULL;
+
+/** @internal @brief მიმდინარე ეპოქა (მხოლოდ ბოლო ბიტი გამოიყენება). */
+static uint32_t s_epoch = 0;
+
+/** @internal @brief აქტიური მკითხველების რაოდენობა თითოეულ ეპოქაში. */
+static uint32_t s_readers[2] = {0, 0};
+
+/** @internal @brief მიმდინარე ტასკის read სექციების სიღრმე (nested read_lock-ისთვის). */
+static __thread uint32_t s_read_depth = 0;
+
+static SemaphoreHandle_t s_writer_mutex = NULL; /**< @brief სერიალიზებს snapshot-ების ჩანაცვლებას. */
+static SemaphoreHandle_t s_grace_mutex = NULL;  /**< @brief სერიალიზებს grace period-ის ლოდინს. */
+
+// --- Forward Declarations ---
+static event_subscriber_snapshot_t *snapshot_alloc(uint8_t count, uint8_t filter_count, uint8_t sync_count);
+static size_t snapshot_size(uint8_t count, uint8_t filter_count, uint8_t sync_count);
+static void snapshot_copy_entry(event_subscriber_snapshot_t *dst, uint8_t to, const event_subscriber_snapshot_t *src, uint8_t from);
+static event_subscription_filter_t *filter_create(const synapse_event_filter_t *filter);
+static bool field_matches(const synapse_event_field_match_t *field, const void *payload);
+static void publish_snapshot(synapse_event_id_t event_id, event_subscriber_snapshot_t *snapshot);
+static void retire_block(event_retired_t *block);
+static esp_err_t publish_patterns(void);
+static bool wait_for_readers(void);
+static esp_err_t reclaim_retired(void);
+static void reclaim_retired_nowait(void);
+
+// --- Internal Helper Functions ---
+
+/**
+ * @internal
+ * @brief აბრუნებს snapshot-ის ბლოკის ზომას: სათაური, მოდულები და არსებობის შემთხვევაში ფილტრები და sync დროშები.
+ */
+static size_t snapshot_size(uint8_t count, uint8_t filter_count, uint8_t sync_count)
+{
+    return sizeof(event_subscriber_snapshot_t) + count * sizeof(module_t *) +
+           (filter_count ? count * sizeof(event_subscription_filter_t *) : 0) + (sync_count ? count : 0);
+}
+
+/**
+ * @internal
+ * @brief გამოყოფს snapshot-ს `count` ელემენტისთვის.
+ * @details პარალელური მასივები (ფილტრები, sync დროშები) იმავე ბლოკშია და
+ *          მხოლოდ მაშინ არსებობს, როცა შესაბამისი მრიცხველი ნულზე მეტია; ისინი
+ *          ინიციალიზდება ნულებით და ივსება `snapshot_copy_entry()`-ით.
+ */
+static event_subscriber_snapshot_t *snapshot_alloc(uint8_t count, uint8_t filter_count, uint8_t sync_count)
+{
+    size_t header = sizeof(event_subscriber_snapshot_t) + count * sizeof(module_t *);
+    size_t size = snapshot_size(count, filter_count, sync_count);
+    event_subscriber_snapshot_t *snapshot = malloc(size);
+    if (snapshot)
+    {
+        snapshot->retired.next = NULL;
+        snapshot->count = count;
+        snapshot->filter_count = filter_count;
+        snapshot->sync_count = sync_count;
+        memset((uint8_t *)snapshot + header, 0, size - header);
+    }
+    return snapshot;
+}
+
+/**
+ * @internal
+ * @brief აკოპირებს `src`-ის `from` ჩანაწერს (მოდული, ფილტრი, sync დროშა) `dst`-ის `to` პოზიციაზე.
+ * @note `dst`-ის მრიცხველები უკვე უნდა ითვალისწინებდეს კოპირებულ ფილტრს/დროშას.
+ */
+static void snapshot_copy_entry(event_subscriber_snapshot_t *dst, uint8_t to, const event_subscriber_snapshot_t *src, uint8_t from)
+{
+    dst->modules[to] = src->modules[from];
+    event_subscription_filter_t **src_filters = event_snapshot_filters(src);
+    if (src_filters && src_filters[from])
+    {
+        event_snapshot_filters(dst)[to] = src_filters[from];
+    }
+    const uint8_t *src_sync = event_snapshot_sync(src);
+    if (src_sync && src_sync[from])
+    {
+        event_snapshot_sync(dst)[to] = 1;
+    }
+}
+
+/**
+ * @internal
+ * @brief ქმნის ფილტრის ბლოკს (STRING მნიშვნელობა კოპირდება იმავე ბლოკში).
+ */
+static event_subscription_filter_t *filter_create(const synapse_event_filter_t *filter)
+{
+    bool has_string = (filter->field.type == SYNAPSE_EVENT_FIELD_STRING);
+    size_t str_len = has_string ? strlen(filter->field.value.str) + 1 : 0;
+    event_subscription_filter_t *block = calloc(1, sizeof(event_subscription_filter_t) + str_len);
+    if (!block)
+    {
+        return NULL;
+    }
+    block->filter = *filter;
+    if (has_string)
+    {
+        char *copy = (char *)(block + 1);
+        memcpy(copy, filter->field.value.str, str_len);
+        block->filter.field.value.str = copy;
+    }
+    return block;
+}
+
+/**
+ * @internal
+ * @brief ადარებს payload-ის ველს ფილტრის მნიშვნელობას.
+ */
+static bool field_matches(const synapse_event_field_match_t *field, const void *payload)
+{
+    const uint8_t *ptr = (const uint8_t *)payload + field->offset;
+    int cmp;
+
+    switch (field->type)
+    {
+    case SYNAPSE_EVENT_FIELD_STRING:
+        cmp = strncmp((const char *)ptr, field->value.str, field->size);
+        break;
+    case SYNAPSE_EVENT_FIELD_I32:
+    {
+        int32_t v;
+        memcpy(&v, ptr, sizeof(v));
+        cmp = (v > field->value.i32) - (v < field->value.i32);
+        break;
+    }
+    default:
+    {
+        // payload-ის ველი შეიძლება არ იყოს გასწორებული - ვკითხულობთ memcpy-ით
+        uint32_t v = 0;
+        if (field->type == SYNAPSE_EVENT_FIELD_U8)
+        {
+            v = *ptr;
+        }
+        else if (field->type == SYNAPSE_EVENT_FIELD_U16)
+        {
+            uint16_t v16;
+            memcpy(&v16, ptr, sizeof(v16));
+            v = v16;
+        }
+        else
+        {
+            memcpy(&v, ptr, sizeof(v));
+        }
+        cmp = (v > field->value.u32) - (v < field->value.u32);
+        break;
+    }
+    }
+
+    switch (field->op)
+    {
+    case SYNAPSE_EVENT_FIELD_NE:
+        return cmp != 0;
+    case SYNAPSE_EVENT_FIELD_LT:
+        return cmp < 0;
+    case SYNAPSE_EVENT_FIELD_GT:
+        return cmp > 0;
+    case SYNAPSE_EVENT_FIELD_EQ:
+    default:
+        return cmp == 0;
+    }
+}
+
+/**
+ * @internal
+ * @brief ატომურად აქვეყნებს ახალ snapshot-ს და ძველს გადაიტანს retired სიაში.
+ * @note უნდა გამოიძახოს მხოლოდ s_writer_mutex-ის დაცულ სექციაში.
+ */
+static void publish_snapshot(synapse_event_id_t event_id, event_subscriber_snapshot_t *snapshot)
+{
+    event_subscriber_snapshot_t *old = __atomic_exchange_n(&s_snapshots[event_id], snapshot, __ATOMIC_SEQ_CST);
+    if (old)
+    {
+        retire_block(&old->retired);
+    }
+}
+
+/**
+ * @internal
+ * @brief გადააქვს ჩანაცვლებული ბლოკი retired სიაში.
+ * @note უნდა გამოიძახოს მხოლოდ s_writer_mutex-ის დაცულ სექციაში.
+ */
+static void retire_block(event_retired_t *block)
+{
+    block->next = s_retired;
+    s_retired = block;
+}
+
+/**
+ * @internal
+ * @brief აკომპილირებს `s_patterns`-ს ახალ trie-ად და აქვეყნებს მას.
+ * @note უნდა გამოიძახოს მხოლოდ s_writer_mutex-ის დაცულ სექციაში.
+ * @return ESP_OK ან ESP_ERR_NO_MEM (ამ შემთხვევაში ძველი trie რჩება).
+ */
+static esp_err_t publish_patterns(void)
+{
+    event_pattern_trie_t *trie = NULL;
+    if (s_pattern_count > 0)
+    {
+        trie = synapse_event_pattern_trie_build(s_patterns, s_pattern_count);
+        if (!trie)
+        {
+            ESP_LOGE(TAG, "Failed to compile %u pattern subscriptions.", (unsigned)s_pattern_count);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    event_pattern_trie_t *old = __atomic_exchange_n(&s_pattern_trie, trie, __ATOMIC_SEQ_CST);
+    if (old)
+    {
+        retire_block((event_retired_t *)old); // event_retired_t trie-ს პირველი ველია
+    }
+    return ESP_OK;
+}
+
+/**
+ * @internal
+ * @brief ელოდება, სანამ ყველა read სექცია, რომელიც ამ გამოძახებამდე დაიწყო, დასრულდება.
+ * @details ორფაზიანი ლოდინი (SRCU-ს მსგავსად): ეპოქა იცვლება ორჯერ და ყოველი
+ *          ცვლილების შემდეგ იცლება ძველი ეპოქის მრიცხველი. ასე იფარება ის
+ *          მკითხველებიც, რომლებიც წინა (ტაიმაუტით დასრულებული) ლოდინის დროს
+ *          დარჩნენ მეორე მრიცხველში. ეპოქის შეცვლის შემდეგ დაწყებული მკითხველი
+ *          აუცილებლად ხედავს ახალ snapshot-ს (seq_cst თანმიმდევრობა).
+ * @note უნდა გამოიძახოს მხოლოდ s_grace_mutex-ის დაცულ სექციაში.
+ * @return true, თუ grace period დასრულდა ტაიმაუტამდე.
+ */
+static bool wait_for_readers(void)
+{
+    int64_t deadline = esp_timer_get_time() + SUBS_GRACE_TIMEOUT_US;
+
+    for (int phase = 0; phase < 2; phase++)
+    {
+        uint32_t old_epoch = __atomic_fetch_xor(&s_epoch, 1, __ATOMIC_SEQ_CST) & 1;
+        while (__atomic_load_n(&s_readers[old_epoch], __ATOMIC_SEQ_CST) != 0)
+        {
+            if (esp_timer_get_time() > deadline)
+            {
+                return false;
+            }
+            vTaskDelay(1);
+        }
+    }
+    return true;
+}
+
+/**
+ * @internal
+ * @brief ათავისუფლებს retired snapshot-ებს grace period-ის შემდეგ.
+ * @details read სექციის შიგნიდან (ან ტაიმაუტისას) snapshot-ები რჩება retired სიაში
+ *          და გათავისუფლდება შემდეგი ჩამწერის მიერ. ელოდება მხოლოდ
+ *          `set_static()` (ცხრილის მფლობელს ძველი ცხრილის ბედი უნდა იცოდეს) და
+ *          `synchronize()`; გამოწერის ოპერაციები `reclaim_retired_nowait()`-ს იყენებენ.
+ * @return ESP_OK - grace period დასრულდა; ESP_ERR_INVALID_STATE - გამოძახება read
+ *         სექციიდანაა; ESP_ERR_TIMEOUT - დისპეტჩერი ჯერ კიდევ კითხულობს ძველ ბლოკებს.
+ */
+static esp_err_t reclaim_retired(void)
+{
+    if (s_read_depth > 0)
+    {
+        return ESP_ERR_INVALID_STATE; // საკუთარ read სექციას ვერ დაველოდებით
+    }
+
+    if (xSemaphoreTake(s_grace_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) != pdTRUE)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    esp_err_t ret = ESP_OK;
+
+    event_retired_t *list = NULL;
+    if (xSemaphoreTake(s_writer_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) == pdTRUE)
+    {
+        list = s_retired;
+        s_retired = NULL;
+        xSemaphoreGive(s_writer_mutex);
+    }
+
+    // ცარიელ სიაზეც ველოდებით: `synchronize()`-ის გამომძახებელს grace period სჭირდება
+    if (wait_for_readers())
+    {
+        while (list)
+        {
+            event_retired_t *next = list->next;
+            free(list);
+            list = next;
+        }
+    }
+    else
+    {
+        ESP_LOGW(TAG, "Grace period timed out; a dispatcher is still running. Deferring snapshot reclamation.");
+        ret = ESP_ERR_TIMEOUT;
+        if (list && xSemaphoreTake(s_writer_mutex, portMAX_DELAY) == pdTRUE)
+        {
+            event_retired_t *tail = list;
+            while (tail->next)
+            {
+                tail = tail->next;
+            }
+            tail->next = s_retired;
+            s_retired = list;
+            xSemaphoreGive(s_writer_mutex);
+        }
+    }
+
+    xSemaphoreGive(s_grace_mutex);
+    return ret;
+}
+
+/**
+ * @internal
+ * @brief ათავისუფლებს retired snapshot-ებს, თუ ახლა არცერთი read სექცია არ არის ღია.
+ * @details retired ბლოკს კითხულობს მხოლოდ მკითხველი, რომელიც სიის აღებამდე დაიწყო;
+ *          ასეთი მკითხველი, სანამ ღიაა, თავისი ეპოქის მრიცხველში ჩანს. ორივე
+ *          მრიცხველის ნული ნიშნავს, რომ ბლოკები აღარავის აქვს. სხვა შემთხვევაში
+ *          (მათ შორის საკუთარი read სექციიდან) სია ბრუნდება და გათავისუფლდება
+ *          შემდეგი ჩამწერის მიერ - ჩამწერი დისპეტჩერებს არასდროს ელოდება.
+ */
+static void reclaim_retired_nowait(void)
+{
+    if (xSemaphoreTake(s_grace_mutex, 0) != pdTRUE)
+    {
+        return; // სხვა ჩამწერი უკვე ათავისუფლებს
+    }
+
+    event_retired_t *list = NULL;
+    if (xSemaphoreTake(s_writer_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) == pdTRUE)
+    {
+        list = s_retired;
+        s_retired = NULL;
+        xSemaphoreGive(s_writer_mutex);
+    }
+
+    if (list && __atomic_load_n(&s_readers[0], __ATOMIC_SEQ_CST) == 0 &&
+        __atomic_load_n(&s_readers[1], __ATOMIC_SEQ_CST) == 0)
+    {
+        while (list)
+        {
+            event_retired_t *next = list->next;
+            free(list);
+            list = next;
+        }
+    }
+    else if (list && xSemaphoreTake(s_writer_mutex, portMAX_DELAY) == pdTRUE)
+    {
+        event_retired_t *tail = list;
+        while (tail->next)
+        {
+            tail = tail->next;
+        }
+        tail->next = s_retired;
+        s_retired = list;
+        xSemaphoreGive(s_writer_mutex);
+    }
+
+    xSemaphoreGive(s_grace_mutex);
+}
+
+// --- Internal API Implementation ---
+
+esp_err_t synapse_event_subscriptions_init(void)
+{
+    if (s_writer_mutex != NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    s_writer_mutex = xSemaphoreCreateMutex();
+    s_grace_mutex = xSemaphoreCreateMutex();
+    if (!s_writer_mutex || !s_grace_mutex)
+    {
+        ESP_LOGE(TAG, "Failed to create subscription mutexes.");
+        if (s_writer_mutex)
+        {
+            vSemaphoreDelete(s_writer_mutex);
+            s_writer_mutex = NULL;
+        }
+        if (s_grace_mutex)
+        {
+            vSemaphoreDelete(s_grace_mutex);
+            s_grace_mutex = NULL;
+        }
+        return ESP_ERR_NO_MEM;
+    }
+
+    memset(s_snapshots, 0, sizeof(s_snapshots));
+    s_retired = NULL;
+    return ESP_OK;
+}
+
+uint32_t synapse_event_subscriptions_read_lock(void)
+{
+    s_read_depth++;
+    uint32_t epoch = __atomic_load_n(&s_epoch, __ATOMIC_SEQ_CST) & 1;
+    __atomic_fetch_add(&s_readers[epoch], 1, __ATOMIC_SEQ_CST);
+    return epoch;
+}
+
+void synapse_event_subscriptions_read_unlock(uint32_t token)
+{
+    __atomic_fetch_sub(&s_readers[token & 1], 1, __ATOMIC_SEQ_CST);
+    s_read_depth--;
+}
+
+esp_err_t synapse_event_subscriptions_synchronize(void)
+{
+    if (!s_grace_mutex)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return reclaim_retired();
+}
+
+const event_subscriber_snapshot_t *synapse_event_subscriptions_get(synapse_event_id_t event_id)
+{
+    if (event_id >= SUBS_MAX_EVENTS)
+    {
+        return NULL;
+    }
+    return __atomic_load_n(&s_snapshots[event_id], __ATOMIC_SEQ_CST);
+}
+
+const event_subscriber_snapshot_t *synapse_event_subscriptions_get_static(synapse_event_id_t event_id)
+{
+    const event_static_table_t *table = __atomic_load_n(&s_static_table, __ATOMIC_SEQ_CST);
+    if (!table)
+    {
+        return NULL;
+    }
+
+    // ცხრილი დალაგებულია ID-ით და იშვიათად შეიცავს ათეულზე მეტ ივენთს
+    size_t low = 0;
+    size_t high = table->count;
+    while (low < high)
+    {
+        size_t mid = (low + high) / 2;
+        if (table->events[mid].event_id < event_id)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return (low < table->count && table->events[low].event_id == event_id) ? table->events[low].snapshot : NULL;
+}
+
+esp_err_t synapse_event_subscriptions_set_static(event_static_table_t *table)
+{
+    // ცხრილი აქ ჯერ არავის გამოუქვეყნებია, ამიტომ შეცდომისას მისი გათავისუფლება უსაფრთხოა
+    if (!s_writer_mutex)
+    {
+        free(table);
+        return ESP_FAIL; // საცავი ინიციალიზებული არ არის
+    }
+    if (xSemaphoreTake(s_writer_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) != pdTRUE)
+    {
+        free(table);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    event_static_table_t *old = __atomic_exchange_n(&s_static_table, table, __ATOMIC_SEQ_CST);
+    if (old)
+    {
+        retire_block(&old->retired);
+    }
+
+    xSemaphoreGive(s_writer_mutex);
+
+    // ამის შემდეგ ძველი ცხრილის მოდულებს აღარცერთი დისპეტჩერი აღარ იძახებს
+    return old ? reclaim_retired() : ESP_OK;
+}
+
+bool synapse_event_subscription_filter_accepts(event_subscription_filter_t *filter, synapse_event_id_t event_id,
+                                               const void *payload)
+{
+    bool accept = true;
+    if (filter->filter.field.type != SYNAPSE_EVENT_FIELD_NONE)
+    {
+        accept = payload && field_matches(&filter->filter.field, payload);
+    }
+    if (accept && filter->filter.predicate)
+    {
+        accept = filter->filter.predicate(event_id, payload, filter->filter.context);
+    }
+
+    // მრიცხველებს ზრდის მხოლოდ ერთი დისპეტჩერი ერთდროულად (ზოლზე), მაგრამ "*"-ის ფილტრს რამდენიმე ზოლი იზიარებს
+    __atomic_fetch_add(&filter->evaluated, 1, __ATOMIC_RELAXED);
+    if (accept)
+    {
+        __atomic_fetch_add(&filter->accepted, 1, __ATOMIC_RELAXED);
+    }
+    return accept;
+}
+
+esp_err_t synapse_event_subscriptions_get_filter_stats(synapse_event_id_t event_id, const module_t *module,
+                                                       uint32_t *evaluated_out, uint32_t *accepted_out)
+{
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    uint32_t token = synapse_event_subscriptions_read_lock();
+    const event_subscriber_snapshot_t *snapshot = synapse_event_subscriptions_get(event_id);
+    event_subscription_filter_t **filters = snapshot ? event_snapshot_filters(snapshot) : NULL;
+    for (uint8_t i = 0; filters && i < snapshot->count; i++)
+    {
+        if (snapshot->modules[i] == module && filters[i])
+        {
+            *evaluated_out = __atomic_load_n(&filters[i]->evaluated, __ATOMIC_RELAXED);
+            *accepted_out = __atomic_load_n(&filters[i]->accepted, __ATOMIC_RELAXED);
+            ret = ESP_OK;
+            break;
+        }
+    }
+    synapse_event_subscriptions_read_unlock(token);
+    return ret;
+}
+
+esp_err_t synapse_event_subscriptions_add(synapse_event_id_t event_id, module_t *module,
+                                          const synapse_event_filter_t *filter, bool sync)
+{
+    if (event_id >= SUBS_MAX_EVENTS || !module)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_writer_mutex)
+    {
+        return ESP_FAIL; // საცავი ინიციალიზებული არ არის
+    }
+
+    if (xSemaphoreTake(s_writer_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) != pdTRUE)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    esp_err_t ret = ESP_OK;
+    const event_subscriber_snapshot_t *current = s_snapshots[event_id];
+    uint8_t count = current ? current->count : 0;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (current->modules[i] == module)
+        {
+            ret = ESP_ERR_INVALID_STATE;
+            break;
+        }
+    }
+
+    if (ret == ESP_OK && count >= SUBS_MAX_PER_EVENT)
+    {
+        ret = ESP_ERR_INVALID_SIZE;
+    }
+
+    event_subscription_filter_t *filter_block = NULL;
+    if (ret == ESP_OK && filter)
+    {
+        filter_block = filter_create(filter);
+        ret = filter_block ? ESP_OK : ESP_ERR_NO_MEM;
+    }
+
+    if (ret == ESP_OK)
+    {
+        uint8_t filter_count = (current ? current->filter_count : 0) + (filter_block ? 1 : 0);
+        uint8_t sync_count = (current ? current->sync_count : 0) + (sync ? 1 : 0);
+        event_subscriber_snapshot_t *next = snapshot_alloc(count + 1, filter_count, sync_count);
+        if (!next)
+        {
+            ESP_LOGE(TAG, "Failed to allocate subscriber snapshot for event ID %u", event_id);
+            free(filter_block);
+            ret = ESP_ERR_NO_MEM;
+        }
+        else
+        {
+            for (uint8_t i = 0; i < count; i++)
+            {
+                snapshot_copy_entry(next, i, current, i);
+            }
+            next->modules[count] = module;
+            if (filter_block)
+            {
+                event_snapshot_filters(next)[count] = filter_block;
+            }
+            if (sync)
+            {
+                event_snapshot_sync(next)[count] = 1;
+            }
+            publish_snapshot(event_id, next);
+        }
+    }
+
+    xSemaphoreGive(s_writer_mutex);
+
+    if (ret == ESP_OK)
+    {
+        reclaim_retired_nowait();
+    }
+    return ret;
+}
+
+esp_err_t synapse_event_subscriptions_remove(synapse_event_id_t event_id, module_t *module)
+{
+    if (event_id >= SUBS_MAX_EVENTS || !module)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_writer_mutex)
+    {
+        return ESP_FAIL; // საცავი ინიციალიზებული არ არის
+    }
+
+    if (xSemaphoreTake(s_writer_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) != pdTRUE)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    const event_subscriber_snapshot_t *current = s_snapshots[event_id];
+    int index = -1;
+
+    for (uint8_t i = 0; current && i < current->count; i++)
+    {
+        if (current->modules[i] == module)
+        {
+            index = i;
+            break;
+        }
+    }
+
+    if (index >= 0)
+    {
+        uint8_t count = current->count - 1;
+        event_subscription_filter_t **filters = event_snapshot_filters(current);
+        const uint8_t *sync = event_snapshot_sync(current);
+        event_subscription_filter_t *removed_filter = filters ? filters[index] : NULL;
+        uint8_t filter_count = current->filter_count - (removed_filter ? 1 : 0);
+        uint8_t sync_count = current->sync_count - ((sync && sync[index]) ? 1 : 0);
+
+        event_subscriber_snapshot_t *next = NULL;
+        if (count > 0)
+        {
+            next = snapshot_alloc(count, filter_count, sync_count);
+            if (!next)
+            {
+                ESP_LOGE(TAG, "Failed to allocate subscriber snapshot for event ID %u", event_id);
+                xSemaphoreGive(s_writer_mutex);
+                return ESP_ERR_NO_MEM;
+            }
+            // თანმიმდევრობა ნარჩუნდება: index-მდე და index-ის შემდეგ
+            for (uint8_t i = 0, j = 0; i < current->count; i++)
+            {
+                if (i != index)
+                {
+                    snapshot_copy_entry(next, j++, current, i);
+                }
+            }
+        }
+        publish_snapshot(event_id, next); // ცარიელი სია აღარ ინახება (NULL)
+        if (removed_filter)
+        {
+            // ძველი snapshot-ით მომუშავე დისპეტჩერი ფილტრს ჯერ კიდევ კითხულობს - ვათავისუფლებთ grace period-ის შემდეგ
+            retire_block(&removed_filter->retired);
+        }
+        ret = ESP_OK;
+    }
+
+    xSemaphoreGive(s_writer_mutex);
+
+    if (ret == ESP_OK)
+    {
+        // მიწოდების დასრულებას Event Bus ელოდება (`in_dispatch`); ბლოკები შეიძლება მოგვიანებით გათავისუფლდეს
+        reclaim_retired_nowait();
+    }
+    return ret;
+}
+
+const event_pattern_trie_t *synapse_event_subscriptions_get_patterns(void)
+{
+    return __atomic_load_n(&s_pattern_trie, __ATOMIC_SEQ_CST);
+}
+
+esp_err_t synapse_event_subscriptions_add_pattern(const char *pattern, module_t *module)
+{
+    if (!module || synapse_event_pattern_validate(pattern) != ESP_OK)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_writer_mutex)
+    {
+        return ESP_FAIL; // საცავი ინიციალიზებული არ არის
+    }
+
+    if (xSemaphoreTake(s_writer_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) != pdTRUE)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    esp_err_t ret = ESP_OK;
+    for (size_t i = 0; i < s_pattern_count; i++)
+    {
+        if (s_patterns[i].module == module && strcmp(s_patterns[i].pattern, pattern) == 0)
+        {
+            ret = ESP_ERR_INVALID_STATE;
+            break;
+        }
+    }
+
+    if (ret == ESP_OK && s_pattern_count == s_pattern_capacity)
+    {
+        size_t capacity = s_pattern_capacity ? s_pattern_capacity * 2 : 8;
+        event_pattern_entry_t *grown = realloc(s_patterns, capacity * sizeof(event_pattern_entry_t));
+        if (grown)
+        {
+            s_patterns = grown;
+            s_pattern_capacity = capacity;
+        }
+        else
+        {
+            ret = ESP_ERR_NO_MEM;
+        }
+    }
+
+    char *copy = NULL;
+    if (ret == ESP_OK)
+    {
+        copy = strdup(pattern);
+        ret = copy ? ESP_OK : ESP_ERR_NO_MEM;
+    }
+
+    if (ret == ESP_OK)
+    {
+        s_patterns[s_pattern_count].pattern = copy;
+        s_patterns[s_pattern_count].module = module;
+        s_pattern_count++;
+        ret = publish_patterns();
+        if (ret != ESP_OK)
+        {
+            s_pattern_count--;
+            free(copy);
+        }
+    }
+
+    xSemaphoreGive(s_writer_mutex);
+
+    if (ret == ESP_OK)
+    {
+        reclaim_retired_nowait();
+    }
+    return ret;
+}
+
+esp_err_t synapse_event_subscriptions_remove_pattern(const char *pattern, module_t *module)
+{
+    if (!pattern || !module)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_writer_mutex)
+    {
+        return ESP_FAIL; // საცავი ინიციალიზებული არ არის
+    }
+
+    if (xSemaphoreTake(s_writer_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) != pdTRUE)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    for (size_t i = 0; i < s_pattern_count; i++)
+    {
+        if (s_patterns[i].module != module || strcmp(s_patterns[i].pattern, pattern) != 0)
+        {
+            continue;
+        }
+
+        event_pattern_entry_t removed = s_patterns[i];
+        memmove(&s_patterns[i], &s_patterns[i + 1], (s_pattern_count - i - 1) * sizeof(event_pattern_entry_t));
+        s_pattern_count--;
+        ret = publish_patterns();
+        if (ret == ESP_OK)
+        {
+            // trie სეგმენტებს საკუთარ ბლოკში აკოპირებს, ამიტომ სტრიქონი აღარ გამოიყენება
+            free((void *)removed.pattern);
+        }
+        else
+        {
+            memmove(&s_patterns[i + 1], &s_patterns[i], (s_pattern_count - i) * sizeof(event_pattern_entry_t));
+            s_patterns[i] = removed;
+            s_pattern_count++;
+        }
+        break;
+    }
+
+    xSemaphoreGive(s_writer_mutex);
+
+    if (ret == ESP_OK)
+    {
+        reclaim_retired_nowait();
+    }
+    return ret;
+}
+
+void synapse_event_subscriptions_get_pattern_stats(uint32_t *patterns_out, uint32_t *nodes_out, uint32_t *bytes_out)
+{
+    if (patterns_out)
+    {
+        *patterns_out = (uint32_t)__atomic_load_n(&s_pattern_count, __ATOMIC_RELAXED);
+    }
+    uint32_t token = synapse_event_subscriptions_read_lock();
+    synapse_event_pattern_trie_get_size(synapse_event_subscriptions_get_patterns(), nodes_out, bytes_out);
+    synapse_event_subscriptions_read_unlock(token);
+}
+
+esp_err_t synapse_event_subscriptions_get_memory_stats(synapse_event_memory_stats_t *stats)
+{
+    if (!s_writer_mutex)
+    {
+        return ESP_FAIL; // საცავი ინიციალიზებული არ არის
+    }
+    if (xSemaphoreTake(s_writer_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) != pdTRUE)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    // ჩამწერის Mutex-ით snapshot-ები, pattern-ების სია და retired სია სტაბილურია
+    memset(stats, 0, sizeof(*stats));
+    stats->table_bytes = sizeof(s_snapshots);
+    for (size_t id = 0; id < SUBS_MAX_EVENTS; id++)
+    {
+        const event_subscriber_snapshot_t *snapshot = s_snapshots[id];
+        if (!snapshot)
+        {
+            continue;
+        }
+        stats->events++;
+        stats->subscriptions += snapshot->count;
+        stats->sync_subscriptions += snapshot->sync_count;
+        stats->filtered_subscriptions += snapshot->filter_count;
+        stats->snapshot_bytes += snapshot_size(snapshot->count, snapshot->filter_count, snapshot->sync_count);
+        stats->heap_blocks++;
+
+        event_subscription_filter_t **filters = event_snapshot_filters(snapshot);
+        for (uint8_t i = 0; filters && i < snapshot->count; i++)
+        {
+            if (filters[i])
+            {
+                const synapse_event_field_match_t *field = &filters[i]->filter.field;
+                stats->filter_bytes += sizeof(event_subscription_filter_t) +
+                                       (field->type == SYNAPSE_EVENT_FIELD_STRING ? strlen(field->value.str) + 1 : 0);
+                stats->heap_blocks++;
+            }
+        }
+    }
+
+    stats->pattern_subscriptions = s_pattern_count;
+    stats->pattern_bytes = s_pattern_capacity * sizeof(event_pattern_entry_t);
+    stats->heap_blocks += (s_pattern_capacity > 0) ? 1 : 0;
+    for (size_t i = 0; i < s_pattern_count; i++)
+    {
+        stats->pattern_bytes += strlen(s_patterns[i].pattern) + 1;
+        stats->heap_blocks++;
+    }
+    uint32_t trie_bytes = 0;
+    synapse_event_pattern_trie_get_size(s_pattern_trie, NULL, &trie_bytes);
+    stats->pattern_bytes += trie_bytes;
+    stats->heap_blocks += s_pattern_trie ? 1 : 0;
+
+    if (s_static_table)
+    {
+        stats->static_subscriptions = s_static_table->bindings;
+        stats->static_bytes = s_static_table->bytes;
+        stats->heap_blocks++;
+    }
+
+    for (const event_retired_t *block = s_retired; block; block = block->next)
+    {
+        stats->retired_blocks++;
+    }
+
+    xSemaphoreGive(s_writer_mutex);
+
+    if (stats->subscriptions > 0)
+    {
+        stats->bytes_per_subscription = (stats->snapshot_bytes + stats->filter_bytes) / stats->subscriptions;
+    }
+    return ESP_OK;
+}
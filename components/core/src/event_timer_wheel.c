@@ -0,0 +1,716 @@
+/**
+ * @file event_timer_wheel.c
+ * @brief დაყოვნებული და პერიოდული ივენთების იმპლემენტაცია იერარქიულ timing wheel-ზე.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-09-29
+ * @details ტაიმერები ინახება 4 დონის wheel-ში, თითო დონეზე 64 სლოტით
+ *          (ორმხრივად დაკავშირებული სიები ინდექსებით). დონე 0-ის სლოტი ერთი
+ *          ტიკია, დონე N-ის სლოტი - 64^N ტიკი. დამატება და გაუქმება O(1)-ია;
+ *          ზედა დონის სლოტი ქვედაზე "ჩამოიყრება" (cascade) მხოლოდ ქვედა დონის
+ *          სრული ბრუნის შემდეგ. 2^24 ტიკზე შორეული ტაიმერი ზედა დონეზე ელოდება
+ *          და ყოველ ჩამოყრაზე თავიდან თავსდება.
+ *
+ *          ერთი ტასკი იღვიძებს მხოლოდ შემდეგ დაკავებულ დონე 0-ის სლოტზე ან
+ *          ბრუნის ბოლოს (cascade) - ცარიელ ტიკებს გამოტოვებს დაკავებულობის
+ *          ბიტური რუკით. ვადაგასული ტაიმერები wheel-იდან იხსნება mutex-ის ქვეშ,
+ *          ხოლო ივენთები ქვეყნდება mutex-ის გარეთ, რადგან გამოქვეყნება შეიძლება
+ *          დაელოდოს სავსე ზოლს.
+ */
+#include "event_bus.h"
+#include "event_bus_internal.h"
+#include "event_registry_internal.h"
+#include "event_data_wrapper.h"
+#include "service_locator.h"
+#include "timer_interface.h"
+#include "logging.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+DEFINE_COMPONENT_TAG("EVENT_TIMER", SYNAPSE_LOG_COLOR_BLUE);
+
+#if defined(CONFIG_SYNAPSE_EVENT_TIMER_ENABLE)
+
+// --- Kconfig Definitions ---
+#define TIMER_MAX_TIMERS CONFIG_SYNAPSE_EVENT_TIMER_MAX_TIMERS
+#define TIMER_RESOLUTION_US ((int64_t)CONFIG_SYNAPSE_EVENT_TIMER_RESOLUTION_MS * 1000)
+#define TIMER_TASK_PRIORITY CONFIG_SYNAPSE_EVENT_TIMER_TASK_PRIORITY
+
+#define TIMER_TASK_STACK_SIZE 3072
+
+#define WHEEL_LEVELS 4
+#define WHEEL_SLOT_BITS 6
+#define WHEEL_SLOTS (1U << WHEEL_SLOT_BITS)
+#define WHEEL_SLOT_MASK (WHEEL_SLOTS - 1)
+/** @brief ყველაზე შორეული დრო (ტიკებში), რომელსაც wheel პირდაპირ ფარავს. */
+#define WHEEL_RANGE_TICKS (1UL << (WHEEL_LEVELS * WHEEL_SLOT_BITS))
+
+/** @brief "არცერთი" ინდექსი სიებში. */
+#define TIMER_NIL UINT16_MAX
+
+_Static_assert(TIMER_MAX_TIMERS < TIMER_NIL, "CONFIG_SYNAPSE_EVENT_TIMER_MAX_TIMERS must fit into a uint16_t index");
+
+// --- Internal Structures ---
+
+/**
+ * @internal
+ * @brief ტაიმერის მდგომარეობა.
+ */
+typedef enum
+{
+    TIMER_STATE_FREE = 0,  /**< @brief თავისუფალ სიაშია. */
+    TIMER_STATE_ARMED,     /**< @brief wheel-ის სლოტშია. */
+    TIMER_STATE_FIRING,    /**< @brief ამოღებულია wheel-იდან და ელოდება გამოქვეყნებას. */
+    TIMER_STATE_CANCELLED, /**< @brief გაუქმდა FIRING მდგომარეობაში; ტასკი გაათავისუფლებს. */
+} timer_state_t;
+
+/**
+ * @internal
+ * @brief ერთი დაგეგმილი ივენთი.
+ */
+typedef struct
+{
+    uint32_t expires;                   /**< @brief შესრულების ტიკი (აბსოლუტური, მოდულით 2^32). */
+    uint32_t period;                    /**< @brief პერიოდი ტიკებში; 0 = ერთჯერადი. */
+    union
+    {
+        event_data_wrapper_t *data_wrapper; /**< @brief ტაიმერის reference მონაცემებზე ან NULL (ივენთის ტაიმერი). */
+        uint32_t callback_arg;              /**< @brief callback-ის არგუმენტი (შიდა ტაიმერი). */
+    };
+    event_timer_callback_t callback;    /**< @brief შიდა ტაიმერის callback; NULL = ივენთის გამოქვეყნება. */
+    synapse_event_id_t event_id;        /**< @brief გამოსაქვეყნებელი ივენთი. */
+    uint16_t generation;                /**< @brief იზრდება ყოველ გათავისუფლებაზე (handle-ის ვალიდაციისთვის). */
+    uint16_t prev;                      /**< @brief წინა ტაიმერი სლოტში. */
+    uint16_t next;                      /**< @brief შემდეგი ტაიმერი სლოტში / თავისუფალ ან FIRING სიაში. */
+    uint8_t state;                      /**< @brief `timer_state_t`. */
+    uint8_t level;                      /**< @brief wheel-ის დონე (ARMED-ისას). */
+    uint8_t slot;                       /**< @brief სლოტი დონეზე (ARMED-ისას). */
+} timer_entry_t;
+
+// --- Static Globals ---
+static timer_entry_t *s_timers = NULL;
+static uint16_t s_free_head = TIMER_NIL;
+static uint16_t s_slots[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint64_t s_occupied[WHEEL_LEVELS];  /**< @brief დაკავებული სლოტების ბიტური რუკა თითო დონეზე. */
+static uint32_t s_now = 0;                 /**< @brief wheel-ის ბოლო დამუშავებული ტიკი. */
+static uint32_t s_wakeup_tick = 0;         /**< @brief ტიკი, რომელზეც ტასკი გაიღვიძებს. */
+static bool s_idle = true;                 /**< @brief ტასკს ტაიმერები არ აქვს და ელოდება შეტყობინებას. */
+static int64_t s_epoch_us = 0;             /**< @brief ტიკი 0-ის დრო. */
+static SemaphoreHandle_t s_lock = NULL;
+static TaskHandle_t s_task = NULL;
+static synapse_event_timer_stats_t s_stats;
+
+// --- Forward Declarations ---
+static void timer_task(void *pvParameters);
+static synapse_timer_handle_t timer_api_schedule_event(const char *event_name, uint32_t interval_ms, bool is_periodic);
+static esp_err_t timer_api_cancel_event(synapse_timer_handle_t handle);
+
+/**
+ * @internal
+ * @brief `timer_api_t` სერვისის სტატიკური ეგზემპლარი.
+ */
+static timer_api_t s_timer_api = {
+    .schedule_event = timer_api_schedule_event,
+    .cancel_event = timer_api_cancel_event,
+};
+
+// --- Internal Helper Functions (wheel) ---
+
+/**
+ * @internal
+ * @brief აბრუნებს მიმდინარე დროს wheel-ის ტიკებში.
+ */
+static uint32_t current_tick(void)
+{
+    return (uint32_t)((esp_timer_get_time() - s_epoch_us) / TIMER_RESOLUTION_US);
+}
+
+/**
+ * @internal
+ * @brief ათავსებს ტაიმერს `expires`-ის შესაბამის სლოტში (s_now-ის მიმართ).
+ * @note უნდა გამოიძახოს მხოლოდ s_lock-ის ქვეშ.
+ */
+static void wheel_insert(uint16_t index)
+{
+    timer_entry_t *timer = &s_timers[index];
+    int32_t delta = (int32_t)(timer->expires - s_now);
+    if (delta <= 0)
+    {
+        // ვადაგასული (მაგ. ჩამორჩენილი პერიოდული) - შემდეგ ტიკზე
+        timer->expires = s_now + 1;
+        delta = 1;
+    }
+
+    uint8_t level;
+    uint8_t slot;
+    if ((uint32_t)delta >= WHEEL_RANGE_TICKS)
+    {
+        // wheel-ის საზღვრებს გარეთ: ზედა დონის მიმდინარე სლოტი ჩამოიყრება 2^24 ტიკის შემდეგ და თავიდან შეფასდება
+        level = WHEEL_LEVELS - 1;
+        slot = (s_now >> (level * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK;
+    }
+    else
+    {
+        level = 0;
+        while ((uint32_t)delta >= (1UL << ((level + 1) * WHEEL_SLOT_BITS)))
+        {
+            level++;
+        }
+        slot = (timer->expires >> (level * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK;
+    }
+
+    timer->level = level;
+    timer->slot = slot;
+    timer->state = TIMER_STATE_ARMED;
+    timer->prev = TIMER_NIL;
+    timer->next = s_slots[level][slot];
+    if (timer->next != TIMER_NIL)
+    {
+        s_timers[timer->next].prev = index;
+    }
+    s_slots[level][slot] = index;
+    s_occupied[level] |= 1ULL << slot;
+}
+
+/**
+ * @internal
+ * @brief ხსნის ARMED ტაიმერს სლოტიდან.
+ * @note უნდა გამოიძახოს მხოლოდ s_lock-ის ქვეშ.
+ */
+static void wheel_unlink(uint16_t index)
+{
+    timer_entry_t *timer = &s_timers[index];
+    if (timer->prev != TIMER_NIL)
+    {
+        s_timers[timer->prev].next = timer->next;
+    }
+    else
+    {
+        s_slots[timer->level][timer->slot] = timer->next;
+    }
+    if (timer->next != TIMER_NIL)
+    {
+        s_timers[timer->next].prev = timer->prev;
+    }
+    if (s_slots[timer->level][timer->slot] == TIMER_NIL)
+    {
+        s_occupied[timer->level] &= ~(1ULL << timer->slot);
+    }
+}
+
+/**
+ * @internal
+ * @brief ხსნის მთელ სლოტს და აბრუნებს მისი სიის თავს.
+ * @note უნდა გამოიძახოს მხოლოდ s_lock-ის ქვეშ.
+ */
+static uint16_t wheel_detach_slot(uint8_t level, uint8_t slot)
+{
+    uint16_t head = s_slots[level][slot];
+    s_slots[level][slot] = TIMER_NIL;
+    s_occupied[level] &= ~(1ULL << slot);
+    return head;
+}
+
+/**
+ * @internal
+ * @brief ათავისუფლებს ტაიმერს და ზრდის მის თაობას (ძველი handle-ები ინვალიდდება).
+ * @note უნდა გამოიძახოს მხოლოდ s_lock-ის ქვეშ. wrapper-ის reference-ს არ ეხება.
+ */
+static void timer_free(uint16_t index)
+{
+    timer_entry_t *timer = &s_timers[index];
+    timer->state = TIMER_STATE_FREE;
+    timer->data_wrapper = NULL;
+    timer->callback = NULL;
+    timer->generation++;
+    timer->next = s_free_head;
+    s_free_head = index;
+    s_stats.active--;
+}
+
+/**
+ * @internal
+ * @brief ტიკების რაოდენობა შემდეგ ტიკამდე, რომელზეც wheel-ს სამუშაო აქვს.
+ * @details ეს არის შემდეგი დაკავებული დონე 0-ის სლოტი მიმდინარე ბრუნში, ან
+ *          ბრუნის ბოლო, სადაც ზედა დონეები ჩამოიყრება.
+ * @note უნდა გამოიძახოს მხოლოდ s_lock-ის ქვეშ.
+ */
+static uint32_t ticks_to_next_work(void)
+{
+    uint32_t index = s_now & WHEEL_SLOT_MASK;
+    uint64_t ahead = s_occupied[0] & ~((2ULL << index) - 1);
+    if (ahead)
+    {
+        return (uint32_t)__builtin_ctzll(ahead) - index;
+    }
+    return WHEEL_SLOTS - index;
+}
+
+/**
+ * @internal
+ * @brief გადაჰყავს wheel `target` ტიკამდე და აბრუნებს ვადაგასული ტაიმერების სიას.
+ * @details ცარიელ ტიკებს გამოტოვებს; ბრუნის საზღვარზე ჩამოყრის ზედა დონის
+ *          სლოტებს. ვადაგასული ტაიმერები ხდება FIRING და ებმება `next`-ით.
+ * @note უნდა გამოიძახოს მხოლოდ s_lock-ის ქვეშ.
+ */
+static uint16_t wheel_advance(uint32_t target)
+{
+    uint16_t firing_head = TIMER_NIL;
+    uint16_t firing_tail = TIMER_NIL;
+
+    while ((int32_t)(target - s_now) > 0)
+    {
+        uint32_t step = ticks_to_next_work();
+        if (step > target - s_now)
+        {
+            s_now = target;
+            break;
+        }
+        s_now += step;
+
+        uint32_t index = s_now & WHEEL_SLOT_MASK;
+        for (uint8_t level = 1; index == 0 && level < WHEEL_LEVELS; level++)
+        {
+            index = (s_now >> (level * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK;
+            uint16_t cursor = wheel_detach_slot(level, (uint8_t)index);
+            while (cursor != TIMER_NIL)
+            {
+                uint16_t next = s_timers[cursor].next;
+                wheel_insert(cursor);
+                cursor = next;
+            }
+        }
+
+        uint16_t cursor = wheel_detach_slot(0, s_now & WHEEL_SLOT_MASK);
+        while (cursor != TIMER_NIL)
+        {
+            uint16_t next = s_timers[cursor].next;
+            s_timers[cursor].state = TIMER_STATE_FIRING;
+            s_timers[cursor].next = TIMER_NIL;
+            if (firing_tail == TIMER_NIL)
+            {
+                firing_head = cursor;
+            }
+            else
+            {
+                s_timers[firing_tail].next = cursor;
+            }
+            firing_tail = cursor;
+            cursor = next;
+        }
+    }
+    return firing_head;
+}
+
+/**
+ * @internal
+ * @brief აქვეყნებს FIRING სიის ივენთებს; პერიოდულს თავიდან აყენებს, ერთჯერადს ათავისუფლებს.
+ */
+static void fire_timers(uint16_t cursor)
+{
+    while (cursor != TIMER_NIL)
+    {
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        timer_entry_t *timer = &s_timers[cursor];
+        uint16_t index = cursor;
+        cursor = timer->next;
+
+        synapse_event_id_t event_id = timer->event_id;
+        event_timer_callback_t callback = timer->callback;
+        uint32_t callback_arg = timer->callback_arg;
+        event_data_wrapper_t *data_wrapper = callback ? NULL : timer->data_wrapper;
+        bool post = (timer->state == TIMER_STATE_FIRING);
+        if (post && timer->period)
+        {
+            // ტაიმერი ინარჩუნებს თავის reference-ს; გამოქვეყნებისთვის ვიღებთ დროებითს
+            if (data_wrapper)
+            {
+                synapse_event_data_acquire(data_wrapper);
+            }
+            timer->expires += timer->period;
+            if ((int32_t)(timer->expires - s_now) <= 0)
+            {
+                // ტასკი პერიოდზე მეტით ჩამორჩა - გამოტოვებულ პერიოდებს არ ვაქვეყნებთ
+                timer->expires = s_now + timer->period;
+            }
+            wheel_insert(index);
+        }
+        else
+        {
+            // ერთჯერადი ან გაუქმებული: ტაიმერის reference გადმოდის აქ
+            timer_free(index);
+        }
+        xSemaphoreGive(s_lock);
+
+        if (post && callback)
+        {
+            callback(callback_arg);
+            __atomic_fetch_add(&s_stats.fired, 1, __ATOMIC_RELAXED);
+        }
+        else if (post)
+        {
+            esp_err_t err = synapse_event_bus_post_id(event_id, data_wrapper);
+            __atomic_fetch_add(err == ESP_OK ? &s_stats.fired : &s_stats.post_failures, 1, __ATOMIC_RELAXED);
+        }
+        if (data_wrapper)
+        {
+            synapse_event_data_release(data_wrapper);
+        }
+    }
+}
+
+/**
+ * @internal
+ * @brief ქმნის ტაიმერს და ათავსებს wheel-ში.
+ */
+static esp_err_t schedule(synapse_event_id_t event_id, event_data_wrapper_t *data_wrapper,
+                          event_timer_callback_t callback, uint32_t callback_arg, uint32_t delay_ms,
+                          uint32_t period_ms, synapse_event_timer_t *timer_out)
+{
+    if (!s_lock)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!callback && (!synapse_event_registry_get(event_id) || event_id == SYNAPSE_EVENT_ID_WILDCARD))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint32_t resolution_ms = CONFIG_SYNAPSE_EVENT_TIMER_RESOLUTION_MS;
+    uint32_t delay_ticks = (delay_ms + resolution_ms - 1) / resolution_ms;
+    uint32_t period_ticks = (period_ms + resolution_ms - 1) / resolution_ms;
+    if (delay_ticks > INT32_MAX / 2 || period_ticks > INT32_MAX / 2)
+    {
+        ESP_LOGE(TAG, "Timer interval too long: %" PRIu32 " ms.", delay_ms > period_ms ? delay_ms : period_ms);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    if (s_free_head == TIMER_NIL)
+    {
+        xSemaphoreGive(s_lock);
+        ESP_LOGW(TAG, "No free timer for %s (CONFIG_SYNAPSE_EVENT_TIMER_MAX_TIMERS=%d).",
+                 callback ? "an internal callback" : synapse_event_bus_get_name(event_id), TIMER_MAX_TIMERS);
+        return ESP_ERR_NO_MEM;
+    }
+    uint16_t index = s_free_head;
+    timer_entry_t *timer = &s_timers[index];
+    s_free_head = timer->next;
+
+    if (data_wrapper)
+    {
+        synapse_event_data_acquire(data_wrapper);
+    }
+    timer->event_id = event_id;
+    timer->callback = callback;
+    if (callback)
+    {
+        timer->callback_arg = callback_arg;
+    }
+    else
+    {
+        timer->data_wrapper = data_wrapper;
+    }
+    timer->period = period_ticks;
+    // ტიკის საზღვრამდე ზემოთ დამრგვალება: ივენთი არასდროს ქვეყნდება `delay_ms`-ზე ადრე
+    uint32_t now_ceil = (uint32_t)((esp_timer_get_time() - s_epoch_us + TIMER_RESOLUTION_US - 1) / TIMER_RESOLUTION_US);
+    timer->expires = now_ceil + delay_ticks;
+    wheel_insert(index);
+
+    s_stats.active++;
+    if (s_stats.active > s_stats.high_watermark)
+    {
+        s_stats.high_watermark = s_stats.active;
+    }
+    // ტასკს ვაღვიძებთ მხოლოდ მაშინ, როცა ახალი ტაიმერი მის დაგეგმილ გაღვიძებამდე იწურება
+    bool wake = s_idle || (int32_t)(timer->expires - s_wakeup_tick) < 0;
+    synapse_event_timer_t handle = ((uint32_t)timer->generation << 16) | (uint32_t)(index + 1);
+    xSemaphoreGive(s_lock);
+
+    if (wake)
+    {
+        xTaskNotifyGive(s_task);
+    }
+    if (timer_out)
+    {
+        *timer_out = handle;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @internal
+ * @brief ტაიმერების ტასკი: ამუშავებს wheel-ს და იძინებს შემდეგ სამუშაო ტიკამდე.
+ */
+static void timer_task(void *pvParameters)
+{
+    for (;;)
+    {
+        int64_t started_us = esp_timer_get_time();
+
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        uint16_t firing = wheel_advance(current_tick());
+        xSemaphoreGive(s_lock);
+
+        fire_timers(firing);
+
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        s_idle = (s_stats.active == 0);
+        s_wakeup_tick = s_now + ticks_to_next_work();
+        uint32_t wakeup_tick = s_wakeup_tick;
+        bool idle = s_idle;
+        s_stats.wakeups++;
+        s_stats.busy_us += (uint64_t)(esp_timer_get_time() - started_us);
+        xSemaphoreGive(s_lock);
+
+        TickType_t wait = portMAX_DELAY;
+        if (!idle)
+        {
+            int64_t wait_us = s_epoch_us + (int64_t)wakeup_tick * TIMER_RESOLUTION_US - esp_timer_get_time();
+            wait = (wait_us > 0) ? pdMS_TO_TICKS((wait_us + 999) / 1000) : 0;
+            if (wait == 0 && wait_us > 0)
+            {
+                wait = 1;
+            }
+        }
+        ulTaskNotifyTake(pdTRUE, wait);
+    }
+}
+
+// --- Service API Implementation ---
+
+static synapse_timer_handle_t timer_api_schedule_event(const char *event_name, uint32_t interval_ms, bool is_periodic)
+{
+    synapse_event_timer_t timer = SYNAPSE_EVENT_TIMER_INVALID;
+    esp_err_t err = is_periodic ? synapse_event_bus_post_periodic(event_name, NULL, interval_ms, &timer)
+                                : synapse_event_bus_post_delayed(event_name, NULL, interval_ms, &timer);
+    return (err == ESP_OK) ? (synapse_timer_handle_t)(uintptr_t)timer : NULL;
+}
+
+static esp_err_t timer_api_cancel_event(synapse_timer_handle_t handle)
+{
+    return synapse_event_bus_cancel_timer((synapse_event_timer_t)(uintptr_t)handle);
+}
+
+// --- Public API Implementation ---
+
+esp_err_t synapse_event_timer_init(void)
+{
+    if (s_lock)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    s_timers = (timer_entry_t *)calloc(TIMER_MAX_TIMERS, sizeof(timer_entry_t));
+    s_lock = xSemaphoreCreateMutex();
+    if (!s_timers || !s_lock)
+    {
+        ESP_LOGE(TAG, "Failed to allocate %d timers.", TIMER_MAX_TIMERS);
+        goto fail;
+    }
+
+    for (uint16_t i = 0; i < TIMER_MAX_TIMERS; i++)
+    {
+        s_timers[i].next = (i + 1 < TIMER_MAX_TIMERS) ? i + 1 : TIMER_NIL;
+    }
+    s_free_head = 0;
+    for (int level = 0; level < WHEEL_LEVELS; level++)
+    {
+        for (uint32_t slot = 0; slot < WHEEL_SLOTS; slot++)
+        {
+            s_slots[level][slot] = TIMER_NIL;
+        }
+    }
+    memset(s_occupied, 0, sizeof(s_occupied));
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_stats.capacity = TIMER_MAX_TIMERS;
+    s_epoch_us = esp_timer_get_time();
+    s_now = 0;
+    s_idle = true;
+
+    if (xTaskCreate(timer_task, "evbus_timer", TIMER_TASK_STACK_SIZE, NULL, TIMER_TASK_PRIORITY, &s_task) != pdPASS)
+    {
+        ESP_LOGE(TAG, "Failed to create timer task.");
+        goto fail;
+    }
+
+    esp_err_t err = synapse_service_register_with_status("event_timer", SYNAPSE_SERVICE_TYPE_TIMER_API, &s_timer_api,
+                                                         SERVICE_STATUS_ACTIVE);
+    if (err != ESP_OK)
+    {
+        // ბირთვის API მუშაობს სერვისის გარეშეც
+        ESP_LOGW(TAG, "Failed to register timer service: %s", esp_err_to_name(err));
+    }
+    ESP_LOGI(TAG, "Timing wheel ready: %d timers, %d ms resolution.", TIMER_MAX_TIMERS,
+             CONFIG_SYNAPSE_EVENT_TIMER_RESOLUTION_MS);
+    return ESP_OK;
+
+fail:
+    if (s_lock)
+    {
+        vSemaphoreDelete(s_lock);
+        s_lock = NULL;
+    }
+    free(s_timers);
+    s_timers = NULL;
+    return ESP_ERR_NO_MEM;
+}
+
+esp_err_t synapse_event_bus_post_delayed_id(synapse_event_id_t event_id, event_data_wrapper_t *data_wrapper,
+                                            uint32_t delay_ms, synapse_event_timer_t *timer_out)
+{
+    return schedule(event_id, data_wrapper, NULL, 0, delay_ms, 0, timer_out);
+}
+
+esp_err_t synapse_event_bus_post_periodic_id(synapse_event_id_t event_id, event_data_wrapper_t *data_wrapper,
+                                             uint32_t period_ms, synapse_event_timer_t *timer_out)
+{
+    if (period_ms == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return schedule(event_id, data_wrapper, NULL, 0, period_ms, period_ms, timer_out);
+}
+
+esp_err_t synapse_event_timer_schedule_callback(uint32_t delay_ms, event_timer_callback_t callback, uint32_t arg,
+                                                synapse_event_timer_t *timer_out)
+{
+    if (!callback)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return schedule(SYNAPSE_EVENT_ID_INVALID, NULL, callback, arg, delay_ms, 0, timer_out);
+}
+
+esp_err_t synapse_event_bus_cancel_timer(synapse_event_timer_t timer)
+{
+    uint32_t index = (timer & 0xFFFF) - 1;
+    uint16_t generation = (uint16_t)(timer >> 16);
+    if (timer == SYNAPSE_EVENT_TIMER_INVALID || index >= TIMER_MAX_TIMERS)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_lock)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    event_data_wrapper_t *data_wrapper = NULL;
+    esp_err_t ret = ESP_OK;
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    timer_entry_t *entry = &s_timers[index];
+    if (entry->generation != generation || (entry->state != TIMER_STATE_ARMED && entry->state != TIMER_STATE_FIRING))
+    {
+        ret = ESP_ERR_NOT_FOUND;
+    }
+    else if (entry->state == TIMER_STATE_FIRING)
+    {
+        // ტასკი მას ახლა ამუშავებს; გამოქვეყნების ნაცვლად გაათავისუფლებს
+        entry->state = TIMER_STATE_CANCELLED;
+        s_stats.cancelled++;
+    }
+    else
+    {
+        wheel_unlink((uint16_t)index);
+        data_wrapper = entry->callback ? NULL : entry->data_wrapper;
+        timer_free((uint16_t)index);
+        s_stats.cancelled++;
+    }
+    xSemaphoreGive(s_lock);
+
+    if (data_wrapper)
+    {
+        synapse_event_data_release(data_wrapper);
+    }
+    return ret;
+}
+
+esp_err_t synapse_event_bus_get_timer_stats(synapse_event_timer_stats_t *stats)
+{
+    if (!stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_lock)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    *stats = s_stats;
+    xSemaphoreGive(s_lock);
+    return ESP_OK;
+}
+
+#else // !CONFIG_SYNAPSE_EVENT_TIMER_ENABLE
+
+esp_err_t synapse_event_timer_init(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t synapse_event_bus_post_delayed_id(synapse_event_id_t event_id, event_data_wrapper_t *data_wrapper,
+                                            uint32_t delay_ms, synapse_event_timer_t *timer_out)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t synapse_event_bus_post_periodic_id(synapse_event_id_t event_id, event_data_wrapper_t *data_wrapper,
+                                             uint32_t period_ms, synapse_event_timer_t *timer_out)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t synapse_event_timer_schedule_callback(uint32_t delay_ms, event_timer_callback_t callback, uint32_t arg,
+                                                synapse_event_timer_t *timer_out)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t synapse_event_bus_cancel_timer(synapse_event_timer_t timer)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t synapse_event_bus_get_timer_stats(synapse_event_timer_stats_t *stats)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif // CONFIG_SYNAPSE_EVENT_TIMER_ENABLE
+
+esp_err_t synapse_event_bus_post_delayed(const char *event_name, event_data_wrapper_t *data_wrapper,
+                                         uint32_t delay_ms, synapse_event_timer_t *timer_out)
+{
+    if (!event_name || strlen(event_name) == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    synapse_event_id_t event_id = synapse_event_bus_intern(event_name);
+    if (event_id == SYNAPSE_EVENT_ID_INVALID)
+    {
+        ESP_LOGE(TAG, "Failed to intern event name '%s'.", event_name);
+        return ESP_ERR_NO_MEM;
+    }
+    return synapse_event_bus_post_delayed_id(event_id, data_wrapper, delay_ms, timer_out);
+}
+
+esp_err_t synapse_event_bus_post_periodic(const char *event_name, event_data_wrapper_t *data_wrapper,
+                                          uint32_t period_ms, synapse_event_timer_t *timer_out)
+{
+    if (!event_name || strlen(event_name) == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    synapse_event_id_t event_id = synapse_event_bus_intern(event_name);
+    if (event_id == SYNAPSE_EVENT_ID_INVALID)
+    {
+        ESP_LOGE(TAG, "Failed to intern event name '%s'.", event_name);
+        return ESP_ERR_NO_MEM;
+    }
+    return synapse_event_bus_post_periodic_id(event_id, data_wrapper, period_ms, timer_out);
+}
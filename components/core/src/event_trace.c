@@ -0,0 +1,251 @@
+/**
+ * @file event_trace.c
+ * @brief ბირთვის ბინარული trace ჩამწერის იმპლემენტაცია.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-09-27
+ * @details ჩანაწერები იწერება სტატიკურ წრიულ ბუფერში. ჩამწერი იღებს სლოტს
+ *          ერთი ატომური `fetch_add`-ით და ავსებს მას - ლოკის გარეშე, ამიტომ
+ *          ერთდროულად წერენ დისპეტჩერები, ISR-ები და worker-ები. ბუფერის
+ *          სავსეობისას უძველესი ჩანაწერები იწერება ზემოდან.
+ *
+ *          დროის ნიშნული CPU-ს ციკლების მთვლელია (რამდენიმე ციკლი), და არა
+ *          `esp_timer_get_time()`. მთვლელი თითო ბირთვზე ცალკეა და 32 ბიტზე
+ *          გადაივსება (~18 წმ 240 MHz-ზე); დეკოდერი მას ბირთვების მიხედვით "ხსნის".
+ */
+#include "synapse_trace.h"
+#include "event_bus.h"
+#include "event_registry_internal.h"
+#include "module_registry.h"
+#include "service_locator.h"
+#include "cmd_router_interface.h"
+#include "logging.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_cpu.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+DEFINE_COMPONENT_TAG("SYNAPSE_TRACE", SYNAPSE_LOG_COLOR_BLUE);
+
+#if defined(CONFIG_SYNAPSE_TRACE_ENABLE)
+
+// --- Kconfig Definitions ---
+#define TRACE_BUFFER_RECORDS CONFIG_SYNAPSE_TRACE_BUFFER_RECORDS
+#define TRACE_BUFFER_MASK (TRACE_BUFFER_RECORDS - 1)
+
+_Static_assert((TRACE_BUFFER_RECORDS & TRACE_BUFFER_MASK) == 0, "CONFIG_SYNAPSE_TRACE_BUFFER_RECORDS must be a power of two");
+
+/** @brief ჩანაწერების რაოდენობა `SYNTRACE R` ხაზზე. */
+#define TRACE_DUMP_RECORDS_PER_LINE 8
+/** @brief ბინარული/ტექსტური ფორმატის ვერსია (დეკოდერი ამოწმებს). */
+#define TRACE_FORMAT_VERSION 1
+
+// --- Static Globals ---
+static synapse_trace_record_t s_ring[TRACE_BUFFER_RECORDS];
+static uint32_t s_head = 0;       /**< @brief შემდეგი ჩანაწერის რიგითი ნომერი (მონოტონური). */
+static uint32_t s_base = 0;       /**< @brief რიგითი ნომერი ბოლო გასუფთავებისას. */
+static uint32_t s_enabled = 1;    /**< @brief ჩაწერა ჩართულია (ნაგულისხმევად - ყოველთვის). */
+
+// --- Forward Declarations ---
+static esp_err_t trace_command_handler(int argc, char **argv, void *context);
+
+/**
+ * @internal
+ * @brief Command Router-ის ბრძანება (უნდა იცოცხლოს რეგისტრაციის მთელი დროის განმავლობაში).
+ */
+static const cmd_t s_trace_command = {
+    .command = "trace",
+    .help = "Dumps or controls the core event trace buffer.",
+    .usage = "trace <dump|clear|on|off>",
+    .min_args = 2,
+    .max_args = 2,
+    .handler = trace_command_handler,
+    .context = NULL,
+};
+
+// --- Public API Implementation ---
+
+void synapse_trace_record(synapse_trace_type_t type, uint16_t id, uint32_t arg)
+{
+    if (!__atomic_load_n(&s_enabled, __ATOMIC_RELAXED))
+    {
+        return;
+    }
+    uint32_t seq = __atomic_fetch_add(&s_head, 1, __ATOMIC_RELAXED);
+    synapse_trace_record_t *rec = &s_ring[seq & TRACE_BUFFER_MASK];
+    rec->timestamp = (uint32_t)esp_cpu_get_cycle_count();
+    rec->type = (uint8_t)type;
+    rec->core = (uint8_t)xPortGetCoreID();
+    rec->id = id;
+    rec->arg = arg;
+    rec->task = (uint32_t)(uintptr_t)xTaskGetCurrentTaskHandle();
+}
+
+esp_err_t synapse_trace_set_enabled(bool enabled)
+{
+    __atomic_store_n(&s_enabled, enabled ? 1 : 0, __ATOMIC_RELEASE);
+    return ESP_OK;
+}
+
+void synapse_trace_clear(void)
+{
+    __atomic_store_n(&s_base, __atomic_load_n(&s_head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+}
+
+esp_err_t synapse_trace_snapshot(synapse_trace_record_t *records, size_t max, size_t *count_out, uint32_t *lost_out)
+{
+    if (!records || !count_out)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // ჩაწერის შეჩერება, რომ კოპირებისას ბუფერი არ "გადაირბინოს"; უკვე დაწყებული ჩანაწერი შეიძლება ნაწილობრივი იყოს
+    uint32_t was_enabled = __atomic_exchange_n(&s_enabled, 0, __ATOMIC_ACQ_REL);
+
+    uint32_t head = __atomic_load_n(&s_head, __ATOMIC_ACQUIRE);
+    uint32_t written = head - __atomic_load_n(&s_base, __ATOMIC_ACQUIRE);
+    uint32_t available = (written < TRACE_BUFFER_RECORDS) ? written : TRACE_BUFFER_RECORDS;
+    uint32_t count = (available < max) ? available : (uint32_t)max;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        records[i] = s_ring[(head - count + i) & TRACE_BUFFER_MASK];
+    }
+
+    __atomic_store_n(&s_enabled, was_enabled, __ATOMIC_RELEASE);
+
+    *count_out = count;
+    if (lost_out)
+    {
+        *lost_out = written - count;
+    }
+    return ESP_OK;
+}
+
+esp_err_t synapse_trace_dump(void)
+{
+    synapse_trace_record_t *records = malloc(sizeof(synapse_trace_record_t) * TRACE_BUFFER_RECORDS);
+    if (!records)
+    {
+        ESP_LOGE(TAG, "Not enough memory to dump %d trace records.", TRACE_BUFFER_RECORDS);
+        return ESP_ERR_NO_MEM;
+    }
+
+    size_t count = 0;
+    uint32_t lost = 0;
+    synapse_trace_snapshot(records, TRACE_BUFFER_RECORDS, &count, &lost);
+
+    printf("SYNTRACE BEGIN %d %d %u %" PRIu32 "\n", TRACE_FORMAT_VERSION, CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+           (unsigned)count, lost);
+
+    // სახელების ცხრილები: ჩანაწერებში მხოლოდ ID-ები და მისამართებია
+    uint16_t event_count = synapse_event_registry_count();
+    for (uint16_t id = 0; id < event_count; id++)
+    {
+        printf("SYNTRACE E %u %s\n", id, synapse_event_bus_get_name(id));
+    }
+
+    const module_t **modules = NULL;
+    uint8_t module_count = 0;
+    if (synapse_module_registry_get_all(&modules, &module_count) == ESP_OK)
+    {
+        for (uint8_t i = 0; i < module_count; i++)
+        {
+            printf("SYNTRACE M %08" PRIx32 " %s\n", (uint32_t)(uintptr_t)modules[i], modules[i]->name);
+        }
+    }
+
+    for (size_t i = 0; i < count; i += TRACE_DUMP_RECORDS_PER_LINE)
+    {
+        size_t line_records = (count - i < TRACE_DUMP_RECORDS_PER_LINE) ? count - i : TRACE_DUMP_RECORDS_PER_LINE;
+        const uint8_t *bytes = (const uint8_t *)&records[i];
+        printf("SYNTRACE R ");
+        for (size_t b = 0; b < line_records * sizeof(synapse_trace_record_t); b++)
+        {
+            printf("%02x", bytes[b]);
+        }
+        printf("\n");
+    }
+    printf("SYNTRACE END\n");
+
+    free(records);
+    return ESP_OK;
+}
+
+esp_err_t synapse_trace_register_command(void)
+{
+    cmd_router_api_t *router = (cmd_router_api_t *)synapse_service_lookup_by_type(SYNAPSE_SERVICE_TYPE_CMD_ROUTER_API);
+    if (!router || !router->register_command)
+    {
+        ESP_LOGD(TAG, "Command Router not available; 'trace' command not registered.");
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (router->is_command_registered && router->is_command_registered(s_trace_command.command))
+    {
+        return ESP_OK;
+    }
+
+    esp_err_t err = router->register_command(&s_trace_command);
+    if (err != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Failed to register 'trace' command: %s", esp_err_to_name(err));
+    }
+    return err;
+}
+
+// --- Internal Helper Functions ---
+
+/**
+ * @internal
+ * @brief `trace <dump|clear|on|off>` ბრძანების დამმუშავებელი.
+ */
+static esp_err_t trace_command_handler(int argc, char **argv, void *context)
+{
+    const char *action = argv[1];
+    if (strcmp(action, "dump") == 0)
+    {
+        return synapse_trace_dump();
+    }
+    if (strcmp(action, "clear") == 0)
+    {
+        synapse_trace_clear();
+        return ESP_OK;
+    }
+    if (strcmp(action, "on") == 0 || strcmp(action, "off") == 0)
+    {
+        return synapse_trace_set_enabled(strcmp(action, "on") == 0);
+    }
+    ESP_LOGW(TAG, "Unknown trace action '%s'. Usage: %s", action, s_trace_command.usage);
+    return ESP_ERR_INVALID_ARG;
+}
+
+#else // !CONFIG_SYNAPSE_TRACE_ENABLE
+
+esp_err_t synapse_trace_set_enabled(bool enabled)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+void synapse_trace_clear(void)
+{
+}
+
+esp_err_t synapse_trace_snapshot(synapse_trace_record_t *records, size_t max, size_t *count_out, uint32_t *lost_out)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t synapse_trace_dump(void)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t synapse_trace_register_command(void)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif // CONFIG_SYNAPSE_TRACE_ENABLE
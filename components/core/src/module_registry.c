@@ -16,6 +16,8 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "base_module.h"
+#include "event_static_routes_internal.h" // module.json-ის `subscribes` მარშრუტები
+#include "event_bus.h"                     // მოდულის ივენთების საფოსტო ყუთი
 #include <string.h>
 #include <stdlib.h>
 
@@ -34,6 +36,47 @@ static SemaphoreHandle_t registry_mutex = NULL;
 // --- შიდა ფუნქციების წინასწარი დეკლარაცია ---
 static esp_err_t register_module(module_t *module);
 
+/**
+ * @internal
+ * @brief ჩართავს მოდულის საფოსტო ყუთს, თუ ინსტანციის კონფიგურაცია ამას ითხოვს.
+ * @details `"event_mailbox": true` ნაგულისხმევ პარამეტრებს იყენებს, ობიექტი კი
+ *          `queue_length` და `block_timeout_ms` ველებს იღებს.
+ */
+static void apply_event_mailbox_config(module_t *module, const cJSON *module_config_json)
+{
+    const cJSON *mailbox_json = cJSON_GetObjectItem(module_config_json, "event_mailbox");
+    if (!mailbox_json || cJSON_IsFalse(mailbox_json))
+    {
+        return;
+    }
+
+    synapse_event_mailbox_config_t mailbox_config = {0};
+    if (cJSON_IsObject(mailbox_json))
+    {
+        const cJSON *length_json = cJSON_GetObjectItem(mailbox_json, "queue_length");
+        const cJSON *timeout_json = cJSON_GetObjectItem(mailbox_json, "block_timeout_ms");
+        if (cJSON_IsNumber(length_json) && length_json->valueint > 0)
+        {
+            mailbox_config.queue_length = (uint16_t)length_json->valueint;
+        }
+        if (cJSON_IsNumber(timeout_json) && timeout_json->valueint > 0)
+        {
+            mailbox_config.block_timeout_ms = (uint32_t)timeout_json->valueint;
+        }
+    }
+    else if (!cJSON_IsTrue(mailbox_json))
+    {
+        ESP_LOGW(TAG, "Invalid 'event_mailbox' value for module '%s'; ignoring.", module->name);
+        return;
+    }
+
+    if (synapse_event_bus_enable_mailbox(module, &mailbox_config) != ESP_OK)
+    {
+        // მოდული მუშაობს, უბრალოდ ივენთებს დისპეტჩერის ნაკადში მიიღებს
+        ESP_LOGW(TAG, "Failed to enable the event mailbox of module '%s'.", module->name);
+    }
+}
+
 /**
  * @internal
  * @brief qsort-ისთვის განკუთვნილი შედარების ფუნქცია.
@@ -123,6 +166,15 @@ esp_err_t synapse_module_registry_init(void)
                 // ამიტომ აქ დამატებითი მოქმედება არ არის საჭირო.
                 ESP_LOGE(TAG, "Failed to register created module of type '%s'.", type_json->valuestring);
             }
+            else
+            {
+                if (synapse_event_static_routes_bind(new_module, type_json->valuestring) != ESP_OK)
+                {
+                    // მოდული მუშაობს, უბრალოდ module.json-ით გამოცხადებულ ივენთებს ვერ მიიღებს
+                    ESP_LOGW(TAG, "Failed to bind static event routes of module '%s'.", new_module->name);
+                }
+                apply_event_mailbox_config(new_module, module_config_json);
+            }
         }
         else
         {
@@ -136,6 +188,12 @@ esp_err_t synapse_module_registry_init(void)
         qsort(registered_modules, registered_modules_count, sizeof(module_t *), compare_modules_by_init_level);
     }
 
+    // ყველა ინსტანცია შექმნილია - ვლუქავთ სტატიკურ მარშრუტებს და ვაქვეყნებთ Event Bus-ში
+    if (synapse_event_static_routes_seal() != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Static event routes are unavailable; modules must subscribe at runtime.");
+    }
+
     ESP_LOGI(TAG, "--- Module Registry Initialization Complete: %d modules registered ---", registered_modules_count);
     return ESP_OK;
 }
@@ -12,6 +12,7 @@
 #include "promise_manager.h"
 #include "promise_manager_internal.h"
 #include "logging.h"
+#include "synapse_trace.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
@@ -22,7 +23,13 @@
 DEFINE_COMPONENT_TAG("PROMISE_MANAGER", SYNAPSE_LOG_COLOR_BLUE);
 
 // --- Kconfig Definitions ---
+#if CONFIG_SYNAPSE_EVENT_TIMER_ENABLE
+// თითოეული მოთხოვნა (synapse_event_bus_request) ერთხელ სრულდება, ამიტომ პასუხების
+// ტალღისთვის რიგში ადგილი წინასწარ ემატება და callback არ იკარგება
+#define PROMISE_QUEUE_LENGTH (CONFIG_SYNAPSE_PROMISE_QUEUE_LENGTH + CONFIG_SYNAPSE_EVENT_REQUEST_MAX_PENDING)
+#else
 #define PROMISE_QUEUE_LENGTH CONFIG_SYNAPSE_PROMISE_QUEUE_LENGTH
+#endif
 #define PROMISE_TASK_STACK_SIZE CONFIG_SYNAPSE_PROMISE_TASK_STACK_SIZE
 #define PROMISE_TASK_PRIORITY CONFIG_SYNAPSE_PROMISE_TASK_PRIORITY
 
@@ -159,16 +166,19 @@ static esp_err_t synapse_promise_fulfill(promise_handle_t handle, void *data, vo
     promise->free_fn = free_fn;
 
     xSemaphoreGive(registry_mutex);
+    SYNAPSE_TRACE(SYNAPSE_TRACE_PROMISE_SETTLE, is_resolve ? 1 : 0, promise->id);
 
+    // რიგში ჩადების შემდეგ promise შეიძლება callback-ის ტასკმა მაშინვე გაათავისუფლოს
+    uint32_t promise_id = promise->id;
     promise_message_t msg = {.handle = handle};
     if (xQueueSend(promise_execution_queue, &msg, 0) != pdPASS)
     {
-        ESP_LOGE(TAG, "Failed to queue promise (ID %" PRIu32 ") for execution.", promise->id);
+        ESP_LOGE(TAG, "Failed to queue promise (ID %" PRIu32 ") for execution.", promise_id);
         cleanup_promise(promise);
         return ESP_FAIL;
     }
 
-    ESP_LOGD(TAG, "Queued promise ID %" PRIu32 " for %s.", promise->id, is_resolve ? "resolution" : "rejection");
+    ESP_LOGD(TAG, "Queued promise ID %" PRIu32 " for %s.", promise_id, is_resolve ? "resolution" : "rejection");
     return ESP_OK;
 }
 
@@ -182,6 +192,29 @@ esp_err_t synapse_promise_reject(promise_handle_t handle, void *error_data, void
     return synapse_promise_fulfill(handle, error_data, free_fn, false);
 }
 
+esp_err_t synapse_promise_cancel(promise_handle_t handle)
+{
+    promise_t *promise = (promise_t *)handle;
+    if (!promise)
+        return ESP_ERR_INVALID_ARG;
+
+    if (xSemaphoreTake(registry_mutex, portMAX_DELAY) != pdTRUE)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+    if (promise->state != PROMISE_STATE_PENDING)
+    {
+        xSemaphoreGive(registry_mutex);
+        return ESP_ERR_INVALID_STATE;
+    }
+    SLIST_REMOVE(&promise_registry_head, promise, promise_t, entries);
+    xSemaphoreGive(registry_mutex);
+
+    ESP_LOGD(TAG, "Cancelled promise with ID %" PRIu32, promise->id);
+    free(promise);
+    return ESP_OK;
+}
+
 // --- Internal Helper Functions ---
 
 static void cleanup_promise(promise_t *promise)
@@ -214,6 +247,7 @@ static void promise_manager_task(void *params)
             if (!promise)
                 continue;
 
+            SYNAPSE_TRACE(SYNAPSE_TRACE_PROMISE_CB_START, 0, promise->id);
             if (promise->state == PROMISE_STATE_RESOLVED && promise->then_callback)
             {
                 ESP_LOGD(TAG, "Executing 'then' callback for promise ID %" PRIu32, promise->id);
@@ -224,6 +258,7 @@ static void promise_manager_task(void *params)
                 ESP_LOGD(TAG, "Executing 'catch' callback for promise ID %" PRIu32, promise->id);
                 promise->catch_callback(promise->result_data, promise->user_context);
             }
+            SYNAPSE_TRACE(SYNAPSE_TRACE_PROMISE_CB_END, 0, promise->id);
 
             cleanup_promise(promise);
         }
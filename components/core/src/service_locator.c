@@ -1,8 +1,8 @@
 /**
  * @file service_locator.c
  * @brief Service Locator პატერნის იმპლემენტაცია.
- * @date 2025-06-26
- * @version 1.1
+ * @date 2025-10-10
+ * @version 2.0
  * @author Giorgi Magradze
  * @details ეს ფაილი შეიცავს Service Locator პატერნის კონკრეტულ იმპლემენტაციას.
  *          ის საშუალებას აძლევს მოდულებს, დინამიურად იპოვონ და გამოიყენონ
@@ -10,23 +10,35 @@
  *
  *          ძირითადი მახასიათებლები:
  *          - სერვისის რეგისტრაცია უნიკალური სახელითა და ტიპით.
- *          - სერვისის მოძიება სახელით.
+ *          - სერვისის მოძიება სახელით - O(1), სახელის ჰეშით.
  *          - სერვისის ტიპის მოძიება.
  *          - ნაკად-უსაფრთხო (thread-safe) ოპერაციები FreeRTOS mutex-ის გამოყენებით.
+ *          - ქეშირებადი token-ები (`synapse_service_resolve()`), რომელთა
+ *            გამოყენება mutex-ს არ საჭიროებს.
  *
- *          იმპლემენტაცია იყენებს ცალმხრივად დაკავშირებულ სიას (singly-linked list)
- *          რეგისტრირებული სერვისების შესანახად და mutex-ს ერთდროული წვდომის
- *          უსაფრთხოდ სამართავად.
+ *          რეესტრი არის `CONFIG_SYNAPSE_MAX_SERVICES` ზომის სტატიკური სლოტების
+ *          მასივი და მასზე აგებული ჰეშ-ცხრილი (bucket-ები სლოტების ინდექსების
+ *          ჯაჭვით). თითოეულ სლოტს აქვს თაობის (generation) მრიცხველი, რომელიც
+ *          იზრდება რეგისტრაციისა და გაუქმებისას: კენტი მნიშვნელობა ნიშნავს
+ *          დაკავებულ სლოტს. token ინახავს სლოტის ინდექსსა და თაობას, ამიტომ
+ *          ხელახლა რეგისტრირებული სერვისის ძველი token-ი უბრალოდ აღარ ემთხვევა.
+ *          token-ის წაკითხვა seqlock-ის პრინციპით ხდება: თაობა იკითხება
+ *          handle-მდე და მის შემდეგ.
  */
 #include "synapse.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include <string.h>
 #include <stdlib.h>
-#include <sys/queue.h> // SLIST-ისთვის
 
 DEFINE_COMPONENT_TAG("SERVICE_LOCATOR", SYNAPSE_LOG_COLOR_BLUE);
 
+#define SERVICE_SLOT_COUNT CONFIG_SYNAPSE_MAX_SERVICES
+#define SERVICE_BUCKET_COUNT CONFIG_SYNAPSE_MAX_SERVICES
+#define SERVICE_SLOT_NONE (-1)
+
+_Static_assert(SERVICE_SLOT_COUNT > 0 && SERVICE_SLOT_COUNT < INT16_MAX, "CONFIG_SYNAPSE_MAX_SERVICES is out of range");
+
 /**
  * @internal
  * @struct service_entry_t
@@ -34,25 +46,37 @@ DEFINE_COMPONENT_TAG("SERVICE_LOCATOR", SYNAPSE_LOG_COLOR_BLUE);
  *
  * @details ეს შიდა სტრუქტურა ინახავს სერვისის ყველა მეტამონაცემს,
  *          მათ შორის მის სახელს, ტიპს და მისამართს მის Public API სტრუქტურაზე.
- *          ეს ჩანაწერები ქმნიან ცალმხრივად დაკავშირებულ სიას სერვისების რეესტრისთვის.
+ *          ჩანაწერები სტატიკურ მასივშია; `next` აკავშირებს ერთი bucket-ის სლოტებს.
  */
-typedef struct service_entry_t {
+typedef struct
+{
     char name[CONFIG_SYNAPSE_SERVICE_NAME_MAX_LENGTH]; /**< @brief სერვისის უნიკალური სახელი. */
+    uint32_t hash;                                     /**< @brief სახელის FNV-1a ჰეში. */
+    uint32_t generation;                               /**< @brief თაობა: კენტი - სლოტი დაკავებულია. ატომური. */
+    uint32_t sequence;                                 /**< @brief რეგისტრაციის რიგითი ნომერი (`lookup_by_type`-ისთვის). */
     synapse_service_type_t type;                       /**< @brief სერვისის ტიპი (enum). */
     service_status_t status;                           /**< @brief სერვისის სტატუსი (enum). */
-    void *service_handle;                              /**< @brief მაჩვენებელი სერვისის API სტრუქტურაზე. */
-    SLIST_ENTRY(service_entry_t)
-    entries; /**< @brief მაჩვენებელი სიის შემდეგ ელემენტზე. */
+    void *service_handle;                              /**< @brief მაჩვენებელი სერვისის API სტრუქტურაზე. ატომური. */
+    int16_t next;                                      /**< @brief იმავე bucket-ის შემდეგი სლოტი, ან `SERVICE_SLOT_NONE`. */
 } service_entry_t;
 
 /**
  * @internal
- * @brief რეგისტრირებული სერვისების სიის "თავი" (head).
- *
- * @details ეს არის ცალმხრივად დაკავშირებული სიის თავი, რომელიც ინახავს
- *          ყველა რეგისტრირებული სერვისის ჩანაწერს.
+ * @brief რეგისტრირებული სერვისების სლოტები.
  */
-static SLIST_HEAD(service_list_head, service_entry_t) service_registry_head;
+static service_entry_t s_service_slots[SERVICE_SLOT_COUNT];
+
+/**
+ * @internal
+ * @brief ჰეშ-ცხრილი: თითოეული bucket ინახავს ჯაჭვის პირველი სლოტის ინდექსს.
+ */
+static int16_t s_service_buckets[SERVICE_BUCKET_COUNT];
+
+/**
+ * @internal
+ * @brief ბოლო რეგისტრაციის რიგითი ნომერი.
+ */
+static uint32_t s_service_sequence;
 
 /**
  * @internal
@@ -60,9 +84,66 @@ static SLIST_HEAD(service_list_head, service_entry_t) service_registry_head;
  *
  * @details ეს mutex-ი უზრუნველყოფს ნაკად-უსაფრთხო წვდომას, როდესაც ხდება
  *          სერვისების რეესტრში ჩანაწერების რეგისტრაცია, მოძიება ან ცვლილება.
+ *          token-ის წაკითხვა (`synapse_service_token_get`) მას არ იყენებს.
  */
 static SemaphoreHandle_t service_registry_mutex = NULL;
 
+// --- Internal Helper Functions ---
+
+/**
+ * @internal
+ * @brief ითვლის სერვისის სახელის FNV-1a ჰეშს (შეზღუდულს სახელის მაქს. სიგრძით).
+ */
+static uint32_t service_name_hash(const char *name)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < CONFIG_SYNAPSE_SERVICE_NAME_MAX_LENGTH - 1 && name[i] != '\0'; i++)
+    {
+        hash ^= (uint8_t)name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @internal
+ * @brief პოულობს სერვისის სლოტს სახელით.
+ * @note გამომძახებელი უნდა ფლობდეს `service_registry_mutex`-ს.
+ * @return სლოტის ინდექსი, ან `SERVICE_SLOT_NONE`.
+ */
+static int16_t find_slot_locked(const char *service_name, uint32_t hash)
+{
+    for (int16_t i = s_service_buckets[hash % SERVICE_BUCKET_COUNT]; i != SERVICE_SLOT_NONE; i = s_service_slots[i].next)
+    {
+        const service_entry_t *entry = &s_service_slots[i];
+        if (entry->hash == hash && strncmp(entry->name, service_name, sizeof(entry->name) - 1) == 0)
+        {
+            return i;
+        }
+    }
+    return SERVICE_SLOT_NONE;
+}
+
+/**
+ * @internal
+ * @brief იღებს mutex-ს და პოულობს სერვისის ჩანაწერს სახელით.
+ * @param[out] entry_out ნაპოვნი ჩანაწერი (mutex-ის გათავისუფლებამდე ვალიდურია).
+ * @return ESP_OK (mutex დაკავებულია), ESP_ERR_NOT_FOUND (mutex დაკავებულია) ან ESP_ERR_TIMEOUT.
+ */
+static esp_err_t lock_and_find(const char *service_name, TickType_t timeout, service_entry_t **entry_out)
+{
+    uint32_t hash = service_name_hash(service_name);
+    if (xSemaphoreTake(service_registry_mutex, timeout) != pdTRUE)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+    int16_t index = find_slot_locked(service_name, hash);
+    *entry_out = (index == SERVICE_SLOT_NONE) ? NULL : &s_service_slots[index];
+    return *entry_out ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+// --- Public API Implementation ---
+
 esp_err_t synapse_service_locator_init(void)
 {
     // შევამოწმოთ, ხომ არ არის უკვე ინიციალიზებული
@@ -72,13 +153,20 @@ esp_err_t synapse_service_locator_init(void)
     }
 
     ESP_LOGI(TAG, "Service Locator-ის ინიციალიზაცია...");
-    SLIST_INIT(&service_registry_head);
+    for (int i = 0; i < SERVICE_BUCKET_COUNT; i++)
+    {
+        s_service_buckets[i] = SERVICE_SLOT_NONE;
+    }
+    for (int i = 0; i < SERVICE_SLOT_COUNT; i++)
+    {
+        s_service_slots[i].next = SERVICE_SLOT_NONE;
+    }
     service_registry_mutex = xSemaphoreCreateMutex();
     if (service_registry_mutex == NULL) {
         ESP_LOGE(TAG, "Service registry mutex-ის შექმნა ვერ მოხერხდა!");
         return ESP_ERR_NO_MEM;
     }
-    ESP_LOGI(TAG, "Service Locator წარმატებით ინიციალიზდა.");
+    ESP_LOGI(TAG, "Service Locator წარმატებით ინიციალიზდა (%d სლოტი).", SERVICE_SLOT_COUNT);
     return ESP_OK;
 }
 
@@ -98,42 +186,34 @@ esp_err_t synapse_service_unregister(const char *service_name)
         return ESP_ERR_INVALID_ARG;
     }
 
+    uint32_t hash = service_name_hash(service_name);
     if (xSemaphoreTake(service_registry_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_SEMAPHORE_TIMEOUT_MS)) != pdTRUE)
     {
         ESP_LOGE(TAG, "Unregister ოპერაციისთვის service registry mutex-ის დაკავება ვერ მოხერხდა.");
         return ESP_ERR_TIMEOUT;
     }
 
-    service_entry_t *current_entry = SLIST_FIRST(&service_registry_head);
-    service_entry_t *prev_entry = NULL;
-
-    // ხელით იტერაცია სიის გასწვრივ
-    while (current_entry != NULL)
+    // ვეძებთ bucket-ის ჯაჭვში და ვიმახსოვრებთ წინა რგოლს
+    int16_t *link = &s_service_buckets[hash % SERVICE_BUCKET_COUNT];
+    while (*link != SERVICE_SLOT_NONE)
     {
-        if (strcmp(current_entry->name, service_name) == 0)
+        service_entry_t *entry = &s_service_slots[*link];
+        if (entry->hash == hash && strncmp(entry->name, service_name, sizeof(entry->name) - 1) == 0)
         {
-            // ვიპოვეთ წასაშლელი ელემენტი
+            *link = entry->next;
+            entry->next = SERVICE_SLOT_NONE;
 
-            if (prev_entry == NULL)
-            {
-                // წასაშლელი ელემენტი არის სიის თავში (head)
-                SLIST_REMOVE_HEAD(&service_registry_head, entries);
-            }
-            else
-            {
-                // წასაშლელი ელემენტი არის სიის შუაში ან ბოლოში
-                SLIST_REMOVE_AFTER(prev_entry, entries);
-            }
+            // ჯერ თაობა (ლუწი - თავისუფალი), მერე handle: token-ის მკითხველი ან ძველ
+            // თაობას ვეღარ დაინახავს, ან handle-ის შემდეგ შეამჩნევს ცვლილებას
+            __atomic_store_n(&entry->generation, entry->generation + 1, __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_RELEASE);
+            __atomic_store_n(&entry->service_handle, NULL, __ATOMIC_RELAXED);
 
-            free(current_entry); // მეხსიერების გათავისუფლება
             xSemaphoreGive(service_registry_mutex);
             ESP_LOGI(TAG, "სერვისი '%s' წარმატებით გაუქმდა.", service_name);
             return ESP_OK;
         }
-
-        // გადავდივართ შემდეგ ელემენტზე და ვიმახსოვრებთ წინას
-        prev_entry = current_entry;
-        current_entry = SLIST_NEXT(current_entry, entries);
+        link = &entry->next;
     }
 
     // თუ ციკლი დასრულდა და ელემენტი ვერ მოიძებნა
@@ -150,6 +230,7 @@ esp_err_t synapse_service_register_with_status(const char *service_name, synapse
         return ESP_ERR_INVALID_ARG;
     }
 
+    uint32_t hash = service_name_hash(service_name);
     if (xSemaphoreTake(service_registry_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) != pdTRUE)
     {
         ESP_LOGE(TAG, "Failed to take service registry mutex for registration.");
@@ -157,32 +238,43 @@ esp_err_t synapse_service_register_with_status(const char *service_name, synapse
     }
 
     // Check for duplicates
-    service_entry_t *it;
-    SLIST_FOREACH(it, &service_registry_head, entries)
+    if (find_slot_locked(service_name, hash) != SERVICE_SLOT_NONE)
+    {
+        ESP_LOGE(TAG, "Service with name '%s' is already registered!", service_name);
+        xSemaphoreGive(service_registry_mutex);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    int16_t index = SERVICE_SLOT_NONE;
+    for (int16_t i = 0; i < SERVICE_SLOT_COUNT; i++)
     {
-        if (strcmp(it->name, service_name) == 0)
+        if ((s_service_slots[i].generation & 1U) == 0)
         {
-            ESP_LOGE(TAG, "Service with name '%s' is already registered!", service_name);
-            xSemaphoreGive(service_registry_mutex);
-            return ESP_ERR_INVALID_STATE;
+            index = i;
+            break;
         }
     }
-
-    service_entry_t *new_entry = malloc(sizeof(service_entry_t));
-    if (!new_entry)
+    if (index == SERVICE_SLOT_NONE)
     {
-        ESP_LOGE(TAG, "Failed to allocate memory for new service entry ('%s').", service_name);
+        ESP_LOGE(TAG, "No free slot for service '%s' (CONFIG_SYNAPSE_MAX_SERVICES = %d).", service_name, SERVICE_SLOT_COUNT);
         xSemaphoreGive(service_registry_mutex);
         return ESP_ERR_NO_MEM;
     }
 
+    service_entry_t *new_entry = &s_service_slots[index];
     strncpy(new_entry->name, service_name, sizeof(new_entry->name) - 1);
     new_entry->name[sizeof(new_entry->name) - 1] = '\0';
+    new_entry->hash = hash;
+    new_entry->sequence = ++s_service_sequence;
     new_entry->type = service_type;
-    new_entry->service_handle = service_handle;
     new_entry->status = initial_status; // <<< ვიყენებთ გადაცემულ სტატუსს
+    __atomic_store_n(&new_entry->service_handle, service_handle, __ATOMIC_RELAXED);
+    // release: token-ის მკითხველი, რომელიც ახალ თაობას ხედავს, ხედავს ახალ handle-საც
+    __atomic_store_n(&new_entry->generation, new_entry->generation + 1, __ATOMIC_RELEASE);
 
-    SLIST_INSERT_HEAD(&service_registry_head, new_entry, entries);
+    int16_t *bucket = &s_service_buckets[hash % SERVICE_BUCKET_COUNT];
+    new_entry->next = *bucket;
+    *bucket = index;
 
     xSemaphoreGive(service_registry_mutex);
 
@@ -204,51 +296,53 @@ esp_err_t synapse_service_set_status(const char *service_name, service_status_t
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (xSemaphoreTake(service_registry_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) != pdTRUE)
+    service_entry_t *it = NULL;
+    esp_err_t result = lock_and_find(service_name, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS), &it);
+    if (result == ESP_ERR_TIMEOUT)
     {
         ESP_LOGE(TAG, "Failed to take mutex to set status for '%s'.", service_name);
         return ESP_ERR_TIMEOUT;
     }
 
-    service_entry_t *it;
-    esp_err_t result = ESP_ERR_NOT_FOUND;
-    SLIST_FOREACH(it, &service_registry_head, entries)
+    if (it && it->status != new_status)
     {
-        if (strcmp(it->name, service_name) == 0)
+        service_status_t old_status = it->status;
+        it->status = new_status;
+
+        ESP_LOGI(TAG, "Status changed for service '%s': %s -> %s",
+                 service_name,
+                 service_status_to_string(old_status),
+                 service_status_to_string(new_status));
+
+        // Post event to the event bus
+        synapse_service_status_payload_t payload = {
+            .old_status = old_status,
+            .new_status = new_status,
+        };
+        strncpy(payload.service_name, service_name, sizeof(payload.service_name) - 1);
+
+        if (sizeof(payload) <= CONFIG_SYNAPSE_EVENT_INLINE_PAYLOAD_SIZE)
+        {
+            // payload რიგის სლოტში კოპირდება - heap-ის გამოყოფის გარეშე
+            synapse_event_bus_post_inline(SYNAPSE_EVENT_ID_SERVICE_STATUS_CHANGED, &payload, sizeof(payload));
+        }
+        else
         {
-            if (it->status != new_status)
+            synapse_service_status_payload_t *heap_payload = SYNAPSE_POOL_NEW(synapse_service_status_payload_t);
+            event_data_wrapper_t *wrapper;
+            if (heap_payload)
             {
-                service_status_t old_status = it->status;
-                it->status = new_status;
-
-                ESP_LOGI(TAG, "Status changed for service '%s': %s -> %s",
-                         service_name,
-                         service_status_to_string(old_status),
-                         service_status_to_string(new_status));
-
-                // Post event to the event bus
-                synapse_service_status_payload_t *payload = malloc(sizeof(synapse_service_status_payload_t));
-                if (payload)
+                memcpy(heap_payload, &payload, sizeof(payload));
+                if (synapse_event_data_wrap(heap_payload, synapse_payload_common_free, &wrapper) == ESP_OK)
                 {
-                    strncpy(payload->service_name, service_name, sizeof(payload->service_name) - 1);
-                    payload->service_name[sizeof(payload->service_name) - 1] = '\0';
-                    payload->old_status = old_status;
-                    payload->new_status = new_status;
-
-                    event_data_wrapper_t *wrapper;
-                    if (synapse_event_data_wrap(payload, synapse_payload_common_free, &wrapper) == ESP_OK)
-                    {
-                        synapse_event_bus_post(SYNAPSE_EVENT_SERVICE_STATUS_CHANGED, wrapper);
-                        synapse_event_data_release(wrapper);
-                    }
-                    else
-                    {
-                        free(payload);
-                    }
+                    synapse_event_bus_post_id(SYNAPSE_EVENT_ID_SERVICE_STATUS_CHANGED, wrapper);
+                    synapse_event_data_release(wrapper);
+                }
+                else
+                {
+                    synapse_pool_free(heap_payload);
                 }
             }
-            result = ESP_OK;
-            break;
         }
     }
 
@@ -268,25 +362,19 @@ esp_err_t synapse_service_get_status(const char *service_name, service_status_t
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (xSemaphoreTake(service_registry_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS)) != pdTRUE)
+    service_entry_t *it = NULL;
+    esp_err_t result = lock_and_find(service_name, pdMS_TO_TICKS(CONFIG_SYNAPSE_MUTEX_TIMEOUT_MS), &it);
+    if (result == ESP_ERR_TIMEOUT)
     {
         ESP_LOGE(TAG, "Failed to take mutex to get status for '%s'.", service_name);
         return ESP_ERR_TIMEOUT;
     }
 
-    service_entry_t *it;
-    esp_err_t result = ESP_ERR_NOT_FOUND;
-    SLIST_FOREACH(it, &service_registry_head, entries)
+    if (it)
     {
-        if (strcmp(it->name, service_name) == 0)
-        {
-            *out_status = it->status;
-            result = ESP_OK;
-            break;
-        }
+        *out_status = it->status;
     }
-
-    if (result == ESP_ERR_NOT_FOUND)
+    else
     {
         ESP_LOGW(TAG, "Service '%s' not found to get status.", service_name);
     }
@@ -302,20 +390,14 @@ service_handle_t synapse_service_get(const char *service_name)
         return NULL;
     }
 
-    if (xSemaphoreTake(service_registry_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_SEMAPHORE_TIMEOUT_MS)) != pdTRUE)
+    service_entry_t *it = NULL;
+    if (lock_and_find(service_name, pdMS_TO_TICKS(CONFIG_SYNAPSE_SEMAPHORE_TIMEOUT_MS), &it) == ESP_ERR_TIMEOUT)
     {
         ESP_LOGE(TAG, "Get ოპერაციისთვის service registry mutex-ის დაკავება ვერ მოხერხდა.");
         return NULL;
     }
 
-    service_handle_t found_handle = NULL;
-    service_entry_t *it;
-    SLIST_FOREACH(it, &service_registry_head, entries) {
-        if (strcmp(it->name, service_name) == 0) {
-            found_handle = it->service_handle;
-            break;
-        }
-    }
+    service_handle_t found_handle = it ? it->service_handle : NULL;
 
     xSemaphoreGive(service_registry_mutex);
 
@@ -328,6 +410,79 @@ service_handle_t synapse_service_get(const char *service_name)
     return found_handle;
 }
 
+esp_err_t synapse_service_resolve(const char *service_name, synapse_service_token_t *token_out)
+{
+    if (!service_name || !token_out)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *token_out = SYNAPSE_SERVICE_TOKEN_INVALID;
+
+    service_entry_t *it = NULL;
+    esp_err_t result = lock_and_find(service_name, pdMS_TO_TICKS(CONFIG_SYNAPSE_SEMAPHORE_TIMEOUT_MS), &it);
+    if (result == ESP_ERR_TIMEOUT)
+    {
+        ESP_LOGE(TAG, "Resolve ოპერაციისთვის service registry mutex-ის დაკავება ვერ მოხერხდა.");
+        return ESP_ERR_TIMEOUT;
+    }
+
+    if (it)
+    {
+        token_out->slot = (uint16_t)(it - s_service_slots);
+        token_out->generation = it->generation;
+    }
+
+    xSemaphoreGive(service_registry_mutex);
+
+    // გამოტოვებული სერვისი აქ ნორმალური შემთხვევაა (არჩევითი დამოკიდებულება)
+    ESP_LOGD(TAG, "Resolve '%s': %s.", service_name, esp_err_to_name(result));
+    return result;
+}
+
+service_handle_t synapse_service_token_get(const synapse_service_token_t *token)
+{
+    if (!token || (token->generation & 1U) == 0 || token->slot >= SERVICE_SLOT_COUNT)
+    {
+        return NULL;
+    }
+
+    service_entry_t *entry = &s_service_slots[token->slot];
+    if (__atomic_load_n(&entry->generation, __ATOMIC_ACQUIRE) != token->generation)
+    {
+        return NULL;
+    }
+    service_handle_t handle = __atomic_load_n(&entry->service_handle, __ATOMIC_RELAXED);
+
+    // handle ამ თაობას ეკუთვნის მხოლოდ მაშინ, თუ თაობა წაკითხვის შემდეგაც იგივეა
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&entry->generation, __ATOMIC_RELAXED) != token->generation)
+    {
+        return NULL;
+    }
+    return handle;
+}
+
+service_handle_t synapse_service_get_cached(const char *service_name, synapse_service_token_t *token)
+{
+    if (!token)
+    {
+        return NULL;
+    }
+
+    service_handle_t handle = synapse_service_token_get(token);
+    if (handle)
+    {
+        return handle;
+    }
+
+    // token ცარიელია ან მოძველდა - ერთხელ ვეძებთ ხელახლა
+    if (synapse_service_resolve(service_name, token) != ESP_OK)
+    {
+        return NULL;
+    }
+    return synapse_service_token_get(token);
+}
+
 esp_err_t synapse_service_get_type(const char *service_name, synapse_service_type_t *out_service_type)
 {
     if (!service_name || !out_service_type) {
@@ -335,20 +490,16 @@ esp_err_t synapse_service_get_type(const char *service_name, synapse_service_typ
         return ESP_ERR_INVALID_ARG;
     }
 
-    if (xSemaphoreTake(service_registry_mutex, pdMS_TO_TICKS(CONFIG_SYNAPSE_SEMAPHORE_TIMEOUT_MS)) != pdTRUE)
+    service_entry_t *it = NULL;
+    if (lock_and_find(service_name, pdMS_TO_TICKS(CONFIG_SYNAPSE_SEMAPHORE_TIMEOUT_MS), &it) == ESP_ERR_TIMEOUT)
     {
         ESP_LOGE(TAG, "Get_type ოპერაციისთვის service registry mutex-ის დაკავება ვერ მოხერხდა.");
         return ESP_ERR_TIMEOUT;
     }
 
-    bool found = false;
-    service_entry_t *it;
-    SLIST_FOREACH(it, &service_registry_head, entries) {
-        if (strcmp(it->name, service_name) == 0) {
-            *out_service_type = it->type;
-            found = true;
-            break;
-        }
+    bool found = (it != NULL);
+    if (found) {
+        *out_service_type = it->type;
     }
 
     xSemaphoreGive(service_registry_mutex);
@@ -373,14 +524,16 @@ service_handle_t synapse_service_lookup_by_type(synapse_service_type_t service_t
         return NULL;
     }
 
+    // ტიპით ძებნა სრულ გადარჩევას მოითხოვს; როგორც ადრე, ბრუნდება ბოლოს რეგისტრირებული
     service_handle_t found_handle = NULL;
-    service_entry_t *it;
-    SLIST_FOREACH(it, &service_registry_head, entries) {
-        // ⭐️ მთავარი შესწორება: პირდაპირი შედარება
-        if (it->type == service_type)
+    uint32_t found_sequence = 0;
+    for (int i = 0; i < SERVICE_SLOT_COUNT; i++)
+    {
+        const service_entry_t *it = &s_service_slots[i];
+        if ((it->generation & 1U) && it->type == service_type && it->sequence > found_sequence)
         {
             found_handle = it->service_handle;
-            break; // დავაბრუნოთ პირველი ნაპოვნი
+            found_sequence = it->sequence;
         }
     }
 
@@ -394,4 +547,4 @@ service_handle_t synapse_service_lookup_by_type(synapse_service_type_t service_t
     }
 
     return found_handle;
-}
\ No newline at end of file
+}
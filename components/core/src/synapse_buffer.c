@@ -0,0 +1,285 @@
+/**
+ * @file synapse_buffer.c
+ * @brief Reference-counted ბუფერებისა და zero-copy ნაჭრების იმპლემენტაცია.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-10-09
+ * @details ბუფერი შედგება თავისგან (`synapse_buffer_t`) და მონაცემებისგან.
+ *          `create`/`copy` ორივეს ერთ ბლოკში გამოყოფს `synapse_pool`-იდან (მონაცემები
+ *          თავის უშუალოდ შემდეგ იწყება); `adopt` მხოლოდ თავს გამოყოფს და გარე
+ *          მეხსიერებაზე მიუთითებს. reference counter-ის სემანტიკა იგივეა, რაც
+ *          `event_data_wrapper`-ში: `acquire` - relaxed ზრდა, `release` - acq_rel კლება.
+ */
+
+#include "synapse_buffer.h"
+#include "logging.h"
+#include "synapse_pool.h"
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+
+DEFINE_COMPONENT_TAG("SYNAPSE_BUFFER", SYNAPSE_LOG_COLOR_BLUE);
+
+/**
+ * @internal
+ * @brief ბუფერის თავი.
+ */
+struct synapse_buffer_t
+{
+    int32_t ref_count;              /**< @brief ატომური reference counter. */
+    uint32_t length;                /**< @brief მონაცემების ზომა ('\0'-ის გარეშე). */
+    const uint8_t *data;            /**< @brief მონაცემები (`inline_data` ან გარე მეხსიერება). */
+    void (*free_fn)(void *data);    /**< @brief გარე მონაცემების გამათავისუფლებელი (`adopt`), ან NULL. */
+    uint8_t inline_data[];          /**< @brief ჩაშენებული მონაცემები (`create`/`copy`). */
+};
+
+/** @internal @brief მრიცხველები (იხ. `synapse_buffer_stats_t`). */
+static synapse_buffer_stats_t s_stats;
+
+// --- Internal Helper Functions ---
+
+/**
+ * @internal
+ * @brief ითვლის ახალ ბუფერს მრიცხველებში.
+ */
+static void stats_on_create(uint32_t length)
+{
+    __atomic_fetch_add(&s_stats.live_buffers, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&s_stats.created, 1, __ATOMIC_RELAXED);
+
+    uint32_t live = __atomic_add_fetch(&s_stats.live_bytes, length, __ATOMIC_RELAXED);
+    uint32_t peak = __atomic_load_n(&s_stats.live_peak, __ATOMIC_RELAXED);
+    while (live > peak && !__atomic_compare_exchange_n(&s_stats.live_peak, &peak, live, true,
+                                                       __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+}
+
+/**
+ * @internal
+ * @brief ამოწმებს `[offset, offset + length)` დიაპაზონს `available` ბაიტის ფარგლებში.
+ * @details `length == SIZE_MAX` იცვლება დარჩენილი ზომით.
+ */
+static bool resolve_range(size_t available, size_t offset, size_t *length)
+{
+    if (offset > available)
+    {
+        return false;
+    }
+    if (*length == SIZE_MAX)
+    {
+        *length = available - offset;
+    }
+    return *length <= available - offset;
+}
+
+// --- Public API Implementation ---
+
+esp_err_t synapse_buffer_create(size_t length, synapse_buffer_t **buffer_out, uint8_t **data_out)
+{
+    if (!buffer_out || length >= UINT32_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *buffer_out = NULL;
+
+    synapse_buffer_t *buffer = synapse_pool_alloc(sizeof(synapse_buffer_t) + length + 1);
+    if (!buffer)
+    {
+        ESP_LOGE(TAG, "Failed to allocate a buffer of %u bytes.", (unsigned)length);
+        return ESP_ERR_NO_MEM;
+    }
+
+    buffer->ref_count = 1;
+    buffer->length = (uint32_t)length;
+    buffer->data = buffer->inline_data;
+    buffer->free_fn = NULL;
+    buffer->inline_data[length] = '\0';
+    stats_on_create(buffer->length);
+
+    *buffer_out = buffer;
+    if (data_out)
+    {
+        *data_out = buffer->inline_data;
+    }
+    return ESP_OK;
+}
+
+esp_err_t synapse_buffer_copy(const void *data, size_t length, synapse_buffer_t **buffer_out)
+{
+    if (!data && length > 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint8_t *dest = NULL;
+    esp_err_t err = synapse_buffer_create(length, buffer_out, &dest);
+    if (err == ESP_OK && length > 0)
+    {
+        memcpy(dest, data, length);
+    }
+    return err;
+}
+
+esp_err_t synapse_buffer_adopt(void *data, size_t length, void (*free_fn)(void *data), synapse_buffer_t **buffer_out)
+{
+    if (!data || !buffer_out || length >= UINT32_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *buffer_out = NULL;
+
+    synapse_buffer_t *buffer = synapse_pool_alloc(sizeof(synapse_buffer_t));
+    if (!buffer)
+    {
+        ESP_LOGE(TAG, "Failed to allocate a buffer header.");
+        return ESP_ERR_NO_MEM;
+    }
+
+    buffer->ref_count = 1;
+    buffer->length = (uint32_t)length;
+    buffer->data = data;
+    buffer->free_fn = free_fn;
+    stats_on_create(buffer->length);
+
+    *buffer_out = buffer;
+    return ESP_OK;
+}
+
+esp_err_t synapse_buffer_acquire(synapse_buffer_t *buffer)
+{
+    if (!buffer)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // გამომძახებელი უკვე ფლობს reference-ს - საკმარისია relaxed
+    int32_t previous = __atomic_fetch_add(&buffer->ref_count, 1, __ATOMIC_RELAXED);
+    if (previous <= 0)
+    {
+        ESP_LOGE(TAG, "Acquire on released buffer %p (ref_count %" PRId32 ").", buffer, previous);
+        return ESP_ERR_INVALID_STATE;
+    }
+    return ESP_OK;
+}
+
+esp_err_t synapse_buffer_release(synapse_buffer_t *buffer)
+{
+    if (!buffer)
+    {
+        return ESP_OK;
+    }
+
+    int32_t remaining = __atomic_sub_fetch(&buffer->ref_count, 1, __ATOMIC_ACQ_REL);
+    if (remaining > 0)
+    {
+        return ESP_OK;
+    }
+    if (remaining < 0)
+    {
+        ESP_LOGE(TAG, "CRITICAL: ref_count for buffer %p dropped below zero!", buffer);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    __atomic_fetch_sub(&s_stats.live_buffers, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_sub(&s_stats.live_bytes, buffer->length, __ATOMIC_RELAXED);
+
+    if (buffer->free_fn)
+    {
+        buffer->free_fn((void *)buffer->data);
+    }
+    synapse_pool_free(buffer);
+    return ESP_OK;
+}
+
+const uint8_t *synapse_buffer_data(const synapse_buffer_t *buffer)
+{
+    return buffer ? buffer->data : NULL;
+}
+
+size_t synapse_buffer_length(const synapse_buffer_t *buffer)
+{
+    return buffer ? buffer->length : 0;
+}
+
+esp_err_t synapse_buffer_slice(synapse_buffer_t *buffer, size_t offset, size_t length, synapse_buffer_slice_t *slice_out)
+{
+    if (!slice_out)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *slice_out = SYNAPSE_BUFFER_SLICE_EMPTY;
+
+    if (!buffer)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!resolve_range(buffer->length, offset, &length))
+    {
+        ESP_LOGW(TAG, "Slice [%u, +%u) is out of range for a buffer of %" PRIu32 " bytes.",
+                 (unsigned)offset, (unsigned)length, buffer->length);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    esp_err_t err = synapse_buffer_acquire(buffer);
+    if (err != ESP_OK)
+    {
+        return err;
+    }
+
+    slice_out->buffer = buffer;
+    slice_out->offset = (uint32_t)offset;
+    slice_out->length = (uint32_t)length;
+    return ESP_OK;
+}
+
+esp_err_t synapse_buffer_slice_sub(const synapse_buffer_slice_t *slice, size_t offset, size_t length,
+                                   synapse_buffer_slice_t *slice_out)
+{
+    if (!slice || !slice->buffer)
+    {
+        if (slice_out)
+        {
+            *slice_out = SYNAPSE_BUFFER_SLICE_EMPTY;
+        }
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!resolve_range(slice->length, offset, &length))
+    {
+        if (slice_out)
+        {
+            *slice_out = SYNAPSE_BUFFER_SLICE_EMPTY;
+        }
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return synapse_buffer_slice(slice->buffer, slice->offset + offset, length, slice_out);
+}
+
+void synapse_buffer_slice_release(synapse_buffer_slice_t *slice)
+{
+    if (!slice || !slice->buffer)
+    {
+        return;
+    }
+    synapse_buffer_release(slice->buffer);
+    *slice = SYNAPSE_BUFFER_SLICE_EMPTY;
+}
+
+esp_err_t synapse_buffer_get_stats(synapse_buffer_stats_t *stats)
+{
+    if (!stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    stats->live_buffers = __atomic_load_n(&s_stats.live_buffers, __ATOMIC_RELAXED);
+    stats->live_bytes = __atomic_load_n(&s_stats.live_bytes, __ATOMIC_RELAXED);
+    stats->live_peak = __atomic_load_n(&s_stats.live_peak, __ATOMIC_RELAXED);
+    stats->created = __atomic_load_n(&s_stats.created, __ATOMIC_RELAXED);
+    return ESP_OK;
+}
+
+void synapse_buffer_reset_stats(void)
+{
+    __atomic_store_n(&s_stats.created, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_stats.live_peak, __atomic_load_n(&s_stats.live_bytes, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+}
@@ -0,0 +1,285 @@
+/**
+ * @file synapse_pool.c
+ * @brief ფიქსირებული ზომის ბლოკების აუზის (slab) იმპლემენტაცია.
+ * @author Giorgi Magradze
+ * @version 1.0.0
+ * @date 2025-10-08
+ * @details თითოეული კლასის ბლოკები სტატიკურ მასივშია (BSS), ამიტომ აუზს
+ *          ინიციალიზაცია არ სჭირდება. ჯერ არგამოყენებული ბლოკები გაიცემა
+ *          `bump` ინდექსით; გათავისუფლებული ბლოკები კი ემატება Treiber-ის სტეკს.
+ *          სტეკის თავი არის ერთი 32-ბიტიანი სიტყვა: ქვედა 16 ბიტი - ბლოკის
+ *          ინდექსი + 1 (0 = ცარიელი), ზედა 16 ბიტი - ვერსია, რომელიც ყოველ
+ *          ცვლილებაზე იზრდება და ABA-ს გამორიცხავს. თავისუფალი ბლოკის პირველი
+ *          ორი ბაიტი ინახავს შემდეგი ბლოკის ინდექსს.
+ */
+
+#include "synapse_pool.h"
+#include "logging.h"
+#include "framework_config.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if CONFIG_SYNAPSE_POOL_ENABLE
+
+DEFINE_COMPONENT_TAG("SYNAPSE_POOL", SYNAPSE_LOG_COLOR_BLUE);
+
+// --- Kconfig Definitions ---
+#define POOL_ALIGN(size) (((size) + 7U) & ~7U)
+#define POOL_SMALL_SIZE POOL_ALIGN(CONFIG_SYNAPSE_POOL_SMALL_BLOCK_SIZE)
+#define POOL_SMALL_COUNT CONFIG_SYNAPSE_POOL_SMALL_BLOCK_COUNT
+#define POOL_MEDIUM_SIZE POOL_ALIGN(CONFIG_SYNAPSE_POOL_MEDIUM_BLOCK_SIZE)
+#define POOL_MEDIUM_COUNT CONFIG_SYNAPSE_POOL_MEDIUM_BLOCK_COUNT
+#define POOL_LARGE_SIZE POOL_ALIGN(CONFIG_SYNAPSE_POOL_LARGE_BLOCK_SIZE)
+#define POOL_LARGE_COUNT CONFIG_SYNAPSE_POOL_LARGE_BLOCK_COUNT
+
+#define POOL_CLASS_COUNT 3
+#define POOL_HEAD_INDEX_MASK 0xFFFFU
+#define POOL_HEAD_TAG_STEP 0x10000U
+
+_Static_assert(POOL_SMALL_SIZE < POOL_MEDIUM_SIZE && POOL_MEDIUM_SIZE < POOL_LARGE_SIZE,
+               "Pool block sizes must grow from small to large");
+
+/**
+ * @internal
+ * @brief ერთი ზომის კლასი.
+ */
+typedef struct
+{
+    uint8_t *blocks;         /**< @brief კლასის უწყვეტი მასივი. */
+    uint16_t block_size;     /**< @brief ბლოკის ზომა (8-ის ჯერადი). */
+    uint16_t block_count;    /**< @brief ბლოკების რაოდენობა. */
+    uint32_t free_head;      /**< @brief თავისუფალი სტეკის თავი: ვერსია << 16 | (ინდექსი + 1). */
+    uint32_t bump;           /**< @brief ჯერ არგაცემული ბლოკების პირველი ინდექსი. */
+    uint32_t in_use;         /**< @brief გამოყოფილი ბლოკები. */
+    uint32_t high_watermark; /**< @brief `in_use`-ის მაქსიმუმი. */
+    uint32_t allocs;         /**< @brief გაცემული ბლოკები. */
+    uint32_t exhausted;      /**< @brief ამოწურვის შემთხვევები. */
+} pool_class_t;
+
+// --- Static Globals ---
+
+static uint8_t s_small_blocks[POOL_SMALL_COUNT ? POOL_SMALL_COUNT * POOL_SMALL_SIZE : 1] __attribute__((aligned(8)));
+static uint8_t s_medium_blocks[POOL_MEDIUM_COUNT ? POOL_MEDIUM_COUNT * POOL_MEDIUM_SIZE : 1] __attribute__((aligned(8)));
+static uint8_t s_large_blocks[POOL_LARGE_COUNT ? POOL_LARGE_COUNT * POOL_LARGE_SIZE : 1] __attribute__((aligned(8)));
+
+/** @internal @brief კლასები ზომის ზრდით. */
+static pool_class_t s_classes[POOL_CLASS_COUNT] = {
+    {.blocks = s_small_blocks, .block_size = POOL_SMALL_SIZE, .block_count = POOL_SMALL_COUNT},
+    {.blocks = s_medium_blocks, .block_size = POOL_MEDIUM_SIZE, .block_count = POOL_MEDIUM_COUNT},
+    {.blocks = s_large_blocks, .block_size = POOL_LARGE_SIZE, .block_count = POOL_LARGE_COUNT},
+};
+
+/** @internal @brief heap-ზე გადამისამართებული გამოყოფები. */
+static uint32_t s_heap_fallbacks = 0;
+
+// --- Internal Helper Functions ---
+
+/**
+ * @internal
+ * @brief `in_use`-ის ზრდა და high-watermark-ის განახლება.
+ */
+static void note_alloc(pool_class_t *pool)
+{
+    uint32_t in_use = __atomic_add_fetch(&pool->in_use, 1, __ATOMIC_RELAXED);
+    uint32_t seen = __atomic_load_n(&pool->high_watermark, __ATOMIC_RELAXED);
+    while (in_use > seen &&
+           !__atomic_compare_exchange_n(&pool->high_watermark, &seen, in_use, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+    __atomic_fetch_add(&pool->allocs, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @internal
+ * @brief იღებს ბლოკს კლასიდან: ჯერ თავისუფალი სტეკიდან, შემდეგ ჯერ არგაცემულებიდან.
+ * @return ბლოკი ან NULL, თუ კლასი ამოწურულია.
+ */
+static void *pool_take(pool_class_t *pool)
+{
+    uint32_t head = __atomic_load_n(&pool->free_head, __ATOMIC_ACQUIRE);
+    while ((head & POOL_HEAD_INDEX_MASK) != 0)
+    {
+        uint8_t *block = pool->blocks + (size_t)((head & POOL_HEAD_INDEX_MASK) - 1) * pool->block_size;
+        // ბლოკი შეიძლება ამ დროს სხვამ აიღოს და გადაწეროს - მაშინ ვერსია შეიცვლება და CAS ჩავარდება
+        uint16_t next = __atomic_load_n((uint16_t *)block, __ATOMIC_RELAXED);
+        uint32_t new_head = ((head + POOL_HEAD_TAG_STEP) & ~POOL_HEAD_INDEX_MASK) | next;
+        if (__atomic_compare_exchange_n(&pool->free_head, &head, new_head, true, __ATOMIC_ACQUIRE,
+                                        __ATOMIC_ACQUIRE))
+        {
+            note_alloc(pool);
+            return block;
+        }
+    }
+
+    uint32_t index = __atomic_load_n(&pool->bump, __ATOMIC_RELAXED);
+    while (index < pool->block_count)
+    {
+        if (__atomic_compare_exchange_n(&pool->bump, &index, index + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            note_alloc(pool);
+            return pool->blocks + (size_t)index * pool->block_size;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @internal
+ * @brief აბრუნებს ბლოკს კლასის თავისუფალ სტეკში.
+ */
+static void pool_give(pool_class_t *pool, uint8_t *block, uint32_t index)
+{
+    uint32_t head = __atomic_load_n(&pool->free_head, __ATOMIC_RELAXED);
+    uint32_t new_head;
+    do
+    {
+        __atomic_store_n((uint16_t *)block, (uint16_t)(head & POOL_HEAD_INDEX_MASK), __ATOMIC_RELAXED);
+        new_head = ((head + POOL_HEAD_TAG_STEP) & ~POOL_HEAD_INDEX_MASK) | (index + 1);
+    } while (!__atomic_compare_exchange_n(&pool->free_head, &head, new_head, true, __ATOMIC_RELEASE,
+                                          __ATOMIC_RELAXED));
+    __atomic_fetch_sub(&pool->in_use, 1, __ATOMIC_RELAXED);
+}
+
+// --- Public API Implementation ---
+
+void *synapse_pool_alloc(size_t size)
+{
+    bool counted = false;
+    for (int i = 0; i < POOL_CLASS_COUNT; i++)
+    {
+        pool_class_t *pool = &s_classes[i];
+        if (size > pool->block_size || pool->block_count == 0)
+        {
+            continue;
+        }
+        void *block = pool_take(pool);
+        if (block)
+        {
+            return block;
+        }
+        // ამოწურვა ითვლება მხოლოდ იმ კლასში, რომელსაც მოთხოვნა ეკუთვნოდა
+        if (!counted)
+        {
+            __atomic_fetch_add(&pool->exhausted, 1, __ATOMIC_RELAXED);
+            counted = true;
+        }
+    }
+
+    __atomic_fetch_add(&s_heap_fallbacks, 1, __ATOMIC_RELAXED);
+    return malloc(size ? size : 1);
+}
+
+void *synapse_pool_calloc(size_t size)
+{
+    void *block = synapse_pool_alloc(size);
+    if (block)
+    {
+        memset(block, 0, size);
+    }
+    return block;
+}
+
+void synapse_pool_free(void *ptr)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    uint8_t *block = (uint8_t *)ptr;
+    for (int i = 0; i < POOL_CLASS_COUNT; i++)
+    {
+        pool_class_t *pool = &s_classes[i];
+        if (block < pool->blocks || block >= pool->blocks + (size_t)pool->block_count * pool->block_size)
+        {
+            continue;
+        }
+        size_t offset = (size_t)(block - pool->blocks);
+        if (offset % pool->block_size != 0)
+        {
+            ESP_LOGE(TAG, "Free of %p: not the start of a %u-byte pool block.", ptr, pool->block_size);
+            return;
+        }
+        pool_give(pool, block, (uint32_t)(offset / pool->block_size));
+        return;
+    }
+
+    free(ptr);
+}
+
+uint8_t synapse_pool_get_class_count(void)
+{
+    return POOL_CLASS_COUNT;
+}
+
+esp_err_t synapse_pool_get_stats(uint8_t class_index, synapse_pool_stats_t *stats)
+{
+    if (class_index >= POOL_CLASS_COUNT || !stats)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const pool_class_t *pool = &s_classes[class_index];
+    stats->block_size = pool->block_size;
+    stats->block_count = pool->block_count;
+    stats->in_use = (uint16_t)__atomic_load_n(&pool->in_use, __ATOMIC_RELAXED);
+    stats->high_watermark = (uint16_t)__atomic_load_n(&pool->high_watermark, __ATOMIC_RELAXED);
+    stats->allocs = __atomic_load_n(&pool->allocs, __ATOMIC_RELAXED);
+    stats->exhausted = __atomic_load_n(&pool->exhausted, __ATOMIC_RELAXED);
+    return ESP_OK;
+}
+
+uint32_t synapse_pool_get_heap_fallbacks(void)
+{
+    return __atomic_load_n(&s_heap_fallbacks, __ATOMIC_RELAXED);
+}
+
+void synapse_pool_reset_stats(void)
+{
+    for (int i = 0; i < POOL_CLASS_COUNT; i++)
+    {
+        pool_class_t *pool = &s_classes[i];
+        __atomic_store_n(&pool->high_watermark, __atomic_load_n(&pool->in_use, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+        __atomic_store_n(&pool->allocs, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&pool->exhausted, 0, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&s_heap_fallbacks, 0, __ATOMIC_RELAXED);
+}
+
+#else // !CONFIG_SYNAPSE_POOL_ENABLE
+
+void *synapse_pool_alloc(size_t size)
+{
+    return malloc(size ? size : 1);
+}
+
+void *synapse_pool_calloc(size_t size)
+{
+    return calloc(1, size ? size : 1);
+}
+
+void synapse_pool_free(void *ptr)
+{
+    free(ptr);
+}
+
+uint8_t synapse_pool_get_class_count(void)
+{
+    return 0;
+}
+
+esp_err_t synapse_pool_get_stats(uint8_t class_index, synapse_pool_stats_t *stats)
+{
+    return ESP_ERR_INVALID_ARG;
+}
+
+uint32_t synapse_pool_get_heap_fallbacks(void)
+{
+    return 0;
+}
+
+void synapse_pool_reset_stats(void)
+{
+}
+
+#endif // CONFIG_SYNAPSE_POOL_ENABLE
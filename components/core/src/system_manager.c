@@ -17,6 +17,7 @@
 
 #include "synapse.h"
 #include "system_manager_interface.h"
+#include "event_static_routes_internal.h"
 
 DEFINE_COMPONENT_TAG("SYSTEM_MANAGER", SYNAPSE_LOG_COLOR_BLUE);
 
@@ -37,6 +38,7 @@ static uint8_t s_registered_module_count = 0;
 // --- Forward declarations for internal functions ---
 static esp_err_t resolve_dependencies_for_module(module_t *module);
 static void temporary_deinit_task(void *pvParameters);
+static void set_service_status_if_registered(const char *service_name, service_status_t status);
 
 // --- Forward declarations for API implementation ---
 static esp_err_t system_manager_get_all_modules_api(const module_t ***modules, uint8_t *count);
@@ -157,20 +159,14 @@ esp_err_t synapse_system_start(void)
             ESP_LOGI(TAG, "Initializing module: '%s' (level %d)", module->name, module->init_level);
 
             // Set status to INITIALIZING only if the service exists
-            if (synapse_service_get(module->name) != NULL)
-            {
-                synapse_service_set_status(module->name, SERVICE_STATUS_INITIALIZING);
-            }
+            set_service_status_if_registered(module->name, SERVICE_STATUS_INITIALIZING);
 
             err = module->base.init(module);
             if (err != ESP_OK)
             {
                 ESP_LOGE(TAG, "Failed to initialize module '%s': %s. Disabling it.", module->name, esp_err_to_name(err));
                 module->status = MODULE_STATUS_ERROR;
-                if (synapse_service_get(module->name) != NULL)
-                {
-                    synapse_service_set_status(module->name, SERVICE_STATUS_ERROR);
-                }
+                set_service_status_if_registered(module->name, SERVICE_STATUS_ERROR);
             }
             else
             {
@@ -192,18 +188,12 @@ esp_err_t synapse_system_start(void)
             {
                 ESP_LOGE(TAG, "Failed to start module '%s': %s", module->name, esp_err_to_name(err));
                 module->status = MODULE_STATUS_ERROR;
-                if (synapse_service_get(module->name) != NULL)
-                {
-                    synapse_service_set_status(module->name, SERVICE_STATUS_ERROR);
-                }
+                set_service_status_if_registered(module->name, SERVICE_STATUS_ERROR);
             }
             else
             {
                 module->status = MODULE_STATUS_RUNNING;
-                if (synapse_service_get(module->name) != NULL)
-                {
-                    synapse_service_set_status(module->name, SERVICE_STATUS_ACTIVE);
-                }
+                set_service_status_if_registered(module->name, SERVICE_STATUS_ACTIVE);
 
                 if (module->base.ui_init)
                 {
@@ -216,8 +206,11 @@ esp_err_t synapse_system_start(void)
 
     ESP_LOGI(TAG, "--- System is running. ---");
 
+    // Command Router (თუ არის) უკვე გაშვებულია - დავამატოთ `trace` ბრძანება
+    synapse_trace_register_command();
+
     ESP_LOGI(TAG, "Publishing SYNAPSE_EVENT_SYSTEM_START_COMPLETE event.");
-    synapse_event_bus_post(SYNAPSE_EVENT_SYSTEM_START_COMPLETE, NULL);
+    synapse_event_bus_post_id(SYNAPSE_EVENT_ID_SYSTEM_START_COMPLETE, NULL);
 
     return ESP_OK;
 }
@@ -305,6 +298,21 @@ static esp_err_t resolve_dependencies_for_module(module_t *module)
     return ESP_OK;
 }
 
+/**
+ * @internal
+ * @brief ცვლის სერვისის სტატუსს მხოლოდ მაშინ, თუ მოდულს სერვისი აქვს დარეგისტრირებული.
+ * @details `synapse_service_resolve()` ვერ პოვნისას WARN-ს არ ლოგავს, ამიტომ
+ *          სერვისის გარეშე მოდულები start-ის დროს ზედმეტ გაფრთხილებებს აღარ იწვევს.
+ */
+static void set_service_status_if_registered(const char *service_name, service_status_t status)
+{
+    synapse_service_token_t token;
+    if (synapse_service_resolve(service_name, &token) == ESP_OK)
+    {
+        synapse_service_set_status(service_name, status);
+    }
+}
+
 // --- Runtime Functions ---
 
 esp_err_t synapse_module_enable(const char *module_name)
@@ -401,11 +409,27 @@ void synapse_system_shutdown(void)
     ESP_LOGW(TAG, "--- GRACEFUL SHUTDOWN INITIATED ---");
 
     // Step 1: Notify all modules about the impending shutdown
-    synapse_event_bus_post(SYNAPSE_EVENT_SYSTEM_SHUTDOWN_REQUESTED, NULL);
+    synapse_event_bus_post_id(SYNAPSE_EVENT_ID_SYSTEM_SHUTDOWN_REQUESTED, NULL);
 
     // Step 2: Provide a short grace period for modules to finish critical tasks
     vTaskDelay(pdMS_TO_TICKS(200));
 
+    // module.json-ის სტატიკური მარშრუტები არ უქმდება deinit-ში - ვხსნით მოდულების გათავისუფლებამდე
+    if (synapse_event_static_routes_clear() != ESP_OK)
+    {
+        ESP_LOGW(TAG, "A dispatcher still uses the static event routes.");
+    }
+
+    // საფოსტო ყუთები ჯერ ასრულებენ რიგში დარჩენილ ივენთებს, შემდეგ ჩერდებიან - deinit-ის შემდეგ მოდულს ვეღარ მიწვდებიან
+    for (int i = 0; i < s_registered_module_count; i++)
+    {
+        module_t *module = (module_t *)s_registered_modules[i];
+        if (module && module->mailbox)
+        {
+            synapse_event_bus_disable_mailbox(module);
+        }
+    }
+
     ESP_LOGI(TAG, "Starting deinitialization of %d modules in reverse order...", s_registered_module_count);
 
     // Step 3: Deinitialize modules in reverse init_level order
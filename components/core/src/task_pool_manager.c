@@ -8,6 +8,7 @@
 #include "task_pool_manager.h"
 #include "task_pool_manager_internal.h"
 #include "logging.h"
+#include "synapse_trace.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
@@ -136,9 +137,10 @@ esp_err_t synapse_task_pool_cancel_job(synapse_job_handle_t handle)
 
         if (found) {
             SLIST_REMOVE(&scheduled_jobs_list, job_to_remove, synapse_job_t, entries);
+            // Log before free: even printing a freed pointer is undefined behaviour
+            ESP_LOGD(TAG, "Cancelled and freed job handle %p", handle);
             free(job_to_remove);
             result = ESP_OK;
-            ESP_LOGD(TAG, "Cancelled and freed job handle %p", handle);
         }
         xSemaphoreGive(job_list_mutex);
     }
@@ -154,7 +156,9 @@ static void worker_task(void* pvParameters)
         if (xQueueReceive(job_execution_queue, &job_to_execute, portMAX_DELAY) == pdPASS) {
             if (job_to_execute && job_to_execute->function) {
                 ESP_LOGD(TAG, "Worker task executing job %p", job_to_execute);
+                SYNAPSE_TRACE(SYNAPSE_TRACE_JOB_START, 0, (uintptr_t)job_to_execute->function);
                 job_to_execute->function(job_to_execute->context);
+                SYNAPSE_TRACE(SYNAPSE_TRACE_JOB_END, 0, (uintptr_t)job_to_execute->function);
             }
 
             // If the job was a one-shot, it's now done. Free it.
@@ -0,0 +1,175 @@
+/**
+ * @file bench_main.c
+ * @brief Command line runner of the Synapse host benchmarks.
+ * @details Usage:
+ *
+ *              synapse_host_bench --list
+ *              synapse_host_bench <case> [--events N] [--subscribers N] [--payload BYTES]
+ *                                        [--producers N] [--wildcards N] [--quick]
+ *
+ *          Prints one JSON object per run on stdout:
+ *          `{"case":..., "variant":..., "options":{...}, "result":{...}}`.
+ *          The exit status is 1 when a check failed, 2 on a usage error.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_bench.h"
+
+#ifndef SYNAPSE_HOST_BENCH_VARIANT
+#define SYNAPSE_HOST_BENCH_VARIANT "default"
+#endif
+
+// --- Cases ---
+
+void bench_case_throughput(bench_options_t *options, cJSON *result);
+void bench_case_isr(bench_options_t *options, cJSON *result);
+void bench_case_refcount(bench_options_t *options, cJSON *result);
+void bench_case_pool(bench_options_t *options, cJSON *result);
+void bench_case_percore(bench_options_t *options, cJSON *result);
+void bench_case_spill(bench_options_t *options, cJSON *result);
+void bench_case_rcu(bench_options_t *options, cJSON *result);
+void bench_case_lanes(bench_options_t *options, cJSON *result);
+void bench_case_batch(bench_options_t *options, cJSON *result);
+void bench_case_patterns(bench_options_t *options, cJSON *result);
+void bench_case_timer(bench_options_t *options, cJSON *result);
+void bench_case_request(bench_options_t *options, cJSON *result);
+void bench_case_mailbox(bench_options_t *options, cJSON *result);
+void bench_case_scratch(bench_options_t *options, cJSON *result);
+void bench_case_buffer(bench_options_t *options, cJSON *result);
+void bench_case_service(bench_options_t *options, cJSON *result);
+
+static const bench_case_t s_cases[] = {
+    {"throughput", "post -> handler throughput, latency percentiles and heap allocations per event", bench_case_throughput},
+    {"isr", "simulated interrupt -> handler latency of post_from_isr (with stream capture running)", bench_case_isr},
+    {"refcount", "event data wrapper wrap/acquire/release cost and concurrent reference counting", bench_case_refcount},
+    {"pool", "fixed-block pool versus malloc: single task, concurrent tasks and wrap/release", bench_case_pool},
+    {"percore", "keyed event with a 200 us handler: serialized and concurrent module on the per-core dispatchers", bench_case_percore},
+    {"spill", "FIFO order of a SPILL-policy event while the spill buffer drains", bench_case_spill},
+    {"rcu", "subscribe/unsubscribe churn during dispatch and the unsubscribe grace-period contract", bench_case_rcu},
+    {"lanes", "critical-lane post -> handler latency while a bulk flood saturates the bulk lane", bench_case_lanes},
+    {"batch", "post_batch versus single posts: producer cost, events/sec, events per wakeup and order", bench_case_batch},
+    {"patterns", "pattern trie match time for 100, 1000 and 5000 pattern subscriptions and pattern delivery", bench_case_patterns},
+    {"timer", "timing wheel: delayed-post accuracy, cancellation and the CPU cost of all timer slots running periodically", bench_case_timer},
+    {"request", "request/reply round trip, a full table of concurrent requests and timeouts", bench_case_request},
+    {"mailbox", "a 5 ms subscriber on the dispatcher versus in an 8-slot mailbox, next to a fast subscriber", bench_case_mailbox},
+    {"scratch", "three temporary buffers per event from the handler scratch arena versus malloc/free", bench_case_scratch},
+    {"buffer", "three consumers keeping parts of one telemetry payload: malloc+memcpy copies versus buffer slices", bench_case_buffer},
+    {"service", "Service Locator lookup by name (first and last of 30 services) versus a cached token, and token invalidation", bench_case_service},
+};
+
+#define CASE_COUNT (sizeof(s_cases) / sizeof(s_cases[0]))
+
+// --- Runner ---
+
+static void print_usage(void)
+{
+    fprintf(stderr,
+            "usage: synapse_host_bench --list\n"
+            "       synapse_host_bench <case> [--events N] [--subscribers N] [--payload BYTES]\n"
+            "                                 [--producers N] [--wildcards N] [--quick]\n");
+}
+
+static bool parse_options(int argc, char **argv, bench_options_t *options)
+{
+    for (int i = 2; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        if (strcmp(arg, "--quick") == 0)
+        {
+            options->quick = true;
+            continue;
+        }
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+        unsigned long value = strtoul(argv[++i], NULL, 0);
+        if (strcmp(arg, "--events") == 0)
+        {
+            options->events = (uint32_t)value;
+        }
+        else if (strcmp(arg, "--subscribers") == 0)
+        {
+            options->subscribers = (uint8_t)value;
+        }
+        else if (strcmp(arg, "--payload") == 0)
+        {
+            options->payload = (uint16_t)value;
+        }
+        else if (strcmp(arg, "--producers") == 0)
+        {
+            options->producers = (uint8_t)value;
+        }
+        else if (strcmp(arg, "--wildcards") == 0)
+        {
+            options->wildcards = (uint8_t)value;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2 && strcmp(argv[1], "--list") == 0)
+    {
+        for (size_t i = 0; i < CASE_COUNT; i++)
+        {
+            printf("%-16s %s\n", s_cases[i].name, s_cases[i].description);
+        }
+        return 0;
+    }
+
+    const bench_case_t *bench_case = NULL;
+    for (size_t i = 0; argc >= 2 && i < CASE_COUNT; i++)
+    {
+        if (strcmp(argv[1], s_cases[i].name) == 0)
+        {
+            bench_case = &s_cases[i];
+        }
+    }
+
+    bench_options_t options = {0};
+    if (!bench_case || !parse_options(argc, argv, &options))
+    {
+        print_usage();
+        return 2;
+    }
+
+    esp_err_t err = bench_core_init();
+    if (err != ESP_OK)
+    {
+        fprintf(stderr, "core init failed: %s\n", esp_err_to_name(err));
+        return 2;
+    }
+
+    cJSON *report = cJSON_CreateObject();
+    cJSON_AddStringToObject(report, "case", bench_case->name);
+    cJSON_AddStringToObject(report, "variant", SYNAPSE_HOST_BENCH_VARIANT);
+    cJSON *result = cJSON_CreateObject();
+    bench_case->run(&options, result);
+    int failures = bench_failures(result);
+
+    // parameters after the case applied its defaults
+    cJSON *json_options = cJSON_AddObjectToObject(report, "options");
+    cJSON_AddNumberToObject(json_options, "events", options.events);
+    cJSON_AddNumberToObject(json_options, "subscribers", options.subscribers);
+    cJSON_AddNumberToObject(json_options, "payload", options.payload);
+    cJSON_AddNumberToObject(json_options, "producers", options.producers);
+    cJSON_AddNumberToObject(json_options, "wildcards", options.wildcards);
+    cJSON_AddBoolToObject(json_options, "quick", options.quick);
+    cJSON_AddItemToObject(report, "result", result);
+
+    char *json = cJSON_PrintUnformatted(report);
+    printf("%s\n", json);
+    free(json);
+    cJSON_Delete(report);
+
+    fflush(stdout);
+    _Exit(failures > 0 ? 1 : 0); // dispatcher tasks are still running
+}
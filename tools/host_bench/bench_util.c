@@ -0,0 +1,175 @@
+/**
+ * @file bench_util.c
+ * @brief Shared helpers of the host benchmark cases (see host_bench.h).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "host_bench.h"
+
+bool bench_check(cJSON *result, bool ok, const char *expression, const char *file, int line)
+{
+    if (ok)
+    {
+        return true;
+    }
+
+    char message[256];
+    const char *base = strrchr(file, '/');
+    snprintf(message, sizeof(message), "%s:%d: %s", base ? base + 1 : file, line, expression);
+    fprintf(stderr, "CHECK FAILED %s\n", message);
+
+    cJSON *failures = cJSON_GetObjectItem(result, "failures");
+    if (!failures)
+    {
+        failures = cJSON_AddArrayToObject(result, "failures");
+    }
+    cJSON_AddItemToArray(failures, cJSON_CreateString(message));
+    return false;
+}
+
+int bench_failures(const cJSON *result)
+{
+    int count = 0;
+    const cJSON *failure = NULL;
+    cJSON_ArrayForEach(failure, cJSON_GetObjectItem(result, "failures"))
+    {
+        count++;
+    }
+    return count;
+}
+
+esp_err_t bench_core_init(void)
+{
+    esp_err_t err = synapse_service_locator_init();
+    if (err == ESP_OK)
+    {
+        err = synapse_event_bus_init();
+    }
+    if (err == ESP_OK)
+    {
+        err = synapse_promise_manager_init();
+    }
+    if (err == ESP_OK)
+    {
+        err = synapse_task_pool_init();
+    }
+    return err;
+}
+
+module_t *bench_module_create(const char *name, module_event_handler_fn handler, void *context)
+{
+    module_t *module = calloc(1, sizeof(module_t));
+    if (!module)
+    {
+        return NULL;
+    }
+    synapse_safe_strncpy(module->name, name, sizeof(module->name));
+    module->status = MODULE_STATUS_RUNNING;
+    module->base.handle_event = handler;
+    module->private_data = context;
+    host_registry_add(module);
+    return module;
+}
+
+bool bench_wait_for(const uint32_t *counter, uint32_t target, uint32_t timeout_ms)
+{
+    int64_t deadline = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+    while (__atomic_load_n(counter, __ATOMIC_ACQUIRE) < target)
+    {
+        if (esp_timer_get_time() > deadline)
+        {
+            return false;
+        }
+        usleep(100);
+    }
+    return true;
+}
+
+void bench_report_allocs(cJSON *result, uint64_t allocs_before, uint32_t operations)
+{
+    uint64_t allocs = host_port_alloc_count() - allocs_before;
+    cJSON_AddNumberToObject(result, "heap_allocs", (double)allocs);
+    cJSON_AddNumberToObject(result, "heap_allocs_per_op", operations ? (double)allocs / operations : 0.0);
+}
+
+void bench_report_bus_stats(cJSON *result)
+{
+    char *json = NULL;
+    if (synapse_event_bus_get_stats_json(&json) == ESP_OK)
+    {
+        cJSON_AddRawToObject(result, "bus", json);
+        free(json);
+    }
+}
+
+bool bench_latency_init(bench_latency_t *latency, uint32_t capacity)
+{
+    latency->samples_ns = malloc((size_t)capacity * sizeof(uint32_t));
+    latency->capacity = latency->samples_ns ? capacity : 0;
+    latency->count = 0;
+    return latency->samples_ns != NULL;
+}
+
+void bench_latency_add(bench_latency_t *latency, uint64_t ns)
+{
+    uint32_t index = __atomic_fetch_add(&latency->count, 1, __ATOMIC_RELAXED);
+    if (index < latency->capacity)
+    {
+        latency->samples_ns[index] = (ns > UINT32_MAX) ? UINT32_MAX : (uint32_t)ns;
+    }
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/** @brief Nearest-rank percentile of a sorted array, in microseconds. */
+static double percentile_us(const uint32_t *sorted, uint32_t count, double fraction)
+{
+    uint32_t rank = (uint32_t)(fraction * count + 0.999999);
+    rank = rank ? rank - 1 : 0;
+    return sorted[rank < count ? rank : count - 1] / 1000.0;
+}
+
+void bench_latency_report(bench_latency_t *latency, cJSON *result, const char *name)
+{
+    uint32_t count = latency->count < latency->capacity ? latency->count : latency->capacity;
+    cJSON *json = cJSON_AddObjectToObject(result, name);
+    cJSON_AddNumberToObject(json, "samples", count);
+    if (count == 0)
+    {
+        return;
+    }
+    qsort(latency->samples_ns, count, sizeof(uint32_t), compare_u32);
+    cJSON_AddNumberToObject(json, "p50", percentile_us(latency->samples_ns, count, 0.50));
+    cJSON_AddNumberToObject(json, "p99", percentile_us(latency->samples_ns, count, 0.99));
+    cJSON_AddNumberToObject(json, "p999", percentile_us(latency->samples_ns, count, 0.999));
+    cJSON_AddNumberToObject(json, "max", latency->samples_ns[count - 1] / 1000.0);
+}
+
+void bench_latency_free(bench_latency_t *latency)
+{
+    free(latency->samples_ns);
+    latency->samples_ns = NULL;
+    latency->capacity = 0;
+}
+
+double bench_time_ns(void (*fn)(void *context), void *context, uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations / 10; i++)
+    {
+        fn(context);
+    }
+    uint64_t start = host_port_now_ns();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        fn(context);
+    }
+    return iterations ? (double)(host_port_now_ns() - start) / iterations : 0.0;
+}
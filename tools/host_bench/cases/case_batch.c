@@ -0,0 +1,151 @@
+/**
+ * @file case_batch.c
+ * @brief `post_batch()` versus single posts: throughput, events per wakeup and order.
+ * @details The same `--events` events (each a wrapper carrying a sequence
+ *          number) are posted twice to a BLOCK-policy event: once with
+ *          `post_id()` per event and once with `post_batch()` in batches of
+ *          `BATCH_ENTRIES`. Each run reports the producer time per event,
+ *          events/sec until the last handler call and `events_per_wakeup`
+ *          (`dispatched / dispatch_batches` of the lane), and checks that
+ *          every event arrives exactly once and in order.
+ *
+ *          The host port's `vTaskSuspendAll()` is a no-op, so the dispatcher
+ *          may wake up in the middle of a batch here; the wakeup reduction
+ *          itself is measured on the device.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_bench.h"
+
+#define BATCH_ENTRIES 16
+
+typedef struct
+{
+    uint32_t last_seq;
+    uint32_t order_violations;
+    uint32_t handled;
+} batch_state_t;
+
+static uint32_t s_freed = 0;
+
+static void free_seq(void *payload)
+{
+    free(payload);
+    __atomic_fetch_add(&s_freed, 1, __ATOMIC_RELEASE);
+}
+
+static void batch_handler(module_t *self, const char *event_name, void *data)
+{
+    batch_state_t *state = self->private_data;
+    event_data_wrapper_t *wrapper = data;
+    uint32_t seq = (wrapper && wrapper->payload) ? *(const uint32_t *)wrapper->payload : 0;
+    if (seq <= state->last_seq)
+    {
+        state->order_violations++;
+    }
+    state->last_seq = seq;
+    if (wrapper)
+    {
+        synapse_event_data_release(wrapper);
+    }
+    __atomic_fetch_add(&state->handled, 1, __ATOMIC_RELEASE);
+}
+
+/** @brief Wraps the sequence numbers 1..count; the caller posts and then releases them. */
+static bool create_wrappers(event_data_wrapper_t **wrappers, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t *seq = malloc(sizeof(*seq));
+        if (!seq)
+        {
+            return false;
+        }
+        *seq = i + 1;
+        if (synapse_event_data_wrap(seq, free_seq, &wrappers[i]) != ESP_OK)
+        {
+            free(seq);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void run_mode(bench_options_t *options, cJSON *result, const char *name, bool batch)
+{
+    batch_state_t state = {0};
+    __atomic_store_n(&s_freed, 0, __ATOMIC_RELAXED);
+    synapse_event_id_t event_id = synapse_event_bus_intern(batch ? "BENCH_BATCH_BATCHED" : "BENCH_BATCH_SINGLE");
+    BENCH_CHECK(result, event_id != SYNAPSE_EVENT_ID_INVALID);
+    BENCH_CHECK(result, synapse_event_bus_set_overflow_policy(event_id, SYNAPSE_EVENT_OVERFLOW_BLOCK, 1000) == ESP_OK);
+    module_t *module = bench_module_create(name, batch_handler, &state);
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id(event_id, module) == ESP_OK);
+
+    event_data_wrapper_t **wrappers = calloc(options->events, sizeof(*wrappers));
+    if (!BENCH_CHECK(result, wrappers && create_wrappers(wrappers, options->events)))
+    {
+        free(wrappers);
+        return;
+    }
+
+    synapse_event_bus_reset_lane_stats();
+    uint64_t start_ns = host_port_now_ns();
+    if (batch)
+    {
+        synapse_event_batch_entry_t entries[BATCH_ENTRIES];
+        for (uint32_t i = 0; i < options->events; i += BATCH_ENTRIES)
+        {
+            size_t count = (options->events - i < BATCH_ENTRIES) ? options->events - i : BATCH_ENTRIES;
+            for (size_t e = 0; e < count; e++)
+            {
+                entries[e] = (synapse_event_batch_entry_t){.event_id = event_id, .data_wrapper = wrappers[i + e]};
+            }
+            BENCH_CHECK(result, synapse_event_bus_post_batch(entries, count, NULL) == ESP_OK);
+        }
+    }
+    else
+    {
+        for (uint32_t i = 0; i < options->events; i++)
+        {
+            BENCH_CHECK(result, synapse_event_bus_post_id(event_id, wrappers[i]) == ESP_OK);
+        }
+    }
+    uint64_t post_ns = host_port_now_ns() - start_ns;
+    BENCH_CHECK(result, bench_wait_for(&state.handled, options->events, 30000));
+    uint64_t elapsed_ns = host_port_now_ns() - start_ns;
+
+    synapse_event_lane_stats_t lane = {0};
+    synapse_event_bus_get_lane_stats(SYNAPSE_EVENT_PRIORITY_NORMAL, &lane);
+    synapse_event_bus_unsubscribe_id(event_id, module);
+    for (uint32_t i = 0; i < options->events; i++)
+    {
+        synapse_event_data_release(wrappers[i]);
+    }
+    free(wrappers);
+
+    cJSON *json = cJSON_AddObjectToObject(result, name);
+    cJSON_AddNumberToObject(json, "handled", __atomic_load_n(&state.handled, __ATOMIC_ACQUIRE));
+    cJSON_AddNumberToObject(json, "post_ns_per_event", (double)post_ns / options->events);
+    cJSON_AddNumberToObject(json, "events_per_sec", elapsed_ns ? (double)options->events * 1e9 / elapsed_ns : 0.0);
+    cJSON_AddNumberToObject(json, "events_per_wakeup", lane.dispatch_batches ? (double)lane.dispatched / lane.dispatch_batches : 0.0);
+    cJSON_AddNumberToObject(json, "order_violations", state.order_violations);
+
+    BENCH_CHECK(result, state.handled == options->events);
+    BENCH_CHECK(result, state.order_violations == 0);
+    // handler-მა, დისპეტჩერმა და გამომქვეყნებელმა თავიანთი reference-ები დააბრუნეს
+    BENCH_CHECK(result, bench_wait_for(&s_freed, options->events, 5000));
+}
+
+void bench_case_batch(bench_options_t *options, cJSON *result)
+{
+    options->events = options->events ? options->events : (options->quick ? 2000 : 100000);
+    options->subscribers = 1;
+    options->producers = 1;
+    options->payload = sizeof(uint32_t);
+
+    cJSON_AddNumberToObject(result, "batch_entries", BATCH_ENTRIES);
+    cJSON_AddNumberToObject(result, "dispatch_batch_size", CONFIG_SYNAPSE_EVENT_DISPATCH_BATCH_SIZE);
+    run_mode(options, result, "single", false);
+    run_mode(options, result, "batch", true);
+}
@@ -0,0 +1,162 @@
+/**
+ * @file case_buffer.c
+ * @brief Sharing telemetry with several consumers: copies versus buffer slices.
+ * @details A telemetry payload is created from one shared buffer of
+ *          `BUFFER_CONSUMERS` ranges. Per "event" every consumer keeps its own
+ *          range, for `BUFFER_RANGE_SMALL` and `BUFFER_RANGE_LARGE` bytes:
+ *          - `copy`: `malloc` + `memcpy` of the range (the `strdup` pattern);
+ *          - `slice`: `synapse_telemetry_payload_get_slice()`.
+ *
+ *          Reported per size: the time per event (`*_ns`), the heap
+ *          allocations per event and the bytes the consumers hold on top of
+ *          the payload (`*_held_bytes`). Slices must not allocate, must point
+ *          at the payload's data, and `live_buffers` must return to its start
+ *          value once the payload is freed.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_bench.h"
+#include "event_payloads.h"
+#include "synapse_buffer.h"
+
+#define BUFFER_CONSUMERS 3
+#define BUFFER_RANGE_SMALL 256
+#define BUFFER_RANGE_LARGE 1024
+
+typedef struct
+{
+    const synapse_telemetry_payload_t *payload;
+    size_t range;
+    size_t held_bytes;
+    bool mismatch;
+} buffer_run_t;
+
+static void copy_event(void *context)
+{
+    buffer_run_t *run = context;
+    const char *json = synapse_telemetry_payload_get_json(run->payload, NULL);
+    char *copies[BUFFER_CONSUMERS];
+    for (int i = 0; i < BUFFER_CONSUMERS; i++)
+    {
+        copies[i] = malloc(run->range + 1);
+        if (copies[i])
+        {
+            memcpy(copies[i], json + i * run->range, run->range);
+            copies[i][run->range] = '\0';
+        }
+    }
+    for (int i = 0; i < BUFFER_CONSUMERS; i++)
+    {
+        free(copies[i]);
+    }
+}
+
+static void slice_event(void *context)
+{
+    buffer_run_t *run = context;
+    synapse_buffer_slice_t slices[BUFFER_CONSUMERS];
+    for (int i = 0; i < BUFFER_CONSUMERS; i++)
+    {
+        if (synapse_telemetry_payload_get_slice(run->payload, i * run->range, run->range, &slices[i]) != ESP_OK)
+        {
+            run->mismatch = true;
+            slices[i] = SYNAPSE_BUFFER_SLICE_EMPTY;
+        }
+    }
+    for (int i = 0; i < BUFFER_CONSUMERS; i++)
+    {
+        synapse_buffer_slice_release(&slices[i]);
+    }
+}
+
+/** @brief Holds one slice per consumer and checks that they point into the payload without new buffers. */
+static void check_slices(buffer_run_t *run, cJSON *result)
+{
+    const char *json = synapse_telemetry_payload_get_json(run->payload, NULL);
+    synapse_buffer_stats_t before = {0};
+    synapse_buffer_get_stats(&before);
+
+    synapse_buffer_slice_t slices[BUFFER_CONSUMERS];
+    for (int i = 0; i < BUFFER_CONSUMERS; i++)
+    {
+        BENCH_CHECK(result, synapse_telemetry_payload_get_slice(run->payload, i * run->range, run->range, &slices[i]) == ESP_OK);
+        BENCH_CHECK(result, (const char *)synapse_buffer_slice_data(&slices[i]) == json + i * run->range);
+        BENCH_CHECK(result, slices[i].length == run->range);
+    }
+    synapse_buffer_stats_t held = {0};
+    synapse_buffer_get_stats(&held);
+    run->held_bytes = held.live_bytes - before.live_bytes;
+    BENCH_CHECK(result, held.live_buffers == before.live_buffers && held.created == before.created);
+    for (int i = 0; i < BUFFER_CONSUMERS; i++)
+    {
+        synapse_buffer_slice_release(&slices[i]);
+    }
+}
+
+static void run_size(bench_options_t *options, cJSON *result, const char *name, size_t range)
+{
+    synapse_buffer_stats_t start = {0};
+    synapse_buffer_get_stats(&start);
+
+    synapse_buffer_t *buffer = NULL;
+    uint8_t *data = NULL;
+    if (!BENCH_CHECK(result, synapse_buffer_create(range * BUFFER_CONSUMERS, &buffer, &data) == ESP_OK))
+    {
+        return;
+    }
+    for (size_t i = 0; i < range * BUFFER_CONSUMERS; i++)
+    {
+        data[i] = (uint8_t)('a' + i % 26);
+    }
+    synapse_telemetry_payload_t *payload = NULL;
+    BENCH_CHECK(result, synapse_telemetry_payload_create_from_buffer("bench", buffer, &payload) == ESP_OK);
+    // payload-ს საკუთარი reference აქვს
+    synapse_buffer_release(buffer);
+    if (!payload)
+    {
+        return;
+    }
+
+    buffer_run_t run = {.payload = payload, .range = range};
+    uint32_t iterations = options->events;
+    // bench_time_ns() ჯერ iterations / 10 გამახურებელ გამოძახებას აკეთებს
+    uint32_t calls = iterations + iterations / 10;
+    uint64_t allocs_before = host_port_alloc_count();
+    double copy_ns = bench_time_ns(copy_event, &run, iterations);
+    uint64_t copy_allocs = host_port_alloc_count() - allocs_before;
+    allocs_before = host_port_alloc_count();
+    double slice_ns = bench_time_ns(slice_event, &run, iterations);
+    uint64_t slice_allocs = host_port_alloc_count() - allocs_before;
+    check_slices(&run, result);
+
+    cJSON *json = cJSON_AddObjectToObject(result, name);
+    cJSON_AddNumberToObject(json, "consumers", BUFFER_CONSUMERS);
+    cJSON_AddNumberToObject(json, "range_bytes", range);
+    cJSON_AddNumberToObject(json, "copy_ns", copy_ns);
+    cJSON_AddNumberToObject(json, "copy_allocs_per_event", (double)copy_allocs / calls);
+    cJSON_AddNumberToObject(json, "copy_held_bytes", BUFFER_CONSUMERS * (range + 1));
+    cJSON_AddNumberToObject(json, "slice_ns", slice_ns);
+    cJSON_AddNumberToObject(json, "slice_allocs_per_event", (double)slice_allocs / calls);
+    cJSON_AddNumberToObject(json, "slice_held_bytes", run.held_bytes);
+
+    BENCH_CHECK(result, !run.mismatch);
+    BENCH_CHECK(result, copy_allocs == (uint64_t)calls * BUFFER_CONSUMERS);
+    BENCH_CHECK(result, slice_allocs == 0);
+    BENCH_CHECK(result, run.held_bytes == 0);
+
+    synapse_telemetry_payload_free(payload);
+    synapse_buffer_stats_t end = {0};
+    synapse_buffer_get_stats(&end);
+    BENCH_CHECK(result, end.live_buffers == start.live_buffers && end.live_bytes == start.live_bytes);
+}
+
+void bench_case_buffer(bench_options_t *options, cJSON *result)
+{
+    options->events = options->events ? options->events : (options->quick ? 10000 : 1000000);
+    options->subscribers = BUFFER_CONSUMERS;
+    options->producers = 1;
+
+    run_size(options, result, "small", BUFFER_RANGE_SMALL);
+    run_size(options, result, "large", BUFFER_RANGE_LARGE);
+}
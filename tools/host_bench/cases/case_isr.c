@@ -0,0 +1,161 @@
+/**
+ * @file case_isr.c
+ * @brief ISR -> handler latency of `synapse_event_bus_post_from_isr()` with a simulated interrupt source.
+ * @details An "interrupt source" task fires `--events` interrupts, one every
+ *          50 µs. Each runs in simulated interrupt context
+ *          (`host_port_isr_enter()`), posts an inline time stamp and ends with
+ *          `portYIELD_FROM_ISR()`, like a GPIO ISR would. A stream capture
+ *          runs at the same time, so the capture path is covered from the ISR
+ *          as well.
+ *
+ *          The checks fail if the ISR path called a task-only FreeRTOS API,
+ *          allocated from the heap, or woke a task (the dispatcher or the
+ *          capture writer) without passing it to `higher_priority_task_woken`.
+ */
+#include <string.h>
+#include <unistd.h>
+
+#include "host_bench.h"
+
+#define ISR_PERIOD_US 50
+
+typedef struct
+{
+    synapse_event_id_t event_id;
+    uint32_t interrupts;
+    uint32_t posted;
+    uint32_t rejected;
+    SemaphoreHandle_t done;
+} isr_source_t;
+
+static bench_latency_t s_latency;
+static uint32_t s_handled = 0;
+
+static void isr_handler(module_t *self, const char *event_name, void *data)
+{
+    event_data_wrapper_t *wrapper = data;
+    if (wrapper && wrapper->payload)
+    {
+        uint64_t fired_ns;
+        memcpy(&fired_ns, wrapper->payload, sizeof(fired_ns));
+        bench_latency_add(&s_latency, host_port_now_ns() - fired_ns);
+        __atomic_fetch_add(&s_handled, 1, __ATOMIC_RELEASE);
+    }
+    if (wrapper)
+    {
+        synapse_event_data_release(wrapper);
+    }
+}
+
+/** @brief The simulated interrupt service routine. */
+static void simulated_isr(isr_source_t *source)
+{
+    BaseType_t woken = pdFALSE;
+    uint64_t fired_ns = host_port_now_ns();
+    if (synapse_event_bus_post_from_isr(source->event_id, &fired_ns, sizeof(fired_ns), &woken) == ESP_OK)
+    {
+        source->posted++;
+    }
+    else
+    {
+        source->rejected++;
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+static void isr_source_task(void *arg)
+{
+    isr_source_t *source = arg;
+    for (uint32_t i = 0; i < source->interrupts; i++)
+    {
+        host_port_isr_enter();
+        simulated_isr(source);
+        host_port_isr_exit();
+        usleep(ISR_PERIOD_US);
+    }
+    xSemaphoreGive(source->done);
+    vTaskDelete(NULL);
+}
+
+static esp_err_t counting_sink_write(void *context, const void *data, size_t size)
+{
+    *(size_t *)context += size;
+    return ESP_OK;
+}
+
+void bench_case_isr(bench_options_t *options, cJSON *result)
+{
+    options->events = options->events ? options->events : (options->quick ? 2000 : 20000);
+    options->subscribers = options->subscribers ? options->subscribers : 1;
+    options->payload = sizeof(uint64_t);
+    options->producers = 1;
+    if (options->subscribers > CONFIG_SYNAPSE_MAX_SUBSCRIBERS_PER_EVENT)
+    {
+        options->subscribers = CONFIG_SYNAPSE_MAX_SUBSCRIBERS_PER_EVENT;
+    }
+
+    isr_source_t source = {
+        .event_id = synapse_event_bus_intern("BENCH_ISR"),
+        .interrupts = options->events,
+        .done = xSemaphoreCreateBinary(),
+    };
+    BENCH_CHECK(result, source.event_id != SYNAPSE_EVENT_ID_INVALID);
+    for (uint8_t i = 0; i < options->subscribers; i++)
+    {
+        BENCH_CHECK(result, synapse_event_bus_subscribe_id(source.event_id, bench_module_create("isr_sub", isr_handler, NULL)) == ESP_OK);
+    }
+    BENCH_CHECK(result, bench_latency_init(&s_latency, options->events * options->subscribers));
+
+    size_t capture_bytes = 0;
+    synapse_event_capture_sink_t sink = {.write = counting_sink_write, .context = &capture_bytes};
+    esp_err_t capture_err = synapse_event_capture_start(&sink);
+    BENCH_CHECK(result, capture_err == ESP_OK || capture_err == ESP_ERR_NOT_SUPPORTED);
+
+    host_port_stats_t before;
+    host_port_get_stats(&before);
+
+    xTaskCreate(isr_source_task, "isr_source", 4096, &source, configMAX_PRIORITIES - 1, NULL);
+    xSemaphoreTake(source.done, portMAX_DELAY);
+    BENCH_CHECK(result, bench_wait_for(&s_handled, source.posted * options->subscribers, 10000));
+
+    host_port_stats_t after;
+    host_port_get_stats(&after);
+
+    synapse_event_capture_stats_t capture = {0};
+    if (capture_err == ESP_OK)
+    {
+        synapse_event_capture_get_stats(&capture);
+        BENCH_CHECK(result, synapse_event_capture_stop() == ESP_OK);
+    }
+
+    cJSON_AddNumberToObject(result, "interrupts", source.interrupts);
+    cJSON_AddNumberToObject(result, "posted", source.posted);
+    cJSON_AddNumberToObject(result, "rejected", source.rejected);
+    cJSON_AddNumberToObject(result, "handled", __atomic_load_n(&s_handled, __ATOMIC_ACQUIRE));
+    bench_latency_report(&s_latency, result, "isr_to_handler_us");
+
+    cJSON *isr = cJSON_AddObjectToObject(result, "isr");
+    cJSON_AddNumberToObject(isr, "heap_allocs", (double)(after.isr_allocs - before.isr_allocs));
+    cJSON_AddNumberToObject(isr, "task_api_calls", (double)(after.isr_api_violations - before.isr_api_violations));
+    cJSON_AddNumberToObject(isr, "woken_reported", (double)(after.isr_woken_reported - before.isr_woken_reported));
+    cJSON_AddNumberToObject(isr, "woken_lost", (double)(after.isr_woken_lost - before.isr_woken_lost));
+    cJSON_AddNumberToObject(isr, "yield_requests", (double)(after.isr_yield_requests - before.isr_yield_requests));
+
+    cJSON *json_capture = cJSON_AddObjectToObject(result, "capture");
+    cJSON_AddBoolToObject(json_capture, "enabled", capture_err == ESP_OK);
+    cJSON_AddNumberToObject(json_capture, "captured", capture.captured);
+    cJSON_AddNumberToObject(json_capture, "dropped", capture.dropped);
+
+    BENCH_CHECK(result, source.posted > 0);
+    BENCH_CHECK(result, __atomic_load_n(&s_handled, __ATOMIC_ACQUIRE) == source.posted * options->subscribers);
+    BENCH_CHECK(result, after.isr_allocs == before.isr_allocs);
+    BENCH_CHECK(result, after.isr_api_violations == before.isr_api_violations);
+    BENCH_CHECK(result, after.isr_woken_lost == before.isr_woken_lost);
+    BENCH_CHECK(result, after.isr_yield_requests > before.isr_yield_requests);
+    if (capture_err == ESP_OK)
+    {
+        BENCH_CHECK(result, capture.captured + capture.dropped == source.posted + source.rejected);
+        BENCH_CHECK(result, capture.captured > 0);
+    }
+    bench_latency_free(&s_latency);
+}
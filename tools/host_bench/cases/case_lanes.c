@@ -0,0 +1,157 @@
+/**
+ * @file case_lanes.c
+ * @brief Critical-lane latency while the bulk lane is saturated.
+ * @details A flood task posts a BULK event without pause; its handler takes
+ *          ~`LANES_BULK_HANDLER_US`, so the bulk queue stays full and the
+ *          DROP_NEWEST policy rejects the excess. Meanwhile `--events`
+ *          CRITICAL events are posted one per millisecond, each carrying its
+ *          post time stamp.
+ *
+ *          Every critical event must be delivered and its median latency
+ *          must stay below that of the bulk events, which wait behind a full
+ *          queue. The host port ignores task priorities, so the result shows
+ *          the effect of the separate lane queues alone; on the device the
+ *          higher dispatcher priority adds to it. The lane counters and
+ *          percentiles of the bus are reported as `critical_lane` and
+ *          `bulk_lane`.
+ */
+#include <string.h>
+#include <unistd.h>
+
+#include "host_bench.h"
+
+#define LANES_BULK_HANDLER_US 50
+#define LANES_CRITICAL_GAP_US 1000
+
+static bench_latency_t s_critical_latency;
+static bench_latency_t s_bulk_latency;
+static uint32_t s_critical_handled = 0;
+static uint32_t s_bulk_stop = 0;
+static uint32_t s_bulk_posted = 0;
+
+static void lanes_handler(module_t *self, const char *event_name, void *data)
+{
+    event_data_wrapper_t *wrapper = data;
+    bool critical = self->private_data != NULL;
+    if (wrapper && wrapper->payload)
+    {
+        uint64_t posted_ns;
+        memcpy(&posted_ns, wrapper->payload, sizeof(posted_ns));
+        bench_latency_add(critical ? &s_critical_latency : &s_bulk_latency, host_port_now_ns() - posted_ns);
+    }
+    if (critical)
+    {
+        __atomic_fetch_add(&s_critical_handled, 1, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        usleep(LANES_BULK_HANDLER_US);
+    }
+    if (wrapper)
+    {
+        synapse_event_data_release(wrapper);
+    }
+}
+
+static void bulk_flood(void *arg)
+{
+    synapse_event_id_t event_id = *(synapse_event_id_t *)arg;
+    while (!__atomic_load_n(&s_bulk_stop, __ATOMIC_ACQUIRE))
+    {
+        uint64_t now = host_port_now_ns();
+        if (synapse_event_bus_post_inline(event_id, &now, sizeof(now)) == ESP_OK)
+        {
+            __atomic_fetch_add(&s_bulk_posted, 1, __ATOMIC_RELAXED);
+        }
+        else
+        {
+            usleep(5); // რიგი სავსეა - DROP_NEWEST
+        }
+    }
+    __atomic_store_n(&s_bulk_stop, 2, __ATOMIC_RELEASE);
+    vTaskDelete(NULL);
+}
+
+static void report_lane(cJSON *result, const char *name, synapse_event_priority_t priority)
+{
+    synapse_event_lane_stats_t lane = {0};
+    synapse_event_latency_stats_t latency = {0};
+    synapse_event_bus_get_lane_stats(priority, &lane);
+    cJSON *json = cJSON_AddObjectToObject(result, name);
+    cJSON_AddNumberToObject(json, "posted", lane.posted);
+    cJSON_AddNumberToObject(json, "dispatched", lane.dispatched);
+    cJSON_AddNumberToObject(json, "dropped", lane.dropped);
+    cJSON_AddNumberToObject(json, "max_latency_us", lane.max_latency_us);
+    if (synapse_event_bus_get_latency_stats(priority, &latency) == ESP_OK)
+    {
+        cJSON_AddNumberToObject(json, "p50_us", latency.p50_us);
+        cJSON_AddNumberToObject(json, "p99_us", latency.p99_us);
+    }
+}
+
+void bench_case_lanes(bench_options_t *options, cJSON *result)
+{
+    options->events = options->events ? options->events : (options->quick ? 200 : 5000);
+    options->subscribers = 1;
+    options->producers = 2;
+    options->payload = sizeof(uint64_t);
+
+    synapse_event_id_t critical_id = synapse_event_bus_intern("BENCH_LANES_CRITICAL");
+    synapse_event_id_t bulk_id = synapse_event_bus_intern("BENCH_LANES_BULK");
+    BENCH_CHECK(result, critical_id != SYNAPSE_EVENT_ID_INVALID && bulk_id != SYNAPSE_EVENT_ID_INVALID);
+    BENCH_CHECK(result, synapse_event_bus_set_default_priority(critical_id, SYNAPSE_EVENT_PRIORITY_CRITICAL) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_set_default_priority(bulk_id, SYNAPSE_EVENT_PRIORITY_BULK) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_set_overflow_policy(bulk_id, SYNAPSE_EVENT_OVERFLOW_DROP_NEWEST, 0) == ESP_OK);
+    // private_data != NULL ნიშნავს კრიტიკულ მოდულს
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id(critical_id, bench_module_create("lanes_critical", lanes_handler, &s_critical_handled)) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id(bulk_id, bench_module_create("lanes_bulk", lanes_handler, NULL)) == ESP_OK);
+
+    if (!BENCH_CHECK(result, bench_latency_init(&s_critical_latency, options->events) &&
+                                 bench_latency_init(&s_bulk_latency, options->events * 64)))
+    {
+        return;
+    }
+
+    synapse_event_bus_reset_lane_stats();
+    xTaskCreate(bulk_flood, "lanes_bulk", 4096, &bulk_id, 5, NULL);
+    usleep(20000); // bulk რიგი ჯერ უნდა გაივსოს
+
+    uint32_t critical_posted = 0;
+    for (uint32_t i = 0; i < options->events; i++)
+    {
+        uint64_t now = host_port_now_ns();
+        if (synapse_event_bus_post_inline(critical_id, &now, sizeof(now)) == ESP_OK)
+        {
+            critical_posted++;
+        }
+        usleep(LANES_CRITICAL_GAP_US);
+    }
+    BENCH_CHECK(result, bench_wait_for(&s_critical_handled, critical_posted, 5000));
+
+    __atomic_store_n(&s_bulk_stop, 1, __ATOMIC_RELEASE);
+    while (__atomic_load_n(&s_bulk_stop, __ATOMIC_ACQUIRE) != 2)
+    {
+        usleep(100);
+    }
+
+    synapse_event_lane_stats_t bulk = {0};
+    synapse_event_bus_get_lane_stats(SYNAPSE_EVENT_PRIORITY_BULK, &bulk);
+    report_lane(result, "critical_lane", SYNAPSE_EVENT_PRIORITY_CRITICAL);
+    report_lane(result, "bulk_lane", SYNAPSE_EVENT_PRIORITY_BULK);
+    cJSON_AddNumberToObject(result, "critical_posted", critical_posted);
+    cJSON_AddNumberToObject(result, "critical_handled", __atomic_load_n(&s_critical_handled, __ATOMIC_ACQUIRE));
+    cJSON_AddNumberToObject(result, "bulk_posted", __atomic_load_n(&s_bulk_posted, __ATOMIC_RELAXED));
+    bench_latency_report(&s_critical_latency, result, "critical_latency");
+    bench_latency_report(&s_bulk_latency, result, "bulk_latency");
+
+    BENCH_CHECK(result, critical_posted == options->events);
+    BENCH_CHECK(result, s_critical_handled == critical_posted);
+    BENCH_CHECK(result, bulk.dropped > 0);
+
+    cJSON *critical_p50 = cJSON_GetObjectItem(cJSON_GetObjectItem(result, "critical_latency"), "p50");
+    cJSON *bulk_p50 = cJSON_GetObjectItem(cJSON_GetObjectItem(result, "bulk_latency"), "p50");
+    BENCH_CHECK(result, critical_p50 && bulk_p50 && critical_p50->valuedouble < bulk_p50->valuedouble);
+
+    bench_latency_free(&s_critical_latency);
+    bench_latency_free(&s_bulk_latency);
+}
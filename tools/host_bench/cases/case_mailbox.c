@@ -0,0 +1,183 @@
+/**
+ * @file case_mailbox.c
+ * @brief A slow subscriber with and without a mailbox, next to a fast one.
+ * @details One event has two subscribers: a fast module and a slow one whose
+ *          handler takes `MAILBOX_SLOW_HANDLER_MS`. `--events` events are
+ *          posted back to back, twice:
+ *          - `direct`: both handlers run on the dispatcher, so the fast module
+ *            receives the last event only after the slow handler has run for
+ *            every event before it;
+ *          - `mailbox`: the slow module has a `MAILBOX_LENGTH`-slot mailbox
+ *            (`block_timeout_ms` = 0). The fast module must receive every
+ *            event well before the slow one is done. The slow module handles
+ *            what fits and drops the rest, in order, before the mailbox is
+ *            disabled again.
+ *
+ *          Reported per run: the time until the fast module has seen all
+ *          events (`fast_done_ms`), and the slow module's `handled`,
+ *          `dropped`, `high_watermark` and `max_wait_us`.
+ *
+ *          Finally (`unsubscribe`) the slow module unsubscribes while its
+ *          handler runs and `MAILBOX_LENGTH` more events are queued: the
+ *          call must wait for the running handler only, and the queued events
+ *          must be dropped without a handler call.
+ */
+#include <string.h>
+#include <unistd.h>
+
+#include "host_bench.h"
+
+#define MAILBOX_SLOW_HANDLER_MS 5
+#define MAILBOX_LENGTH 8
+
+typedef struct
+{
+    uint32_t handled;
+    uint32_t last_seq;
+    uint32_t order_violations;
+    bool slow;
+} mailbox_module_t;
+
+static void mailbox_handler(module_t *self, const char *event_name, void *data)
+{
+    mailbox_module_t *state = self->private_data;
+    event_data_wrapper_t *wrapper = data;
+    uint32_t seq = 0;
+    if (wrapper && wrapper->payload)
+    {
+        memcpy(&seq, wrapper->payload, sizeof(seq));
+    }
+    if (seq <= state->last_seq)
+    {
+        state->order_violations++;
+    }
+    state->last_seq = seq;
+    if (state->slow)
+    {
+        usleep(MAILBOX_SLOW_HANDLER_MS * 1000);
+    }
+    if (wrapper)
+    {
+        synapse_event_data_release(wrapper);
+    }
+    __atomic_fetch_add(&state->handled, 1, __ATOMIC_RELEASE);
+}
+
+static void run_mode(bench_options_t *options, cJSON *result, const char *name, bool mailbox)
+{
+    mailbox_module_t fast_state = {0};
+    mailbox_module_t slow_state = {.slow = true};
+    module_t *fast = bench_module_create("mailbox_fast", mailbox_handler, &fast_state);
+    module_t *slow = bench_module_create("mailbox_slow", mailbox_handler, &slow_state);
+
+    synapse_event_id_t event_id = synapse_event_bus_intern(mailbox ? "BENCH_MAILBOX_QUEUED" : "BENCH_MAILBOX_DIRECT");
+    BENCH_CHECK(result, event_id != SYNAPSE_EVENT_ID_INVALID);
+    BENCH_CHECK(result, synapse_event_bus_set_overflow_policy(event_id, SYNAPSE_EVENT_OVERFLOW_BLOCK, 5000) == ESP_OK);
+    if (mailbox)
+    {
+        synapse_event_mailbox_config_t config = {.queue_length = MAILBOX_LENGTH, .block_timeout_ms = 0};
+        BENCH_CHECK(result, synapse_event_bus_enable_mailbox(slow, &config) == ESP_OK);
+        BENCH_CHECK(result, synapse_event_bus_enable_mailbox(slow, &config) == ESP_ERR_INVALID_STATE);
+    }
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id(event_id, fast) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id(event_id, slow) == ESP_OK);
+    synapse_event_bus_reset_lane_stats();
+
+    uint64_t start_ns = host_port_now_ns();
+    for (uint32_t seq = 1; seq <= options->events; seq++)
+    {
+        BENCH_CHECK(result, synapse_event_bus_post_inline(event_id, &seq, sizeof(seq)) == ESP_OK);
+    }
+    uint32_t timeout_ms = options->events * MAILBOX_SLOW_HANDLER_MS * 4 + 1000;
+    BENCH_CHECK(result, bench_wait_for(&fast_state.handled, options->events, timeout_ms));
+    uint64_t fast_done_ns = host_port_now_ns() - start_ns;
+
+    synapse_event_module_stats_t stats = {0};
+    if (mailbox)
+    {
+        // ყუთის მრიცხველები disable-მდე იკითხება: ის ყუთს ათავისუფლებს
+        uint64_t deadline_ns = host_port_now_ns() + (uint64_t)timeout_ms * 1000000ULL;
+        do
+        {
+            usleep(1000);
+            synapse_event_bus_get_module_stats(slow, &stats);
+        } while (__atomic_load_n(&slow_state.handled, __ATOMIC_ACQUIRE) + stats.dropped < options->events &&
+                 host_port_now_ns() < deadline_ns);
+        BENCH_CHECK(result, stats.mailbox);
+        BENCH_CHECK(result, synapse_event_bus_disable_mailbox(slow) == ESP_OK);
+    }
+    else
+    {
+        BENCH_CHECK(result, bench_wait_for(&slow_state.handled, options->events, timeout_ms));
+        synapse_event_bus_get_module_stats(slow, &stats);
+    }
+    synapse_event_bus_unsubscribe_id(event_id, fast);
+    synapse_event_bus_unsubscribe_id(event_id, slow);
+
+    cJSON *json = cJSON_AddObjectToObject(result, name);
+    cJSON_AddNumberToObject(json, "fast_done_ms", (double)fast_done_ns / 1e6);
+    cJSON_AddNumberToObject(json, "slow_handled", __atomic_load_n(&slow_state.handled, __ATOMIC_ACQUIRE));
+    cJSON_AddNumberToObject(json, "slow_dropped", stats.dropped);
+    cJSON_AddNumberToObject(json, "slow_high_watermark", stats.high_watermark);
+    cJSON_AddNumberToObject(json, "slow_max_wait_us", stats.max_wait_us);
+    cJSON_AddNumberToObject(json, "slow_max_handler_us", stats.max_handler_us);
+
+    BENCH_CHECK(result, fast_state.order_violations == 0 && slow_state.order_violations == 0);
+    if (mailbox)
+    {
+        BENCH_CHECK(result, slow_state.handled + stats.dropped == options->events);
+        BENCH_CHECK(result, stats.high_watermark <= MAILBOX_LENGTH);
+        // ნელი handler-ის სრულ დროზე გაცილებით ადრე
+        BENCH_CHECK(result, fast_done_ns < (uint64_t)options->events * MAILBOX_SLOW_HANDLER_MS * 1000000ULL / 2);
+    }
+    else
+    {
+        BENCH_CHECK(result, slow_state.handled == options->events && stats.dropped == 0);
+        BENCH_CHECK(result, fast_done_ns >= (uint64_t)(options->events - 1) * MAILBOX_SLOW_HANDLER_MS * 1000000ULL);
+    }
+}
+
+static void run_unsubscribe(cJSON *result)
+{
+    mailbox_module_t slow_state = {.slow = true};
+    module_t *slow = bench_module_create("mailbox_unsub", mailbox_handler, &slow_state);
+    synapse_event_id_t event_id = synapse_event_bus_intern("BENCH_MAILBOX_UNSUB");
+    synapse_event_mailbox_config_t config = {.queue_length = MAILBOX_LENGTH, .block_timeout_ms = 0};
+    BENCH_CHECK(result, synapse_event_bus_enable_mailbox(slow, &config) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id(event_id, slow) == ESP_OK);
+
+    // პირველი ივენთის handler-ი მუშაობს, დანარჩენები ყუთში დგას
+    for (uint32_t seq = 1; seq <= MAILBOX_LENGTH + 1; seq++)
+    {
+        BENCH_CHECK(result, synapse_event_bus_post_inline(event_id, &seq, sizeof(seq)) == ESP_OK);
+    }
+    for (int i = 0; i < 1000 && __atomic_load_n(&slow_state.last_seq, __ATOMIC_ACQUIRE) == 0; i++)
+    {
+        usleep(100);
+    }
+    BENCH_CHECK(result, synapse_event_bus_unsubscribe_id(event_id, slow) == ESP_OK);
+    uint32_t handled_at_return = __atomic_load_n(&slow_state.handled, __ATOMIC_ACQUIRE);
+    usleep((MAILBOX_LENGTH + 1) * MAILBOX_SLOW_HANDLER_MS * 1000);
+    uint32_t handled = __atomic_load_n(&slow_state.handled, __ATOMIC_ACQUIRE);
+    BENCH_CHECK(result, synapse_event_bus_disable_mailbox(slow) == ESP_OK);
+
+    cJSON *json = cJSON_AddObjectToObject(result, "unsubscribe");
+    cJSON_AddNumberToObject(json, "handled_at_return", handled_at_return);
+    cJSON_AddNumberToObject(json, "handled_after", handled - handled_at_return);
+    BENCH_CHECK(result, handled_at_return >= 1 && handled_at_return < MAILBOX_LENGTH);
+    BENCH_CHECK(result, handled == handled_at_return);
+}
+
+void bench_case_mailbox(bench_options_t *options, cJSON *result)
+{
+    options->events = options->events ? options->events : (options->quick ? 50 : 500);
+    options->subscribers = 2;
+    options->producers = 1;
+    options->payload = sizeof(uint32_t);
+
+    cJSON_AddNumberToObject(result, "slow_handler_ms", MAILBOX_SLOW_HANDLER_MS);
+    cJSON_AddNumberToObject(result, "mailbox_length", MAILBOX_LENGTH);
+    run_mode(options, result, "direct", false);
+    run_mode(options, result, "mailbox", true);
+    run_unsubscribe(result);
+}
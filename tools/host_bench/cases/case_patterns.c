@@ -0,0 +1,191 @@
+/**
+ * @file case_patterns.c
+ * @brief Pattern trie matching cost against the number of pattern subscriptions.
+ * @details Builds the trie for 100, 1000 and 5000 patterns (`sensor.roomN.+`,
+ *          `devN.*` and `+.xN.value`, one module each) and measures
+ *          `synapse_event_pattern_trie_match()` for a topic that matches one
+ *          pattern and for a topic that matches none. The match time should
+ *          stay nearly flat as the count grows. Every size checks one topic
+ *          per pattern form and that exactly the expected module is returned.
+ *
+ *          A second part subscribes `PATTERNS_BUS_COUNT` patterns through the
+ *          public API and checks that posted events reach exactly the matching
+ *          module, that a posted name nobody receives is not interned, and that
+ *          the trie is freed once the last one unsubscribes.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_bench.h"
+#include "event_pattern_internal.h"
+
+#define PATTERNS_MAX 5000
+#define PATTERNS_BUS_COUNT 200
+#define PATTERNS_MATCH_MAX 8
+
+typedef struct
+{
+    const event_pattern_trie_t *trie;
+    const char *topic;
+} match_args_t;
+
+static char s_patterns[PATTERNS_MAX][24];
+static module_t s_modules[PATTERNS_MAX];
+static uint32_t s_calls[PATTERNS_BUS_COUNT];
+
+static void format_pattern(uint32_t i, char *out, size_t size)
+{
+    switch (i % 3)
+    {
+    case 0:
+        snprintf(out, size, "sensor.room%lu.+", (unsigned long)i);
+        break;
+    case 1:
+        snprintf(out, size, "dev%lu.*", (unsigned long)i);
+        break;
+    default:
+        snprintf(out, size, "+.x%lu.value", (unsigned long)i);
+        break;
+    }
+}
+
+static void match_once(void *context)
+{
+    match_args_t *args = context;
+    module_t *matched[PATTERNS_MATCH_MAX];
+    synapse_event_pattern_trie_match(args->trie, args->topic, matched, PATTERNS_MATCH_MAX, NULL);
+}
+
+/** @brief Returns true if matching `topic` yields exactly the module of pattern `expected`. */
+static bool match_is(const event_pattern_trie_t *trie, const char *topic, uint32_t expected)
+{
+    module_t *matched[PATTERNS_MATCH_MAX];
+    size_t count = synapse_event_pattern_trie_match(trie, topic, matched, PATTERNS_MATCH_MAX, NULL);
+    return count == 1 && matched[0] == &s_modules[expected];
+}
+
+static void run_size(bench_options_t *options, cJSON *result, uint32_t count)
+{
+    event_pattern_entry_t *entries = calloc(count, sizeof(*entries));
+    if (!BENCH_CHECK(result, entries != NULL))
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        entries[i] = (event_pattern_entry_t){.pattern = s_patterns[i], .module = &s_modules[i]};
+    }
+    uint64_t build_start = host_port_now_ns();
+    event_pattern_trie_t *trie = synapse_event_pattern_trie_build(entries, count);
+    uint64_t build_ns = host_port_now_ns() - build_start;
+    free(entries);
+    if (!BENCH_CHECK(result, trie != NULL))
+    {
+        return;
+    }
+
+    // ბოლო სამი pattern - თითო ყოველი ფორმის
+    uint32_t room = ((count - 3) / 3) * 3;
+    char hit[48];
+    char dev_topic[48];
+    char value_topic[48];
+    snprintf(hit, sizeof(hit), "sensor.room%lu.temperature", (unsigned long)room);
+    snprintf(dev_topic, sizeof(dev_topic), "dev%lu.ch1.on", (unsigned long)(room + 1));
+    snprintf(value_topic, sizeof(value_topic), "relay.x%lu.value", (unsigned long)(room + 2));
+    BENCH_CHECK(result, match_is(trie, hit, room));
+    BENCH_CHECK(result, match_is(trie, dev_topic, room + 1));
+    BENCH_CHECK(result, match_is(trie, value_topic, room + 2));
+
+    module_t *matched[PATTERNS_MATCH_MAX];
+    BENCH_CHECK(result, synapse_event_pattern_trie_match(trie, "sensor.hall.temperature.raw", matched, PATTERNS_MATCH_MAX, NULL) == 0);
+
+    uint32_t iterations = options->events;
+    match_args_t hit_args = {.trie = trie, .topic = hit};
+    match_args_t miss_args = {.trie = trie, .topic = "sensor.hall.temperature.raw"};
+    uint32_t nodes = 0;
+    uint32_t bytes = 0;
+    synapse_event_pattern_trie_get_size(trie, &nodes, &bytes);
+
+    char name[16];
+    snprintf(name, sizeof(name), "n%lu", (unsigned long)count);
+    cJSON *json = cJSON_AddObjectToObject(result, name);
+    cJSON_AddNumberToObject(json, "build_us", (double)build_ns / 1000.0);
+    cJSON_AddNumberToObject(json, "match_hit_ns", bench_time_ns(match_once, &hit_args, iterations));
+    cJSON_AddNumberToObject(json, "match_miss_ns", bench_time_ns(match_once, &miss_args, iterations));
+    cJSON_AddNumberToObject(json, "trie_nodes", nodes);
+    cJSON_AddNumberToObject(json, "trie_bytes", bytes);
+    free(trie);
+}
+
+static void bus_handler(module_t *self, const char *event_name, void *data)
+{
+    __atomic_fetch_add((uint32_t *)self->private_data, 1, __ATOMIC_RELEASE);
+}
+
+static void run_bus(cJSON *result)
+{
+    module_t *modules[PATTERNS_BUS_COUNT];
+    for (uint32_t i = 0; i < PATTERNS_BUS_COUNT; i++)
+    {
+        modules[i] = bench_module_create("pattern_sub", bus_handler, &s_calls[i]);
+        BENCH_CHECK(result, synapse_event_bus_subscribe(s_patterns[i], modules[i]) == ESP_OK);
+    }
+
+    synapse_event_pattern_stats_t stats = {0};
+    synapse_event_bus_get_pattern_stats(&stats);
+    BENCH_CHECK(result, stats.patterns == PATTERNS_BUS_COUNT);
+
+    // `+` ზუსტად ერთ სეგმენტს ემთხვევა, ამიტომ ბოლო სახელს გამომწერი არ ჰყავს
+    BENCH_CHECK(result, synapse_event_bus_post("sensor.room3.temperature", NULL) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_post("dev4.ch1.on", NULL) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_post("relay.x5.value", NULL) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_post("sensor.room3.x5.value", NULL) == ESP_OK);
+    for (uint32_t i = 3; i <= 5; i++)
+    {
+        BENCH_CHECK(result, bench_wait_for(&s_calls[i], 1, 5000));
+    }
+    vTaskDelay(pdMS_TO_TICKS(10)); // არასწორად დამთხვეული მოდულიც იმავე მიწოდებაში გამოიძახებოდა
+    // მიმღების გარეშე სახელი სახელების ცხრილში არ ემატება, pattern-ით დამთხვეული კი ემატება
+    BENCH_CHECK(result, synapse_event_bus_find_id("sensor.room3.x5.value") == SYNAPSE_EVENT_ID_INVALID);
+    BENCH_CHECK(result, synapse_event_bus_find_id("relay.x5.value") != SYNAPSE_EVENT_ID_INVALID);
+
+    uint32_t unexpected = 0;
+    for (uint32_t i = 0; i < PATTERNS_BUS_COUNT; i++)
+    {
+        uint32_t expected = (i == 3 || i == 4 || i == 5) ? 1 : 0;
+        if (__atomic_load_n(&s_calls[i], __ATOMIC_ACQUIRE) != expected)
+        {
+            unexpected++;
+        }
+    }
+    cJSON *json = cJSON_AddObjectToObject(result, "bus");
+    cJSON_AddNumberToObject(json, "patterns", stats.patterns);
+    cJSON_AddNumberToObject(json, "trie_nodes", stats.trie_nodes);
+    cJSON_AddNumberToObject(json, "trie_bytes", stats.trie_bytes);
+    cJSON_AddNumberToObject(json, "unexpected_calls", unexpected);
+    BENCH_CHECK(result, unexpected == 0);
+
+    for (uint32_t i = 0; i < PATTERNS_BUS_COUNT; i++)
+    {
+        BENCH_CHECK(result, synapse_event_bus_unsubscribe(s_patterns[i], modules[i]) == ESP_OK);
+    }
+    synapse_event_bus_get_pattern_stats(&stats);
+    BENCH_CHECK(result, stats.patterns == 0 && stats.trie_bytes == 0);
+}
+
+void bench_case_patterns(bench_options_t *options, cJSON *result)
+{
+    options->events = options->events ? options->events : (options->quick ? 2000 : 200000);
+    options->subscribers = 0;
+    options->producers = 1;
+
+    for (uint32_t i = 0; i < PATTERNS_MAX; i++)
+    {
+        format_pattern(i, s_patterns[i], sizeof(s_patterns[i]));
+    }
+    run_size(options, result, 100);
+    run_size(options, result, 1000);
+    run_size(options, result, PATTERNS_MAX);
+    run_bus(result);
+}
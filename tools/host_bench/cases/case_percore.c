@@ -0,0 +1,135 @@
+/**
+ * @file case_percore.c
+ * @brief Per-core dispatch: a keyed event with a slow handler, serialized and concurrent.
+ * @details One event is partitioned over the dispatchers by `PERCORE_KEYS`
+ *          keys and handled by a module whose handler blocks for ~200 µs.
+ *          The case runs `--events` posts twice:
+ *          - `serialized`: a default module. Its handler must never run on
+ *            two dispatchers at once (`max_in_handler` = 1);
+ *          - `concurrent`: a module that called
+ *            `synapse_event_bus_set_module_concurrent()`, so the keys are
+ *            handled in parallel.
+ *
+ *          Both runs check that the sequence number of every key only
+ *          increases and report the elapsed time. Build the `percore`
+ *          variant (`CONFIG_SYNAPSE_EVENT_PER_CORE_DISPATCH=y`) to compare
+ *          one and two dispatchers; the `default` variant has one.
+ */
+#include <string.h>
+#include <unistd.h>
+
+#include "host_bench.h"
+
+#define PERCORE_KEYS 8
+#define PERCORE_HANDLER_US 200
+
+typedef struct
+{
+    uint32_t key;
+    uint32_t seq;
+} percore_sample_t;
+
+typedef struct
+{
+    uint32_t in_handler;
+    uint32_t max_in_handler;
+    uint32_t last_seq[PERCORE_KEYS];
+    uint32_t order_violations;
+    uint32_t handled;
+} percore_module_t;
+
+static uint32_t sample_key(const void *payload)
+{
+    return payload ? ((const percore_sample_t *)payload)->key : 0;
+}
+
+static void percore_handler(module_t *self, const char *event_name, void *data)
+{
+    percore_module_t *state = self->private_data;
+    event_data_wrapper_t *wrapper = data;
+
+    uint32_t inside = __atomic_add_fetch(&state->in_handler, 1, __ATOMIC_ACQ_REL);
+    uint32_t max = __atomic_load_n(&state->max_in_handler, __ATOMIC_RELAXED);
+    while (inside > max &&
+           !__atomic_compare_exchange_n(&state->max_in_handler, &max, inside, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+
+    if (wrapper && wrapper->payload)
+    {
+        percore_sample_t sample;
+        memcpy(&sample, wrapper->payload, sizeof(sample));
+        // ერთი გასაღები ყოველთვის ერთ დისპეტჩერთან მიდის, ამიტომ last_seq[key]-ს ერთი ტასკი წერს
+        if (sample.seq <= state->last_seq[sample.key % PERCORE_KEYS])
+        {
+            __atomic_fetch_add(&state->order_violations, 1, __ATOMIC_RELAXED);
+        }
+        state->last_seq[sample.key % PERCORE_KEYS] = sample.seq;
+    }
+    usleep(PERCORE_HANDLER_US);
+
+    __atomic_fetch_sub(&state->in_handler, 1, __ATOMIC_ACQ_REL);
+    __atomic_fetch_add(&state->handled, 1, __ATOMIC_RELEASE);
+    if (wrapper)
+    {
+        synapse_event_data_release(wrapper);
+    }
+}
+
+/** @brief Posts `events` keyed samples to a new event handled by `module` and adds the run under `name`. */
+static void run_keyed(bench_options_t *options, cJSON *result, const char *name, bool concurrent)
+{
+    percore_module_t state = {0};
+    module_t *module = bench_module_create(name, percore_handler, &state);
+    BENCH_CHECK(result, synapse_event_bus_set_module_concurrent(module, concurrent) == ESP_OK);
+
+    synapse_event_id_t event_id = synapse_event_bus_intern(concurrent ? "BENCH_PERCORE_CONCURRENT" : "BENCH_PERCORE_SERIAL");
+    BENCH_CHECK(result, event_id != SYNAPSE_EVENT_ID_INVALID);
+    BENCH_CHECK(result, synapse_event_bus_set_partition_key(event_id, sample_key) == ESP_OK);
+    synapse_event_bus_set_overflow_policy(event_id, SYNAPSE_EVENT_OVERFLOW_BLOCK, 1000);
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id(event_id, module) == ESP_OK);
+
+    uint64_t start_ns = host_port_now_ns();
+    for (uint32_t i = 1; i <= options->events; i++)
+    {
+        percore_sample_t sample = {.key = i % PERCORE_KEYS, .seq = i};
+        synapse_event_bus_post_inline(event_id, &sample, sizeof(sample));
+    }
+    BENCH_CHECK(result, bench_wait_for(&state.handled, options->events, 60000));
+    uint64_t elapsed_ns = host_port_now_ns() - start_ns;
+    synapse_event_bus_unsubscribe_id(event_id, module);
+
+    cJSON *json = cJSON_AddObjectToObject(result, name);
+    cJSON_AddNumberToObject(json, "handled", __atomic_load_n(&state.handled, __ATOMIC_ACQUIRE));
+    cJSON_AddNumberToObject(json, "elapsed_us", (double)(elapsed_ns / 1000));
+    cJSON_AddNumberToObject(json, "max_in_handler", state.max_in_handler);
+    cJSON_AddNumberToObject(json, "order_violations", state.order_violations);
+
+    BENCH_CHECK(result, state.order_violations == 0);
+    BENCH_CHECK(result, state.max_in_handler <= synapse_event_bus_get_dispatcher_count());
+    if (!concurrent)
+    {
+        BENCH_CHECK(result, state.max_in_handler == 1);
+    }
+}
+
+void bench_case_percore(bench_options_t *options, cJSON *result)
+{
+    options->events = options->events ? options->events : (options->quick ? 400 : 4000);
+    options->subscribers = 1;
+    options->producers = 1;
+    options->payload = sizeof(percore_sample_t);
+
+    cJSON_AddNumberToObject(result, "dispatchers", synapse_event_bus_get_dispatcher_count());
+    cJSON_AddNumberToObject(result, "handler_us", PERCORE_HANDLER_US);
+    run_keyed(options, result, "serialized", false);
+    run_keyed(options, result, "concurrent", true);
+
+    cJSON *dispatched = cJSON_AddArrayToObject(result, "dispatched");
+    for (uint8_t d = 0; d < synapse_event_bus_get_dispatcher_count(); d++)
+    {
+        synapse_event_dispatcher_stats_t stats = {0};
+        synapse_event_bus_get_dispatcher_stats(SYNAPSE_EVENT_PRIORITY_NORMAL, d, &stats);
+        cJSON_AddItemToArray(dispatched, cJSON_CreateNumber(stats.dispatched));
+    }
+}
@@ -0,0 +1,146 @@
+/**
+ * @file case_pool.c
+ * @brief Fixed-block pool (`synapse_pool_alloc`) versus `malloc` for event-sized blocks.
+ * @details Both allocators serve the same `--payload` byte blocks (default 32,
+ *          the size of a wrapper). The case measures:
+ *          - alloc+free in one task;
+ *          - `--producers` tasks (default 4) doing alloc+free at once, each
+ *            holding a few blocks. Every task writes its tag into its blocks
+ *            and checks the tag before freeing, so a block handed out twice
+ *            fails the run;
+ *          - `wrap`+`release` of an event data wrapper, which uses the pool
+ *            when `CONFIG_SYNAPSE_POOL_ENABLE` is set.
+ *
+ *          On a build without the pool, `synapse_pool_alloc()` is a thin
+ *          wrapper around `malloc()`; compare the `default` and `pool`
+ *          variants for the effect on the whole event path.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_bench.h"
+
+#define POOL_HELD_BLOCKS 4
+
+typedef struct
+{
+    void *(*alloc_fn)(size_t size);
+    void (*free_fn)(void *ptr);
+    size_t size;
+    uint32_t iterations;
+    uint32_t corrupted;
+    SemaphoreHandle_t done;
+} pool_worker_t;
+
+typedef struct
+{
+    void *(*alloc_fn)(size_t size);
+    void (*free_fn)(void *ptr);
+    size_t size;
+} pool_op_t;
+
+static void alloc_free(void *context)
+{
+    pool_op_t *op = context;
+    void *block = op->alloc_fn(op->size);
+    __asm__ volatile("" : : "r"(block) : "memory");
+    op->free_fn(block);
+}
+
+static void wrap_release(void *context)
+{
+    static uint32_t payload;
+    event_data_wrapper_t *wrapper = NULL;
+    synapse_event_data_wrap(&payload, NULL, &wrapper);
+    synapse_event_data_release(wrapper);
+}
+
+static void pool_worker(void *arg)
+{
+    pool_worker_t *worker = arg;
+    uint8_t tag = (uint8_t)(uintptr_t)xTaskGetCurrentTaskHandle();
+    void *held[POOL_HELD_BLOCKS] = {0};
+
+    for (uint32_t i = 0; i < worker->iterations; i++)
+    {
+        uint32_t slot = i % POOL_HELD_BLOCKS;
+        if (held[slot])
+        {
+            if (((uint8_t *)held[slot])[0] != tag || ((uint8_t *)held[slot])[worker->size - 1] != tag)
+            {
+                __atomic_fetch_add(&worker->corrupted, 1, __ATOMIC_RELAXED);
+            }
+            worker->free_fn(held[slot]);
+        }
+        held[slot] = worker->alloc_fn(worker->size);
+        if (held[slot])
+        {
+            memset(held[slot], tag, worker->size);
+        }
+    }
+    for (uint32_t slot = 0; slot < POOL_HELD_BLOCKS; slot++)
+    {
+        worker->free_fn(held[slot]);
+    }
+    xSemaphoreGive(worker->done);
+    vTaskDelete(NULL);
+}
+
+/** @brief Runs the concurrent workload with one allocator and adds `{ns_per_op, corrupted}` under `name`. */
+static void run_concurrent(bench_options_t *options, cJSON *result, const char *name,
+                           void *(*alloc_fn)(size_t), void (*free_fn)(void *))
+{
+    pool_worker_t worker = {
+        .alloc_fn = alloc_fn,
+        .free_fn = free_fn,
+        .size = options->payload,
+        .iterations = options->events,
+        .done = xSemaphoreCreateCounting(options->producers, 0),
+    };
+    uint64_t start_ns = host_port_now_ns();
+    for (uint8_t i = 0; i < options->producers; i++)
+    {
+        xTaskCreate(pool_worker, "pool_worker", 4096, &worker, 5, NULL);
+    }
+    for (uint8_t i = 0; i < options->producers; i++)
+    {
+        xSemaphoreTake(worker.done, portMAX_DELAY);
+    }
+    uint64_t elapsed_ns = host_port_now_ns() - start_ns;
+    vSemaphoreDelete(worker.done);
+
+    cJSON *json = cJSON_AddObjectToObject(result, name);
+    cJSON_AddNumberToObject(json, "ns_per_op", (double)elapsed_ns / ((double)options->events * options->producers));
+    cJSON_AddNumberToObject(json, "corrupted", worker.corrupted);
+    BENCH_CHECK(result, worker.corrupted == 0);
+}
+
+void bench_case_pool(bench_options_t *options, cJSON *result)
+{
+    options->events = options->events ? options->events : (options->quick ? 20000 : 1000000);
+    options->payload = options->payload ? options->payload : 32;
+    options->producers = options->producers ? options->producers : 4;
+
+#if defined(CONFIG_SYNAPSE_POOL_ENABLE)
+    cJSON_AddBoolToObject(result, "pool_enabled", true);
+#else
+    cJSON_AddBoolToObject(result, "pool_enabled", false);
+#endif
+
+    pool_op_t pool_op = {synapse_pool_alloc, synapse_pool_free, options->payload};
+    pool_op_t malloc_op = {malloc, free, options->payload};
+
+    synapse_pool_reset_stats();
+    uint64_t allocs_before = host_port_alloc_count();
+    cJSON_AddNumberToObject(result, "pool_alloc_free_ns", bench_time_ns(alloc_free, &pool_op, options->events));
+    cJSON_AddNumberToObject(result, "pool_heap_allocs", (double)(host_port_alloc_count() - allocs_before));
+    cJSON_AddNumberToObject(result, "malloc_alloc_free_ns", bench_time_ns(alloc_free, &malloc_op, options->events));
+
+    allocs_before = host_port_alloc_count();
+    cJSON_AddNumberToObject(result, "wrap_release_ns", bench_time_ns(wrap_release, NULL, options->events));
+    bench_report_allocs(result, allocs_before, options->events + options->events / 10);
+
+    run_concurrent(options, result, "pool_concurrent", synapse_pool_alloc, synapse_pool_free);
+    run_concurrent(options, result, "malloc_concurrent", malloc, free);
+    cJSON_AddNumberToObject(result, "pool_heap_fallbacks", synapse_pool_get_heap_fallbacks());
+}
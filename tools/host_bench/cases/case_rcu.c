@@ -0,0 +1,161 @@
+/**
+ * @file case_rcu.c
+ * @brief Subscription churn against a running dispatcher, and the unsubscribe grace-period contract.
+ * @details A producer posts one event without pause while a churn task
+ *          subscribes and unsubscribes `RCU_CHURN_MODULES` modules `--events`
+ *          times. When `unsubscribe` returns ESP_OK the churn task marks the
+ *          module as released; a handler call on a released module would be
+ *          a call after the grace period (`late_calls`). A last module
+ *          unsubscribes itself from its handler, which must return ESP_OK
+ *          without waiting for its own call to end. Subscribing an already subscribed module, in any
+ *          mode, must return ESP_OK.
+ *
+ *          Reported: mean `unsubscribe` time, events dispatched during the
+ *          churn and the retired blocks left once the churn has stopped.
+ */
+#include <unistd.h>
+
+#include "host_bench.h"
+
+#define RCU_CHURN_MODULES 4
+#define RCU_HANDLER_US 30
+
+typedef struct
+{
+    uint32_t released;
+    uint32_t late_calls;
+    uint32_t calls;
+} rcu_module_t;
+
+static uint32_t s_stop = 0;
+static uint32_t s_posted = 0;
+static esp_err_t s_self_result = ESP_FAIL;
+static uint32_t s_self_calls = 0;
+
+static void rcu_handler(module_t *self, const char *event_name, void *data)
+{
+    rcu_module_t *state = self->private_data;
+    __atomic_fetch_add(&state->calls, 1, __ATOMIC_RELAXED);
+    if (__atomic_load_n(&state->released, __ATOMIC_ACQUIRE))
+    {
+        __atomic_fetch_add(&state->late_calls, 1, __ATOMIC_RELAXED);
+    }
+    usleep(RCU_HANDLER_US); // unsubscribe ხშირად უნდა დაემთხვეს მიმდინარე მიწოდებას
+    if (__atomic_load_n(&state->released, __ATOMIC_ACQUIRE))
+    {
+        __atomic_fetch_add(&state->late_calls, 1, __ATOMIC_RELAXED);
+    }
+}
+
+static void self_unsubscribe_handler(module_t *self, const char *event_name, void *data)
+{
+    if (__atomic_fetch_add(&s_self_calls, 1, __ATOMIC_RELAXED) == 0)
+    {
+        s_self_result = synapse_event_bus_unsubscribe(event_name, self);
+    }
+}
+
+static void rcu_producer(void *arg)
+{
+    synapse_event_id_t event_id = *(synapse_event_id_t *)arg;
+    while (!__atomic_load_n(&s_stop, __ATOMIC_ACQUIRE))
+    {
+        if (synapse_event_bus_post_id(event_id, NULL) == ESP_OK)
+        {
+            __atomic_fetch_add(&s_posted, 1, __ATOMIC_RELAXED);
+        }
+        usleep(20);
+    }
+    __atomic_store_n(&s_stop, 2, __ATOMIC_RELEASE);
+    vTaskDelete(NULL);
+}
+
+void bench_case_rcu(bench_options_t *options, cJSON *result)
+{
+    options->events = options->events ? options->events : (options->quick ? 500 : 20000);
+    options->subscribers = RCU_CHURN_MODULES;
+    options->producers = 1;
+
+    synapse_event_id_t event_id = synapse_event_bus_intern("BENCH_RCU");
+    BENCH_CHECK(result, event_id != SYNAPSE_EVENT_ID_INVALID);
+
+    rcu_module_t states[RCU_CHURN_MODULES] = {0};
+    module_t *modules[RCU_CHURN_MODULES];
+    for (int i = 0; i < RCU_CHURN_MODULES; i++)
+    {
+        modules[i] = bench_module_create("rcu_churn", rcu_handler, &states[i]);
+    }
+
+    xTaskCreate(rcu_producer, "rcu_producer", 4096, &event_id, 5, NULL);
+
+    uint32_t timeouts = 0;
+    uint64_t unsubscribe_ns = 0;
+    for (uint32_t i = 0; i < options->events; i++)
+    {
+        int m = i % RCU_CHURN_MODULES;
+        __atomic_store_n(&states[m].released, 0, __ATOMIC_RELEASE);
+        BENCH_CHECK(result, synapse_event_bus_subscribe_id(event_id, modules[m]) == ESP_OK);
+        usleep(50);
+
+        uint64_t start_ns = host_port_now_ns();
+        esp_err_t err = synapse_event_bus_unsubscribe_id(event_id, modules[m]);
+        unsubscribe_ns += host_port_now_ns() - start_ns;
+        if (err == ESP_OK)
+        {
+            // grace period დასრულდა - ამის შემდეგ handler-ის გამოძახება შეცდომაა
+            __atomic_store_n(&states[m].released, 1, __ATOMIC_RELEASE);
+        }
+        else
+        {
+            timeouts++;
+        }
+    }
+
+    // handler-იდან გაუქმება: საკუთარ გამოძახებას ვერ დაელოდება, მაგრამ წარმატებულია
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id(event_id, bench_module_create("rcu_self", self_unsubscribe_handler, NULL)) == ESP_OK);
+    BENCH_CHECK(result, bench_wait_for(&s_self_calls, 1, 5000));
+
+    __atomic_store_n(&s_stop, 1, __ATOMIC_RELEASE);
+    while (__atomic_load_n(&s_stop, __ATOMIC_ACQUIRE) != 2)
+    {
+        usleep(100);
+    }
+    // შემდეგი unsubscribe ათავისუფლებს handler-იდან გადადებულ ბლოკებს
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id(event_id, modules[0]) == ESP_OK);
+    __atomic_store_n(&states[0].released, 0, __ATOMIC_RELEASE);
+    BENCH_CHECK(result, synapse_event_bus_unsubscribe_id(event_id, modules[0]) == ESP_OK);
+
+    // უკვე გამოწერილი მოდული ყველა რეჟიმში ESP_OK-ს იღებს, როგორც subscribe_id()-ში
+    synapse_event_filter_t filter = {.field = {.type = SYNAPSE_EVENT_FIELD_U8, .value = {.u32 = 1}}};
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id_sync(event_id, modules[1]) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id_sync(event_id, modules[1]) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id_filtered(event_id, modules[2], &filter) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id_filtered(event_id, modules[2], &filter) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id(event_id, modules[2]) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_unsubscribe_id(event_id, modules[1]) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_unsubscribe_id(event_id, modules[2]) == ESP_OK);
+
+    uint32_t late_calls = 0;
+    uint32_t calls = 0;
+    for (int i = 0; i < RCU_CHURN_MODULES; i++)
+    {
+        late_calls += states[i].late_calls;
+        calls += states[i].calls;
+    }
+    synapse_event_memory_stats_t memory = {0};
+    synapse_event_bus_get_memory_stats(&memory);
+
+    cJSON_AddNumberToObject(result, "churn_cycles", options->events);
+    cJSON_AddNumberToObject(result, "unsubscribe_us", options->events ? unsubscribe_ns / 1000.0 / options->events : 0.0);
+    cJSON_AddNumberToObject(result, "posted", __atomic_load_n(&s_posted, __ATOMIC_RELAXED));
+    cJSON_AddNumberToObject(result, "churn_handler_calls", calls);
+    cJSON_AddNumberToObject(result, "late_calls", late_calls);
+    cJSON_AddNumberToObject(result, "unsubscribe_errors", timeouts);
+    cJSON_AddStringToObject(result, "self_unsubscribe", esp_err_to_name(s_self_result));
+    cJSON_AddNumberToObject(result, "retired_blocks", memory.retired_blocks);
+
+    BENCH_CHECK(result, late_calls == 0);
+    BENCH_CHECK(result, timeouts == 0);
+    BENCH_CHECK(result, s_self_result == ESP_OK);
+    BENCH_CHECK(result, memory.retired_blocks == 0);
+}
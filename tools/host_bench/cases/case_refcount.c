@@ -0,0 +1,99 @@
+/**
+ * @file case_refcount.c
+ * @brief Cost and correctness of the atomic reference count in `event_data_wrapper_t`.
+ * @details Measures `wrap`+`release` and `acquire`+`release` in nanoseconds and
+ *          the heap allocations per wrapper. Then `--producers` tasks (default
+ *          4) share one wrapper and each runs `--events` acquire/release
+ *          pairs. The payload must be freed exactly once, after the last
+ *          release, and `refcount_errors` must stay 0.
+ */
+#include "host_bench.h"
+
+typedef struct
+{
+    event_data_wrapper_t *wrapper;
+    uint32_t iterations;
+    SemaphoreHandle_t done;
+} refcount_worker_t;
+
+static uint32_t s_payload = 0;
+static uint32_t s_frees = 0;
+
+static void count_free(void *payload)
+{
+    __atomic_fetch_add(&s_frees, 1, __ATOMIC_RELAXED);
+}
+
+static void wrap_release(void *context)
+{
+    event_data_wrapper_t *wrapper = NULL;
+    synapse_event_data_wrap(&s_payload, NULL, &wrapper);
+    synapse_event_data_release(wrapper);
+}
+
+static void acquire_release(void *context)
+{
+    synapse_event_data_acquire(context);
+    synapse_event_data_release(context);
+}
+
+static void refcount_worker(void *arg)
+{
+    refcount_worker_t *worker = arg;
+    for (uint32_t i = 0; i < worker->iterations; i++)
+    {
+        synapse_event_data_acquire(worker->wrapper);
+        synapse_event_data_release(worker->wrapper);
+    }
+    xSemaphoreGive(worker->done);
+    vTaskDelete(NULL);
+}
+
+void bench_case_refcount(bench_options_t *options, cJSON *result)
+{
+    options->events = options->events ? options->events : (options->quick ? 20000 : 1000000);
+    options->producers = options->producers ? options->producers : 4;
+
+    // 1. single-thread cost
+    uint64_t allocs_before = host_port_alloc_count();
+    cJSON_AddNumberToObject(result, "wrap_release_ns", bench_time_ns(wrap_release, NULL, options->events));
+    bench_report_allocs(result, allocs_before, options->events + options->events / 10);
+
+    event_data_wrapper_t *wrapper = NULL;
+    BENCH_CHECK(result, synapse_event_data_wrap(&s_payload, count_free, &wrapper) == ESP_OK);
+    cJSON_AddNumberToObject(result, "acquire_release_ns", bench_time_ns(acquire_release, wrapper, options->events));
+    cJSON_AddNumberToObject(result, "wrapper_bytes", sizeof(event_data_wrapper_t));
+
+    // 2. concurrent acquire/release on one wrapper
+    synapse_event_data_reset_stats();
+    refcount_worker_t worker = {
+        .wrapper = wrapper,
+        .iterations = options->events,
+        .done = xSemaphoreCreateCounting(options->producers, 0),
+    };
+    uint64_t start_ns = host_port_now_ns();
+    for (uint8_t i = 0; i < options->producers; i++)
+    {
+        xTaskCreate(refcount_worker, "refcount", 4096, &worker, 5, NULL);
+    }
+    for (uint8_t i = 0; i < options->producers; i++)
+    {
+        xSemaphoreTake(worker.done, portMAX_DELAY);
+    }
+    uint64_t elapsed_ns = host_port_now_ns() - start_ns;
+    uint32_t frees_before_last = __atomic_load_n(&s_frees, __ATOMIC_RELAXED);
+    synapse_event_data_release(wrapper);
+
+    synapse_event_data_stats_t stats = {0};
+    synapse_event_data_get_stats(&stats);
+    cJSON *concurrent = cJSON_AddObjectToObject(result, "concurrent");
+    cJSON_AddNumberToObject(concurrent, "threads", options->producers);
+    cJSON_AddNumberToObject(concurrent, "pairs_per_thread", options->events);
+    cJSON_AddNumberToObject(concurrent, "ns_per_pair", (double)elapsed_ns / ((double)options->events * options->producers));
+    cJSON_AddNumberToObject(concurrent, "payload_frees", __atomic_load_n(&s_frees, __ATOMIC_RELAXED));
+    cJSON_AddNumberToObject(concurrent, "refcount_errors", stats.refcount_errors);
+
+    BENCH_CHECK(result, frees_before_last == 0);
+    BENCH_CHECK(result, __atomic_load_n(&s_frees, __ATOMIC_RELAXED) == 1);
+    BENCH_CHECK(result, stats.refcount_errors == 0);
+}
@@ -0,0 +1,181 @@
+/**
+ * @file case_request.c
+ * @brief Request/response: round trip, concurrent requests and timeouts.
+ * @details An echo module replies to every request from its handler.
+ *          - `sequential`: `--events` requests, each sent after the previous
+ *            promise callback ran. Reports the bus round trip (`rtt_*`,
+ *            request to reply) and the time to the `then` callback, which adds
+ *            the Promise Manager queue;
+ *          - `concurrent`: `CONFIG_SYNAPSE_EVENT_REQUEST_MAX_PENDING` requests
+ *            sent at once; all must resolve and none may time out;
+ *          - `timeout`: requests to a silent module fill the pending table,
+ *            so one more returns ESP_ERR_NO_MEM. They are rejected with
+ *            ESP_ERR_TIMEOUT, and a reply after that returns
+ *            ESP_ERR_NOT_FOUND and counts as a late reply.
+ */
+#include "host_bench.h"
+
+#define REQUEST_TIMEOUT_MS 1000
+#define REQUEST_SILENT_TIMEOUT_MS 30
+
+static bench_latency_t s_callback_latency;
+static uint32_t s_resolved = 0;
+static uint32_t s_rejected = 0;
+static uint32_t s_timeouts = 0;
+static uint32_t s_last_correlation = 0;
+
+static void echo_handler(module_t *self, const char *event_name, void *data)
+{
+    event_data_wrapper_t *wrapper = data;
+    if (wrapper && wrapper->correlation_id)
+    {
+        synapse_event_bus_reply(wrapper->correlation_id, NULL, NULL);
+    }
+    if (wrapper)
+    {
+        synapse_event_data_release(wrapper);
+    }
+}
+
+static void silent_handler(module_t *self, const char *event_name, void *data)
+{
+    event_data_wrapper_t *wrapper = data;
+    if (wrapper)
+    {
+        __atomic_store_n(&s_last_correlation, wrapper->correlation_id, __ATOMIC_RELEASE);
+        synapse_event_data_release(wrapper);
+    }
+}
+
+static void on_reply(void *result_data, void *user_context)
+{
+    if (user_context)
+    {
+        bench_latency_add(&s_callback_latency, host_port_now_ns() - *(uint64_t *)user_context);
+    }
+    __atomic_fetch_add(&s_resolved, 1, __ATOMIC_RELEASE);
+}
+
+static void on_error(void *error_data, void *user_context)
+{
+    if (error_data && *(esp_err_t *)error_data == ESP_ERR_TIMEOUT)
+    {
+        __atomic_fetch_add(&s_timeouts, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_fetch_add(&s_rejected, 1, __ATOMIC_RELEASE);
+}
+
+static void report_stats(cJSON *json, const synapse_event_request_stats_t *stats)
+{
+    cJSON_AddNumberToObject(json, "sent", stats->sent);
+    cJSON_AddNumberToObject(json, "replied", stats->replied);
+    cJSON_AddNumberToObject(json, "timed_out", stats->timed_out);
+    cJSON_AddNumberToObject(json, "late_replies", stats->late_replies);
+    cJSON_AddNumberToObject(json, "high_watermark", stats->high_watermark);
+    cJSON_AddNumberToObject(json, "rtt_p50_us", stats->rtt_p50_us);
+    cJSON_AddNumberToObject(json, "rtt_p99_us", stats->rtt_p99_us);
+    cJSON_AddNumberToObject(json, "rtt_max_us", stats->rtt_max_us);
+}
+
+static void run_sequential(bench_options_t *options, cJSON *result)
+{
+    if (!BENCH_CHECK(result, bench_latency_init(&s_callback_latency, options->events)))
+    {
+        return;
+    }
+    synapse_event_bus_reset_request_stats();
+    __atomic_store_n(&s_resolved, 0, __ATOMIC_RELEASE);
+    uint64_t sent_ns = 0;
+    for (uint32_t i = 0; i < options->events; i++)
+    {
+        sent_ns = host_port_now_ns();
+        if (!BENCH_CHECK(result, synapse_event_bus_request("BENCH_REQUEST_ECHO", NULL, REQUEST_TIMEOUT_MS,
+                                                           on_reply, on_error, &sent_ns, NULL) == ESP_OK) ||
+            !BENCH_CHECK(result, bench_wait_for(&s_resolved, i + 1, 2000)))
+        {
+            break;
+        }
+    }
+
+    synapse_event_request_stats_t stats = {0};
+    synapse_event_bus_get_request_stats(&stats);
+    cJSON *json = cJSON_AddObjectToObject(result, "sequential");
+    report_stats(json, &stats);
+    bench_latency_report(&s_callback_latency, json, "callback_latency");
+    bench_latency_free(&s_callback_latency);
+    BENCH_CHECK(result, stats.replied == options->events);
+    BENCH_CHECK(result, stats.timed_out == 0);
+}
+
+static void run_concurrent(cJSON *result)
+{
+    synapse_event_bus_reset_request_stats();
+    synapse_event_request_stats_t stats = {0};
+    synapse_event_bus_get_request_stats(&stats);
+    __atomic_store_n(&s_resolved, 0, __ATOMIC_RELEASE);
+
+    uint32_t sent = 0;
+    for (uint32_t i = 0; i < stats.capacity; i++)
+    {
+        if (synapse_event_bus_request("BENCH_REQUEST_ECHO", NULL, REQUEST_TIMEOUT_MS, on_reply, on_error, NULL, NULL) == ESP_OK)
+        {
+            sent++;
+        }
+    }
+    BENCH_CHECK(result, bench_wait_for(&s_resolved, sent, 5000));
+
+    synapse_event_bus_get_request_stats(&stats);
+    cJSON *json = cJSON_AddObjectToObject(result, "concurrent");
+    report_stats(json, &stats);
+    cJSON_AddNumberToObject(json, "capacity", stats.capacity);
+    BENCH_CHECK(result, sent == stats.capacity);
+    BENCH_CHECK(result, stats.replied == sent && stats.timed_out == 0);
+    BENCH_CHECK(result, stats.high_watermark <= stats.capacity);
+}
+
+static void run_timeout(cJSON *result)
+{
+    synapse_event_bus_reset_request_stats();
+    synapse_event_request_stats_t stats = {0};
+    synapse_event_bus_get_request_stats(&stats);
+    __atomic_store_n(&s_rejected, 0, __ATOMIC_RELEASE);
+
+    for (uint32_t i = 0; i < stats.capacity; i++)
+    {
+        BENCH_CHECK(result, synapse_event_bus_request("BENCH_REQUEST_SILENT", NULL, REQUEST_SILENT_TIMEOUT_MS,
+                                                      on_reply, on_error, NULL, NULL) == ESP_OK);
+    }
+    // ცხრილი სავსეა
+    BENCH_CHECK(result, synapse_event_bus_request("BENCH_REQUEST_SILENT", NULL, REQUEST_SILENT_TIMEOUT_MS,
+                                                  on_reply, on_error, NULL, NULL) == ESP_ERR_NO_MEM);
+    BENCH_CHECK(result, bench_wait_for(&s_rejected, stats.capacity, 5000));
+    uint32_t correlation_id = __atomic_load_n(&s_last_correlation, __ATOMIC_ACQUIRE);
+    BENCH_CHECK(result, correlation_id != 0 && synapse_event_bus_reply(correlation_id, NULL, NULL) == ESP_ERR_NOT_FOUND);
+
+    synapse_event_bus_get_request_stats(&stats);
+    cJSON *json = cJSON_AddObjectToObject(result, "timeout");
+    report_stats(json, &stats);
+    cJSON_AddNumberToObject(json, "timeout_callbacks", s_timeouts);
+    BENCH_CHECK(result, stats.timed_out == stats.capacity);
+    BENCH_CHECK(result, s_timeouts == stats.capacity);
+    BENCH_CHECK(result, stats.late_replies == 1);
+    BENCH_CHECK(result, stats.pending == 0);
+}
+
+void bench_case_request(bench_options_t *options, cJSON *result)
+{
+    options->events = options->events ? options->events : (options->quick ? 500 : 20000);
+    options->subscribers = 1;
+    options->producers = 1;
+
+#if !CONFIG_SYNAPSE_EVENT_TIMER_ENABLE
+    cJSON_AddBoolToObject(result, "skipped", true);
+    return;
+#endif
+
+    BENCH_CHECK(result, synapse_event_bus_subscribe("BENCH_REQUEST_ECHO", bench_module_create("request_echo", echo_handler, NULL)) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_subscribe("BENCH_REQUEST_SILENT", bench_module_create("request_silent", silent_handler, NULL)) == ESP_OK);
+    run_sequential(options, result);
+    run_concurrent(result);
+    run_timeout(result);
+}
@@ -0,0 +1,177 @@
+/**
+ * @file case_scratch.c
+ * @brief Scratch arena versus malloc/free for a handler's temporary buffers.
+ * @details Two parts:
+ *          - `bus`: a handler takes three scratch buffers (48/64/80 bytes) and
+ *            one `scratch_printf()` string per event on the dispatcher. Every
+ *            buffer must be non-NULL and 8-byte aligned, a request larger than
+ *            the arena must return NULL, and the statistics must show the
+ *            allocations, the overflows and a per-event high-watermark.
+ *            The same handler called through `publish_sync()` runs in the
+ *            publisher's task and must get NULL;
+ *          - `cost`: the same three buffers per "event" on the calling task,
+ *            once with `malloc`/`free` and once from a bound arena plus its
+ *            reset (what the dispatcher does after each event).
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_bench.h"
+#include "event_scratch_internal.h"
+
+#define SCRATCH_SIZES {48, 64, 80}
+#define SCRATCH_BUFFERS 3
+
+typedef struct
+{
+    uint32_t handled;
+    uint32_t null_buffers;
+    uint32_t misaligned;
+    uint32_t oversize_granted;
+    uint32_t sync_granted;
+} scratch_state_t;
+
+static scratch_state_t s_state;
+static event_scratch_arena_t s_arena;
+
+static void scratch_handler(module_t *self, const char *event_name, void *data)
+{
+    static const size_t sizes[SCRATCH_BUFFERS] = SCRATCH_SIZES;
+    event_data_wrapper_t *wrapper = data;
+    bool sync = self->private_data != NULL;
+
+    for (int i = 0; i < SCRATCH_BUFFERS; i++)
+    {
+        uint8_t *buffer = synapse_event_scratch_alloc(sizes[i]);
+        if (sync)
+        {
+            s_state.sync_granted += buffer != NULL;
+            continue;
+        }
+        if (!buffer)
+        {
+            s_state.null_buffers++;
+            continue;
+        }
+        if ((uintptr_t)buffer % 8 != 0)
+        {
+            s_state.misaligned++;
+        }
+        memset(buffer, 0xA5, sizes[i]);
+    }
+    if (!sync)
+    {
+        if (!synapse_event_scratch_printf("sensor/%s/value", event_name))
+        {
+            s_state.null_buffers++;
+        }
+        if (synapse_event_scratch_alloc(CONFIG_SYNAPSE_EVENT_SCRATCH_SIZE + 1))
+        {
+            s_state.oversize_granted++;
+        }
+    }
+    if (wrapper)
+    {
+        synapse_event_data_release(wrapper);
+    }
+    __atomic_fetch_add(&s_state.handled, 1, __ATOMIC_RELEASE);
+}
+
+static void malloc_event(void *context)
+{
+    static const size_t sizes[SCRATCH_BUFFERS] = SCRATCH_SIZES;
+    void *buffers[SCRATCH_BUFFERS];
+    for (int i = 0; i < SCRATCH_BUFFERS; i++)
+    {
+        buffers[i] = malloc(sizes[i]);
+        // კომპილატორმა გამოყოფა არ უნდა ამოაგდოს
+        __asm__ volatile("" : : "r"(buffers[i]) : "memory");
+    }
+    for (int i = 0; i < SCRATCH_BUFFERS; i++)
+    {
+        free(buffers[i]);
+    }
+}
+
+static void scratch_event(void *context)
+{
+    static const size_t sizes[SCRATCH_BUFFERS] = SCRATCH_SIZES;
+    for (int i = 0; i < SCRATCH_BUFFERS; i++)
+    {
+        void *buffer = synapse_event_scratch_alloc(sizes[i]);
+        __asm__ volatile("" : : "r"(buffer) : "memory");
+    }
+    synapse_event_scratch_reset(&s_arena);
+}
+
+static void run_bus(bench_options_t *options, cJSON *result)
+{
+    synapse_event_id_t event_id = synapse_event_bus_intern("BENCH_SCRATCH");
+    synapse_event_id_t sync_id = synapse_event_bus_intern("BENCH_SCRATCH_SYNC");
+    BENCH_CHECK(result, synapse_event_bus_set_overflow_policy(event_id, SYNAPSE_EVENT_OVERFLOW_BLOCK, 1000) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id(event_id, bench_module_create("scratch_sub", scratch_handler, NULL)) == ESP_OK);
+    // private_data != NULL ნიშნავს sync გამოძახებას
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id_sync(sync_id, bench_module_create("scratch_sync", scratch_handler, &s_state)) == ESP_OK);
+
+    synapse_event_bus_reset_lane_stats();
+    for (uint32_t i = 0; i < options->events; i++)
+    {
+        BENCH_CHECK(result, synapse_event_bus_post_id(event_id, NULL) == ESP_OK);
+    }
+    BENCH_CHECK(result, bench_wait_for(&s_state.handled, options->events, 10000));
+    BENCH_CHECK(result, synapse_event_bus_publish_sync_id(sync_id, NULL) == ESP_OK);
+
+    synapse_event_scratch_stats_t stats = {0};
+    synapse_event_bus_get_scratch_stats(&stats);
+    cJSON *json = cJSON_AddObjectToObject(result, "bus");
+    cJSON_AddNumberToObject(json, "arena_size", stats.arena_size);
+    cJSON_AddNumberToObject(json, "arenas", stats.arenas);
+    cJSON_AddNumberToObject(json, "allocations", stats.allocations);
+    cJSON_AddNumberToObject(json, "overflows", stats.overflows);
+    cJSON_AddNumberToObject(json, "high_watermark", stats.high_watermark);
+    cJSON_AddNumberToObject(json, "null_buffers", s_state.null_buffers);
+    cJSON_AddNumberToObject(json, "misaligned", s_state.misaligned);
+
+    BENCH_CHECK(result, s_state.null_buffers == 0 && s_state.misaligned == 0);
+    BENCH_CHECK(result, s_state.oversize_granted == 0 && s_state.sync_granted == 0);
+    // რამდენიმე ივენთი შეიძლება ჯერ არ იყოს დათვლილი: მრიცხველები არენის reset-ზე ემატება
+    BENCH_CHECK(result, stats.allocations >= (options->events - 1) * (SCRATCH_BUFFERS + 1));
+    BENCH_CHECK(result, stats.overflows >= options->events - 1);
+    // ერთი ივენთის მოცულობა (48 + 64 + 80 + სტრიქონი) და არა ჯამი ყველა ივენთზე
+    BENCH_CHECK(result, stats.high_watermark >= 192 && stats.high_watermark <= CONFIG_SYNAPSE_EVENT_SCRATCH_SIZE);
+}
+
+static void run_cost(bench_options_t *options, cJSON *result)
+{
+    cJSON *json = cJSON_AddObjectToObject(result, "cost");
+    cJSON_AddNumberToObject(json, "malloc_free_ns", bench_time_ns(malloc_event, NULL, options->events * 10));
+
+    if (!BENCH_CHECK(result, synapse_event_scratch_init(&s_arena) == ESP_OK))
+    {
+        return;
+    }
+    synapse_event_scratch_bind(&s_arena);
+    uint64_t allocs_before = host_port_alloc_count();
+    double scratch_ns = bench_time_ns(scratch_event, NULL, options->events * 10);
+    uint64_t allocs = host_port_alloc_count() - allocs_before;
+    cJSON_AddNumberToObject(json, "scratch_reset_ns", scratch_ns);
+    cJSON_AddNumberToObject(json, "heap_allocs", (double)allocs);
+    BENCH_CHECK(result, allocs == 0);
+    synapse_event_scratch_bind(NULL);
+    synapse_event_scratch_deinit(&s_arena);
+}
+
+void bench_case_scratch(bench_options_t *options, cJSON *result)
+{
+    options->events = options->events ? options->events : (options->quick ? 1000 : 100000);
+    options->subscribers = 1;
+    options->producers = 1;
+
+#if CONFIG_SYNAPSE_EVENT_SCRATCH_SIZE == 0
+    cJSON_AddBoolToObject(result, "skipped", true);
+    return;
+#endif
+
+    run_bus(options, result);
+    run_cost(options, result);
+}
@@ -0,0 +1,97 @@
+/**
+ * @file case_service.c
+ * @brief Service Locator: lookup by name versus a cached token.
+ * @details `SERVICE_COUNT` services are registered. Reported: the time of
+ *          `synapse_service_get()` for the first and the last registered
+ *          service (`get_first_ns`, `get_last_ns`) and of
+ *          `synapse_service_get_cached()` with a valid token (`cached_ns`).
+ *          Every lookup must return the registered handle without heap use.
+ *
+ *          The token must then become invalid when its service is
+ *          unregistered, stay invalid after the name is registered again, and
+ *          `get_cached()` must resolve the new handle on its own.
+ */
+#include <stdio.h>
+
+#include "host_bench.h"
+#include "service_locator.h"
+
+#define SERVICE_COUNT 30
+
+typedef struct
+{
+    const char *name;
+    service_handle_t expected;
+    synapse_service_token_t token;
+    uint32_t wrong;
+} service_run_t;
+
+static int s_handles[SERVICE_COUNT + 1];
+static char s_names[SERVICE_COUNT][CONFIG_SYNAPSE_SERVICE_NAME_MAX_LENGTH];
+
+static void get_by_name(void *context)
+{
+    service_run_t *run = context;
+    run->wrong += synapse_service_get(run->name) != run->expected;
+}
+
+static void get_cached(void *context)
+{
+    service_run_t *run = context;
+    run->wrong += synapse_service_get_cached(run->name, &run->token) != run->expected;
+}
+
+static double time_lookup(bench_options_t *options, cJSON *result, void (*fn)(void *context), service_run_t *run)
+{
+    uint64_t allocs_before = host_port_alloc_count();
+    double ns = bench_time_ns(fn, run, options->events);
+    BENCH_CHECK(result, host_port_alloc_count() == allocs_before);
+    BENCH_CHECK(result, run->wrong == 0);
+    return ns;
+}
+
+static void run_invalidation(cJSON *result, service_run_t *run)
+{
+    synapse_service_token_t stale = run->token;
+    BENCH_CHECK(result, synapse_service_token_is_valid(&stale));
+    BENCH_CHECK(result, synapse_service_unregister(run->name) == ESP_OK);
+    BENCH_CHECK(result, !synapse_service_token_is_valid(&stale));
+    BENCH_CHECK(result, synapse_service_get_cached(run->name, &run->token) == NULL);
+
+    // იგივე სახელი ახალი handle-ით: ძველი token ვალიდური აღარ ხდება
+    service_handle_t replacement = &s_handles[SERVICE_COUNT];
+    BENCH_CHECK(result, synapse_service_register_with_status(run->name, SYNAPSE_SERVICE_TYPE_UNKNOWN, replacement,
+                                                             SERVICE_STATUS_ACTIVE) == ESP_OK);
+    BENCH_CHECK(result, synapse_service_token_get(&stale) == NULL);
+    BENCH_CHECK(result, synapse_service_get_cached(run->name, &run->token) == replacement);
+    BENCH_CHECK(result, synapse_service_token_get(&run->token) == replacement);
+}
+
+void bench_case_service(bench_options_t *options, cJSON *result)
+{
+    options->events = options->events ? options->events : (options->quick ? 100000 : 10000000);
+    options->subscribers = 0;
+    options->producers = 1;
+
+    for (int i = 0; i < SERVICE_COUNT; i++)
+    {
+        snprintf(s_names[i], sizeof(s_names[i]), "bench_service_%02d", i);
+        BENCH_CHECK(result, synapse_service_register_with_status(s_names[i], SYNAPSE_SERVICE_TYPE_UNKNOWN, &s_handles[i],
+                                                                 SERVICE_STATUS_ACTIVE) == ESP_OK);
+    }
+
+    service_run_t first = {.name = s_names[0], .expected = &s_handles[0]};
+    service_run_t last = {.name = s_names[SERVICE_COUNT - 1], .expected = &s_handles[SERVICE_COUNT - 1]};
+    BENCH_CHECK(result, synapse_service_resolve(last.name, &last.token) == ESP_OK);
+
+    cJSON_AddNumberToObject(result, "services", SERVICE_COUNT);
+    cJSON_AddNumberToObject(result, "get_first_ns", time_lookup(options, result, get_by_name, &first));
+    cJSON_AddNumberToObject(result, "get_last_ns", time_lookup(options, result, get_by_name, &last));
+    cJSON_AddNumberToObject(result, "cached_ns", time_lookup(options, result, get_cached, &last));
+
+    run_invalidation(result, &last);
+    for (int i = 0; i < SERVICE_COUNT; i++)
+    {
+        synapse_service_unregister(s_names[i]);
+    }
+}
@@ -0,0 +1,129 @@
+/**
+ * @file case_spill.c
+ * @brief FIFO order of an event with the SPILL overflow policy across the spill buffer.
+ * @details The first event blocks its handler until the producer has filled
+ *          the lane queue and put `SPILL_BUFFERED` events into the spill
+ *          buffer. The producer then keeps posting while the dispatcher works
+ *          through the backlog (a ~100 µs handler), so new posts arrive while
+ *          spilled events are still waiting. Every handled sequence number
+ *          must be larger than the previous one; a new post that reached the
+ *          queue before the spilled events shows up as `order_violations`.
+ *          Every event must be counted in `posted` exactly once and the
+ *          event's `high_watermark` must not exceed its queue's length.
+ */
+#include <string.h>
+#include <unistd.h>
+
+#include "host_bench.h"
+
+#define SPILL_BUFFERED 8
+#define SPILL_HANDLER_US 100
+#define SPILL_POST_GAP_US 150
+
+typedef struct
+{
+    SemaphoreHandle_t gate;
+    uint32_t last_seq;
+    uint32_t order_violations;
+    uint32_t handled;
+} spill_state_t;
+
+static void spill_handler(module_t *self, const char *event_name, void *data)
+{
+    spill_state_t *state = self->private_data;
+    event_data_wrapper_t *wrapper = data;
+    uint32_t seq = 0;
+    if (wrapper && wrapper->payload)
+    {
+        memcpy(&seq, wrapper->payload, sizeof(seq));
+    }
+    if (seq == 1)
+    {
+        xSemaphoreTake(state->gate, portMAX_DELAY);
+    }
+    if (seq <= state->last_seq)
+    {
+        state->order_violations++;
+    }
+    state->last_seq = seq;
+    usleep(SPILL_HANDLER_US);
+    __atomic_fetch_add(&state->handled, 1, __ATOMIC_RELEASE);
+    if (wrapper)
+    {
+        synapse_event_data_release(wrapper);
+    }
+}
+
+void bench_case_spill(bench_options_t *options, cJSON *result)
+{
+    options->events = options->events ? options->events : (options->quick ? 300 : 3000);
+    options->subscribers = 1;
+    options->producers = 1;
+    options->payload = sizeof(uint32_t);
+
+#if CONFIG_SYNAPSE_EVENT_SPILL_BUFFER_LENGTH < SPILL_BUFFERED
+    cJSON_AddBoolToObject(result, "skipped", true);
+    return;
+#endif
+
+    spill_state_t state = {.gate = xSemaphoreCreateBinary()};
+    synapse_event_id_t event_id = synapse_event_bus_intern("BENCH_SPILL");
+    BENCH_CHECK(result, event_id != SYNAPSE_EVENT_ID_INVALID);
+    BENCH_CHECK(result, synapse_event_bus_set_overflow_policy(event_id, SYNAPSE_EVENT_OVERFLOW_SPILL, 0) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id(event_id, bench_module_create("spill_sub", spill_handler, &state)) == ESP_OK);
+
+    synapse_event_lane_stats_t lane = {0};
+    synapse_event_bus_get_lane_stats(SYNAPSE_EVENT_PRIORITY_NORMAL, &lane);
+    // ივენთის ID ერთ დისპეტჩერთან მიდის, ამიტომ ერთი რიგის სიგრძე საკმარისია
+    uint32_t queue_length = lane.queue_length / synapse_event_bus_get_dispatcher_count();
+    uint32_t burst = queue_length + SPILL_BUFFERED;
+    if (options->events < burst + 1)
+    {
+        options->events = burst + 1;
+    }
+
+    // 1. პირველი ივენთი handler-ს აჩერებს; რიგი ივსება და SPILL_BUFFERED ივენთი ბუფერში გადადის
+    uint32_t seq = 1;
+    BENCH_CHECK(result, synapse_event_bus_post_inline(event_id, &seq, sizeof(seq)) == ESP_OK);
+    do
+    {
+        // ველოდებით, სანამ დისპეტჩერი პირველ ივენთს რიგიდან აიღებს
+        usleep(100);
+        synapse_event_bus_get_lane_stats(SYNAPSE_EVENT_PRIORITY_NORMAL, &lane);
+    } while (lane.pending > 0);
+    for (seq = 2; seq <= burst + 1; seq++)
+    {
+        BENCH_CHECK(result, synapse_event_bus_post_inline(event_id, &seq, sizeof(seq)) == ESP_OK);
+    }
+    synapse_event_bus_get_lane_stats(SYNAPSE_EVENT_PRIORITY_NORMAL, &lane);
+    cJSON_AddNumberToObject(result, "spill_pending_at_release", lane.spill_pending);
+
+    // 2. handler აგრძელებს, მწარმოებელი კი ამასობაში ახალ ივენთებს აქვეყნებს
+    xSemaphoreGive(state.gate);
+    uint32_t posted = burst + 1;
+    for (; seq <= options->events; seq++)
+    {
+        if (synapse_event_bus_post_inline(event_id, &seq, sizeof(seq)) == ESP_OK)
+        {
+            posted++;
+        }
+        usleep(SPILL_POST_GAP_US);
+    }
+    BENCH_CHECK(result, bench_wait_for(&state.handled, posted, 30000));
+
+    synapse_event_stats_t stats = {0};
+    synapse_event_bus_get_event_stats(event_id, &stats);
+    cJSON_AddNumberToObject(result, "queue_length", queue_length);
+    cJSON_AddNumberToObject(result, "posted", posted);
+    cJSON_AddNumberToObject(result, "handled", __atomic_load_n(&state.handled, __ATOMIC_ACQUIRE));
+    cJSON_AddNumberToObject(result, "spilled", stats.spilled);
+    cJSON_AddNumberToObject(result, "dropped", stats.dropped);
+    cJSON_AddNumberToObject(result, "order_violations", state.order_violations);
+
+    BENCH_CHECK(result, stats.spilled >= SPILL_BUFFERED);
+    // spill-ის დროს რიგის შევსება არ "გამოიგონება": ყოველი ივენთი ერთხელ ითვლება, რეალური შევსებით
+    BENCH_CHECK(result, stats.posted == posted);
+    BENCH_CHECK(result, stats.high_watermark <= queue_length);
+    BENCH_CHECK(result, state.order_violations == 0);
+    vSemaphoreDelete(state.gate);
+}
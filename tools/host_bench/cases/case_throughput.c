@@ -0,0 +1,135 @@
+/**
+ * @file case_throughput.c
+ * @brief Standard Event Bus benchmark: events/sec, post -> handler latency and heap allocations per event.
+ * @details `--producers` tasks post `--events` events of `--payload` bytes to
+ *          one event with `--subscribers` subscribers, plus `--wildcards`
+ *          modules subscribed to `*`. Payloads up to
+ *          `CONFIG_SYNAPSE_EVENT_INLINE_PAYLOAD_SIZE` go inline, larger ones
+ *          are heap-allocated and wrapped, as a producer would do. The event
+ *          uses the BLOCK overflow policy, so every event is delivered.
+ *
+ *          Every handler call records the time since the post, so the
+ *          percentiles include the fan-out to all subscribers. The payload
+ *          carries the post time stamp and is therefore at least 8 bytes.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "host_bench.h"
+
+typedef struct
+{
+    synapse_event_id_t event_id;
+    uint32_t per_producer;
+    uint16_t payload;
+    SemaphoreHandle_t done;
+} producer_args_t;
+
+static bench_latency_t s_latency;
+static uint32_t s_handled = 0;
+
+static void bench_handler(module_t *self, const char *event_name, void *data)
+{
+    event_data_wrapper_t *wrapper = data;
+    if (wrapper && wrapper->payload)
+    {
+        uint64_t posted_ns;
+        memcpy(&posted_ns, wrapper->payload, sizeof(posted_ns));
+        bench_latency_add(&s_latency, host_port_now_ns() - posted_ns);
+        __atomic_fetch_add(&s_handled, 1, __ATOMIC_RELEASE);
+    }
+    if (wrapper)
+    {
+        synapse_event_data_release(wrapper);
+    }
+}
+
+static void producer_task(void *arg)
+{
+    producer_args_t *args = arg;
+    uint8_t payload[1024] = {0};
+
+    for (uint32_t i = 0; i < args->per_producer; i++)
+    {
+        uint64_t now = host_port_now_ns();
+        memcpy(payload, &now, sizeof(now));
+        if (args->payload <= CONFIG_SYNAPSE_EVENT_INLINE_PAYLOAD_SIZE)
+        {
+            synapse_event_bus_post_inline(args->event_id, payload, args->payload);
+        }
+        else
+        {
+            void *copy = malloc(args->payload);
+            event_data_wrapper_t *wrapper = NULL;
+            memcpy(copy, payload, args->payload);
+            if (synapse_event_data_wrap(copy, free, &wrapper) == ESP_OK)
+            {
+                synapse_event_bus_post_id(args->event_id, wrapper);
+                synapse_event_data_release(wrapper);
+            }
+        }
+    }
+    xSemaphoreGive(args->done);
+    vTaskDelete(NULL);
+}
+
+void bench_case_throughput(bench_options_t *options, cJSON *result)
+{
+    options->events = options->events ? options->events : (options->quick ? 2000 : 200000);
+    options->subscribers = options->subscribers ? options->subscribers : 1;
+    options->producers = options->producers ? options->producers : 1;
+    options->payload = options->payload < sizeof(uint64_t) ? sizeof(uint64_t) : options->payload;
+    options->payload = options->payload > 1024 ? 1024 : options->payload;
+    if (options->subscribers > CONFIG_SYNAPSE_MAX_SUBSCRIBERS_PER_EVENT)
+    {
+        options->subscribers = CONFIG_SYNAPSE_MAX_SUBSCRIBERS_PER_EVENT;
+    }
+
+    synapse_event_id_t event_id = synapse_event_bus_intern("BENCH_THROUGHPUT");
+    BENCH_CHECK(result, event_id != SYNAPSE_EVENT_ID_INVALID);
+    for (uint8_t i = 0; i < options->subscribers; i++)
+    {
+        BENCH_CHECK(result, synapse_event_bus_subscribe_id(event_id, bench_module_create("bench_sub", bench_handler, NULL)) == ESP_OK);
+    }
+    for (uint8_t i = 0; i < options->wildcards; i++)
+    {
+        BENCH_CHECK(result, synapse_event_bus_subscribe("*", bench_module_create("bench_wild", bench_handler, NULL)) == ESP_OK);
+    }
+    synapse_event_bus_set_overflow_policy(event_id, SYNAPSE_EVENT_OVERFLOW_BLOCK, 1000);
+
+    uint32_t per_producer = options->events / options->producers;
+    options->events = per_producer * options->producers;
+    uint32_t expected = options->events * (options->subscribers + options->wildcards);
+    BENCH_CHECK(result, bench_latency_init(&s_latency, expected));
+
+    producer_args_t args = {
+        .event_id = event_id,
+        .per_producer = per_producer,
+        .payload = options->payload,
+        .done = xSemaphoreCreateCounting(options->producers, 0),
+    };
+
+    synapse_event_data_reset_stats();
+    synapse_event_bus_reset_lane_stats();
+    uint64_t allocs_before = host_port_alloc_count();
+    uint64_t start_ns = host_port_now_ns();
+
+    for (uint8_t p = 0; p < options->producers; p++)
+    {
+        xTaskCreate(producer_task, "bench_prod", 4096, &args, 5, NULL);
+    }
+    for (uint8_t p = 0; p < options->producers; p++)
+    {
+        xSemaphoreTake(args.done, portMAX_DELAY);
+    }
+    BENCH_CHECK(result, bench_wait_for(&s_handled, expected, 30000));
+
+    uint64_t elapsed_ns = host_port_now_ns() - start_ns;
+    cJSON_AddNumberToObject(result, "handled", __atomic_load_n(&s_handled, __ATOMIC_ACQUIRE));
+    cJSON_AddNumberToObject(result, "elapsed_us", (double)(elapsed_ns / 1000));
+    cJSON_AddNumberToObject(result, "events_per_sec", elapsed_ns ? options->events * 1e9 / elapsed_ns : 0.0);
+    bench_latency_report(&s_latency, result, "latency_us");
+    bench_report_allocs(result, allocs_before, options->events);
+    bench_report_bus_stats(result);
+    bench_latency_free(&s_latency);
+}
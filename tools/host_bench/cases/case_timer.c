@@ -0,0 +1,197 @@
+/**
+ * @file case_timer.c
+ * @brief Timing wheel: delayed-post accuracy, cancellation and the cost of many periodic timers.
+ * @details Three parts:
+ *          - `delayed`: `TIMER_DELAYED` events posted with `post_delayed()`
+ *            (20-200 ms); each must arrive no earlier than requested, and the
+ *            lateness is reported;
+ *          - `cancel`: a cancelled timer must never fire, and a second
+ *            `cancel` returns ESP_ERR_NOT_FOUND;
+ *          - `periodic`: every free timer slot
+ *            (`CONFIG_SYNAPSE_EVENT_TIMER_MAX_TIMERS`) posts one of 32 events
+ *            with a period of 100-190 ms. Reported: fired events, timer task
+ *            wakeups and its CPU share (`busy_us` over the run), checked
+ *            against the number of periods that elapsed.
+ *
+ *          Build a variant with a larger `CONFIG_SYNAPSE_EVENT_TIMER_MAX_TIMERS`
+ *          to measure thousands of timers.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "host_bench.h"
+
+#define TIMER_DELAYED 10
+#define TIMER_EVENTS 32
+#define TIMER_PERIOD_MS 100
+
+static uint64_t s_posted_ns[TIMER_DELAYED];
+static uint64_t s_fired_ns[TIMER_DELAYED];
+static uint32_t s_delayed_handled = 0;
+static uint32_t s_cancel_calls = 0;
+static uint32_t s_periodic_handled = 0;
+
+/** @brief payload-ები სტატიკურია, ამიტომ wrapper მათ არ ათავისუფლებს. */
+static void keep_payload(void *payload)
+{
+}
+
+static void delayed_handler(module_t *self, const char *event_name, void *data)
+{
+    event_data_wrapper_t *wrapper = data;
+    if (wrapper && wrapper->payload)
+    {
+        uint32_t index = *(const uint32_t *)wrapper->payload;
+        s_fired_ns[index % TIMER_DELAYED] = host_port_now_ns();
+    }
+    if (wrapper)
+    {
+        synapse_event_data_release(wrapper);
+    }
+    __atomic_fetch_add(&s_delayed_handled, 1, __ATOMIC_RELEASE);
+}
+
+static void cancel_handler(module_t *self, const char *event_name, void *data)
+{
+    __atomic_fetch_add(&s_cancel_calls, 1, __ATOMIC_RELEASE);
+}
+
+static void periodic_handler(module_t *self, const char *event_name, void *data)
+{
+    __atomic_fetch_add(&s_periodic_handled, 1, __ATOMIC_RELEASE);
+}
+
+static void run_delayed(cJSON *result)
+{
+    static uint32_t indices[TIMER_DELAYED];
+    synapse_event_id_t event_id = synapse_event_bus_intern("BENCH_TIMER_DELAYED");
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id(event_id, bench_module_create("timer_delayed", delayed_handler, NULL)) == ESP_OK);
+
+    for (uint32_t i = 0; i < TIMER_DELAYED; i++)
+    {
+        indices[i] = i;
+        event_data_wrapper_t *wrapper = NULL;
+        BENCH_CHECK(result, synapse_event_data_wrap(&indices[i], keep_payload, &wrapper) == ESP_OK);
+        s_posted_ns[i] = host_port_now_ns();
+        BENCH_CHECK(result, synapse_event_bus_post_delayed_id(event_id, wrapper, 20 * (i + 1), NULL) == ESP_OK);
+        synapse_event_data_release(wrapper);
+    }
+    BENCH_CHECK(result, bench_wait_for(&s_delayed_handled, TIMER_DELAYED, 5000));
+
+    uint32_t early = 0;
+    double max_late_ms = 0.0;
+    for (uint32_t i = 0; i < TIMER_DELAYED; i++)
+    {
+        double delay_ms = (double)(s_fired_ns[i] - s_posted_ns[i]) / 1e6;
+        double late_ms = delay_ms - 20.0 * (i + 1);
+        // ერთი host ტიკის (1 ms) დამრგვალება დასაშვებია
+        if (late_ms < -1.0)
+        {
+            early++;
+        }
+        max_late_ms = late_ms > max_late_ms ? late_ms : max_late_ms;
+    }
+    cJSON *json = cJSON_AddObjectToObject(result, "delayed");
+    cJSON_AddNumberToObject(json, "timers", TIMER_DELAYED);
+    cJSON_AddNumberToObject(json, "early", early);
+    cJSON_AddNumberToObject(json, "max_late_ms", max_late_ms);
+    BENCH_CHECK(result, early == 0);
+}
+
+static void run_cancel(cJSON *result)
+{
+    synapse_event_id_t event_id = synapse_event_bus_intern("BENCH_TIMER_CANCEL");
+    BENCH_CHECK(result, synapse_event_bus_subscribe_id(event_id, bench_module_create("timer_cancel", cancel_handler, NULL)) == ESP_OK);
+
+    synapse_event_timer_t timer = SYNAPSE_EVENT_TIMER_INVALID;
+    BENCH_CHECK(result, synapse_event_bus_post_delayed_id(event_id, NULL, 50, &timer) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_cancel_timer(timer) == ESP_OK);
+    BENCH_CHECK(result, synapse_event_bus_cancel_timer(timer) == ESP_ERR_NOT_FOUND);
+    usleep(100000);
+    BENCH_CHECK(result, __atomic_load_n(&s_cancel_calls, __ATOMIC_ACQUIRE) == 0);
+}
+
+static void run_periodic(bench_options_t *options, cJSON *result)
+{
+    synapse_event_timer_stats_t before = {0};
+    synapse_event_bus_get_timer_stats(&before);
+    uint32_t count = before.capacity - before.active;
+
+    synapse_event_id_t event_ids[TIMER_EVENTS];
+    module_t *module = bench_module_create("timer_periodic", periodic_handler, NULL);
+    for (int i = 0; i < TIMER_EVENTS; i++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "BENCH_TIMER_TICK_%d", i);
+        event_ids[i] = synapse_event_bus_intern(name);
+        BENCH_CHECK(result, synapse_event_bus_subscribe_id(event_ids[i], module) == ESP_OK);
+    }
+
+    synapse_event_timer_t *timers = calloc(count, sizeof(*timers));
+    if (!BENCH_CHECK(result, timers != NULL))
+    {
+        return;
+    }
+    uint32_t expected_min = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t period_ms = TIMER_PERIOD_MS + (i % 10) * 10;
+        BENCH_CHECK(result, synapse_event_bus_post_periodic_id(event_ids[i % TIMER_EVENTS], NULL, period_ms, &timers[i]) == ESP_OK);
+        expected_min += options->events / period_ms;
+    }
+
+    synapse_event_timer_stats_t start = {0};
+    synapse_event_bus_get_timer_stats(&start);
+    uint64_t start_ns = host_port_now_ns();
+    usleep(options->events * 1000);
+    synapse_event_timer_stats_t end = {0};
+    synapse_event_bus_get_timer_stats(&end);
+    uint64_t elapsed_us = (host_port_now_ns() - start_ns) / 1000;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        BENCH_CHECK(result, synapse_event_bus_cancel_timer(timers[i]) == ESP_OK);
+    }
+    free(timers);
+    synapse_event_timer_stats_t after = {0};
+    synapse_event_bus_get_timer_stats(&after);
+
+    uint32_t fired = end.fired - start.fired;
+    cJSON *json = cJSON_AddObjectToObject(result, "periodic");
+    cJSON_AddNumberToObject(json, "timers", count);
+    cJSON_AddNumberToObject(json, "duration_ms", options->events);
+    cJSON_AddNumberToObject(json, "fired", fired);
+    cJSON_AddNumberToObject(json, "expected_min", expected_min);
+    cJSON_AddNumberToObject(json, "wakeups", end.wakeups - start.wakeups);
+    cJSON_AddNumberToObject(json, "fired_per_wakeup",
+                            end.wakeups > start.wakeups ? (double)fired / (end.wakeups - start.wakeups) : 0.0);
+    cJSON_AddNumberToObject(json, "busy_us", (double)(end.busy_us - start.busy_us));
+    cJSON_AddNumberToObject(json, "cpu_percent", elapsed_us ? 100.0 * (double)(end.busy_us - start.busy_us) / elapsed_us : 0.0);
+    cJSON_AddNumberToObject(json, "post_failures", end.post_failures - start.post_failures);
+
+    // პერიოდის საზღვარზე ერთი გამოქვეყნება შეიძლება ჯერ არ მომხდარა
+    BENCH_CHECK(result, fired + count >= expected_min);
+    BENCH_CHECK(result, end.post_failures == start.post_failures);
+    BENCH_CHECK(result, after.active == before.active);
+    // ყოველი გამოქვეყნებული ივენთი handler-მდე მიდის, გაუქმებამდე გამოქვეყნებულების ჩათვლით
+    BENCH_CHECK(result, bench_wait_for(&s_periodic_handled, after.fired - start.fired, 5000));
+}
+
+void bench_case_timer(bench_options_t *options, cJSON *result)
+{
+    // --events აქ პერიოდული ნაწილის ხანგრძლივობაა (ms)
+    options->events = options->events ? options->events : (options->quick ? 500 : 10000);
+    options->subscribers = 1;
+    options->producers = 0;
+
+#if !CONFIG_SYNAPSE_EVENT_TIMER_ENABLE
+    cJSON_AddBoolToObject(result, "skipped", true);
+    return;
+#endif
+
+    cJSON_AddNumberToObject(result, "resolution_ms", CONFIG_SYNAPSE_EVENT_TIMER_RESOLUTION_MS);
+    run_delayed(result);
+    run_cancel(result);
+    run_periodic(options, result);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file host_bench.h
+ * @brief Shared helpers of the Synapse host benchmark and test harness.
+ * @details Every case is a function that runs one scenario against the
+ *          unmodified core sources and fills a JSON result object. The runner
+ *          (`bench_main.c`) adds the configuration, prints one JSON line per
+ *          case and exits non-zero when a `BENCH_CHECK` failed, so the same
+ *          cases serve as CTest tests (`--quick`) and as benchmarks.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cJSON.h"
+#include "synapse.h"
+#include "host_port.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Command line parameters shared by all cases.
+     * @details Cases use the fields that apply to them and report what they used.
+     */
+    typedef struct
+    {
+        uint32_t events;     /**< Events (or iterations) to run; 0 = the case default. */
+        uint8_t subscribers; /**< Subscribers of the benchmark event. */
+        uint16_t payload;    /**< Payload size in bytes. */
+        uint8_t producers;   /**< Producer tasks. */
+        uint8_t wildcards;   /**< Additional `*` subscribers. */
+        bool quick;          /**< Short run for CTest. */
+    } bench_options_t;
+
+    /**
+     * @brief A benchmark case.
+     * @details Replaces zero options with its defaults (they are reported after
+     *          the run), adds its measurements to `result` and records failed
+     *          checks with `BENCH_CHECK`.
+     */
+    typedef void (*bench_case_fn_t)(bench_options_t *options, cJSON *result);
+
+    typedef struct
+    {
+        const char *name;
+        const char *description;
+        bench_case_fn_t run;
+    } bench_case_t;
+
+    /**
+     * @brief Records a check in `result["failures"]` and on stderr when it fails.
+     * @return `ok`, so the macro can be used in conditions.
+     */
+    bool bench_check(cJSON *result, bool ok, const char *expression, const char *file, int line);
+
+#define BENCH_CHECK(result, condition) bench_check((result), (condition), #condition, __FILE__, __LINE__)
+
+    /** @brief Returns the number of failed checks recorded in `result`. */
+    int bench_failures(const cJSON *result);
+
+    /**
+     * @brief Initializes the core services in the System Manager order
+     *        (Service Locator, Event Bus, Promise Manager, Task Pool).
+     */
+    esp_err_t bench_core_init(void);
+
+    /**
+     * @brief Creates a module with the given handler and adds it to the host module registry.
+     * @param[in] name Instance name (copied).
+     * @param[in] handler `handle_event` implementation.
+     * @param[in] context Stored in `private_data`.
+     */
+    module_t *bench_module_create(const char *name, module_event_handler_fn handler, void *context);
+
+    /** @brief Adds a module to the list returned by `synapse_module_registry_get_all()`. */
+    esp_err_t host_registry_add(module_t *module);
+
+    /**
+     * @brief Waits until `*counter` reaches `target`.
+     * @return false on timeout.
+     */
+    bool bench_wait_for(const uint32_t *counter, uint32_t target, uint32_t timeout_ms);
+
+    /** @brief Adds the process heap counters since `allocs_before` as `heap_allocs` and `heap_allocs_per_op`. */
+    void bench_report_allocs(cJSON *result, uint64_t allocs_before, uint32_t operations);
+
+    /** @brief Adds the output of `synapse_event_bus_get_stats_json()` as `result["bus"]`. */
+    void bench_report_bus_stats(cJSON *result);
+
+    /**
+     * @brief Fixed-capacity latency recorder, safe for concurrent `add` calls.
+     */
+    typedef struct
+    {
+        uint32_t *samples_ns;
+        uint32_t capacity;
+        uint32_t count;
+    } bench_latency_t;
+
+    bool bench_latency_init(bench_latency_t *latency, uint32_t capacity);
+    void bench_latency_add(bench_latency_t *latency, uint64_t ns);
+
+    /** @brief Adds `{samples, p50, p99, p999, max}` in microseconds under `name`. */
+    void bench_latency_report(bench_latency_t *latency, cJSON *result, const char *name);
+    void bench_latency_free(bench_latency_t *latency);
+
+    /**
+     * @brief Measures `fn(context)` `iterations` times and returns the mean in nanoseconds.
+     * @details Runs a tenth of the iterations first as warm-up.
+     */
+    double bench_time_ns(void (*fn)(void *context), void *context, uint32_t iterations);
+
+#ifdef __cplusplus
+}
+#endif
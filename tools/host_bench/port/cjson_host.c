@@ -0,0 +1,235 @@
+/**
+ * @file cjson_host.c
+ * @brief Minimal cJSON builder and printer for the host benchmarks (see cJSON.h).
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cJSON.h"
+
+#define HOST_CJSON_RAW (1 << 7)
+
+static cJSON *item_new(int type)
+{
+    cJSON *item = calloc(1, sizeof(cJSON));
+    if (item)
+    {
+        item->type = type;
+    }
+    return item;
+}
+
+cJSON *cJSON_CreateObject(void)
+{
+    return item_new(cJSON_Object);
+}
+
+cJSON *cJSON_CreateArray(void)
+{
+    return item_new(cJSON_Array);
+}
+
+cJSON *cJSON_CreateNumber(double number)
+{
+    cJSON *item = item_new(cJSON_Number);
+    if (item)
+    {
+        item->valuedouble = number;
+        item->valueint = (int)number;
+    }
+    return item;
+}
+
+cJSON *cJSON_CreateString(const char *string)
+{
+    cJSON *item = item_new(cJSON_String);
+    if (item)
+    {
+        item->valuestring = strdup(string ? string : "");
+    }
+    return item;
+}
+
+bool cJSON_AddItemToArray(cJSON *array, cJSON *item)
+{
+    if (!array || !item)
+    {
+        return false;
+    }
+    cJSON **link = &array->child;
+    cJSON *prev = NULL;
+    while (*link)
+    {
+        prev = *link;
+        link = &(*link)->next;
+    }
+    item->prev = prev;
+    *link = item;
+    return true;
+}
+
+bool cJSON_AddItemToObject(cJSON *object, const char *name, cJSON *item)
+{
+    if (!item || !name)
+    {
+        return false;
+    }
+    item->string = strdup(name);
+    return cJSON_AddItemToArray(object, item);
+}
+
+static cJSON *add_new(cJSON *object, const char *name, cJSON *item)
+{
+    if (!cJSON_AddItemToObject(object, name, item))
+    {
+        cJSON_Delete(item);
+        return NULL;
+    }
+    return item;
+}
+
+cJSON *cJSON_AddNumberToObject(cJSON *object, const char *name, double number)
+{
+    return add_new(object, name, cJSON_CreateNumber(number));
+}
+
+cJSON *cJSON_AddStringToObject(cJSON *object, const char *name, const char *string)
+{
+    return add_new(object, name, cJSON_CreateString(string));
+}
+
+cJSON *cJSON_AddBoolToObject(cJSON *object, const char *name, bool boolean)
+{
+    cJSON *item = item_new(HOST_CJSON_RAW);
+    if (item)
+    {
+        item->valuestring = strdup(boolean ? "true" : "false");
+    }
+    return add_new(object, name, item);
+}
+
+cJSON *cJSON_AddRawToObject(cJSON *object, const char *name, const char *raw)
+{
+    cJSON *item = item_new(HOST_CJSON_RAW);
+    if (item)
+    {
+        item->valuestring = strdup(raw ? raw : "null");
+    }
+    return add_new(object, name, item);
+}
+
+cJSON *cJSON_AddObjectToObject(cJSON *object, const char *name)
+{
+    return add_new(object, name, cJSON_CreateObject());
+}
+
+cJSON *cJSON_AddArrayToObject(cJSON *object, const char *name)
+{
+    return add_new(object, name, cJSON_CreateArray());
+}
+
+cJSON *cJSON_GetObjectItem(const cJSON *object, const char *name)
+{
+    cJSON *item = NULL;
+    cJSON_ArrayForEach(item, object)
+    {
+        if (item->string && strcmp(item->string, name) == 0)
+        {
+            return item;
+        }
+    }
+    return NULL;
+}
+
+void cJSON_Delete(cJSON *item)
+{
+    while (item)
+    {
+        cJSON *next = item->next;
+        cJSON_Delete(item->child);
+        free(item->string);
+        free(item->valuestring);
+        free(item);
+        item = next;
+    }
+}
+
+typedef struct
+{
+    char *data;
+    size_t length;
+    size_t capacity;
+} print_buffer_t;
+
+static void put(print_buffer_t *out, const char *text)
+{
+    size_t len = strlen(text);
+    if (out->length + len + 1 > out->capacity)
+    {
+        size_t capacity = out->capacity ? out->capacity : 256;
+        while (out->length + len + 1 > capacity)
+        {
+            capacity *= 2;
+        }
+        out->data = realloc(out->data, capacity);
+        out->capacity = capacity;
+    }
+    memcpy(out->data + out->length, text, len + 1);
+    out->length += len;
+}
+
+static void print_item(const cJSON *item, print_buffer_t *out)
+{
+    char number[40];
+    if (item->string)
+    {
+        put(out, "\"");
+        put(out, item->string);
+        put(out, "\":");
+    }
+    switch (item->type)
+    {
+    case cJSON_Number:
+        if (item->valuedouble == (double)(long long)item->valuedouble)
+        {
+            snprintf(number, sizeof(number), "%lld", (long long)item->valuedouble);
+        }
+        else
+        {
+            snprintf(number, sizeof(number), "%.6g", item->valuedouble);
+        }
+        put(out, number);
+        break;
+    case cJSON_String:
+        put(out, "\"");
+        put(out, item->valuestring);
+        put(out, "\"");
+        break;
+    case HOST_CJSON_RAW:
+        put(out, item->valuestring);
+        break;
+    default:
+        put(out, item->type == cJSON_Object ? "{" : "[");
+        for (const cJSON *child = item->child; child; child = child->next)
+        {
+            print_item(child, out);
+            if (child->next)
+            {
+                put(out, ",");
+            }
+        }
+        put(out, item->type == cJSON_Object ? "}" : "]");
+        break;
+    }
+}
+
+char *cJSON_PrintUnformatted(const cJSON *item)
+{
+    print_buffer_t out = {0};
+    if (item)
+    {
+        print_item(item, &out);
+    }
+    return out.data;
+}
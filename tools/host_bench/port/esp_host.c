@@ -0,0 +1,199 @@
+/**
+ * @file esp_host.c
+ * @brief ESP-IDF services (time, logging, error names, heap) for the host benchmarks.
+ * @details The benchmark binaries are linked with `-Wl,--wrap=` for malloc,
+ *          calloc, realloc, strdup and free, so every allocation made by the
+ *          core sources passes through the counters below.
+ */
+#define _GNU_SOURCE
+#include <malloc.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp_cpu.h"
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "host_port.h"
+
+// --- Heap allocation counters ---
+
+static uint64_t s_allocs = 0;
+static uint64_t s_frees = 0;
+static uint64_t s_isr_allocs = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+char *__real_strdup(const char *str);
+void __real_free(void *ptr);
+
+static inline void count_alloc(void)
+{
+    __atomic_fetch_add(&s_allocs, 1, __ATOMIC_RELAXED);
+    if (host_port_in_isr())
+    {
+        __atomic_fetch_add(&s_isr_allocs, 1, __ATOMIC_RELAXED);
+    }
+}
+
+void *__wrap_malloc(size_t size)
+{
+    count_alloc();
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    count_alloc();
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    count_alloc();
+    return __real_realloc(ptr, size);
+}
+
+char *__wrap_strdup(const char *str)
+{
+    count_alloc();
+    return __real_strdup(str);
+}
+
+void __wrap_free(void *ptr)
+{
+    if (ptr)
+    {
+        __atomic_fetch_add(&s_frees, 1, __ATOMIC_RELAXED);
+    }
+    __real_free(ptr);
+}
+
+uint64_t host_port_alloc_count(void)
+{
+    return __atomic_load_n(&s_allocs, __ATOMIC_RELAXED);
+}
+
+void host_port_get_alloc_stats(uint64_t *allocs, uint64_t *frees, uint64_t *isr_allocs)
+{
+    *allocs = __atomic_load_n(&s_allocs, __ATOMIC_RELAXED);
+    *frees = __atomic_load_n(&s_frees, __ATOMIC_RELAXED);
+    *isr_allocs = __atomic_load_n(&s_isr_allocs, __ATOMIC_RELAXED);
+}
+
+// --- Time ---
+
+int64_t esp_timer_get_time(void)
+{
+    return (int64_t)(host_port_now_ns() / 1000);
+}
+
+esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void)
+{
+    return (esp_cpu_cycle_count_t)host_port_now_ns();
+}
+
+// --- Logging ---
+
+void host_log_write(char level, const char *tag, const char *format, ...)
+{
+    static int s_enabled = -1;
+    if (s_enabled < 0)
+    {
+        s_enabled = getenv("SYNAPSE_HOST_LOG") != NULL;
+    }
+    if (!s_enabled)
+    {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "%c (%lld) %s: ", level, (long long)(esp_timer_get_time() / 1000), tag);
+    vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+// --- Errors ---
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code)
+    {
+    case ESP_OK:
+        return "ESP_OK";
+    case ESP_FAIL:
+        return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:
+        return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:
+        return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE:
+        return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE:
+        return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND:
+        return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_NOT_SUPPORTED:
+        return "ESP_ERR_NOT_SUPPORTED";
+    case ESP_ERR_TIMEOUT:
+        return "ESP_ERR_TIMEOUT";
+    case ESP_ERR_INVALID_RESPONSE:
+        return "ESP_ERR_INVALID_RESPONSE";
+    case ESP_ERR_INVALID_VERSION:
+        return "ESP_ERR_INVALID_VERSION";
+    case ESP_ERR_NOT_FINISHED:
+        return "ESP_ERR_NOT_FINISHED";
+    default:
+        return "UNKNOWN ERROR";
+    }
+}
+
+// --- System and heap ---
+
+void esp_restart(void)
+{
+    fprintf(stderr, "esp_restart() called\n");
+    exit(2);
+}
+
+static size_t heap_free_estimate(void)
+{
+    struct mallinfo2 info = mallinfo2();
+    return info.fordblks;
+}
+
+uint32_t esp_get_free_heap_size(void)
+{
+    return (uint32_t)heap_free_estimate();
+}
+
+uint32_t esp_get_minimum_free_heap_size(void)
+{
+    return (uint32_t)heap_free_estimate();
+}
+
+size_t heap_caps_get_free_size(uint32_t caps)
+{
+    (void)caps;
+    return heap_free_estimate();
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps)
+{
+    (void)caps;
+    return heap_free_estimate();
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps)
+{
+    (void)caps;
+    return heap_free_estimate();
+}
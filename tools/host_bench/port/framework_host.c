@@ -0,0 +1,48 @@
+/**
+ * @file framework_host.c
+ * @brief Framework pieces outside the Event Bus that the benchmarked sources link against.
+ * @details The real module registry builds modules from the configuration
+ *          (Config Manager, factory, NVS). The benchmarks create their modules
+ *          directly and add them here, so statistics, trace names and static
+ *          routes see the same list a device would.
+ */
+#include <string.h>
+
+#include "module_registry.h"
+#include "synapse_utils.h"
+#include "host_bench.h"
+
+static const module_t *s_modules[CONFIG_SYNAPSE_MAX_MODULES];
+static uint8_t s_module_count = 0;
+
+esp_err_t host_registry_add(module_t *module)
+{
+    if (s_module_count >= CONFIG_SYNAPSE_MAX_MODULES)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    s_modules[s_module_count++] = module;
+    return ESP_OK;
+}
+
+esp_err_t synapse_module_registry_get_all(const module_t ***modules, uint8_t *count)
+{
+    if (!modules || !count)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *modules = s_modules;
+    *count = s_module_count;
+    return ESP_OK;
+}
+
+char *synapse_safe_strncpy(char *dest, const char *src, size_t size)
+{
+    if (!dest || size == 0)
+    {
+        return dest;
+    }
+    strncpy(dest, src ? src : "", size - 1);
+    dest[size - 1] = '\0';
+    return dest;
+}
@@ -0,0 +1,755 @@
+/**
+ * @file freertos_posix.c
+ * @brief FreeRTOS API subset on top of pthreads for the host benchmarks.
+ * @details Queues and semaphores are ring buffers guarded by a mutex and a
+ *          condition variable; tasks are detached pthreads; one service thread
+ *          runs the software timers. Priorities are accepted and ignored, so
+ *          results describe the core's own cost, not FreeRTOS scheduling.
+ *
+ *          Simulated interrupt context (see host_port.h) is tracked per thread.
+ *          Task-only calls made inside it are counted in `isr_api_violations`,
+ *          and FromISR calls report `*higher_priority_task_woken` when a task
+ *          was blocked on the queue, as the real kernel does.
+ */
+#define _GNU_SOURCE
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+#include "host_port.h"
+
+// --- Simulated interrupt context and counters ---
+
+static __thread int s_isr_nesting = 0;
+static __thread int s_core_id = 0;
+
+static uint64_t s_isr_api_violations = 0;
+static uint64_t s_isr_yield_requests = 0;
+static uint64_t s_isr_woken_reported = 0;
+static uint64_t s_isr_woken_lost = 0;
+
+void host_port_isr_enter(void)
+{
+    s_isr_nesting++;
+}
+
+void host_port_isr_exit(void)
+{
+    s_isr_nesting--;
+}
+
+bool host_port_in_isr(void)
+{
+    return s_isr_nesting > 0;
+}
+
+void host_port_set_core(int core)
+{
+    s_core_id = core;
+}
+
+uint64_t host_port_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/** @brief Counts a task-only API call made in simulated interrupt context. */
+static void check_task_context(const char *api)
+{
+    if (s_isr_nesting > 0)
+    {
+        if (__atomic_fetch_add(&s_isr_api_violations, 1, __ATOMIC_RELAXED) == 0)
+        {
+            fprintf(stderr, "host_port: %s() called from interrupt context\n", api);
+        }
+    }
+}
+
+void host_port_yield_from_isr(BaseType_t higher_priority_task_woken)
+{
+    if (higher_priority_task_woken)
+    {
+        __atomic_fetch_add(&s_isr_yield_requests, 1, __ATOMIC_RELAXED);
+    }
+}
+
+/** @brief Implemented in esp_host.c next to the allocation wrappers. */
+void host_port_get_alloc_stats(uint64_t *allocs, uint64_t *frees, uint64_t *isr_allocs);
+
+void host_port_get_stats(host_port_stats_t *stats)
+{
+    host_port_get_alloc_stats(&stats->allocs, &stats->frees, &stats->isr_allocs);
+    stats->isr_api_violations = __atomic_load_n(&s_isr_api_violations, __ATOMIC_RELAXED);
+    stats->isr_yield_requests = __atomic_load_n(&s_isr_yield_requests, __ATOMIC_RELAXED);
+    stats->isr_woken_reported = __atomic_load_n(&s_isr_woken_reported, __ATOMIC_RELAXED);
+    stats->isr_woken_lost = __atomic_load_n(&s_isr_woken_lost, __ATOMIC_RELAXED);
+}
+
+// --- Critical sections ---
+
+static pthread_mutex_t s_critical = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+void vPortEnterCritical(portMUX_TYPE *mux)
+{
+    (void)mux;
+    pthread_mutex_lock(&s_critical);
+}
+
+void vPortExitCritical(portMUX_TYPE *mux)
+{
+    (void)mux;
+    pthread_mutex_unlock(&s_critical);
+}
+
+// Scheduler suspension only groups queue operations on a real target; other threads keep running here.
+void vTaskSuspendAll(void)
+{
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+    return pdFALSE;
+}
+
+void *pvPortMalloc(size_t size)
+{
+    return malloc(size);
+}
+
+void vPortFree(void *ptr)
+{
+    free(ptr);
+}
+
+// --- Time ---
+
+static int64_t s_start_us = 0;
+
+__attribute__((constructor)) static void port_clock_init(void)
+{
+    s_start_us = esp_timer_get_time();
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)((esp_timer_get_time() - s_start_us) / (1000 * portTICK_PERIOD_MS));
+}
+
+TickType_t xTaskGetTickCountFromISR(void)
+{
+    return xTaskGetTickCount();
+}
+
+/** @brief Converts a tick timeout into an absolute CLOCK_MONOTONIC deadline. */
+static void deadline_from_ticks(struct timespec *ts, TickType_t ticks)
+{
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    uint64_t ns = (uint64_t)ticks * portTICK_PERIOD_MS * 1000000ULL;
+    ts->tv_sec += (time_t)(ns / 1000000000ULL);
+    ts->tv_nsec += (long)(ns % 1000000000ULL);
+    if (ts->tv_nsec >= 1000000000L)
+    {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+/** @brief Waits on `cond`; returns false when the tick timeout expired. */
+static bool wait_ticks(pthread_cond_t *cond, pthread_mutex_t *mutex, TickType_t ticks, const struct timespec *deadline)
+{
+    if (ticks == portMAX_DELAY)
+    {
+        pthread_cond_wait(cond, mutex);
+        return true;
+    }
+    return pthread_cond_timedwait(cond, mutex, deadline) != ETIMEDOUT;
+}
+
+static void cond_init_monotonic(pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+// --- Queues and semaphores ---
+
+struct host_queue_t
+{
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    uint8_t *storage;
+    size_t item_size;
+    size_t length;
+    size_t head;
+    size_t count;
+    uint32_t waiting_receivers;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    QueueHandle_t queue = calloc(1, sizeof(*queue));
+    if (!queue)
+    {
+        return NULL;
+    }
+    queue->storage = calloc(length ? length : 1, item_size ? item_size : 1);
+    if (!queue->storage)
+    {
+        free(queue);
+        return NULL;
+    }
+    pthread_mutex_init(&queue->lock, NULL);
+    cond_init_monotonic(&queue->changed);
+    queue->item_size = item_size;
+    queue->length = length;
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    if (queue)
+    {
+        pthread_mutex_destroy(&queue->lock);
+        pthread_cond_destroy(&queue->changed);
+        free(queue->storage);
+        free(queue);
+    }
+}
+
+/** @brief Common send path; `woken` reports whether a receiver was blocked on the queue. */
+static BaseType_t queue_send(QueueHandle_t queue, const void *item, TickType_t ticks, bool front, BaseType_t *woken)
+{
+    struct timespec deadline;
+    deadline_from_ticks(&deadline, ticks);
+
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == queue->length)
+    {
+        if (ticks == 0 || !wait_ticks(&queue->changed, &queue->lock, ticks, &deadline))
+        {
+            if (queue->count == queue->length)
+            {
+                pthread_mutex_unlock(&queue->lock);
+                return errQUEUE_FULL;
+            }
+        }
+    }
+
+    size_t index;
+    if (front)
+    {
+        queue->head = (queue->head + queue->length - 1) % queue->length;
+        index = queue->head;
+    }
+    else
+    {
+        index = (queue->head + queue->count) % queue->length;
+    }
+    if (queue->item_size && item)
+    {
+        memcpy(queue->storage + index * queue->item_size, item, queue->item_size);
+    }
+    queue->count++;
+    if (woken && queue->waiting_receivers > 0)
+    {
+        *woken = pdTRUE;
+    }
+    pthread_cond_broadcast(&queue->changed);
+    pthread_mutex_unlock(&queue->lock);
+    return pdPASS;
+}
+
+static BaseType_t queue_receive(QueueHandle_t queue, void *item, TickType_t ticks, bool peek)
+{
+    struct timespec deadline;
+    deadline_from_ticks(&deadline, ticks);
+
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == 0)
+    {
+        if (ticks == 0)
+        {
+            pthread_mutex_unlock(&queue->lock);
+            return pdFAIL;
+        }
+        queue->waiting_receivers++;
+        bool signalled = wait_ticks(&queue->changed, &queue->lock, ticks, &deadline);
+        queue->waiting_receivers--;
+        if (!signalled && queue->count == 0)
+        {
+            pthread_mutex_unlock(&queue->lock);
+            return pdFAIL;
+        }
+    }
+
+    if (queue->item_size && item)
+    {
+        memcpy(item, queue->storage + queue->head * queue->item_size, queue->item_size);
+    }
+    if (!peek)
+    {
+        queue->head = (queue->head + 1) % queue->length;
+        queue->count--;
+        pthread_cond_broadcast(&queue->changed);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return pdPASS;
+}
+
+/** @brief Reports a woken task through the caller's flag and counts it. */
+static BaseType_t send_from_isr(QueueHandle_t queue, const void *item, BaseType_t *higher_priority_task_woken)
+{
+    BaseType_t woken = pdFALSE;
+    BaseType_t ret = queue_send(queue, item, 0, false, &woken);
+    if (woken && higher_priority_task_woken)
+    {
+        __atomic_fetch_add(&s_isr_woken_reported, 1, __ATOMIC_RELAXED);
+        *higher_priority_task_woken = pdTRUE;
+    }
+    else if (woken)
+    {
+        __atomic_fetch_add(&s_isr_woken_lost, 1, __ATOMIC_RELAXED);
+    }
+    return ret;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks)
+{
+    check_task_context("xQueueSend");
+    return queue_send(queue, item, ticks, false, NULL);
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t ticks)
+{
+    check_task_context("xQueueSendToBack");
+    return queue_send(queue, item, ticks, false, NULL);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void *item, TickType_t ticks)
+{
+    check_task_context("xQueueSendToFront");
+    return queue_send(queue, item, ticks, true, NULL);
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void *item, BaseType_t *higher_priority_task_woken)
+{
+    return send_from_isr(queue, item, higher_priority_task_woken);
+}
+
+BaseType_t xQueueSendToBackFromISR(QueueHandle_t queue, const void *item, BaseType_t *higher_priority_task_woken)
+{
+    return send_from_isr(queue, item, higher_priority_task_woken);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks)
+{
+    check_task_context("xQueueReceive");
+    return queue_receive(queue, item, ticks, false);
+}
+
+BaseType_t xQueueReceiveFromISR(QueueHandle_t queue, void *item, BaseType_t *higher_priority_task_woken)
+{
+    (void)higher_priority_task_woken;
+    return queue_receive(queue, item, 0, false);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void *item, TickType_t ticks)
+{
+    check_task_context("xQueuePeek");
+    return queue_receive(queue, item, ticks, true);
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue)
+{
+    pthread_mutex_lock(&queue->lock);
+    queue->head = 0;
+    queue->count = 0;
+    pthread_cond_broadcast(&queue->changed);
+    pthread_mutex_unlock(&queue->lock);
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    check_task_context("uxQueueMessagesWaiting");
+    return uxQueueMessagesWaitingFromISR(queue);
+}
+
+UBaseType_t uxQueueMessagesWaitingFromISR(QueueHandle_t queue)
+{
+    pthread_mutex_lock(&queue->lock);
+    UBaseType_t count = (UBaseType_t)queue->count;
+    pthread_mutex_unlock(&queue->lock);
+    return count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue)
+{
+    pthread_mutex_lock(&queue->lock);
+    UBaseType_t spaces = (UBaseType_t)(queue->length - queue->count);
+    pthread_mutex_unlock(&queue->lock);
+    return spaces;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    SemaphoreHandle_t mutex = xQueueCreate(1, 0);
+    if (mutex)
+    {
+        mutex->count = 1;
+    }
+    return mutex;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return xQueueCreate(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count, UBaseType_t initial_count)
+{
+    SemaphoreHandle_t semaphore = xQueueCreate(max_count, 0);
+    if (semaphore)
+    {
+        semaphore->count = initial_count;
+    }
+    return semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks)
+{
+    check_task_context("xSemaphoreTake");
+    return queue_receive(semaphore, NULL, ticks, false);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    check_task_context("xSemaphoreGive");
+    return queue_send(semaphore, NULL, 0, false, NULL);
+}
+
+BaseType_t xSemaphoreTakeFromISR(SemaphoreHandle_t semaphore, BaseType_t *higher_priority_task_woken)
+{
+    (void)higher_priority_task_woken;
+    return queue_receive(semaphore, NULL, 0, false);
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t *higher_priority_task_woken)
+{
+    return send_from_isr(semaphore, NULL, higher_priority_task_woken);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore)
+{
+    vQueueDelete(semaphore);
+}
+
+// --- Tasks ---
+
+struct host_task_t
+{
+    pthread_t thread;
+    TaskFunction_t fn;
+    void *arg;
+    int core;
+    pthread_mutex_t lock;
+    pthread_cond_t notified;
+    uint32_t notify_value;
+    bool waiting;
+};
+
+static __thread struct host_task_t *s_current_task = NULL;
+
+static struct host_task_t *task_alloc(int core)
+{
+    struct host_task_t *task = calloc(1, sizeof(*task));
+    if (task)
+    {
+        task->core = core;
+        pthread_mutex_init(&task->lock, NULL);
+        cond_init_monotonic(&task->notified);
+    }
+    return task;
+}
+
+static void *task_entry(void *arg)
+{
+    struct host_task_t *task = arg;
+    s_current_task = task;
+    s_core_id = task->core;
+    task->fn(task->arg);
+    return NULL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg,
+                                   UBaseType_t priority, TaskHandle_t *handle, BaseType_t core_id)
+{
+    (void)name;
+    (void)stack_depth;
+    (void)priority;
+    struct host_task_t *task = task_alloc((core_id >= 0 && core_id < portNUM_PROCESSORS) ? core_id : 0);
+    if (!task)
+    {
+        return pdFAIL;
+    }
+    task->fn = fn;
+    task->arg = arg;
+    if (handle)
+    {
+        *handle = task;
+    }
+    if (pthread_create(&task->thread, NULL, task_entry, task) != 0)
+    {
+        free(task);
+        return pdFAIL;
+    }
+    pthread_detach(task->thread);
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg, UBaseType_t priority,
+                       TaskHandle_t *handle)
+{
+    return xTaskCreatePinnedToCore(fn, name, stack_depth, arg, priority, handle, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    if (task == NULL || task == s_current_task)
+    {
+        pthread_exit(NULL);
+    }
+    // Another task cannot be stopped safely on pthreads; the core only deletes tasks that already returned.
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    check_task_context("vTaskDelay");
+    usleep((useconds_t)ticks * portTICK_PERIOD_MS * 1000);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    if (!s_current_task)
+    {
+        s_current_task = task_alloc(s_core_id);
+    }
+    return s_current_task;
+}
+
+BaseType_t xTaskGetCoreID(TaskHandle_t task)
+{
+    return task ? task->core : s_core_id;
+}
+
+BaseType_t xPortGetCoreID(void)
+{
+    return s_core_id;
+}
+
+BaseType_t xPortInIsrContext(void)
+{
+    return s_isr_nesting > 0;
+}
+
+static BaseType_t notify_give(TaskHandle_t task)
+{
+    pthread_mutex_lock(&task->lock);
+    bool waiting = task->waiting;
+    task->notify_value++;
+    pthread_cond_broadcast(&task->notified);
+    pthread_mutex_unlock(&task->lock);
+    return waiting ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    check_task_context("xTaskNotifyGive");
+    notify_give(task);
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_task_woken)
+{
+    if (notify_give(task))
+    {
+        __atomic_fetch_add(&s_isr_woken_reported, 1, __ATOMIC_RELAXED);
+        if (higher_priority_task_woken)
+        {
+            *higher_priority_task_woken = pdTRUE;
+        }
+    }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks)
+{
+    check_task_context("ulTaskNotifyTake");
+    struct host_task_t *task = xTaskGetCurrentTaskHandle();
+    struct timespec deadline;
+    deadline_from_ticks(&deadline, ticks);
+
+    pthread_mutex_lock(&task->lock);
+    task->waiting = true;
+    while (task->notify_value == 0 && ticks != 0)
+    {
+        if (!wait_ticks(&task->notified, &task->lock, ticks, &deadline))
+        {
+            break;
+        }
+    }
+    task->waiting = false;
+    uint32_t value = task->notify_value;
+    if (value)
+    {
+        task->notify_value = clear_on_exit ? 0 : value - 1;
+    }
+    pthread_mutex_unlock(&task->lock);
+    return value;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task)
+{
+    (void)task;
+    return 1024;
+}
+
+// --- Software timers ---
+
+struct host_timer_t
+{
+    TimerCallbackFunction_t callback;
+    void *id;
+    TickType_t period;
+    bool auto_reload;
+    bool active;
+    bool deleted;
+    int64_t expiry_us;
+    struct host_timer_t *next;
+};
+
+static pthread_mutex_t s_timers_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct host_timer_t *s_timers = NULL;
+static pthread_once_t s_timer_thread_once = PTHREAD_ONCE_INIT;
+
+/** @brief Timer service thread: polls once per tick and runs expired callbacks outside the lock. */
+static void *timer_service(void *arg)
+{
+    (void)arg;
+    for (;;)
+    {
+        usleep(portTICK_PERIOD_MS * 1000);
+        int64_t now = esp_timer_get_time();
+        struct host_timer_t *due[64];
+        size_t due_count = 0;
+
+        pthread_mutex_lock(&s_timers_lock);
+        struct host_timer_t **link = &s_timers;
+        while (*link)
+        {
+            struct host_timer_t *timer = *link;
+            if (timer->deleted)
+            {
+                *link = timer->next;
+                free(timer);
+                continue;
+            }
+            if (timer->active && now >= timer->expiry_us && due_count < sizeof(due) / sizeof(due[0]))
+            {
+                due[due_count++] = timer;
+                if (timer->auto_reload)
+                {
+                    timer->expiry_us += (int64_t)timer->period * portTICK_PERIOD_MS * 1000;
+                }
+                else
+                {
+                    timer->active = false;
+                }
+            }
+            link = &timer->next;
+        }
+        pthread_mutex_unlock(&s_timers_lock);
+
+        for (size_t i = 0; i < due_count; i++)
+        {
+            due[i]->callback(due[i]);
+        }
+    }
+    return NULL;
+}
+
+static void timer_thread_start(void)
+{
+    pthread_t thread;
+    pthread_create(&thread, NULL, timer_service, NULL);
+    pthread_detach(thread);
+}
+
+TimerHandle_t xTimerCreate(const char *name, TickType_t period, UBaseType_t auto_reload, void *timer_id,
+                           TimerCallbackFunction_t callback)
+{
+    (void)name;
+    struct host_timer_t *timer = calloc(1, sizeof(*timer));
+    if (!timer)
+    {
+        return NULL;
+    }
+    timer->callback = callback;
+    timer->id = timer_id;
+    timer->period = period;
+    timer->auto_reload = auto_reload;
+
+    pthread_once(&s_timer_thread_once, timer_thread_start);
+    pthread_mutex_lock(&s_timers_lock);
+    timer->next = s_timers;
+    s_timers = timer;
+    pthread_mutex_unlock(&s_timers_lock);
+    return timer;
+}
+
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticks)
+{
+    (void)ticks;
+    pthread_mutex_lock(&s_timers_lock);
+    timer->expiry_us = esp_timer_get_time() + (int64_t)timer->period * portTICK_PERIOD_MS * 1000;
+    timer->active = true;
+    pthread_mutex_unlock(&s_timers_lock);
+    return pdPASS;
+}
+
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticks)
+{
+    (void)ticks;
+    pthread_mutex_lock(&s_timers_lock);
+    timer->active = false;
+    pthread_mutex_unlock(&s_timers_lock);
+    return pdPASS;
+}
+
+BaseType_t xTimerDelete(TimerHandle_t timer, TickType_t ticks)
+{
+    (void)ticks;
+    pthread_mutex_lock(&s_timers_lock);
+    timer->active = false;
+    timer->deleted = true;
+    pthread_mutex_unlock(&s_timers_lock);
+    return pdPASS;
+}
+
+void *pvTimerGetTimerID(TimerHandle_t timer)
+{
+    return timer->id;
+}
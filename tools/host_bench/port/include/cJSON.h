@@ -0,0 +1,46 @@
+/**
+ * @file cJSON.h
+ * @brief Minimal host cJSON: the builder and printer subset used by the core statistics.
+ * @details Values are printed without escaping; keys and strings produced by
+ *          the core are identifiers and event names.
+ */
+#pragma once
+
+#include <stdbool.h>
+
+#define cJSON_Invalid (0)
+#define cJSON_Number (1 << 3)
+#define cJSON_String (1 << 4)
+#define cJSON_Array (1 << 5)
+#define cJSON_Object (1 << 6)
+
+typedef struct cJSON
+{
+    struct cJSON *next;
+    struct cJSON *prev;
+    struct cJSON *child;
+    int type;
+    char *valuestring;
+    int valueint;
+    double valuedouble;
+    char *string;
+} cJSON;
+
+#define cJSON_ArrayForEach(element, array) \
+    for (element = (array != NULL) ? (array)->child : NULL; element != NULL; element = element->next)
+
+cJSON *cJSON_CreateObject(void);
+cJSON *cJSON_CreateArray(void);
+cJSON *cJSON_CreateNumber(double number);
+cJSON *cJSON_CreateString(const char *string);
+cJSON *cJSON_AddNumberToObject(cJSON *object, const char *name, double number);
+cJSON *cJSON_AddStringToObject(cJSON *object, const char *name, const char *string);
+cJSON *cJSON_AddBoolToObject(cJSON *object, const char *name, bool boolean);
+cJSON *cJSON_AddRawToObject(cJSON *object, const char *name, const char *raw);
+cJSON *cJSON_AddObjectToObject(cJSON *object, const char *name);
+cJSON *cJSON_AddArrayToObject(cJSON *object, const char *name);
+bool cJSON_AddItemToObject(cJSON *object, const char *name, cJSON *item);
+bool cJSON_AddItemToArray(cJSON *array, cJSON *item);
+cJSON *cJSON_GetObjectItem(const cJSON *object, const char *name);
+char *cJSON_PrintUnformatted(const cJSON *item);
+void cJSON_Delete(cJSON *item);
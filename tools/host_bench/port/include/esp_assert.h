@@ -0,0 +1,7 @@
+/**
+ * @file esp_assert.h
+ * @brief Host stand-in for ESP-IDF static assertions.
+ */
+#pragma once
+
+#include <assert.h>
@@ -0,0 +1,11 @@
+/**
+ * @file esp_cpu.h
+ * @brief Host stand-in for the CPU cycle counter (nanoseconds, i.e. a 1 GHz "CPU").
+ */
+#pragma once
+
+#include <stdint.h>
+
+typedef uint32_t esp_cpu_cycle_count_t;
+
+esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void);
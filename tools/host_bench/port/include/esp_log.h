@@ -0,0 +1,21 @@
+/**
+ * @file esp_log.h
+ * @brief Host stand-in for ESP-IDF logging.
+ * @details Messages go to stderr only when `SYNAPSE_HOST_LOG` is set in the
+ *          environment, so benchmark runs are not slowed by formatting.
+ */
+#pragma once
+
+#include <stdio.h>
+#include <inttypes.h>
+#include "esp_err.h"
+
+void host_log_write(char level, const char *tag, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+#define ESP_LOGE(tag, ...) host_log_write('E', tag, __VA_ARGS__)
+#define ESP_LOGW(tag, ...) host_log_write('W', tag, __VA_ARGS__)
+#define ESP_LOGI(tag, ...) host_log_write('I', tag, __VA_ARGS__)
+#define ESP_LOGD(tag, ...) host_log_write('D', tag, __VA_ARGS__)
+#define ESP_LOGV(tag, ...) host_log_write('V', tag, __VA_ARGS__)
+#define ESP_EARLY_LOGE(tag, ...) host_log_write('E', tag, __VA_ARGS__)
+#define ESP_DRAM_LOGE(tag, ...) host_log_write('E', tag, __VA_ARGS__)
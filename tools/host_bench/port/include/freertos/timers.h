@@ -0,0 +1,17 @@
+/**
+ * @file timers.h
+ * @brief Host stand-in for FreeRTOS software timers (one service thread, 1 ms resolution).
+ */
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct host_timer_t *TimerHandle_t;
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t);
+
+TimerHandle_t xTimerCreate(const char *name, TickType_t period, UBaseType_t auto_reload, void *timer_id,
+                           TimerCallbackFunction_t callback);
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticks);
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticks);
+BaseType_t xTimerDelete(TimerHandle_t timer, TickType_t ticks);
+void *pvTimerGetTimerID(TimerHandle_t timer);
@@ -0,0 +1,59 @@
+/**
+ * @file host_port.h
+ * @brief Controls and counters of the host FreeRTOS/ESP-IDF port used by the benchmarks.
+ * @details The port runs the core component unmodified on pthreads. On top of
+ *          the FreeRTOS API it offers what a benchmark needs to observe:
+ *          - a simulated interrupt context (`host_port_isr_enter()`), in which
+ *            `xPortInIsrContext()` is true and every task-only API call or heap
+ *            allocation is counted as a violation;
+ *          - heap allocation counters (the binary is linked with `--wrap=malloc`);
+ *          - a per-thread "core" label returned by `xPortGetCoreID()`.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Counters of the host port. All are cumulative since program start.
+     */
+    typedef struct
+    {
+        uint64_t allocs;              /**< malloc/calloc/realloc/strdup calls. */
+        uint64_t frees;               /**< free calls with a non-NULL pointer. */
+        uint64_t isr_allocs;          /**< Heap allocations made in simulated interrupt context. */
+        uint64_t isr_api_violations;  /**< Task-only FreeRTOS calls made in simulated interrupt context. */
+        uint64_t isr_yield_requests;  /**< `portYIELD_FROM_ISR(pdTRUE)` calls. */
+        uint64_t isr_woken_reported;  /**< FromISR calls that reported a woken task through the caller's flag. */
+        uint64_t isr_woken_lost;      /**< FromISR calls that woke a task but got no flag (the context switch is lost). */
+    } host_port_stats_t;
+
+    /** @brief Enters simulated interrupt context on the calling thread (may nest). */
+    void host_port_isr_enter(void);
+
+    /** @brief Leaves simulated interrupt context. */
+    void host_port_isr_exit(void);
+
+    /** @brief Returns true while the calling thread is in simulated interrupt context. */
+    bool host_port_in_isr(void);
+
+    /** @brief Sets the core label that `xPortGetCoreID()` returns on the calling thread. */
+    void host_port_set_core(int core);
+
+    /** @brief Reads the port counters. */
+    void host_port_get_stats(host_port_stats_t *stats);
+
+    /** @brief Returns the number of heap allocations made so far (cheap; for per-event deltas). */
+    uint64_t host_port_alloc_count(void);
+
+    /** @brief Returns a monotonic time stamp in nanoseconds. */
+    uint64_t host_port_now_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
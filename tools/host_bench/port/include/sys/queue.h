@@ -0,0 +1,16 @@
+/**
+ * @file queue.h
+ * @brief Adds the BSD list macros that glibc's <sys/queue.h> lacks.
+ */
+#pragma once
+
+#include_next <sys/queue.h>
+
+#ifndef SLIST_REMOVE_AFTER
+#define SLIST_REMOVE_AFTER(elm, field) ((elm)->field.sle_next = (elm)->field.sle_next->field.sle_next)
+#endif
+
+#ifndef SLIST_FOREACH_SAFE
+#define SLIST_FOREACH_SAFE(var, head, field, tvar) \
+    for ((var) = SLIST_FIRST((head)); (var) && ((tvar) = SLIST_NEXT((var), field), 1); (var) = (tvar))
+#endif
@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+"""
+Synapse trace decoder.
+
+Reads the `SYNTRACE` lines printed by `synapse_trace_dump()` (or the Command
+Router `trace dump` command) from a serial log and writes a Chrome / Perfetto
+trace JSON file (open it in chrome://tracing or https://ui.perfetto.dev).
+
+Usage:
+    python tools/synapse_trace_decode.py <serial.log> [-o trace.json]
+    idf.py monitor | tee serial.log      # then run "trace dump" on the device
+"""
+import argparse
+import json
+import re
+import struct
+import sys
+from pathlib import Path
+
+FORMAT_VERSION = 1
+RECORD = struct.Struct("<IBBHII")  # timestamp, type, core, id, arg, task
+
+EVENT_POST = 1
+EVENT_DEQUEUE = 2
+HANDLER_ENTER = 3
+HANDLER_EXIT = 4
+JOB_START = 5
+JOB_END = 6
+PROMISE_SETTLE = 7
+PROMISE_CB_START = 8
+PROMISE_CB_END = 9
+EVENT_DROP = 10
+
+LANE_NAMES = {0: "critical", 1: "normal", 2: "bulk"}
+LINE_RE = re.compile(r"SYNTRACE (\w+)(?: (.*))?$")
+
+
+def parse_dump(lines):
+    """Returns (header, event_names, module_names, records) of the last complete dump in the log."""
+    dumps = []
+    current = None
+    for raw in lines:
+        match = LINE_RE.search(raw.rstrip("\r\n"))
+        if not match:
+            continue
+        kind, rest = match.group(1), match.group(2) or ""
+        if kind == "BEGIN":
+            version, cpu_mhz, count, lost = (int(v) for v in rest.split())
+            if version != FORMAT_VERSION:
+                raise ValueError(f"Unsupported trace format version {version}")
+            current = {"cpu_mhz": cpu_mhz, "count": count, "lost": lost,
+                       "events": {}, "modules": {}, "data": bytearray()}
+        elif current is None:
+            continue
+        elif kind == "E":
+            event_id, _, name = rest.partition(" ")
+            current["events"][int(event_id)] = name
+        elif kind == "M":
+            address, _, name = rest.partition(" ")
+            current["modules"][int(address, 16)] = name
+        elif kind == "R":
+            current["data"].extend(bytes.fromhex(rest.strip()))
+        elif kind == "END":
+            dumps.append(current)
+            current = None
+
+    if not dumps:
+        raise ValueError("No complete 'SYNTRACE BEGIN ... END' block found")
+    dump = dumps[-1]
+    records = [RECORD.unpack_from(dump["data"], off) for off in range(0, len(dump["data"]), RECORD.size)]
+    return dump, records
+
+
+def unwrap_timestamps(records, cpu_mhz):
+    """Converts the 32-bit per-core cycle counters to monotonic microseconds."""
+    last = {}
+    high = {}
+    result = []
+    for timestamp, _, core, _, _, _ in records:
+        if core in last and timestamp < last[core]:
+            high[core] = high.get(core, 0) + (1 << 32)
+        last[core] = timestamp
+        result.append((high.get(core, 0) + timestamp) / cpu_mhz)
+    base = min(result) if result else 0.0
+    return [t - base for t in result]
+
+
+def to_chrome_trace(dump, records):
+    events = dump["events"]
+    modules = dump["modules"]
+    times = unwrap_timestamps(records, dump["cpu_mhz"])
+    trace = []
+    thread_roles = {}
+
+    def event_name(event_id):
+        return events.get(event_id, f"event#{event_id}")
+
+    for (timestamp, rtype, core, rid, arg, task), ts in zip(records, times):
+        common = {"pid": core, "tid": task, "ts": round(ts, 3)}
+        if rtype == EVENT_POST:
+            lane = LANE_NAMES.get(arg >> 16, str(arg >> 16))
+            depth = arg & 0xFFFF
+            trace.append({**common, "ph": "i", "s": "t", "name": f"post {event_name(rid)}",
+                          "cat": "event", "args": {"lane": lane, "queue_depth": depth}})
+            trace.append({**common, "ph": "C", "name": f"queue depth ({lane})", "args": {"depth": depth}})
+        elif rtype == EVENT_DEQUEUE:
+            thread_roles.setdefault(task, "event dispatcher")
+            trace.append({**common, "ph": "i", "s": "t", "name": f"dequeue {event_name(rid)}",
+                          "cat": "event", "args": {"latency_us": arg}})
+        elif rtype in (HANDLER_ENTER, HANDLER_EXIT):
+            module = modules.get(arg, f"module@{arg:08x}")
+            trace.append({**common, "ph": "B" if rtype == HANDLER_ENTER else "E",
+                          "name": f"{module}: {event_name(rid)}", "cat": "handler"})
+        elif rtype in (JOB_START, JOB_END):
+            thread_roles.setdefault(task, "task pool worker")
+            trace.append({**common, "ph": "B" if rtype == JOB_START else "E",
+                          "name": f"job {arg:08x}", "cat": "task_pool"})
+        elif rtype == PROMISE_SETTLE:
+            trace.append({**common, "ph": "i", "s": "t", "cat": "promise",
+                          "name": f"promise #{arg} {'resolved' if rid else 'rejected'}"})
+        elif rtype in (PROMISE_CB_START, PROMISE_CB_END):
+            thread_roles.setdefault(task, "promise manager")
+            trace.append({**common, "ph": "B" if rtype == PROMISE_CB_START else "E",
+                          "name": f"promise #{arg} callback", "cat": "promise"})
+        elif rtype == EVENT_DROP:
+            trace.append({**common, "ph": "i", "s": "g", "name": f"DROP {event_name(rid)}",
+                          "cat": "event", "args": {"lane": LANE_NAMES.get(arg, str(arg))}})
+
+    for core in sorted({r[2] for r in records}):
+        trace.append({"ph": "M", "pid": core, "name": "process_name", "args": {"name": f"core {core}"}})
+    for (core, task) in sorted({(r[2], r[5]) for r in records}):
+        role = thread_roles.get(task, "task")
+        trace.append({"ph": "M", "pid": core, "tid": task, "name": "thread_name",
+                      "args": {"name": f"{role} {task:08x}"}})
+
+    return {"traceEvents": trace, "displayTimeUnit": "ns",
+            "otherData": {"records": len(records), "lost": dump["lost"], "cpu_mhz": dump["cpu_mhz"]}}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a Synapse trace dump into Chrome/Perfetto trace JSON.")
+    parser.add_argument("log", help="Serial log containing the SYNTRACE dump ('-' for stdin)")
+    parser.add_argument("-o", "--output", default="synapse_trace.json", help="Output JSON file")
+    args = parser.parse_args()
+
+    try:
+        if args.log == "-":
+            lines = sys.stdin.readlines()
+        else:
+            lines = Path(args.log).read_text(errors="replace").splitlines()
+        dump, records = parse_dump(lines)
+    except (OSError, ValueError) as e:
+        print(f"❌ Error: {e}", file=sys.stderr)
+        sys.exit(1)
+
+    Path(args.output).write_text(json.dumps(to_chrome_trace(dump, records)))
+    print(f"✅ {len(records)} records ({dump['lost']} overwritten) written to {args.output}")
+
+
+if __name__ == "__main__":
+    main()